@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <vector>
+
+extern "C" {
+    #include "hash.h"
+    #include "map.h"
+}
+
+
+static char const hash_key[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+// Raw throughput of a hash function over keys of the given length
+static void BM_Hash(benchmark::State & state, CHasher hasher) {
+    std::vector<char> data(state.range(0));
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = (char) (i * 31 + 7);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hasher(data.data(), data.size(), hash_key));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// What the hash function costs in a map lookup, where keys are short
+static void BM_HashMapLookup(benchmark::State & state, CHasher hasher) {
+    std::vector<uint64_t> keys(state.range(0));
+    struct HashMap * map = newFlatHashMap(16);
+    hashMapUseHasher(map, hasher, bytesEqual);
+
+    for (size_t i = 0; i < keys.size(); i++) {
+        keys[i] = i * 0x9e3779b97f4a7c15ULL;
+        hashMapInsert(map, sizeof keys[i], &keys[i], &keys[i]);
+    }
+
+    for (auto _ : state) {
+        for (uint64_t & key : keys)
+            benchmark::DoNotOptimize(hashMapGet(map, sizeof key, &key));
+    }
+
+    state.SetItemsProcessed(state.iterations() * keys.size());
+    deleteHashMap(&map, nullptr);
+}
+
+BENCHMARK_CAPTURE(BM_Hash, siphash24, sipHash24)->Arg(8)->Arg(16)->Arg(64)->Arg(1024);
+BENCHMARK_CAPTURE(BM_Hash, wyhash, wyHash)->Arg(8)->Arg(16)->Arg(64)->Arg(1024);
+BENCHMARK_CAPTURE(BM_Hash, crc32c, crc32cHash)->Arg(8)->Arg(16)->Arg(64)->Arg(1024);
+BENCHMARK_CAPTURE(BM_HashMapLookup, siphash24, sipHash24)->Arg(100000);
+BENCHMARK_CAPTURE(BM_HashMapLookup, wyhash, wyHash)->Arg(100000);
+BENCHMARK_CAPTURE(BM_HashMapLookup, crc32c, crc32cHash)->Arg(100000);
@@ -0,0 +1,175 @@
+#include <benchmark/benchmark.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <vector>
+
+extern "C" {
+    #include "deque.h"
+    #include "list.h"
+    #include "lsearch.h"
+    #include "map.h"
+    #include "set.h"
+    #include "vector.h"
+}
+
+
+static int intComparator(void const * a, void const * b) {
+    int const * a_int = (int const *) a;
+    int const * b_int = (int const *) b;
+    return (* a_int > * b_int) - (* a_int < * b_int);
+}
+
+static int pointerComparator(void const * a, void const * b) {
+    return a != b;
+}
+
+static int mapItemComparator(void const * a, void const * b) {
+    return intComparator(((struct HashMapItem const *) a) -> value, b);
+}
+
+static int setItemComparator(void const * a, void const * b) {
+    return intComparator(((struct HashSetItem const *) a) -> value, b);
+}
+
+// The linear search as it was before collections had iterators: two indirect calls per element
+static int lsearchByIndex(struct Collection * const collection, void const * const needle, CComparator compare) {
+    for (unsigned index = 0; collection -> atEnd(collection, index) == false; index++) {
+        if (compare(collection -> get(collection, index), needle) == 0)
+            return index;
+    }
+
+    return -1;
+}
+
+enum ContainerKind {
+    VECTOR,
+    LIST,
+    DEQUE,
+    HASH_MAP,
+    HASH_SET,
+};
+
+/*
+ * Builds the given container over the values and returns its collection, along with the comparator to search it with.
+ * Owner keeps the container alive, deleteContainer frees it.
+ */
+struct Container {
+    enum ContainerKind kind;
+    void * owner;
+    struct Collection * collection;
+    CComparator compare;
+};
+
+static struct Container newContainer(enum ContainerKind kind, std::vector<int> & values) {
+    struct Container container = {kind, nullptr, nullptr, intComparator};
+
+    if (kind == VECTOR) {
+        struct Vector * vector = newVector(values.size());
+        for (int & value : values)
+            vectorPushBack(vector, &value);
+        container.owner = vector;
+        container.collection = &vector -> collection;
+    }
+    else if (kind == LIST) {
+        struct List * list = newList();
+        for (int & value : values)
+            listPushBack(list, &value);
+        container.owner = list;
+        container.collection = &list -> collection;
+    }
+    else if (kind == DEQUE) {
+        struct Deque * deque = newDeque(64);
+        for (int & value : values)
+            dequePushBack(deque, &value);
+        container.owner = deque;
+        container.collection = &deque -> collection;
+    }
+    else if (kind == HASH_MAP) {
+        struct HashMap * map = newHashMap(16);
+        for (int & value : values)
+            hashMapInsert(map, sizeof value, &value, &value);
+        container.owner = map;
+        container.collection = &map -> collection;
+        container.compare = mapItemComparator;
+    }
+    else {
+        struct HashSet * set = newHashSet(16);
+        for (int & value : values)
+            hashSetInsert(set, sizeof value, &value);
+        container.owner = set;
+        container.collection = &set -> collection;
+        container.compare = setItemComparator;
+    }
+
+    return container;
+}
+
+static void deleteContainer(struct Container & container) {
+    if (container.kind == VECTOR)
+        deleteVector((struct Vector **) &container.owner, nullptr);
+    else if (container.kind == LIST)
+        deleteList((struct List **) &container.owner, nullptr);
+    else if (container.kind == DEQUE)
+        deleteDeque((struct Deque **) &container.owner, nullptr);
+    else if (container.kind == HASH_MAP)
+        deleteHashMap((struct HashMap **) &container.owner, nullptr);
+    else
+        deleteHashSet((struct HashSet **) &container.owner, nullptr);
+}
+
+
+// Every search misses so that all elements are visited
+static void BM_LSearch(benchmark::State & state, enum ContainerKind kind, bool by_index) {
+    std::vector<int> values(state.range(0));
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = i;
+
+    struct Container container = newContainer(kind, values);
+    int needle = -1;
+
+    for (auto _ : state) {
+        if (by_index)
+            benchmark::DoNotOptimize(lsearchByIndex(container.collection, &needle, container.compare));
+        else
+            benchmark::DoNotOptimize(lsearch(container.collection, &needle, container.compare));
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+    deleteContainer(container);
+}
+
+BENCHMARK_CAPTURE(BM_LSearch, vector_by_index, VECTOR, true)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_LSearch, vector, VECTOR, false)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_LSearch, list_by_index, LIST, true)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_LSearch, list, LIST, false)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_LSearch, deque_by_index, DEQUE, true)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_LSearch, deque, DEQUE, false)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_LSearch, hash_map_by_index, HASH_MAP, true)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_LSearch, hash_map, HASH_MAP, false)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_LSearch, hash_set_by_index, HASH_SET, true)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_LSearch, hash_set, HASH_SET, false)->Arg(1000)->Arg(100000);
+
+// Looking for a handle by address in a large vector, with a comparator then without
+static void BM_LSearchHandle(benchmark::State & state, bool comparator) {
+    std::vector<int> handles(state.range(0));
+    struct Vector * vector = newVector(handles.size());
+    for (int & handle : handles)
+        vectorPushBack(vector, &handle);
+
+    // The needle is the last handle so that the whole vector is scanned
+    int * needle = &handles.back();
+
+    for (auto _ : state) {
+        if (comparator)
+            benchmark::DoNotOptimize(lsearch(&vector -> collection, needle, pointerComparator));
+        else
+            benchmark::DoNotOptimize(lsearchPointer(&vector -> collection, needle));
+    }
+
+    state.SetItemsProcessed(state.iterations() * handles.size());
+    deleteVector(&vector, nullptr);
+}
+
+BENCHMARK_CAPTURE(BM_LSearchHandle, comparator, true)->Arg(1000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_LSearchHandle, pointer, false)->Arg(1000)->Arg(1000000);
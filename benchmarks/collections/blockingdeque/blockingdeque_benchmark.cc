@@ -0,0 +1,164 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <inttypes.h>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+    #include "blockingdeque.h"
+    #include "deque.h"
+}
+
+/*
+ * A producer thread sends elements to a consumer thread, either through a blocking deque
+ * or through a deque behind a mutex that the consumer polls, yielding the processor between attempts.
+ * The paced benchmarks leave a gap between elements, like a stage waiting on I/O would:
+ * that's where polling wastes processor time, which the cpu_utilization counter reports
+ * as the processor time of the whole process divided by the elapsed time.
+ */
+
+static const unsigned paced_count = 200;
+static const unsigned burst_count = 1 << 16;
+
+typedef std::chrono::steady_clock Clock;
+
+// A deque behind a mutex, polled by the consumer
+struct PolledDeque {
+    std::mutex mutex;
+    struct Deque * deque;
+};
+
+static void polledPushBack(struct PolledDeque * polled, void * element) {
+    std::lock_guard<std::mutex> guard(polled -> mutex);
+    dequePushBack(polled -> deque, element);
+}
+
+static void * polledPopFront(struct PolledDeque * polled) {
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> guard(polled -> mutex);
+            if (isDequeEmpty(polled -> deque) == false)
+                return dequePopFront(polled -> deque);
+        }
+        std::this_thread::yield();
+    }
+}
+
+static double processorSeconds() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// Sends paced_count elements with the given gap between them and reports the latency of each one
+template <typename Push, typename Pop>
+static void pacedTransfer(benchmark::State & state, Push push, Pop pop) {
+    std::chrono::microseconds gap(state.range(0));
+    std::vector<Clock::time_point> sent(paced_count + 1);
+    std::vector<double> latencies;
+    double processor = 0, elapsed = 0;
+
+    for (auto _ : state) {
+        double processor_start = processorSeconds();
+        Clock::time_point start = Clock::now();
+
+        std::thread producer([&]() {
+            for (uintptr_t i = 1; i <= paced_count; i++) {
+                std::this_thread::sleep_for(gap);
+                sent[i] = Clock::now();
+                push((void *) i);
+            }
+        });
+
+        for (unsigned received = 0; received < paced_count; received++) {
+            uintptr_t i = (uintptr_t) pop();
+            latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - sent[i]).count());
+        }
+
+        producer.join();
+        processor += processorSeconds() - processor_start;
+        elapsed += std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    state.counters["p50_us"] = latencies[latencies.size() / 2];
+    state.counters["p99_us"] = latencies[latencies.size() * 99 / 100];
+    state.counters["cpu_utilization"] = processor / elapsed;
+    state.SetItemsProcessed(state.iterations() * paced_count);
+}
+
+static void BM_BlockingDequePaced(benchmark::State & state) {
+    struct BlockingDeque * deque = newBlockingDeque(0);
+
+    pacedTransfer(state,
+        [deque](void * element) { blockingDequePushBack(deque, element, BLOCKING_DEQUE_FOREVER); },
+        [deque]() { return blockingDequePopFront(deque, BLOCKING_DEQUE_FOREVER); });
+
+    deleteBlockingDeque(&deque, nullptr);
+}
+
+static void BM_PolledDequePaced(benchmark::State & state) {
+    struct PolledDeque polled;
+    polled.deque = newDeque(64);
+    struct PolledDeque * shared = &polled;
+
+    pacedTransfer(state,
+        [shared](void * element) { polledPushBack(shared, element); },
+        [shared]() { return polledPopFront(shared); });
+
+    deleteDeque(&polled.deque, nullptr);
+}
+
+
+// Elements sent as fast as possible through a bounded deque, the consumer draining up to the given number at once
+static void BM_BlockingDequeBurst(benchmark::State & state) {
+    unsigned batch_size = state.range(0);
+    struct BlockingDeque * deque = newBlockingDeque(1024);
+    std::vector<void *> popped(batch_size);
+
+    for (auto _ : state) {
+        std::thread producer([deque]() {
+            for (uintptr_t i = 1; i <= burst_count; i++)
+                blockingDequePushBack(deque, (void *) i, BLOCKING_DEQUE_FOREVER);
+        });
+
+        for (unsigned received = 0; received < burst_count; )
+            received += blockingDequeDrain(deque, popped.data(), batch_size, BLOCKING_DEQUE_FOREVER);
+
+        producer.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * burst_count);
+    deleteBlockingDeque(&deque, nullptr);
+}
+
+static void BM_PolledDequeBurst(benchmark::State & state) {
+    struct PolledDeque polled;
+    polled.deque = newDeque(64);
+
+    for (auto _ : state) {
+        std::thread producer([&polled]() {
+            for (uintptr_t i = 1; i <= burst_count; i++)
+                polledPushBack(&polled, (void *) i);
+        });
+
+        for (unsigned received = 0; received < burst_count; received++)
+            benchmark::DoNotOptimize(polledPopFront(&polled));
+
+        producer.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * burst_count);
+    deleteDeque(&polled.deque, nullptr);
+}
+
+BENCHMARK(BM_BlockingDequePaced)->Arg(50)->Arg(500)->UseRealTime()->Unit(benchmark::kMillisecond)->Iterations(5);
+BENCHMARK(BM_PolledDequePaced)->Arg(50)->Arg(500)->UseRealTime()->Unit(benchmark::kMillisecond)->Iterations(5);
+BENCHMARK(BM_BlockingDequeBurst)->Arg(1)->Arg(64)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PolledDequeBurst)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,203 @@
+#include <benchmark/benchmark.h>
+#include <inttypes.h>
+#include <random>
+#include <stddef.h>
+#include <stdlib.h>
+#include <vector>
+
+extern "C" {
+    #include "deque.h"
+}
+
+
+/*
+ * A producer and a consumer taking turns: the producer pushes a burst at the back, the consumer drains it from the front.
+ * The queue keeps crossing block boundaries, so every burst starts and empties blocks.
+ * The spare block limit is the second argument, with zero every emptied block goes back to the allocator.
+ */
+static void BM_DequeProducerConsumer(benchmark::State & state) {
+    int64_t burst = state.range(0);
+    int value = 0;
+
+    struct Deque * deque = newDeque(64);
+    deque -> spare_limit = state.range(1);
+
+    for (auto _ : state) {
+        for (int64_t i = 0; i < burst; i++)
+            dequePushBack(deque, &value);
+        for (int64_t i = 0; i < burst; i++)
+            benchmark::DoNotOptimize(dequePopFront(deque));
+    }
+
+    state.SetItemsProcessed(state.iterations() * burst * 2);
+    deleteDeque(&deque, nullptr);
+}
+
+// Same as above with the queue hovering right on a block boundary, one element in and one out
+static void BM_DequeBoundaryOscillation(benchmark::State & state) {
+    int value = 0;
+
+    struct Deque * deque = newDeque(64);
+    deque -> spare_limit = state.range(0);
+    for (int i = 0; i < 63; i++)
+        dequePushBack(deque, &value);
+
+    for (auto _ : state) {
+        dequePushBack(deque, &value);
+        dequePushBack(deque, &value);
+        benchmark::DoNotOptimize(dequePopBack(deque));
+        benchmark::DoNotOptimize(dequePopBack(deque));
+    }
+
+    state.SetItemsProcessed(state.iterations() * 4);
+    deleteDeque(&deque, nullptr);
+}
+
+// A long-lived queue drifting towards the back, which has to keep adding blocks at one end of the map and dropping them at the other
+static void BM_DequeSteadyQueue(benchmark::State & state) {
+    int value = 0;
+
+    struct Deque * deque = newDeque(64);
+    for (int64_t i = 0; i < state.range(0); i++)
+        dequePushBack(deque, &value);
+
+    for (auto _ : state) {
+        dequePushBack(deque, &value);
+        benchmark::DoNotOptimize(dequePopFront(deque));
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+    deleteDeque(&deque, nullptr);
+}
+
+static struct Deque * newFilledDeque(bool power_of_two, int64_t count) {
+    static int value = 0;
+
+    struct Deque * deque = power_of_two ? newPowerOfTwoDeque(64) : newDeque(64);
+    for (int64_t i = 0; i < count; i++)
+        dequePushBack(deque, &value);
+
+    return deque;
+}
+
+// Reading elements at random positions, which is where the division by the block capacity shows
+static void BM_DequeRandomAccess(benchmark::State & state, bool power_of_two) {
+    struct Deque * deque = newFilledDeque(power_of_two, state.range(0));
+
+    std::vector<unsigned> indices(4096);
+    std::mt19937 random(42);
+    for (unsigned & index : indices)
+        index = random() % deque -> size;
+
+    for (auto _ : state) {
+        for (unsigned index : indices)
+            benchmark::DoNotOptimize(dequeGet(deque, index));
+    }
+
+    state.SetItemsProcessed(state.iterations() * indices.size());
+    deleteDeque(&deque, nullptr);
+}
+
+// Visiting every element by index
+static void BM_DequeScanByIndex(benchmark::State & state, bool power_of_two) {
+    struct Deque * deque = newFilledDeque(power_of_two, state.range(0));
+
+    for (auto _ : state) {
+        for (int i = 0; i < deque -> size; i++)
+            benchmark::DoNotOptimize(dequeGet(deque, i));
+    }
+
+    state.SetItemsProcessed(state.iterations() * deque -> size);
+    deleteDeque(&deque, nullptr);
+}
+
+// Visiting every element one block at a time
+static void BM_DequeScanBySegment(benchmark::State & state, bool power_of_two) {
+    struct Deque * deque = newFilledDeque(power_of_two, state.range(0));
+
+    for (auto _ : state) {
+        struct DequeSegment segment = dequeSegment(deque);
+        while (dequeSegmentNext(deque, &segment)) {
+            for (unsigned i = 0; i < segment.length; i++)
+                benchmark::DoNotOptimize(segment.elements[i]);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * deque -> size);
+    deleteDeque(&deque, nullptr);
+}
+
+static void countElement(void * element) {
+    benchmark::DoNotOptimize(element);
+}
+
+// Deleting a deque with a deleter, which walks it segment by segment
+static void BM_DequeDeleteWithDeleter(benchmark::State & state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        struct Deque * deque = newFilledDeque(false, state.range(0));
+        state.ResumeTiming();
+
+        deleteDeque(&deque, countElement);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/*
+ * A pipeline stage moving events through a deque: batches pushed at the back are taken from the front,
+ * with a backlog of a few thousand events in between. The batch size is the argument, a batch of 1 still goes through the N calls.
+ */
+static void BM_DequePipelineBatch(benchmark::State & state) {
+    unsigned batch_size = state.range(0);
+    std::vector<int> events(4096);
+    std::vector<void *> batch(batch_size), drained(batch_size);
+    for (unsigned i = 0; i < batch_size; i++)
+        batch[i] = &events[i % events.size()];
+
+    struct Deque * deque = newDeque(64);
+    for (int & event : events)
+        dequePushBack(deque, &event);
+
+    for (auto _ : state) {
+        for (unsigned moved = 0; moved < 4096; moved += batch_size) {
+            dequePushBackN(deque, batch.data(), batch_size);
+            benchmark::DoNotOptimize(dequePopFrontN(deque, drained.data(), batch_size));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * 4096);
+    deleteDeque(&deque, nullptr);
+}
+
+// Same pipeline one event at a time with the single element calls
+static void BM_DequePipelineSingle(benchmark::State & state) {
+    std::vector<int> events(4096);
+
+    struct Deque * deque = newDeque(64);
+    for (int & event : events)
+        dequePushBack(deque, &event);
+
+    for (auto _ : state) {
+        for (int & event : events) {
+            dequePushBack(deque, &event);
+            benchmark::DoNotOptimize(dequePopFront(deque));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * 4096);
+    deleteDeque(&deque, nullptr);
+}
+
+BENCHMARK(BM_DequeProducerConsumer)->ArgsProduct({{16, 256, 4096}, {0, 4}});
+BENCHMARK(BM_DequeBoundaryOscillation)->Arg(0)->Arg(4);
+BENCHMARK(BM_DequeSteadyQueue)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_DequeRandomAccess, divide, false)->Arg(1000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_DequeRandomAccess, power_of_two, true)->Arg(1000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_DequeScanByIndex, divide, false)->Arg(1000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_DequeScanByIndex, power_of_two, true)->Arg(1000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_DequeScanBySegment, divide, false)->Arg(1000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_DequeScanBySegment, power_of_two, true)->Arg(1000)->Arg(1000000);
+BENCHMARK(BM_DequeDeleteWithDeleter)->Arg(1000)->Arg(1000000);
+BENCHMARK(BM_DequePipelineBatch)->Arg(1)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(BM_DequePipelineSingle);
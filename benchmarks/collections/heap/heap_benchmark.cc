@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <inttypes.h>
+#include <random>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+extern "C" {
+    #include "heap.h"
+    #include "vector.h"
+}
+
+/*
+ * Heaps of each arity holding pointers to 64-bit priorities, like a scheduler holding pointers to its tasks.
+ * The priorities are shuffled in memory so that comparing two elements may cost a cache miss, as it would with real tasks.
+ */
+
+static const unsigned operations_count = 10000000;
+
+static int comparePriorities(void const * a, void const * b) {
+    uint64_t x = * (uint64_t const *) a, y = * (uint64_t const *) b;
+    return (x > y) - (x < y);
+}
+
+static std::vector<uint64_t *> makePriorities(std::vector<uint64_t> & storage, size_t count) {
+    std::mt19937_64 random(42);
+    storage.resize(count);
+    std::vector<uint64_t *> priorities(count);
+    for (size_t i = 0; i < count; i++) {
+        storage[i] = random() >> 16;
+        priorities[i] = &storage[i];
+    }
+
+    std::shuffle(priorities.begin(), priorities.end(), random);
+    return priorities;
+}
+
+
+// Half the operations are pops, the other half push the popped element back with a later priority, keeping the size steady
+static void BM_HeapHold(benchmark::State & state) {
+    unsigned arity = state.range(0);
+    std::vector<uint64_t> storage;
+    std::vector<uint64_t *> priorities = makePriorities(storage, state.range(1));
+    std::mt19937_64 random(7);
+    std::vector<uint64_t> delays(1 << 16);
+    for (uint64_t & delay : delays)
+        delay = random() >> 40;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        struct Heap * heap = newHeap(priorities.size(), arity, comparePriorities);
+        for (uint64_t * priority : priorities)
+            heapPush(heap, priority);
+        state.ResumeTiming();
+
+        for (unsigned i = 0; i < operations_count / 2; i++) {
+            uint64_t * lowest = (uint64_t *) heapPop(heap);
+            * lowest += delays[i & (delays.size() - 1)];
+            heapPush(heap, lowest);
+        }
+
+        state.PauseTiming();
+        deleteHeap(&heap, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * operations_count);
+}
+
+// Same as above, with the pop and the push fused into a single sift
+static void BM_HeapReplace(benchmark::State & state) {
+    unsigned arity = state.range(0);
+    std::vector<uint64_t> storage;
+    std::vector<uint64_t *> priorities = makePriorities(storage, state.range(1));
+    std::mt19937_64 random(7);
+    std::vector<uint64_t> delays(1 << 16);
+    for (uint64_t & delay : delays)
+        delay = random() >> 40;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        struct Heap * heap = newHeap(priorities.size(), arity, comparePriorities);
+        for (uint64_t * priority : priorities)
+            heapPush(heap, priority);
+        state.ResumeTiming();
+
+        for (unsigned i = 0; i < operations_count / 2; i++) {
+            // The lowest element is at the root, so its priority can change before it sifts down
+            uint64_t * lowest = (uint64_t *) heapPeek(heap);
+            * lowest += delays[i & (delays.size() - 1)];
+            heapReplace(heap, lowest);
+        }
+
+        state.PauseTiming();
+        deleteHeap(&heap, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * operations_count);
+}
+
+// Filling a heap one push at a time, against building it from a vector in one go
+static void BM_HeapPushAll(benchmark::State & state) {
+    unsigned arity = state.range(0);
+    std::vector<uint64_t> storage;
+    std::vector<uint64_t *> priorities = makePriorities(storage, state.range(1));
+
+    for (auto _ : state) {
+        struct Heap * heap = newHeap(priorities.size(), arity, comparePriorities);
+        for (uint64_t * priority : priorities)
+            heapPush(heap, priority);
+
+        state.PauseTiming();
+        deleteHeap(&heap, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * priorities.size());
+}
+
+static void BM_HeapFromVector(benchmark::State & state) {
+    unsigned arity = state.range(0);
+    std::vector<uint64_t> storage;
+    std::vector<uint64_t *> priorities = makePriorities(storage, state.range(1));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        struct Vector * vector = newVector(priorities.size());
+        for (uint64_t * priority : priorities)
+            vectorPushBack(vector, priority);
+        state.ResumeTiming();
+
+        struct Heap * heap = newHeapFromVector(vector, arity, comparePriorities);
+
+        state.PauseTiming();
+        deleteHeap(&heap, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * priorities.size());
+}
+
+// The first argument is the arity, the second the number of elements in the heap
+BENCHMARK(BM_HeapHold)->ArgsProduct({{2, 4, 8}, {1000, 1000000}})->Unit(benchmark::kMillisecond)->Iterations(1);
+BENCHMARK(BM_HeapReplace)->ArgsProduct({{2, 4, 8}, {1000, 1000000}})->Unit(benchmark::kMillisecond)->Iterations(1);
+BENCHMARK(BM_HeapPushAll)->ArgsProduct({{2, 4, 8}, {1000000}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HeapFromVector)->ArgsProduct({{2, 4, 8}, {1000000}})->Unit(benchmark::kMillisecond);
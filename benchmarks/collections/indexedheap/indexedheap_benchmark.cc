@@ -0,0 +1,154 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <inttypes.h>
+#include <random>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+extern "C" {
+    #include "heap.h"
+    #include "indexedheap.h"
+}
+
+/*
+ * Dijkstra's shortest paths on a random directed graph, with the first argument as the number of vertices
+ * and the second as the number of edges leaving each vertex.
+ * One version lowers the distance of queued vertices with indexedHeapDecreaseKey,
+ * the other pushes a new entry every time and skips the stale ones as they come out.
+ */
+
+static const uint64_t unreachable = UINT64_MAX;
+
+// Adjacency lists laid out one after the other
+struct Graph {
+    std::vector<unsigned> offsets;
+    std::vector<unsigned> targets;
+    std::vector<unsigned> weights;
+};
+
+static struct Graph makeGraph(unsigned vertices_count, unsigned degree) {
+    std::mt19937 random(42);
+    struct Graph graph;
+    graph.offsets.resize(vertices_count + 1);
+    graph.targets.resize((size_t) vertices_count * degree);
+    graph.weights.resize((size_t) vertices_count * degree);
+
+    for (unsigned v = 0; v <= vertices_count; v++)
+        graph.offsets[v] = v * degree;
+    for (size_t e = 0; e < graph.targets.size(); e++) {
+        graph.targets[e] = random() % vertices_count;
+        graph.weights[e] = 1 + random() % 1000;
+    }
+
+    return graph;
+}
+
+static int compareDistances(void const * a, void const * b) {
+    uint64_t x = * (uint64_t const *) a, y = * (uint64_t const *) b;
+    return (x > y) - (x < y);
+}
+
+// The queue holds pointers into the distance array, so the vertex is where the pointer points
+static void BM_DijkstraDecreaseKey(benchmark::State & state) {
+    struct Graph graph = makeGraph(state.range(0), state.range(1));
+    unsigned vertices_count = state.range(0);
+    std::vector<uint64_t> distances(vertices_count);
+    std::vector<unsigned> handles(vertices_count);
+    size_t pops = 0, peak = 0;
+
+    for (auto _ : state) {
+        std::fill(distances.begin(), distances.end(), unreachable);
+        struct IndexedHeap * queue = newIndexedHeap(1024, 0, compareDistances);
+
+        distances[0] = 0;
+        handles[0] = indexedHeapPush(queue, &distances[0]);
+
+        while (isIndexedHeapEmpty(queue) == false) {
+            peak = std::max<size_t>(peak, indexedHeapSize(queue));
+            uint64_t * closest = (uint64_t *) indexedHeapPop(queue);
+            unsigned u = closest - distances.data();
+            pops++;
+
+            for (unsigned e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                unsigned v = graph.targets[e];
+                uint64_t distance = * closest + graph.weights[e];
+                if (distance >= distances[v])
+                    continue;
+
+                // A vertex still unreached was never queued, any other one with a longer distance is still queued
+                bool queued = distances[v] != unreachable;
+                distances[v] = distance;
+                if (queued)
+                    indexedHeapDecreaseKey(queue, handles[v], &distances[v]);
+                else
+                    handles[v] = indexedHeapPush(queue, &distances[v]);
+            }
+        }
+
+        deleteIndexedHeap(&queue, nullptr);
+        benchmark::DoNotOptimize(distances.data());
+    }
+
+    state.counters["pops_per_run"] = (double) pops / state.iterations();
+    state.counters["peak_queue_size"] = peak;
+    state.SetItemsProcessed(state.iterations() * graph.targets.size());
+}
+
+// Every improvement queues a new entry holding the distance it was queued with
+struct Entry {
+    uint64_t distance;
+    unsigned vertex;
+};
+
+static void BM_DijkstraDuplicates(benchmark::State & state) {
+    struct Graph graph = makeGraph(state.range(0), state.range(1));
+    unsigned vertices_count = state.range(0);
+    std::vector<uint64_t> distances(vertices_count);
+    std::vector<struct Entry> entries;
+    entries.reserve(graph.targets.size() + 1);
+    size_t pops = 0, peak = 0;
+
+    for (auto _ : state) {
+        std::fill(distances.begin(), distances.end(), unreachable);
+        entries.clear();
+        struct Heap * queue = newHeap(1024, 0, compareDistances);
+
+        distances[0] = 0;
+        entries.push_back({0, 0});
+        heapPush(queue, &entries.back());
+
+        while (isHeapEmpty(queue) == false) {
+            peak = std::max<size_t>(peak, heapSize(queue));
+            struct Entry * closest = (struct Entry *) heapPop(queue);
+            pops++;
+
+            // A shorter distance was found after this entry was queued
+            if (closest -> distance > distances[closest -> vertex])
+                continue;
+
+            unsigned u = closest -> vertex;
+            for (unsigned e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                unsigned v = graph.targets[e];
+                uint64_t distance = closest -> distance + graph.weights[e];
+                if (distance >= distances[v])
+                    continue;
+
+                distances[v] = distance;
+                entries.push_back({distance, v});
+                heapPush(queue, &entries.back());
+            }
+        }
+
+        deleteHeap(&queue, nullptr);
+        benchmark::DoNotOptimize(distances.data());
+    }
+
+    state.counters["pops_per_run"] = (double) pops / state.iterations();
+    state.counters["peak_queue_size"] = peak;
+    state.SetItemsProcessed(state.iterations() * graph.targets.size());
+}
+
+BENCHMARK(BM_DijkstraDecreaseKey)->ArgsProduct({{100000, 1000000}, {4, 16}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DijkstraDuplicates)->ArgsProduct({{100000, 1000000}, {4, 16}})->Unit(benchmark::kMillisecond);
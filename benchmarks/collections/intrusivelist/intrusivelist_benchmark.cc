@@ -0,0 +1,176 @@
+#include <benchmark/benchmark.h>
+#include <inttypes.h>
+#include <random>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+extern "C" {
+    #include "intrusivelist.h"
+    #include "list.h"
+}
+
+/*
+ * An LRU cache of a fixed capacity over twice as many keys, accessed uniformly at random:
+ * a hit moves the entry to the front of the list and a miss evicts the entry at the back.
+ * Entries are found through a table indexed by key so that the list dominates the timings.
+ */
+
+static const unsigned accesses_count = 1000000;
+
+struct Entry {
+    uint64_t value;
+    struct ListNode * node;
+    struct ListLink link;
+    bool cached;
+};
+
+static std::vector<unsigned> makeAccesses(unsigned keys_count) {
+    std::mt19937 random(42);
+    std::vector<unsigned> accesses(accesses_count);
+    for (unsigned & access : accesses)
+        access = random() % keys_count;
+
+    return accesses;
+}
+
+// List has no way to move a node, so we relink it by hand as a user would have to
+static void listMoveNodeToFront(struct List * list, struct ListNode * node) {
+    if (node == list -> head)
+        return;
+
+    node -> prev -> next = node -> next;
+    if (node -> next != NULL)
+        node -> next -> prev = node -> prev;
+    else
+        list -> tail = node -> prev;
+
+    node -> prev = NULL;
+    node -> next = list -> head;
+    list -> head -> prev = node;
+    list -> head = node;
+}
+
+
+static void BM_ListLru(benchmark::State & state, bool pooled) {
+    unsigned capacity = state.range(0);
+    std::vector<struct Entry> entries(2 * capacity);
+    std::vector<unsigned> accesses = makeAccesses(entries.size());
+    uint64_t sum = 0;
+
+    struct List * list = pooled ? newPooledList(nullptr) : newList();
+    for (unsigned i = 0; i < capacity; i++) {
+        listPushFront(list, &entries[i]);
+        entries[i].node = list -> head;
+        entries[i].cached = true;
+    }
+
+    for (auto _ : state) {
+        for (unsigned key : accesses) {
+            struct Entry * entry = &entries[key];
+            if (entry -> cached) {
+                listMoveNodeToFront(list, entry -> node);
+            }
+            else {
+                struct Entry * victim = (struct Entry *) listPopBack(list);
+                victim -> cached = false;
+                listPushFront(list, entry);
+                entry -> node = list -> head;
+                entry -> cached = true;
+            }
+
+            sum += ((struct Entry *) list -> head -> element) -> value;
+        }
+    }
+
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * accesses.size());
+    deleteList(&list, nullptr);
+}
+
+static void BM_IntrusiveListLru(benchmark::State & state) {
+    unsigned capacity = state.range(0);
+    std::vector<struct Entry> entries(2 * capacity);
+    std::vector<unsigned> accesses = makeAccesses(entries.size());
+    uint64_t sum = 0;
+
+    struct IntrusiveList list;
+    initIntrusiveList(&list);
+    for (unsigned i = 0; i < capacity; i++) {
+        intrusiveListPushFront(&list, &entries[i].link);
+        entries[i].cached = true;
+    }
+
+    for (auto _ : state) {
+        for (unsigned key : accesses) {
+            struct Entry * entry = &entries[key];
+            if (entry -> cached) {
+                intrusiveListMoveToFront(&list, &entry -> link);
+            }
+            else {
+                struct Entry * victim = intrusiveListEntry(intrusiveListPopBack(&list), struct Entry, link);
+                victim -> cached = false;
+                intrusiveListPushFront(&list, &entry -> link);
+                entry -> cached = true;
+            }
+
+            sum += intrusiveListEntry(list.head, struct Entry, link) -> value;
+        }
+    }
+
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * accesses.size());
+}
+
+
+// Visiting every element after the churn has shuffled the order of the list
+static void BM_ListIterateShuffled(benchmark::State & state) {
+    std::vector<struct Entry> entries(state.range(0));
+    std::mt19937 random(42);
+
+    struct List * list = newList();
+    for (struct Entry & entry : entries) {
+        listPushFront(list, &entry);
+        entry.node = list -> head;
+    }
+    for (unsigned i = 0; i < entries.size(); i++)
+        listMoveNodeToFront(list, entries[random() % entries.size()].node);
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (struct ListNode * node = list -> head; node != NULL; node = node -> next)
+            sum += ((struct Entry *) node -> element) -> value;
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * entries.size());
+    deleteList(&list, nullptr);
+}
+
+static void BM_IntrusiveListIterateShuffled(benchmark::State & state) {
+    std::vector<struct Entry> entries(state.range(0));
+    std::mt19937 random(42);
+
+    struct IntrusiveList list;
+    initIntrusiveList(&list);
+    for (struct Entry & entry : entries)
+        intrusiveListPushFront(&list, &entry.link);
+    for (unsigned i = 0; i < entries.size(); i++)
+        intrusiveListMoveToFront(&list, &entries[random() % entries.size()].link);
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (struct ListLink * link = list.head; link != NULL; link = link -> next)
+            sum += intrusiveListEntry(link, struct Entry, link) -> value;
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * entries.size());
+}
+
+BENCHMARK_CAPTURE(BM_ListLru, malloc, false)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ListLru, pooled, true)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IntrusiveListLru)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ListIterateShuffled)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_IntrusiveListIterateShuffled)->Arg(1000)->Arg(100000)->Arg(1000000);
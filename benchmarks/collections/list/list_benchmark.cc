@@ -0,0 +1,371 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <inttypes.h>
+#include <random>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+extern "C" {
+    #include "list.h"
+    #include "vector.h"
+}
+
+
+enum BenchmarkList {
+    LINKED_MALLOC,
+    LINKED_POOLED,
+    UNROLLED,
+};
+
+static struct List * newBenchmarkList(enum BenchmarkList kind) {
+    if (kind == UNROLLED)
+        return newUnrolledList();
+
+    return kind == LINKED_POOLED ? newPooledList(nullptr) : newList();
+}
+
+// Size of the chunk a glibc-style allocator hands out for a request of the given size
+static size_t chunkSize(size_t size) {
+    return std::max<size_t>(32, (size + sizeof(size_t) + 15) & ~(size_t) 15);
+}
+
+// Bytes owned by the list divided by the number of elements, including the per-allocation overhead
+static double bytesPerElement(struct List const * list) {
+    double bytes = 0;
+    if (list -> layout == LIST_UNROLLED) {
+        for (struct ListBlock * block = list -> head_block; block != NULL; block = block -> next)
+            bytes += chunkSize(sizeof *block);
+    }
+    else if (list -> pool != NULL) {
+        unsigned slabs = 0;
+        for (struct ListNodeSlab * slab = list -> pool -> slabs; slab != NULL; slab = slab -> next)
+            slabs++;
+        bytes = slabs * chunkSize(sizeof(struct ListNodeSlab) + list -> pool -> slab_size * sizeof(struct ListNode));
+    }
+    else {
+        bytes = list -> size * chunkSize(sizeof(struct ListNode));
+    }
+
+    return bytes / list -> size;
+}
+
+
+// Fills the list then drains it from the front, as a queue would
+static void BM_ListPushPop(benchmark::State & state, enum BenchmarkList kind) {
+    int64_t count = state.range(0);
+    int value = 0;
+    struct List * list = newBenchmarkList(kind);
+
+    for (auto _ : state) {
+        for (int64_t i = 0; i < count; i++)
+            listPushBack(list, &value);
+        for (int64_t i = 0; i < count; i++)
+            benchmark::DoNotOptimize(listPopFront(list));
+    }
+
+    state.SetItemsProcessed(state.iterations() * count * 2);
+    deleteList(&list, nullptr);
+}
+
+// A queue that stays short, with one push for each pop
+static void BM_ListSteadyQueue(benchmark::State & state, enum BenchmarkList kind) {
+    int value = 0;
+    struct List * list = newBenchmarkList(kind);
+    for (int64_t i = 0; i < state.range(0); i++)
+        listPushBack(list, &value);
+
+    for (auto _ : state) {
+        listPushBack(list, &value);
+        benchmark::DoNotOptimize(listPopFront(list));
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+    deleteList(&list, nullptr);
+}
+
+// Building a list and deleting it, which a private pool does in one go
+static void BM_ListBuildDelete(benchmark::State & state, enum BenchmarkList kind) {
+    int64_t count = state.range(0);
+    int value = 0;
+
+    for (auto _ : state) {
+        struct List * list = newBenchmarkList(kind);
+        for (int64_t i = 0; i < count; i++)
+            listPushBack(list, &value);
+        deleteList(&list, nullptr);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Visiting every element, where adjacent nodes help the cache and unrolled blocks even more so
+static void BM_ListIterate(benchmark::State & state, enum BenchmarkList kind) {
+    int value = 0;
+    struct List * list = newBenchmarkList(kind);
+    for (int64_t i = 0; i < state.range(0); i++)
+        listPushBack(list, &value);
+
+    for (auto _ : state) {
+        if (list -> layout == LIST_UNROLLED) {
+            for (struct ListBlock * block = list -> head_block; block != NULL; block = block -> next) {
+                for (unsigned i = 0; i < block -> count; i++)
+                    benchmark::DoNotOptimize(block -> elements[i]);
+            }
+        }
+        else {
+            for (struct ListNode * node = list -> head; node != NULL; node = node -> next)
+                benchmark::DoNotOptimize(node -> element);
+        }
+    }
+
+    state.counters["bytes_per_element"] = bytesPerElement(list);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    deleteList(&list, nullptr);
+}
+
+// Inserting in the middle of a list then removing the element, where the current node stays close to the next position
+static void BM_ListInsertMiddle(benchmark::State & state, enum BenchmarkList kind) {
+    int value = 0;
+    struct List * list = newBenchmarkList(kind);
+    for (int64_t i = 0; i < state.range(0); i++)
+        listPushBack(list, &value);
+
+    for (auto _ : state) {
+        listInsert(list, list -> size / 2, &value);
+        listRemove(list, list -> size / 2);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+    deleteList(&list, nullptr);
+}
+
+// Inserting at random positions then popping at the back, where the walk to the position dominates
+static void BM_ListInsertRandom(benchmark::State & state, enum BenchmarkList kind) {
+    std::mt19937 random(42);
+    int value = 0;
+    struct List * list = newBenchmarkList(kind);
+    for (int64_t i = 0; i < state.range(0); i++)
+        listPushBack(list, &value);
+
+    for (auto _ : state) {
+        listInsert(list, random() % list -> size, &value);
+        listPopBack(list);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+    deleteList(&list, nullptr);
+}
+
+static int compareInts(void const * a, void const * b) {
+    return * (int const *) a - * (int const *) b;
+}
+
+static int comparePointedInts(void const * a, void const * b) {
+    return compareInts(* (void * const *) a, * (void * const *) b);
+}
+
+// Sorting a list of shuffled values in place, relinking the nodes
+static void BM_ListSort(benchmark::State & state) {
+    std::vector<int> values(state.range(0));
+    std::mt19937 random(42);
+    for (int & value : values)
+        value = random();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        struct List * list = newList();
+        for (int & value : values)
+            listPushBack(list, &value);
+        state.ResumeTiming();
+
+        listSort(list, compareInts);
+
+        state.PauseTiming();
+        deleteList(&list, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// Same as above, copying the elements into a vector, sorting them with qsort and writing them back into the nodes
+static void BM_ListSortThroughVector(benchmark::State & state) {
+    std::vector<int> values(state.range(0));
+    std::mt19937 random(42);
+    for (int & value : values)
+        value = random();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        struct List * list = newList();
+        for (int & value : values)
+            listPushBack(list, &value);
+        state.ResumeTiming();
+
+        struct Vector * vector = newVector(list -> size);
+        for (struct ListNode * node = list -> head; node != NULL; node = node -> next)
+            vectorPushBack(vector, node -> element);
+        qsort(vector -> elements, vector -> size, sizeof *vector -> elements, comparePointedInts);
+
+        unsigned i = 0;
+        for (struct ListNode * node = list -> head; node != NULL; node = node -> next)
+            node -> element = vector -> elements[i++];
+        deleteVector(&vector, nullptr);
+
+        state.PauseTiming();
+        deleteList(&list, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// Moving every element of a list to the back of another one, then back again
+static void BM_ListConcatenate(benchmark::State & state, bool splice) {
+    int value = 0;
+    struct List * list = newList();
+    struct List * other = newList();
+    for (int64_t i = 0; i < state.range(0); i++)
+        listPushBack(other, &value);
+
+    for (auto _ : state) {
+        if (splice) {
+            listSplice(list, NULL, other, other -> head, other -> tail, other -> size);
+            listSplice(other, NULL, list, list -> head, list -> tail, list -> size);
+        }
+        else {
+            while (isListEmpty(other) == false)
+                listPushBack(list, listPopFront(other));
+            while (isListEmpty(list) == false)
+                listPushBack(other, listPopFront(list));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+    deleteList(&list, nullptr);
+    deleteList(&other, nullptr);
+}
+
+// Removing the odd values of a list in place, going through indices and the current node of the list
+static void BM_ListFilterByIndex(benchmark::State & state) {
+    std::vector<int> values(state.range(0));
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = i;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        struct List * list = newList();
+        for (int & value : values)
+            listPushBack(list, &value);
+        state.ResumeTiming();
+
+        for (unsigned i = 0; i < list -> size; ) {
+            if (* (int *) listGet(list, i) % 2 == 1)
+                listRemove(list, i);
+            else
+                i++;
+        }
+
+        state.PauseTiming();
+        deleteList(&list, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// Same as above, with an iterator
+static void BM_ListFilterByIterator(benchmark::State & state) {
+    std::vector<int> values(state.range(0));
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = i;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        struct List * list = newList();
+        for (int & value : values)
+            listPushBack(list, &value);
+        state.ResumeTiming();
+
+        struct ListIterator iterator = listIterator(list);
+        while (listIteratorNext(&iterator)) {
+            if (* (int *) listIteratorGet(&iterator) % 2 == 1)
+                listIteratorErase(&iterator);
+        }
+
+        state.PauseTiming();
+        deleteList(&list, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// Pairing the elements from both ends of the list, where two walks interleave and the current node goes back and forth
+static void BM_ListTwoEndsByIndex(benchmark::State & state) {
+    int value = 0;
+    struct List * list = newList();
+    for (int64_t i = 0; i < state.range(0); i++)
+        listPushBack(list, &value);
+
+    for (auto _ : state) {
+        for (unsigned i = 0, j = list -> size - 1; i < j; i++, j--) {
+            benchmark::DoNotOptimize(listGet(list, i));
+            benchmark::DoNotOptimize(listGet(list, j));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    deleteList(&list, nullptr);
+}
+
+// Same as above, with an iterator for each end
+static void BM_ListTwoEndsByIterator(benchmark::State & state) {
+    int value = 0;
+    struct List * list = newList();
+    for (int64_t i = 0; i < state.range(0); i++)
+        listPushBack(list, &value);
+
+    for (auto _ : state) {
+        struct ListIterator front = listIterator(list);
+        struct ListIterator back = listIterator(list);
+        for (unsigned i = 0; i < list -> size / 2; i++) {
+            listIteratorNext(&front);
+            listIteratorPrev(&back);
+            benchmark::DoNotOptimize(listIteratorGet(&front));
+            benchmark::DoNotOptimize(listIteratorGet(&back));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    deleteList(&list, nullptr);
+}
+
+BENCHMARK_CAPTURE(BM_ListPushPop, malloc, LINKED_MALLOC)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_ListPushPop, pooled, LINKED_POOLED)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_ListPushPop, unrolled, UNROLLED)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_ListSteadyQueue, malloc, LINKED_MALLOC)->Arg(16)->Arg(1000);
+BENCHMARK_CAPTURE(BM_ListSteadyQueue, pooled, LINKED_POOLED)->Arg(16)->Arg(1000);
+BENCHMARK_CAPTURE(BM_ListSteadyQueue, unrolled, UNROLLED)->Arg(16)->Arg(1000);
+BENCHMARK_CAPTURE(BM_ListBuildDelete, malloc, LINKED_MALLOC)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_ListBuildDelete, pooled, LINKED_POOLED)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_ListBuildDelete, unrolled, UNROLLED)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_ListIterate, malloc, LINKED_MALLOC)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_ListIterate, pooled, LINKED_POOLED)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_ListIterate, unrolled, UNROLLED)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_ListInsertMiddle, malloc, LINKED_MALLOC)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_ListInsertMiddle, pooled, LINKED_POOLED)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_ListInsertMiddle, unrolled, UNROLLED)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_ListInsertRandom, malloc, LINKED_MALLOC)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_ListInsertRandom, pooled, LINKED_POOLED)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_ListInsertRandom, unrolled, UNROLLED)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_ListSort)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ListSortThroughVector)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ListConcatenate, push_pop, false)->Arg(1000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_ListConcatenate, splice, true)->Arg(1000)->Arg(1000000);
+BENCHMARK(BM_ListFilterByIndex)->Arg(1000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ListFilterByIterator)->Arg(1000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ListTwoEndsByIndex)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ListTwoEndsByIterator)->Arg(1000)->Arg(10000)->Arg(1000000)->Unit(benchmark::kMillisecond);
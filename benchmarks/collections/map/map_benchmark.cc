@@ -0,0 +1,219 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <inttypes.h>
+#include <random>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+    #include "map.h"
+}
+
+/*
+ * Cache misses can be reported alongside the timings when Google Benchmark is built with libpfm:
+ *     bazel run --define pfm=1 //benchmarks/collections/map:map_benchmark -- --benchmark_perf_counters=CACHE-MISSES
+ */
+
+
+static std::vector<uint64_t> makeKeys(size_t count) {
+    std::vector<uint64_t> keys(count);
+    for (size_t i = 0; i < count; i++)
+        keys[i] = i * 0x9e3779b97f4a7c15ULL;
+
+    return keys;
+}
+
+// Distinct keys of the given length, which is what hashing cost depends on
+static std::vector<std::string> makeStringKeys(size_t count, size_t length) {
+    std::vector<std::string> keys(count);
+    for (size_t i = 0; i < count; i++) {
+        keys[i] = std::to_string(i);
+        keys[i].resize(std::max(length, keys[i].size()), 'k');
+    }
+
+    return keys;
+}
+
+static std::vector<uint64_t> shuffled(std::vector<uint64_t> keys) {
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(42));
+    return keys;
+}
+
+// Size of the chunk a glibc-style allocator hands out for a request of the given size
+static size_t chunkSize(size_t size) {
+    return std::max<size_t>(32, (size + sizeof(size_t) + 15) & ~(size_t) 15);
+}
+
+// Bytes owned by the map divided by the number of entries, including the per-allocation overhead
+static double bytesPerEntry(struct HashMap const * map) {
+    double bytes = 0;
+    if (map -> layout == HASH_MAP_FLAT)
+        bytes = map -> capacity * (sizeof *map -> controls + sizeof *map -> slots);
+    else
+        bytes = map -> capacity * sizeof *map -> items + map -> size * chunkSize(sizeof(struct HashMapItem));
+
+    return bytes / map -> size;
+}
+
+static struct HashMap * newMap(enum HashMapLayout layout, unsigned initial_capacity) {
+    return layout == HASH_MAP_FLAT ? newFlatHashMap(initial_capacity) : newHashMap(initial_capacity);
+}
+
+static struct HashMap * newMap(bool incremental, unsigned initial_capacity) {
+    return incremental ? newIncrementalHashMap(initial_capacity) : newHashMap(initial_capacity);
+}
+
+
+static void BM_HashMapInsert(benchmark::State & state, enum HashMapLayout layout) {
+    std::vector<uint64_t> keys = makeKeys(state.range(0));
+
+    for (auto _ : state) {
+        struct HashMap * map = newMap(layout, 16);
+        for (uint64_t & key : keys)
+            hashMapInsert(map, sizeof key, &key, &key);
+
+        state.PauseTiming();
+        state.counters["bytes_per_entry"] = bytesPerEntry(map);
+        deleteHashMap(&map, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+static void BM_HashMapLookup(benchmark::State & state, enum HashMapLayout layout) {
+    std::vector<uint64_t> keys = makeKeys(state.range(0));
+    std::vector<uint64_t> needles = shuffled(keys);
+
+    struct HashMap * map = newMap(layout, 16);
+    for (uint64_t & key : keys)
+        hashMapInsert(map, sizeof key, &key, &key);
+
+    for (auto _ : state) {
+        for (uint64_t & needle : needles)
+            benchmark::DoNotOptimize(hashMapGet(map, sizeof needle, &needle));
+    }
+
+    state.counters["bytes_per_entry"] = bytesPerEntry(map);
+    state.SetItemsProcessed(state.iterations() * needles.size());
+    deleteHashMap(&map, nullptr);
+}
+
+static void BM_HashMapLookupMiss(benchmark::State & state, enum HashMapLayout layout) {
+    std::vector<uint64_t> keys = makeKeys(state.range(0));
+    std::vector<uint64_t> needles = shuffled(keys);
+    for (uint64_t & needle : needles)
+        needle += 1;
+
+    struct HashMap * map = newMap(layout, 16);
+    for (uint64_t & key : keys)
+        hashMapInsert(map, sizeof key, &key, &key);
+
+    for (auto _ : state) {
+        for (uint64_t & needle : needles)
+            benchmark::DoNotOptimize(hashMapGet(map, sizeof needle, &needle));
+    }
+
+    state.SetItemsProcessed(state.iterations() * needles.size());
+    deleteHashMap(&map, nullptr);
+}
+
+// Tail latency of individual inserts, which is where resizing shows up
+static void BM_HashMapInsertLatency(benchmark::State & state, bool incremental) {
+    std::vector<uint64_t> keys = makeKeys(state.range(0));
+    std::vector<double> latencies(keys.size());
+
+    for (auto _ : state) {
+        struct HashMap * map = newMap(incremental, 16);
+        for (size_t i = 0; i < keys.size(); i++) {
+            auto start = std::chrono::steady_clock::now();
+            hashMapInsert(map, sizeof keys[i], &keys[i], &keys[i]);
+            latencies[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        state.PauseTiming();
+        std::sort(latencies.begin(), latencies.end());
+        state.counters["p99.9_us"] = latencies[latencies.size() * 999 / 1000];
+        state.counters["max_us"] = latencies.back();
+        deleteHashMap(&map, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// Time spent growing a chained map, which should depend on the number of entries only
+// The last argument is the growth in percent, 175 being how much maps grow on their own
+static void BM_HashMapResize(benchmark::State & state) {
+    std::vector<std::string> keys = makeStringKeys(state.range(1), state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        struct HashMap * map = newHashMap(2 * keys.size());
+        for (std::string & key : keys)
+            hashMapInsert(map, key.size(), key.data(), &key);
+        state.ResumeTiming();
+
+        resizeHashMap(map, map -> capacity * state.range(2) / 100);
+
+        state.PauseTiming();
+        deleteHashMap(&map, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// Visiting every entry through the collection interface, which should scale linearly with the size of the map
+static void BM_HashMapIterate(benchmark::State & state, enum HashMapLayout layout) {
+    std::vector<uint64_t> keys = makeKeys(state.range(0));
+
+    struct HashMap * map = newMap(layout, 16);
+    for (uint64_t & key : keys)
+        hashMapInsert(map, sizeof key, &key, &key);
+
+    for (auto _ : state) {
+        for (unsigned i = 0; map -> collection.atEnd(&map -> collection, i) == false; i++)
+            benchmark::DoNotOptimize(map -> collection.get(&map -> collection, i));
+    }
+
+    state.SetComplexityN(state.range(0));
+    state.SetItemsProcessed(state.iterations() * keys.size());
+    deleteHashMap(&map, nullptr);
+}
+
+// Same as above, with a cursor
+static void BM_HashMapCursor(benchmark::State & state, enum HashMapLayout layout) {
+    std::vector<uint64_t> keys = makeKeys(state.range(0));
+
+    struct HashMap * map = newMap(layout, 16);
+    for (uint64_t & key : keys)
+        hashMapInsert(map, sizeof key, &key, &key);
+
+    for (auto _ : state) {
+        struct HashMapCursor cursor = hashMapCursor(map);
+        while (hashMapCursorNext(map, &cursor))
+            benchmark::DoNotOptimize(cursor.value);
+    }
+
+    state.SetComplexityN(state.range(0));
+    state.SetItemsProcessed(state.iterations() * keys.size());
+    deleteHashMap(&map, nullptr);
+}
+
+BENCHMARK_CAPTURE(BM_HashMapInsert, chained, HASH_MAP_CHAINED)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_HashMapInsert, flat, HASH_MAP_FLAT)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_HashMapLookup, chained, HASH_MAP_CHAINED)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_HashMapLookup, flat, HASH_MAP_FLAT)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_HashMapLookupMiss, chained, HASH_MAP_CHAINED)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_HashMapLookupMiss, flat, HASH_MAP_FLAT)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_HashMapResize)->ArgsProduct({{16, 256, 4096}, {100000}, {175, 200}})->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_HashMapInsertLatency, chained, false)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_HashMapInsertLatency, incremental, true)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_HashMapIterate, chained, HASH_MAP_CHAINED)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_HashMapIterate, flat, HASH_MAP_FLAT)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_HashMapCursor, chained, HASH_MAP_CHAINED)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_HashMapCursor, flat, HASH_MAP_FLAT)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oN);
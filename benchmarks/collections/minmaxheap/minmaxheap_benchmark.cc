@@ -0,0 +1,171 @@
+#include <benchmark/benchmark.h>
+#include <inttypes.h>
+#include <random>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+extern "C" {
+    #include "minmaxheap.h"
+    #include "indexedheap.h"
+}
+
+/*
+ * A min-max heap against what it replaces: a min-heap and a max-heap holding the same items,
+ * where taking an item out of one heap means removing it from the other through its handle.
+ */
+
+static const unsigned operations_count = 10000000;
+
+struct Item {
+    uint64_t value;
+    unsigned min_handle;
+    unsigned max_handle;
+};
+
+static int compareItems(void const * a, void const * b) {
+    uint64_t x = ((struct Item const *) a) -> value, y = ((struct Item const *) b) -> value;
+    return (x > y) - (x < y);
+}
+
+static int compareItemsReversed(void const * a, void const * b) {
+    return compareItems(b, a);
+}
+
+// The two heaps kept in sync
+struct TwoHeaps {
+    struct IndexedHeap * min;
+    struct IndexedHeap * max;
+};
+
+static void twoHeapsPush(struct TwoHeaps * heaps, struct Item * item) {
+    item -> min_handle = indexedHeapPush(heaps -> min, item);
+    item -> max_handle = indexedHeapPush(heaps -> max, item);
+}
+
+static struct Item * twoHeapsPopMin(struct TwoHeaps * heaps) {
+    struct Item * item = (struct Item *) indexedHeapPop(heaps -> min);
+    indexedHeapRemove(heaps -> max, item -> max_handle);
+    return item;
+}
+
+static struct Item * twoHeapsPopMax(struct TwoHeaps * heaps) {
+    struct Item * item = (struct Item *) indexedHeapPop(heaps -> max);
+    indexedHeapRemove(heaps -> min, item -> min_handle);
+    return item;
+}
+
+static std::vector<struct Item> makeItems(size_t count) {
+    std::mt19937_64 random(42);
+    std::vector<struct Item> items(count);
+    for (struct Item & item : items)
+        item.value = random();
+
+    return items;
+}
+
+
+// Keeping the largest K items of a stream of a million
+static void BM_MinMaxHeapTopK(benchmark::State & state) {
+    unsigned k = state.range(0);
+    std::vector<struct Item> items = makeItems(1000000);
+
+    for (auto _ : state) {
+        struct MinMaxHeap * heap = newMinMaxHeap(k + 1, compareItems);
+        for (struct Item & item : items) {
+            if (minMaxHeapSize(heap) < k)
+                minMaxHeapPush(heap, &item);
+            else if (compareItems(&item, minMaxHeapPeekMin(heap)) > 0)
+                minMaxHeapReplaceMin(heap, &item);
+        }
+
+        benchmark::DoNotOptimize(minMaxHeapPeekMax(heap));
+        deleteMinMaxHeap(&heap, nullptr);
+    }
+
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+static void BM_TwoHeapsTopK(benchmark::State & state) {
+    unsigned k = state.range(0);
+    std::vector<struct Item> items = makeItems(1000000);
+
+    for (auto _ : state) {
+        struct TwoHeaps heaps = {newIndexedHeap(k + 1, 2, compareItems), newIndexedHeap(k + 1, 2, compareItemsReversed)};
+        for (struct Item & item : items) {
+            if (indexedHeapSize(heaps.min) < k)
+                twoHeapsPush(&heaps, &item);
+            else if (compareItems(&item, indexedHeapPeek(heaps.min)) > 0) {
+                twoHeapsPopMin(&heaps);
+                twoHeapsPush(&heaps, &item);
+            }
+        }
+
+        benchmark::DoNotOptimize(indexedHeapPeek(heaps.max));
+        deleteIndexedHeap(&heaps.min, nullptr);
+        deleteIndexedHeap(&heaps.max, nullptr);
+    }
+
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+
+// Taking an item from either end at random and pushing it back with a new value, keeping the size steady
+static void BM_MinMaxHeapDoubleEnded(benchmark::State & state) {
+    std::vector<struct Item> items = makeItems(state.range(0));
+    std::mt19937_64 random(7);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        struct MinMaxHeap * heap = newMinMaxHeap(items.size(), compareItems);
+        for (struct Item & item : items)
+            minMaxHeapPush(heap, &item);
+        state.ResumeTiming();
+
+        for (unsigned i = 0; i < operations_count / 2; i++) {
+            uint64_t value = random();
+            struct Item * item = (struct Item *) ((value & 1) ? minMaxHeapPopMin(heap) : minMaxHeapPopMax(heap));
+            item -> value = value;
+            minMaxHeapPush(heap, item);
+        }
+
+        state.PauseTiming();
+        deleteMinMaxHeap(&heap, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * operations_count);
+}
+
+static void BM_TwoHeapsDoubleEnded(benchmark::State & state) {
+    std::vector<struct Item> items = makeItems(state.range(0));
+    std::mt19937_64 random(7);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        struct TwoHeaps heaps = {newIndexedHeap(items.size(), 2, compareItems), newIndexedHeap(items.size(), 2, compareItemsReversed)};
+        for (struct Item & item : items)
+            twoHeapsPush(&heaps, &item);
+        state.ResumeTiming();
+
+        for (unsigned i = 0; i < operations_count / 2; i++) {
+            uint64_t value = random();
+            struct Item * item = (value & 1) ? twoHeapsPopMin(&heaps) : twoHeapsPopMax(&heaps);
+            item -> value = value;
+            twoHeapsPush(&heaps, item);
+        }
+
+        state.PauseTiming();
+        deleteIndexedHeap(&heaps.min, nullptr);
+        deleteIndexedHeap(&heaps.max, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * operations_count);
+}
+
+BENCHMARK(BM_MinMaxHeapTopK)->Arg(100)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TwoHeapsTopK)->Arg(100)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MinMaxHeapDoubleEnded)->Arg(1000)->Arg(1000000)->Unit(benchmark::kMillisecond)->Iterations(1);
+BENCHMARK(BM_TwoHeapsDoubleEnded)->Arg(1000)->Arg(1000000)->Unit(benchmark::kMillisecond)->Iterations(1);
@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+#include <inttypes.h>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+    #include "mpmc.h"
+    #include "deque.h"
+}
+
+/*
+ * Producer threads hand a fixed number of pointers to consumer threads, either through the lock-free queue
+ * or through a deque guarded by a single mutex. The first argument is the number of producers, the second the number of consumers.
+ * Thread counts go up to the number of cores of the machine (and at least 2, so there is always some contention to look at).
+ */
+
+static const unsigned transfer_count = 1 << 16;
+
+// A deque behind a mutex
+struct LockedDeque {
+    std::mutex mutex;
+    struct Deque * deque;
+};
+
+static void lockedPushBack(struct LockedDeque * locked, void * element) {
+    std::lock_guard<std::mutex> guard(locked -> mutex);
+    dequePushBack(locked -> deque, element);
+}
+
+static void * lockedPopFront(struct LockedDeque * locked) {
+    std::lock_guard<std::mutex> guard(locked -> mutex);
+    return dequePopFront(locked -> deque);
+}
+
+// Runs the producers and consumers once, each side splitting the elements evenly between its threads
+template <typename Push, typename Pop>
+static void transfer(unsigned producers_count, unsigned consumers_count, Push push, Pop pop) {
+    std::vector<std::thread> threads;
+
+    for (unsigned p = 0; p < producers_count; p++) {
+        threads.emplace_back([=]() {
+            for (uintptr_t i = p; i < transfer_count; i += producers_count)
+                push((void *) (i + 1));
+        });
+    }
+
+    for (unsigned c = 0; c < consumers_count; c++) {
+        threads.emplace_back([=]() {
+            for (uintptr_t i = c; i < transfer_count; i += consumers_count)
+                benchmark::DoNotOptimize(pop());
+        });
+    }
+
+    for (std::thread & thread : threads)
+        thread.join();
+}
+
+static void threadCounts(benchmark::internal::Benchmark * benchmark) {
+    unsigned cores = std::thread::hardware_concurrency();
+    if (cores < 2)
+        cores = 2;
+
+    for (unsigned producers = 1; producers <= cores; producers *= 2) {
+        for (unsigned consumers = 1; consumers <= cores; consumers *= 2)
+            benchmark -> Args({producers, consumers});
+    }
+}
+
+
+static void BM_MpmcQueueTransfer(benchmark::State & state) {
+    struct MpmcQueue * queue = newMpmcQueue(1024);
+
+    for (auto _ : state) {
+        transfer(state.range(0), state.range(1),
+            [queue](void * element) { mpmcQueuePushBack(queue, element); },
+            [queue]() { return mpmcQueuePopFront(queue); });
+    }
+
+    state.SetItemsProcessed(state.iterations() * transfer_count);
+    deleteMpmcQueue(&queue, nullptr);
+}
+
+static void BM_LockedDequeTransfer(benchmark::State & state) {
+    struct LockedDeque locked;
+    locked.deque = newDeque(64);
+    struct LockedDeque * shared = &locked;
+
+    for (auto _ : state) {
+        transfer(state.range(0), state.range(1),
+            [shared](void * element) { lockedPushBack(shared, element); },
+            [shared]() {
+                void * element;
+                while ((element = lockedPopFront(shared)) == nullptr)
+                    std::this_thread::yield();
+                return element;
+            });
+    }
+
+    state.SetItemsProcessed(state.iterations() * transfer_count);
+    deleteDeque(&locked.deque, nullptr);
+}
+
+// Uncontended cost of a push followed by a pop on the calling thread
+static void BM_MpmcQueuePushPop(benchmark::State & state) {
+    struct MpmcQueue * queue = newMpmcQueue(1024);
+    int value;
+
+    for (auto _ : state) {
+        mpmcQueueTryPushBack(queue, &value);
+        benchmark::DoNotOptimize(mpmcQueueTryPopFront(queue));
+    }
+
+    deleteMpmcQueue(&queue, nullptr);
+}
+
+static void BM_LockedDequePushPop(benchmark::State & state) {
+    struct LockedDeque locked;
+    locked.deque = newDeque(64);
+    int value;
+
+    for (auto _ : state) {
+        lockedPushBack(&locked, &value);
+        benchmark::DoNotOptimize(lockedPopFront(&locked));
+    }
+
+    deleteDeque(&locked.deque, nullptr);
+}
+
+BENCHMARK(BM_MpmcQueueTransfer)->Apply(threadCounts)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LockedDequeTransfer)->Apply(threadCounts)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MpmcQueuePushPop);
+BENCHMARK(BM_LockedDequePushPop);
@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+#include <inttypes.h>
+#include <random>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+extern "C" {
+    #include "sequence.h"
+    #include "list.h"
+    #include "vector.h"
+}
+
+/*
+ * Each iteration inserts an element at a random position then pops the last one, so the size stays the same.
+ * The vector stores the pointers by value so that it can insert in place, shifting everything after the position.
+ */
+
+static void BM_SequenceInsertRandom(benchmark::State & state) {
+    std::mt19937 random(42);
+    int value = 0;
+    struct Sequence * sequence = newSequence();
+    for (int64_t i = 0; i < state.range(0); i++)
+        sequencePushBack(sequence, &value);
+
+    for (auto _ : state) {
+        sequenceInsert(sequence, random() % sequence -> size, &value);
+        sequencePopBack(sequence);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+    deleteSequence(&sequence, nullptr);
+}
+
+static void BM_ListInsertRandom(benchmark::State & state) {
+    std::mt19937 random(42);
+    int value = 0;
+    struct List * list = newList();
+    for (int64_t i = 0; i < state.range(0); i++)
+        listPushBack(list, &value);
+
+    for (auto _ : state) {
+        listInsert(list, random() % list -> size, &value);
+        listPopBack(list);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+    deleteList(&list, nullptr);
+}
+
+static void BM_VectorInsertRandom(benchmark::State & state) {
+    std::mt19937 random(42);
+    int * value = nullptr;
+    struct ValueVector * vector = newValueVector(sizeof value, state.range(0) + 1);
+    for (int64_t i = 0; i < state.range(0); i++)
+        valueVectorPushBack(vector, &value);
+
+    for (auto _ : state) {
+        valueVectorInsert(vector, random() % vector -> size, &value);
+        valueVectorErase(vector, vector -> size - 1, nullptr);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+    deleteValueVector(&vector, nullptr);
+}
+
+// Random reads, which a list can only answer by walking from its current node
+static void BM_SequenceGetRandom(benchmark::State & state) {
+    std::mt19937 random(42);
+    int value = 0;
+    struct Sequence * sequence = newSequence();
+    for (int64_t i = 0; i < state.range(0); i++)
+        sequencePushBack(sequence, &value);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sequenceGet(sequence, random() % sequence -> size));
+
+    state.SetItemsProcessed(state.iterations());
+    deleteSequence(&sequence, nullptr);
+}
+
+static void BM_SequencePushPop(benchmark::State & state) {
+    int value = 0;
+
+    for (auto _ : state) {
+        struct Sequence * sequence = newSequence();
+        for (int64_t i = 0; i < state.range(0); i++)
+            sequencePushBack(sequence, &value);
+        while (sequencePopFront(sequence) != NULL)
+            continue;
+        deleteSequence(&sequence, nullptr);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+
+// Visiting every element through the collection iterators, which go over the leaves one array at a time
+static void BM_SequenceIterate(benchmark::State & state) {
+    int value = 0;
+    struct Sequence * sequence = newSequence();
+    for (int64_t i = 0; i < state.range(0); i++)
+        sequencePushBack(sequence, &value);
+
+    struct Collection * collection = &sequence -> collection;
+    for (auto _ : state) {
+        struct CIterator iterator;
+        for (bool more = collection -> begin(collection, &iterator); more; more = collection -> next(&iterator))
+            benchmark::DoNotOptimize(collection -> deref(&iterator));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    deleteSequence(&sequence, nullptr);
+}
+
+BENCHMARK(BM_SequenceInsertRandom)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_ListInsertRandom)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_VectorInsertRandom)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_SequenceGetRandom)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_SequencePushPop)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_SequenceIterate)->Arg(1000)->Arg(100000)->Arg(1000000);
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+    #include "set.h"
+}
+
+
+// Distinct values of the given length, which is what hashing cost depends on
+static std::vector<std::string> makeStringValues(size_t count, size_t length) {
+    std::vector<std::string> values(count);
+    for (size_t i = 0; i < count; i++) {
+        values[i] = std::to_string(i);
+        values[i].resize(std::max(length, values[i].size()), 'v');
+    }
+
+    return values;
+}
+
+
+static void BM_HashSetInsert(benchmark::State & state) {
+    std::vector<std::string> values = makeStringValues(state.range(1), state.range(0));
+
+    for (auto _ : state) {
+        struct HashSet * set = newHashSet(16);
+        for (std::string & value : values)
+            hashSetInsert(set, value.size(), value.data());
+
+        state.PauseTiming();
+        deleteHashSet(&set, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// Time spent growing a set, which should depend on the number of values only
+// The last argument is the growth in percent, 175 being how much sets grow on their own
+static void BM_HashSetResize(benchmark::State & state) {
+    std::vector<std::string> values = makeStringValues(state.range(1), state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        struct HashSet * set = newHashSet(2 * values.size());
+        for (std::string & value : values)
+            hashSetInsert(set, value.size(), value.data());
+        state.ResumeTiming();
+
+        resizeHashSet(set, set -> capacity * state.range(2) / 100);
+
+        state.PauseTiming();
+        deleteHashSet(&set, nullptr);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// Visiting every value through the collection interface, which should scale linearly with the size of the set
+static void BM_HashSetIterate(benchmark::State & state) {
+    std::vector<uint64_t> values(state.range(0));
+
+    struct HashSet * set = newHashSet(16);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = i * 0x9e3779b97f4a7c15ULL;
+        hashSetInsert(set, sizeof values[i], &values[i]);
+    }
+
+    for (auto _ : state) {
+        for (unsigned i = 0; set -> collection.atEnd(&set -> collection, i) == false; i++)
+            benchmark::DoNotOptimize(set -> collection.get(&set -> collection, i));
+    }
+
+    state.SetComplexityN(state.range(0));
+    state.SetItemsProcessed(state.iterations() * values.size());
+    deleteHashSet(&set, nullptr);
+}
+
+BENCHMARK(BM_HashSetInsert)->ArgsProduct({{16, 256, 4096}, {100000}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HashSetResize)->ArgsProduct({{16, 256, 4096}, {100000}, {175, 200}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HashSetIterate)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oN);
@@ -0,0 +1,174 @@
+#include <benchmark/benchmark.h>
+#include <inttypes.h>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+    #include "spsc.h"
+    #include "deque.h"
+}
+
+/*
+ * One producer thread hands pointers to the benchmark thread, either through the lock-free queue
+ * or through a deque guarded by a mutex, which is what callers had to do before.
+ * Waiting sides yield so that the benchmarks still make progress when both threads share a core.
+ */
+
+static const unsigned transfer_count = 1 << 16;
+
+// A deque behind a mutex
+struct LockedDeque {
+    std::mutex mutex;
+    struct Deque * deque;
+};
+
+static void lockedPushBack(struct LockedDeque * locked, void * element) {
+    std::lock_guard<std::mutex> guard(locked -> mutex);
+    dequePushBack(locked -> deque, element);
+}
+
+static void * lockedPopFront(struct LockedDeque * locked) {
+    std::lock_guard<std::mutex> guard(locked -> mutex);
+    return dequePopFront(locked -> deque);
+}
+
+
+static void BM_SpscQueueThroughput(benchmark::State & state) {
+    unsigned batch_size = state.range(0);
+    struct SpscQueue * queue = newSpscQueue(1024);
+
+    for (auto _ : state) {
+        std::thread producer([queue, batch_size]() {
+            std::vector<void *> batch(batch_size);
+            for (uintptr_t i = 1; i <= transfer_count; ) {
+                unsigned length = 0;
+                for (; length < batch_size && i + length <= transfer_count; length++)
+                    batch[length] = (void *) (i + length);
+
+                unsigned pushed = batch_size == 1
+                    ? spscQueuePushBack(queue, batch[0])
+                    : spscQueuePushBackN(queue, batch.data(), length);
+                if (pushed == 0)
+                    std::this_thread::yield();
+                i += pushed;
+            }
+        });
+
+        std::vector<void *> popped(batch_size);
+        for (unsigned received = 0; received < transfer_count; ) {
+            unsigned length = batch_size == 1
+                ? (popped[0] = spscQueuePopFront(queue)) != nullptr
+                : spscQueuePopFrontN(queue, popped.data(), batch_size);
+            if (length == 0)
+                std::this_thread::yield();
+            received += length;
+        }
+
+        producer.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * transfer_count);
+    deleteSpscQueue(&queue, nullptr);
+}
+
+static void BM_LockedDequeThroughput(benchmark::State & state) {
+    struct LockedDeque locked;
+    locked.deque = newDeque(64);
+
+    for (auto _ : state) {
+        std::thread producer([&locked]() {
+            for (uintptr_t i = 1; i <= transfer_count; i++)
+                lockedPushBack(&locked, (void *) i);
+        });
+
+        for (unsigned received = 0; received < transfer_count; ) {
+            if (lockedPopFront(&locked) != nullptr)
+                received++;
+            else
+                std::this_thread::yield();
+        }
+
+        producer.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * transfer_count);
+    deleteDeque(&locked.deque, nullptr);
+}
+
+
+// Round trips through a pair of queues, with a second thread echoing every element back
+static void BM_SpscQueueRoundTrip(benchmark::State & state) {
+    struct SpscQueue * requests = newSpscQueue(64);
+    struct SpscQueue * responses = newSpscQueue(64);
+
+    std::thread echo([requests, responses]() {
+        for (;;) {
+            void * element = spscQueuePopFront(requests);
+            if (element == nullptr) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // The benchmark thread sends the queue itself to stop us
+            if (element == requests)
+                return;
+            while (spscQueuePushBack(responses, element) == false)
+                std::this_thread::yield();
+        }
+    });
+
+    int token = 0;
+    for (auto _ : state) {
+        spscQueuePushBack(requests, &token);
+        while (spscQueuePopFront(responses) == nullptr)
+            std::this_thread::yield();
+    }
+
+    spscQueuePushBack(requests, requests);
+    echo.join();
+
+    deleteSpscQueue(&requests, nullptr);
+    deleteSpscQueue(&responses, nullptr);
+}
+
+static void BM_LockedDequeRoundTrip(benchmark::State & state) {
+    struct LockedDeque requests, responses;
+    requests.deque = newDeque(64);
+    responses.deque = newDeque(64);
+
+    std::thread echo([&requests, &responses]() {
+        for (;;) {
+            void * element = lockedPopFront(&requests);
+            if (element == nullptr) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            if (element == &requests)
+                return;
+            lockedPushBack(&responses, element);
+        }
+    });
+
+    int token = 0;
+    for (auto _ : state) {
+        lockedPushBack(&requests, &token);
+        while (lockedPopFront(&responses) == nullptr)
+            std::this_thread::yield();
+    }
+
+    lockedPushBack(&requests, &requests);
+    echo.join();
+
+    deleteDeque(&requests.deque, nullptr);
+    deleteDeque(&responses.deque, nullptr);
+}
+
+BENCHMARK(BM_SpscQueueThroughput)->Arg(1)->Arg(16)->Arg(256)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LockedDequeThroughput)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SpscQueueRoundTrip)->UseRealTime();
+BENCHMARK(BM_LockedDequeRoundTrip)->UseRealTime();
@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+    #include "taskpool.h"
+}
+
+/*
+ * Fork-join workloads on the task pool, with the number of workers as argument.
+ * Worker counts go up to the number of cores of the machine, and a sequential version of each workload gives the baseline.
+ */
+
+static void workerCounts(benchmark::internal::Benchmark * benchmark) {
+    unsigned cores = std::thread::hardware_concurrency();
+    if (cores < 2)
+        cores = 2;
+
+    for (unsigned workers = 1; workers <= cores; workers *= 2)
+        benchmark -> Arg(workers);
+}
+
+
+// Recursive Fibonacci, the subproblems below the cutoff are solved on the spot
+static const unsigned fibonacci_n = 30;
+static const unsigned fibonacci_cutoff = 12;
+
+struct FibonacciArgument {
+    unsigned n;
+    uint64_t result;
+};
+
+static uint64_t fibonacciSequential(unsigned n) {
+    return n < 2 ? n : fibonacciSequential(n - 1) + fibonacciSequential(n - 2);
+}
+
+static void fibonacci(struct TaskPool * const pool, void * argument) {
+    struct FibonacciArgument * fib = (struct FibonacciArgument *) argument;
+    if (fib -> n < fibonacci_cutoff) {
+        fib -> result = fibonacciSequential(fib -> n);
+        return;
+    }
+
+    struct FibonacciArgument left = {fib -> n - 1, 0}, right = {fib -> n - 2, 0};
+    struct Task task;
+    taskPoolSpawn(pool, &task, fibonacci, &left);
+    fibonacci(pool, &right);
+    taskPoolWait(pool, &task);
+
+    fib -> result = left.result + right.result;
+}
+
+static void BM_FibonacciSequential(benchmark::State & state) {
+    for (auto _ : state)
+        benchmark::DoNotOptimize(fibonacciSequential(fibonacci_n));
+}
+
+static void BM_FibonacciTaskPool(benchmark::State & state) {
+    struct TaskPool * pool = newTaskPool(state.range(0));
+
+    for (auto _ : state) {
+        struct FibonacciArgument fib = {fibonacci_n, 0};
+        struct Task task;
+        taskPoolSpawn(pool, &task, fibonacci, &fib);
+        taskPoolWait(pool, &task);
+        benchmark::DoNotOptimize(fib.result);
+    }
+
+    deleteTaskPool(&pool);
+}
+
+
+// Sum of an array, split in halves until the pieces are small enough
+static const size_t sum_length = 1 << 24;
+static const size_t sum_grain = 1 << 14;
+
+struct SumArgument {
+    uint64_t const * values;
+    size_t length;
+    uint64_t result;
+};
+
+static uint64_t sumSequential(uint64_t const * values, size_t length) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < length; i++)
+        sum += values[i];
+
+    return sum;
+}
+
+static void sum(struct TaskPool * const pool, void * argument) {
+    struct SumArgument * range = (struct SumArgument *) argument;
+    if (range -> length <= sum_grain) {
+        range -> result = sumSequential(range -> values, range -> length);
+        return;
+    }
+
+    size_t half = range -> length / 2;
+    struct SumArgument left = {range -> values, half, 0};
+    struct SumArgument right = {range -> values + half, range -> length - half, 0};
+    struct Task task;
+    taskPoolSpawn(pool, &task, sum, &left);
+    sum(pool, &right);
+    taskPoolWait(pool, &task);
+
+    range -> result = left.result + right.result;
+}
+
+static void BM_SumSequential(benchmark::State & state) {
+    std::vector<uint64_t> values(sum_length, 3);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sumSequential(values.data(), values.size()));
+
+    state.SetBytesProcessed(state.iterations() * sum_length * sizeof(uint64_t));
+}
+
+static void BM_SumTaskPool(benchmark::State & state) {
+    std::vector<uint64_t> values(sum_length, 3);
+    struct TaskPool * pool = newTaskPool(state.range(0));
+
+    for (auto _ : state) {
+        struct SumArgument range = {values.data(), values.size(), 0};
+        struct Task task;
+        taskPoolSpawn(pool, &task, sum, &range);
+        taskPoolWait(pool, &task);
+        benchmark::DoNotOptimize(range.result);
+    }
+
+    state.SetBytesProcessed(state.iterations() * sum_length * sizeof(uint64_t));
+    deleteTaskPool(&pool);
+}
+
+BENCHMARK(BM_FibonacciSequential)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FibonacciTaskPool)->Apply(workerCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SumSequential)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SumTaskPool)->Apply(workerCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,151 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <inttypes.h>
+#include <random>
+#include <stddef.h>
+#include <stdlib.h>
+#include <vector>
+
+extern "C" {
+    #include "typed.h"
+    #include "vector.h"
+    #include "map.h"
+}
+
+/*
+ * Each benchmark comes in two flavours: the generic container, which stores void pointers and calls
+ * through function pointers, and the container generated for the exact element type.
+ */
+
+CC_VECTOR_DEFINE(IntVector, int)
+CC_HASHMAP_DEFINE(IdMap, uint64_t, uint64_t, ccHashInteger, CC_EQUALS)
+
+
+static std::vector<uint64_t> makeKeys(size_t count) {
+    std::vector<uint64_t> keys(count);
+    for (size_t i = 0; i < count; i++)
+        keys[i] = i * 0x9e3779b97f4a7c15ULL;
+
+    return keys;
+}
+
+static std::vector<uint64_t> shuffled(std::vector<uint64_t> keys) {
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(42));
+    return keys;
+}
+
+
+static void BM_GenericVectorPushBack(benchmark::State & state) {
+    // The generic vector only stores pointers so the integers have to live somewhere else
+    std::vector<int> values(state.range(0));
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = (int) i;
+
+    for (auto _ : state) {
+        struct Vector * vector = newVector(16);
+        for (int & value : values)
+            vectorPushBack(vector, &value);
+
+        benchmark::DoNotOptimize(vector -> elements);
+        deleteVector(&vector, nullptr);
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+static void BM_TypedVectorPushBack(benchmark::State & state) {
+    int count = state.range(0);
+
+    for (auto _ : state) {
+        struct IntVector vector;
+        IntVectorInit(&vector, 16);
+        for (int i = 0; i < count; i++)
+            IntVectorPushBack(&vector, i);
+
+        benchmark::DoNotOptimize(vector.elements);
+        IntVectorDestroy(&vector);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_GenericVectorGet(benchmark::State & state) {
+    std::vector<int> values(state.range(0));
+    struct Vector * vector = newVector(16);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = (int) i;
+        vectorPushBack(vector, &values[i]);
+    }
+
+    for (auto _ : state) {
+        long sum = 0;
+        for (unsigned i = 0; i < vector -> size; i++)
+            sum += * (int *) vectorGet(vector, i);
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+    deleteVector(&vector, nullptr);
+}
+
+static void BM_TypedVectorGet(benchmark::State & state) {
+    int count = state.range(0);
+    struct IntVector vector;
+    IntVectorInit(&vector, 16);
+    for (int i = 0; i < count; i++)
+        IntVectorPushBack(&vector, i);
+
+    for (auto _ : state) {
+        long sum = 0;
+        for (unsigned i = 0; i < vector.size; i++)
+            sum += IntVectorGet(&vector, i);
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+    IntVectorDestroy(&vector);
+}
+
+static void BM_GenericHashMapLookup(benchmark::State & state) {
+    std::vector<uint64_t> keys = makeKeys(state.range(0));
+    std::vector<uint64_t> needles = shuffled(keys);
+
+    struct HashMap * map = newFlatHashMap(16);
+    for (uint64_t & key : keys)
+        hashMapInsert(map, sizeof key, &key, &key);
+
+    for (auto _ : state) {
+        for (uint64_t & needle : needles)
+            benchmark::DoNotOptimize(hashMapGet(map, sizeof needle, &needle));
+    }
+
+    state.SetItemsProcessed(state.iterations() * needles.size());
+    deleteHashMap(&map, nullptr);
+}
+
+static void BM_TypedHashMapLookup(benchmark::State & state) {
+    std::vector<uint64_t> keys = makeKeys(state.range(0));
+    std::vector<uint64_t> needles = shuffled(keys);
+
+    struct IdMap map;
+    IdMapInit(&map, 16);
+    for (uint64_t key : keys)
+        IdMapInsert(&map, key, key);
+
+    for (auto _ : state) {
+        for (uint64_t needle : needles)
+            benchmark::DoNotOptimize(IdMapGet(&map, needle));
+    }
+
+    state.SetItemsProcessed(state.iterations() * needles.size());
+    IdMapDestroy(&map);
+}
+
+BENCHMARK(BM_GenericVectorPushBack)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_TypedVectorPushBack)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_GenericVectorGet)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_TypedVectorGet)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_GenericHashMapLookup)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_TypedHashMapLookup)->Arg(1000)->Arg(100000)->Arg(1000000);
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <vector>
+
+extern "C" {
+    #include "vector.h"
+}
+
+
+// A 16-byte telemetry record
+struct Record {
+    uint64_t timestamp;
+    uint32_t id;
+    float value;
+};
+
+// Size of the chunk a glibc-style allocator hands out for a request of the given size
+static size_t chunkSize(size_t size) {
+    return std::max<size_t>(32, (size + sizeof(size_t) + 15) & ~(size_t) 15);
+}
+
+
+// Records allocated one by one and stored as pointers, then summed
+static void BM_VectorScan(benchmark::State & state) {
+    struct Vector * vector = newVector(state.range(0));
+    for (int64_t i = 0; i < state.range(0); i++) {
+        struct Record * record = (struct Record *) malloc(sizeof *record);
+        * record = {(uint64_t) i, (uint32_t) i, 1.0f};
+        vectorPushBack(vector, record);
+    }
+
+    for (auto _ : state) {
+        float sum = 0;
+        for (unsigned i = 0; i < vector -> size; i++)
+            sum += ((struct Record *) vector -> elements[i]) -> value;
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["bytes_per_entry"] = (double) (vector -> capacity * sizeof(void *) + vector -> size * chunkSize(sizeof(struct Record))) / vector -> size;
+    state.SetItemsProcessed(state.iterations() * vector -> size);
+    deleteVector(&vector, free);
+}
+
+// The same records stored by value
+static void BM_ValueVectorScan(benchmark::State & state) {
+    struct ValueVector * vector = newValueVector(sizeof(struct Record), state.range(0));
+    for (int64_t i = 0; i < state.range(0); i++) {
+        struct Record record = {(uint64_t) i, (uint32_t) i, 1.0f};
+        valueVectorPushBack(vector, &record);
+    }
+
+    for (auto _ : state) {
+        float sum = 0;
+        struct Record const * records = (struct Record const *) vector -> elements;
+        for (unsigned i = 0; i < vector -> size; i++)
+            sum += records[i].value;
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["bytes_per_entry"] = (double) (vector -> capacity * vector -> element_size) / vector -> size;
+    state.SetItemsProcessed(state.iterations() * vector -> size);
+    deleteValueVector(&vector, nullptr);
+}
+
+// Appending records one at a time, then all at once
+static void BM_ValueVectorPushBack(benchmark::State & state, bool bulk) {
+    std::vector<struct Record> records(state.range(0));
+    for (size_t i = 0; i < records.size(); i++)
+        records[i] = {i, (uint32_t) i, 1.0f};
+
+    for (auto _ : state) {
+        struct ValueVector * vector = newValueVector(sizeof(struct Record), 16);
+        if (bulk) {
+            valueVectorPushBackMany(vector, records.data(), records.size());
+        }
+        else {
+            for (struct Record & record : records)
+                valueVectorPushBack(vector, &record);
+        }
+        deleteValueVector(&vector, nullptr);
+    }
+
+    state.SetItemsProcessed(state.iterations() * records.size());
+}
+
+BENCHMARK(BM_VectorScan)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_ValueVectorScan)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK_CAPTURE(BM_ValueVectorPushBack, one_by_one, false)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_ValueVectorPushBack, bulk, true)->Arg(1000)->Arg(100000);
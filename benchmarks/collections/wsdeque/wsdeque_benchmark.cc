@@ -0,0 +1,33 @@
+#include <benchmark/benchmark.h>
+
+extern "C" {
+    #include "wsdeque.h"
+}
+
+// Cost of the deque operations themselves, on the owner's side only
+static void BM_WorkStealingDequePushPop(benchmark::State & state) {
+    struct WorkStealingDeque * deque = newWorkStealingDeque(64);
+    int value;
+
+    for (auto _ : state) {
+        workStealingDequePushBack(deque, &value);
+        benchmark::DoNotOptimize(workStealingDequePopBack(deque));
+    }
+
+    deleteWorkStealingDeque(&deque, nullptr);
+}
+
+static void BM_WorkStealingDequePushSteal(benchmark::State & state) {
+    struct WorkStealingDeque * deque = newWorkStealingDeque(64);
+    int value;
+
+    for (auto _ : state) {
+        workStealingDequePushBack(deque, &value);
+        benchmark::DoNotOptimize(workStealingDequeSteal(deque));
+    }
+
+    deleteWorkStealingDeque(&deque, nullptr);
+}
+
+BENCHMARK(BM_WorkStealingDequePushPop);
+BENCHMARK(BM_WorkStealingDequePushSteal);
@@ -12,6 +12,9 @@ The available commands are explained below for quick reference.
 # Runs Bazel to test the project
 ./buildtool test
 
+# Runs Bazel to build and run the benchmarks
+./buildtool bench
+
 # Deletes data generated by Bazel and can clean the release artifacts
 ./buildtool clean
 
@@ -48,6 +51,7 @@ collections_targets = [f"{f.path}:{f.name}" for f in os.scandir("src/collections
 collections_tests = [f"//{f.path}:{f.name}_test" for f in os.scandir("tests/collections") if f.is_dir()]
 algorithms_targets = [f"{f.path}:{f.name}" for f in os.scandir("src/algorithms") if f.is_dir()]
 algorithms_tests = [f"//{f.path}:{f.name}_test" for f in os.scandir("tests/algorithms") if f.is_dir()]
+benchmarks = [f"//{f.path}:{f.name}_benchmark" for d in ["benchmarks/collections", "benchmarks/algorithms"] if os.path.isdir(d) for f in os.scandir(d) if f.is_dir()]
 
 
 # Courtesy of https://stackoverflow.com/questions/10349781/how-to-open-read-write-or-create-a-file-with-truncation-allowed/10352231#10352231
@@ -165,6 +169,35 @@ def test(
     return number_of_failures
 
 
+@app.command()
+def bench(
+    collection: str = typer.Option(None, "--collection", "-c"),
+    algorithm: str = typer.Option(None, "--algorithm", "-a")
+):
+    """Invokes Bazel to build and run the benchmarks in optimized mode."""
+    number_of_failures = 0
+    _benchmarks = []
+
+    if collection is not None:
+        _benchmarks = [f"benchmarks/collections/{collection}:{collection}_benchmark"]
+
+    if algorithm is not None:
+        _benchmarks += [f"benchmarks/algorithms/{algorithm}:{algorithm}_benchmark"]
+
+    if not _benchmarks:
+        global benchmarks
+        _benchmarks = benchmarks
+
+    for benchmark in _benchmarks:
+        bench_cmd = ["bazel", "run", "-c", "opt", benchmark]
+        if run(bench_cmd).returncode != 0:
+            number_of_failures += 1
+
+    print(f"Ran {len(_benchmarks)} benchmarks out of which {number_of_failures} failed.")
+
+    return number_of_failures
+
+
 @app.command()
 def clean(expunge: bool = typer.Option(False, "--expunge", "-e")):
     """Deletes all files generated by Bazel. If the --expunge option is provided, released artifacts, if any, are also deleted."""
@@ -0,0 +1,135 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_BLOCKINGDEQUE_H
+#define CCOLLECTIONS_BLOCKINGDEQUE_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common.h"
+#include "deque.h"
+
+// Timeout meaning "wait as long as it takes"
+#define BLOCKING_DEQUE_FOREVER (-1L)
+
+/*
+ * A deque that several threads can share, where consumers sleep while it is empty
+ * and, if it is bounded, producers sleep while it is full.
+ *
+ * Every operation takes the mutex once, batches included.
+ * Waiting threads are counted so that pushes and pops only signal the condition variables when someone sleeps on them.
+ * Closing the deque wakes everybody up: pushes fail from then on, and pops drain what is left then fail too.
+ */
+struct BlockingDeque {
+    struct Deque * deque;
+    // Zero for a deque that never fills up
+    unsigned capacity;
+    bool closed;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    unsigned waiting_consumers;
+    unsigned waiting_producers;
+};
+
+
+/**
+ * Initializes the deque
+ *
+ * @param       capacity the number of elements after which producers wait, or 0 for no limit.
+ *
+ * @return      the newly created deque.
+ */
+struct BlockingDeque * newBlockingDeque(unsigned capacity);
+
+
+/**
+ * Frees the memory occupied by the deque. No thread may be using it anymore.
+ *
+ * @param       deque   pointer to memory occupied by the deque.
+ * @param       deleter function called on the elements still in the deque, if not NULL.
+ */
+void deleteBlockingDeque(struct BlockingDeque ** const deque, CDeleter deleter);
+
+
+/**
+ * Closes the deque and wakes up every waiting thread. Elements already in the deque can still be popped.
+ *
+ * @param       deque pointer to the deque to close.
+ */
+void closeBlockingDeque(struct BlockingDeque * const deque);
+
+
+/**
+ * Check if the deque was closed.
+ *
+ * @param       deque pointer to the deque to check.
+ *
+ * @return      true if the deque is closed, false otherwise.
+ */
+bool isBlockingDequeClosed(struct BlockingDeque * const deque);
+
+
+/**
+ * Returns the number of elements in the deque.
+ *
+ * @param       deque pointer to the deque which size to return.
+ *
+ * @return      the number of elements in the deque.
+ */
+unsigned blockingDequeSize(struct BlockingDeque * const deque);
+
+
+/**
+ * Pushes an element to the back of the deque, waiting for room if the deque is bounded and full.
+ *
+ * @param       deque       pointer to deque to push back onto.
+ * @param       element     pointer to the element to push back.
+ * @param       timeout_ms  how long to wait for room in milliseconds, 0 not to wait, or BLOCKING_DEQUE_FOREVER.
+ *
+ * @return      true if the element was pushed, false if the deque is closed or the timeout expired.
+ */
+bool blockingDequePushBack(struct BlockingDeque * const deque, void * element, long timeout_ms);
+
+
+/**
+ * Pops the element at the front of the deque, waiting for one if the deque is empty.
+ *
+ * @param       deque       pointer to deque to pop front from.
+ * @param       timeout_ms  how long to wait for an element in milliseconds, 0 not to wait, or BLOCKING_DEQUE_FOREVER.
+ *
+ * @return      the element at the front of the deque, or NULL if the deque is closed and empty or the timeout expired.
+ */
+void * blockingDequePopFront(struct BlockingDeque * const deque, long timeout_ms);
+
+
+/**
+ * Pops up to count elements from the front of the deque, waiting for at least one if the deque is empty.
+ *
+ * @param       deque       pointer to deque to pop front from.
+ * @param       destination where to store the popped elements, the front of the deque first.
+ * @param       count       the maximum number of elements to pop.
+ * @param       timeout_ms  how long to wait for an element in milliseconds, 0 not to wait, or BLOCKING_DEQUE_FOREVER.
+ *
+ * @return      the number of elements popped, 0 if the deque is closed and empty or the timeout expired.
+ */
+unsigned blockingDequeDrain(struct BlockingDeque * const deque, void ** destination, unsigned count, long timeout_ms);
+
+#endif
@@ -20,13 +20,41 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <assert.h>
 
 // Structs
+struct Collection;
+
+/*
+ * The position of an iterator over a collection.
+ * Only the collection that initialized it knows what position and index stand for (a node, a bucket, an offset...).
+ */
+struct CIterator {
+    struct Collection const * collection;
+    void * position;
+    unsigned index;
+};
+
+/*
+ * Besides access by index, a collection can be walked with an iterator:
+ *
+ *     struct CIterator iterator;
+ *     for (bool more = collection -> begin(collection, &iterator); more; more = collection -> next(&iterator))
+ *         use(collection -> deref(&iterator));
+ *
+ * begin and next return false once there are no more elements, and each step is O(1) (amortized for hash based collections).
+ * Collections that store their elements in a single array also provide span, which returns that array and its length.
+ * Any of these can be NULL if the collection doesn't support it.
+ */
 struct Collection {
     void * (* get)(struct Collection * const collection, unsigned index);
     void (* set)(struct Collection * const collection, unsigned index, void * element);
     bool (* atEnd)(struct Collection const * const collection, unsigned index);
+    bool (* begin)(struct Collection const * const collection, struct CIterator * const iterator);
+    bool (* next)(struct CIterator * const iterator);
+    void * (* deref)(struct CIterator const * const iterator);
+    void * const * (* span)(struct Collection const * const collection, unsigned * const length);
 };
 // ! Structs
 
@@ -34,11 +62,16 @@ struct Collection {
 // Function pointers
 typedef int (* CComparator)(void const * a, void const * b);
 typedef void (* CDeleter)(void * element);
+typedef uint64_t (* CHasher)(void const * data, unsigned length, char const key[16]);
+typedef bool (* CEquals)(void const * a, void const * b, unsigned length);
 // ! Function pointers
 
 
 // Macros
 #define alt_assert(test, message) assert(((void)(message), test))
+
+// Fields written by different threads are kept this far apart so that they don't share a cache line
+#define CACHE_LINE_SIZE 64
 // ! Macros
 
 #endif
@@ -24,8 +24,18 @@
 
 #include "common.h"
 
+extern float deque_growth_factor;
+// Default number of emptied blocks a deque keeps around for reuse instead of freeing them
+extern unsigned deque_max_spare_blocks;
 
+
+/*
+ * The block map of a deque.
+ * Blocks in use are contents[0] to contents[size - 1], which is kept centered within storage
+ * so that blocks can be added at both ends without moving the others most of the time.
+ */
 struct Buffer {
+    void ** storage;
     void ** contents;
     unsigned capacity;
     unsigned size;
@@ -34,14 +44,26 @@ struct Buffer {
 struct Deque {
     struct Collection collection;
     struct Buffer * buffer;
-    bool front_empty;
-    bool back_empty;
+    void ** spare_blocks;
+    unsigned spare_count;
+    unsigned spare_limit;
+    // Set for deques created with newPowerOfTwoDeque, whose capacity is 1 << block_shift
+    bool power_of_two;
+    unsigned block_shift;
     int front;
     int back;
     int capacity;
     int size;
 };
 
+// A run of elements stored next to each other in one block
+struct DequeSegment {
+    void ** elements;
+    unsigned length;
+    // The next block to visit
+    unsigned block;
+};
+
 
 /**
  * Initializes the deque
@@ -51,6 +73,17 @@ struct Deque {
 struct Deque * newDeque(unsigned capacity);
 
 
+/**
+ * Initializes a deque whose block capacity is rounded up to a power of two,
+ * so that locating an element by index takes a shift and a mask instead of a division.
+ *
+ * @param       capacity the minimum number of elements in each block.
+ *
+ * @return      the newly created deque.
+ */
+struct Deque * newPowerOfTwoDeque(unsigned capacity);
+
+
 /**
  * Frees the memory occupied by the deque.
  *
@@ -117,6 +150,51 @@ void * dequePopBack(struct Deque * const deque);
 void * dequePopFront(struct Deque * const deque);
 
 
+/**
+ * Pushes several elements to the back of the deque, in the order they are given.
+ *
+ * @param       deque       pointer to deque to push back onto.
+ * @param       elements    the elements to push back.
+ * @param       count       the number of elements to push back.
+ */
+void dequePushBackN(struct Deque * const deque, void * const * elements, unsigned count);
+
+
+/**
+ * Pushes several elements to the front of the deque, so that they end up at the front in the order they are given.
+ * The first of the elements becomes the front of the deque.
+ *
+ * @param       deque       pointer to deque to push front onto.
+ * @param       elements    the elements to push front.
+ * @param       count       the number of elements to push front.
+ */
+void dequePushFrontN(struct Deque * const deque, void * const * elements, unsigned count);
+
+
+/**
+ * Pops up to count elements from the front of the deque.
+ *
+ * @param       deque       pointer to deque to pop front from.
+ * @param       destination where to store the popped elements, the front of the deque first.
+ * @param       count       the maximum number of elements to pop.
+ *
+ * @return      the number of elements popped, which is less than count if the deque held fewer elements.
+ */
+unsigned dequePopFrontN(struct Deque * const deque, void ** destination, unsigned count);
+
+
+/**
+ * Pops up to count elements from the back of the deque.
+ *
+ * @param       deque       pointer to deque to pop back from.
+ * @param       destination where to store the popped elements, in the order they were in the deque, so the back of the deque last.
+ * @param       count       the maximum number of elements to pop.
+ *
+ * @return      the number of elements popped, which is less than count if the deque held fewer elements.
+ */
+unsigned dequePopBackN(struct Deque * const deque, void ** destination, unsigned count);
+
+
 /**
  * Gets an element at the back of the deque.
  *
@@ -154,4 +232,31 @@ void * dequeGet(struct Deque * const deque, unsigned index);
  */
 void dequeSet(struct Deque * const deque, unsigned index, void * element);
 
+/**
+ * Creates a segment from which to walk the deque block by block:
+ *
+ *     struct DequeSegment segment = dequeSegment(deque);
+ *     while (dequeSegmentNext(deque, &segment))
+ *         for (unsigned i = 0; i < segment.length; i++)
+ *             use(segment.elements[i]);
+ *
+ * Pushing or popping elements invalidates the segment.
+ *
+ * @param       deque pointer to the deque to walk.
+ *
+ * @return      the new segment, which is empty until moved to the first block.
+ */
+struct DequeSegment dequeSegment(struct Deque const * const deque);
+
+
+/**
+ * Moves the segment to the elements of the next block.
+ *
+ * @param       deque   pointer to the deque the segment was created from.
+ * @param       segment pointer to the segment to move.
+ *
+ * @return      true if the segment holds elements, false if all blocks were visited.
+ */
+bool dequeSegmentNext(struct Deque const * const deque, struct DequeSegment * const segment);
+
 #endif
@@ -0,0 +1,82 @@
+/*  This file is part of the CCollections library.
+ * 
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_HASH_H
+#define CCOLLECTIONS_HASH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common.h"
+
+/*
+ * All the hash functions below are CHasher so they can be handed to hash maps and sets.
+ * Only SipHash is meant to resist keys chosen by an attacker, it's the default for that reason.
+ * The others are much faster and should be used for trusted keys.
+ */
+
+
+/**
+ * Hashes the given data with SipHash-2-4.
+ *
+ * @param       data    the bytes to hash.
+ * @param       length  the number of bytes to hash.
+ * @param       key     the 128-bit key of the hash function.
+ *
+ * @return      the 64-bit hash of the data.
+ */
+uint64_t sipHash24(void const * data, unsigned length, char const key[16]);
+
+
+/**
+ * Hashes the given data with wyhash, seeded with the first 8 bytes of the key.
+ *
+ * @param       data    the bytes to hash.
+ * @param       length  the number of bytes to hash.
+ * @param       key     the key whose first 8 bytes are used as seed.
+ *
+ * @return      the 64-bit hash of the data.
+ */
+uint64_t wyHash(void const * data, unsigned length, char const key[16]);
+
+
+/**
+ * Hashes the given data with two CRC32C lanes, seeded with the first and second 4 bytes of the key.
+ * The low 32 bits are the standard CRC32C of the data when the first 4 bytes of the key are zero.
+ * The SSE4.2 crc32 instruction is used when the processor supports it.
+ *
+ * @param       data    the bytes to hash.
+ * @param       length  the number of bytes to hash.
+ * @param       key     the key whose first 8 bytes are used as seeds.
+ *
+ * @return      the 64-bit hash of the data.
+ */
+uint64_t crc32cHash(void const * data, unsigned length, char const key[16]);
+
+
+/**
+ * Compares two keys byte per byte.
+ *
+ * @param       a       the first key.
+ * @param       b       the second key.
+ * @param       length  the length of both keys in bytes.
+ *
+ * @return      true if the keys are identical, false otherwise.
+ */
+bool bytesEqual(void const * a, void const * b, unsigned length);
+
+#endif
@@ -0,0 +1,189 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_HEAP_H
+#define CCOLLECTIONS_HEAP_H
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common.h"
+#include "vector.h"
+
+// Number of children per node of heaps created with an arity of 0
+extern unsigned heap_default_arity;
+
+// Passed as the source index when the element being sifted is written to its final index
+#define HEAP_HELD_ELEMENT UINT_MAX
+
+struct Heap;
+
+/*
+ * Called by the sifts after every element they write, for structures that keep data alongside each element of a heap.
+ * The element at index from, or the element being sifted if from is HEAP_HELD_ELEMENT, now sits at index to.
+ */
+typedef void (*CHeapMoved)(struct Heap * const heap, unsigned from, unsigned to);
+
+/*
+ * A priority queue kept as an implicit d-ary heap in a vector.
+ * The children of the element at index i are at indices d * i + 1 to d * i + d.
+ *
+ * The element that compares lowest comes out first, so a comparator that orders elements
+ * the other way round gives a max-heap.
+ * With more children per node the heap is shallower, so pushes move elements fewer times,
+ * and the children a pop compares are next to each other in memory, often on the same cache line.
+ * The arity is a power of two so that finding a parent or a child takes a shift.
+ */
+struct Heap {
+    struct Vector * vector;
+    CComparator compare;
+    // NULL for plain heaps
+    CHeapMoved moved;
+    unsigned arity;
+    unsigned arity_shift;
+};
+
+
+/**
+ * Initializes the heap
+ *
+ * @param       initial_capacity    the number of elements to make room for.
+ * @param       arity               the number of children per node, a power of two, or 0 for heap_default_arity.
+ * @param       compare             the function ordering the elements, the lowest comes out first.
+ *
+ * @return      the newly created heap.
+ */
+struct Heap * newHeap(unsigned initial_capacity, unsigned arity, CComparator compare);
+
+
+/**
+ * Initializes a heap holding the elements of the given vector, which it takes over. This takes linear time.
+ *
+ * @param       vector  the vector whose elements to reorder into a heap, owned by the heap from now on.
+ * @param       arity   the number of children per node, a power of two, or 0 for heap_default_arity.
+ * @param       compare the function ordering the elements, the lowest comes out first.
+ *
+ * @return      the newly created heap.
+ */
+struct Heap * newHeapFromVector(struct Vector * const vector, unsigned arity, CComparator compare);
+
+
+/**
+ * Initializes a heap in place over the given vector, whose elements must already be in heap order.
+ * This is for structures that embed a heap and follow its elements around through the moved callback.
+ *
+ * @param       heap    pointer to the heap to initialize.
+ * @param       vector  the vector holding the elements, owned by the heap from now on.
+ * @param       arity   the number of children per node, a power of two, or 0 for heap_default_arity.
+ * @param       compare the function ordering the elements, the lowest comes out first.
+ * @param       moved   the function called after every element the sifts write, or NULL.
+ */
+void initHeap(struct Heap * const heap, struct Vector * const vector, unsigned arity, CComparator compare, CHeapMoved moved);
+
+
+/**
+ * Frees the memory occupied by the heap.
+ *
+ * @param       heap    pointer to memory occupied by the heap.
+ * @param       deleter function called on the elements still in the heap, if not NULL.
+ */
+void deleteHeap(struct Heap ** const heap, CDeleter deleter);
+
+
+/**
+ * Check if the heap is empty.
+ *
+ * @param       heap pointer to the heap which content to check.
+ *
+ * @return      true if the heap is empty, false otherwise.
+ */
+bool isHeapEmpty(struct Heap const * const heap);
+
+
+/**
+ * Returns the number of elements in the heap.
+ *
+ * @param       heap pointer to the heap which size to return.
+ *
+ * @return      the number of elements in the heap.
+ */
+unsigned heapSize(struct Heap const * const heap);
+
+
+/**
+ * Adds an element to the heap.
+ *
+ * @param       heap    pointer to the heap to push onto.
+ * @param       element pointer to the element to push.
+ *
+ * @return      true if the element was added, false otherwise (probably due to insufficient memory)
+ */
+bool heapPush(struct Heap * const heap, void * element);
+
+
+/**
+ * Removes the lowest element of the heap.
+ *
+ * @param       heap pointer to the heap to pop from.
+ *
+ * @return      the lowest element of the heap, or NULL if the heap is empty.
+ */
+void * heapPop(struct Heap * const heap);
+
+
+/**
+ * Returns the lowest element of the heap without removing it.
+ *
+ * @param       heap pointer to the heap to look into.
+ *
+ * @return      the lowest element of the heap, or NULL if the heap is empty.
+ */
+void * heapPeek(struct Heap const * const heap);
+
+
+/**
+ * Replaces the lowest element of the heap with the given one, which is cheaper than a pop followed by a push.
+ *
+ * @param       heap    pointer to the heap to update.
+ * @param       element pointer to the element to push.
+ *
+ * @return      the lowest element of the heap before the replacement, or NULL if the heap was empty.
+ */
+void * heapReplace(struct Heap * const heap, void * element);
+
+
+/**
+ * Places an element in the hole at the given index or above it, moving down the parents that compare higher.
+ *
+ * @param       heap    pointer to the heap to sift in.
+ * @param       index   the index of the hole, below the vector's size.
+ * @param       element the element to place.
+ */
+void heapSiftUp(struct Heap * const heap, unsigned index, void * element);
+
+
+/**
+ * Places an element in the hole at the given index or below it, moving up the lowest child while it compares lower.
+ *
+ * @param       heap    pointer to the heap to sift in.
+ * @param       index   the index of the hole, below the vector's size.
+ * @param       element the element to place.
+ */
+void heapSiftDown(struct Heap * const heap, unsigned index, void * element);
+
+#endif
@@ -0,0 +1,191 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_INDEXEDHEAP_H
+#define CCOLLECTIONS_INDEXEDHEAP_H
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common.h"
+#include "heap.h"
+
+// Returned instead of a handle when an element could not be pushed
+#define INDEXED_HEAP_NO_HANDLE UINT_MAX
+
+/*
+ * A struct Heap that hands out a handle for every element pushed
+ * so that the element can later be moved up or down, or taken out, wherever it is in the heap.
+ *
+ * The elements are kept in heap order by the heap's own sifts. Next to them, handles[i] holds the handle
+ * of the element at index i, and positions[handle] holds the index of the element with that handle,
+ * both kept up to date by the heap's moved callback.
+ * Handles are small integers: a handle is given out again once its element left the heap.
+ */
+struct IndexedHeap {
+    struct Heap heap;
+    unsigned * handles;
+    unsigned * positions;
+    unsigned * free_handles;
+    unsigned free_count;
+    // Number of handles ever given out, which is the size of positions
+    unsigned handles_count;
+    // Number of elements the three arrays above have room for
+    unsigned capacity;
+    // Handle of the element being sifted, which the heap doesn't know about
+    unsigned held_handle;
+};
+
+
+/**
+ * Initializes the heap
+ *
+ * @param       initial_capacity    the number of elements to make room for.
+ * @param       arity               the number of children per node, a power of two, or 0 for heap_default_arity.
+ * @param       compare             the function ordering the elements, the lowest comes out first.
+ *
+ * @return      the newly created heap.
+ */
+struct IndexedHeap * newIndexedHeap(unsigned initial_capacity, unsigned arity, CComparator compare);
+
+
+/**
+ * Frees the memory occupied by the heap.
+ *
+ * @param       heap    pointer to memory occupied by the heap.
+ * @param       deleter function called on the elements still in the heap, if not NULL.
+ */
+void deleteIndexedHeap(struct IndexedHeap ** const heap, CDeleter deleter);
+
+
+/**
+ * Check if the heap is empty.
+ *
+ * @param       heap pointer to the heap which content to check.
+ *
+ * @return      true if the heap is empty, false otherwise.
+ */
+bool isIndexedHeapEmpty(struct IndexedHeap const * const heap);
+
+
+/**
+ * Returns the number of elements in the heap.
+ *
+ * @param       heap pointer to the heap which size to return.
+ *
+ * @return      the number of elements in the heap.
+ */
+unsigned indexedHeapSize(struct IndexedHeap const * const heap);
+
+
+/**
+ * Check if the element with the given handle is still in the heap.
+ *
+ * @param       heap    pointer to the heap to look into.
+ * @param       handle  the handle returned when the element was pushed.
+ *
+ * @return      true if the element is in the heap, false if it was popped or removed.
+ */
+bool indexedHeapContains(struct IndexedHeap const * const heap, unsigned handle);
+
+
+/**
+ * Adds an element to the heap.
+ *
+ * @param       heap    pointer to the heap to push onto.
+ * @param       element pointer to the element to push.
+ *
+ * @return      the handle of the element, or INDEXED_HEAP_NO_HANDLE if it couldn't be added (probably due to insufficient memory)
+ */
+unsigned indexedHeapPush(struct IndexedHeap * const heap, void * element);
+
+
+/**
+ * Removes the lowest element of the heap. Its handle becomes invalid.
+ *
+ * @param       heap pointer to the heap to pop from.
+ *
+ * @return      the lowest element of the heap, or NULL if the heap is empty.
+ */
+void * indexedHeapPop(struct IndexedHeap * const heap);
+
+
+/**
+ * Returns the lowest element of the heap without removing it.
+ *
+ * @param       heap pointer to the heap to look into.
+ *
+ * @return      the lowest element of the heap, or NULL if the heap is empty.
+ */
+void * indexedHeapPeek(struct IndexedHeap const * const heap);
+
+
+/**
+ * Returns the element with the given handle.
+ *
+ * @param       heap    pointer to the heap to look into.
+ * @param       handle  the handle of an element in the heap.
+ *
+ * @return      the element with the given handle.
+ */
+void * indexedHeapGet(struct IndexedHeap const * const heap, unsigned handle);
+
+
+/**
+ * Replaces the element with the given handle by one that compares lower or equal, or signals
+ * that the element compares lower than it did, if the same element is passed after changing it in place.
+ *
+ * @param       heap    pointer to the heap to update.
+ * @param       handle  the handle of an element in the heap.
+ * @param       element the new element, which keeps the handle.
+ */
+void indexedHeapDecreaseKey(struct IndexedHeap * const heap, unsigned handle, void * element);
+
+
+/**
+ * Replaces the element with the given handle by one that compares higher or equal, or signals
+ * that the element compares higher than it did, if the same element is passed after changing it in place.
+ *
+ * @param       heap    pointer to the heap to update.
+ * @param       handle  the handle of an element in the heap.
+ * @param       element the new element, which keeps the handle.
+ */
+void indexedHeapIncreaseKey(struct IndexedHeap * const heap, unsigned handle, void * element);
+
+
+/**
+ * Replaces the element with the given handle by any other, moving it up or down as needed.
+ *
+ * @param       heap    pointer to the heap to update.
+ * @param       handle  the handle of an element in the heap.
+ * @param       element the new element, which keeps the handle.
+ */
+void indexedHeapUpdate(struct IndexedHeap * const heap, unsigned handle, void * element);
+
+
+/**
+ * Removes the element with the given handle from the heap. The handle becomes invalid.
+ *
+ * @param       heap    pointer to the heap to remove from.
+ * @param       handle  the handle of an element in the heap.
+ *
+ * @return      the removed element.
+ */
+void * indexedHeapRemove(struct IndexedHeap * const heap, unsigned handle);
+
+#endif
@@ -0,0 +1,169 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_INTRUSIVE_LIST_H
+#define CCOLLECTIONS_INTRUSIVE_LIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common.h"
+
+/*
+ * A doubly linked list whose links are embedded in the elements themselves:
+ *
+ *     struct Entry {
+ *         uint64_t key;
+ *         struct ListLink link;
+ *     };
+ *
+ *     intrusiveListPushBack(&list, &entry -> link);
+ *     struct Entry * front = intrusiveListEntry(intrusiveListFront(&list), struct Entry, link);
+ *
+ * The list never allocates: it only rewires the links it is handed, so an element can be moved or
+ * removed in O(1) given a pointer to it, and walking the list costs one load per element.
+ * A link belongs to at most one list at a time and the list doesn't own the elements.
+ */
+struct ListLink {
+    struct ListLink * prev;
+    struct ListLink * next;
+};
+
+struct IntrusiveList {
+    struct ListLink * head;
+    struct ListLink * tail;
+    unsigned size;
+};
+
+// Returns a pointer to the structure of the given type that embeds the link as the given member
+#define intrusiveListEntry(link, type, member) ((type *) ((char *) (link) - offsetof(type, member)))
+
+
+/**
+ * Initializes an empty list in memory provided by the caller.
+ *
+ * @param       list pointer to the list to initialize.
+ */
+void initIntrusiveList(struct IntrusiveList * const list);
+
+
+/**
+ * Check if the list is empty.
+ *
+ * @param       list pointer to the list which content to check.
+ *
+ * @return      true if the list is empty, false otherwise.
+ */
+bool isIntrusiveListEmpty(struct IntrusiveList const * const list);
+
+
+/**
+ * Pushes a link to the back of the list.
+ *
+ * @param       list pointer to list to push back onto.
+ * @param       link pointer to the link to push back, which must not be in a list.
+ */
+void intrusiveListPushBack(struct IntrusiveList * const list, struct ListLink * const link);
+
+
+/**
+ * Pushes a link to the front of the list.
+ *
+ * @param       list pointer to list to push front onto.
+ * @param       link pointer to the link to push at the front, which must not be in a list.
+ */
+void intrusiveListPushFront(struct IntrusiveList * const list, struct ListLink * const link);
+
+
+/**
+ * Pops the link at the back of the list.
+ *
+ * @param       list pointer to list to pop back from.
+ *
+ * @return      the link at the back of the list, or NULL if the list is empty.
+ */
+struct ListLink * intrusiveListPopBack(struct IntrusiveList * const list);
+
+
+/**
+ * Pops the link at the front of the list.
+ *
+ * @param       list pointer to list to pop front from.
+ *
+ * @return      the link at the front of the list, or NULL if the list is empty.
+ */
+struct ListLink * intrusiveListPopFront(struct IntrusiveList * const list);
+
+
+/**
+ * Gets the link at the back of the list.
+ *
+ * @param       list pointer to list to get the back link from.
+ *
+ * @return      the link at the back of the list, or NULL if the list is empty.
+ */
+struct ListLink * intrusiveListBack(struct IntrusiveList const * const list);
+
+
+/**
+ * Gets the link at the front of the list.
+ *
+ * @param       list pointer to list to get the front link from.
+ *
+ * @return      the link at the front of the list, or NULL if the list is empty.
+ */
+struct ListLink * intrusiveListFront(struct IntrusiveList const * const list);
+
+
+/**
+ * Inserts a link before the given position.
+ *
+ * @param       list     pointer to the list to insert into.
+ * @param       position pointer to a link of the list, or NULL to insert at the back.
+ * @param       link     pointer to the link to insert, which must not be in a list.
+ */
+void intrusiveListInsertBefore(struct IntrusiveList * const list, struct ListLink * const position, struct ListLink * const link);
+
+
+/**
+ * Removes a link from the list. Removing a link that was already removed is caught by an assertion.
+ *
+ * @param       list pointer to the list to remove from.
+ * @param       link pointer to a link of the list.
+ */
+void intrusiveListRemove(struct IntrusiveList * const list, struct ListLink * const link);
+
+
+/**
+ * Moves a link of the list to its front, as an LRU cache does on every access.
+ *
+ * @param       list pointer to the list to update.
+ * @param       link pointer to a link of the list.
+ */
+void intrusiveListMoveToFront(struct IntrusiveList * const list, struct ListLink * const link);
+
+
+/**
+ * Moves all the links of another list before the given position, leaving the other list empty.
+ *
+ * @param       list     pointer to the list to splice into.
+ * @param       position pointer to a link of the list, or NULL to splice at the back.
+ * @param       other    pointer to the list to take the links from.
+ */
+void intrusiveListSplice(struct IntrusiveList * const list, struct ListLink * const position, struct IntrusiveList * const other);
+
+#endif
@@ -23,6 +23,18 @@
 
 #include "common.h"
 
+// Number of nodes in each slab allocated by a node pool created with a zero slab size
+extern unsigned list_pool_slab_size;
+
+// Number of elements held by each block of an unrolled list, which makes a block two cache lines long on 64-bit systems
+#define LIST_BLOCK_CAPACITY 13
+
+
+enum ListLayout {
+    LIST_LINKED,
+    LIST_UNROLLED,
+};
+
 
 struct ListNode {
     struct ListNode * prev;
@@ -30,15 +42,64 @@ struct ListNode {
     void * element;
 };
 
+/*
+ * Blocks of an unrolled list hold up to LIST_BLOCK_CAPACITY elements side by side.
+ * A block is never empty, so a scan touches a new cache line every few elements rather than for each of them.
+ */
+struct ListBlock {
+    struct ListBlock * prev;
+    struct ListBlock * next;
+    unsigned count;
+    void * elements[LIST_BLOCK_CAPACITY];
+};
+
+/*
+ * A position in a linked list, see listIterator.
+ * An iterator is either on an element of the list or off the list, which is both past the last element
+ * and before the first one: moving forward from there goes to the first element, and moving backward to the last one.
+ */
+struct ListIterator {
+    struct List * list;
+    struct ListNode * node;
+};
+
+struct ListNodeSlab {
+    struct ListNodeSlab * next;
+    struct ListNode nodes[];
+};
+
+/*
+ * Nodes are carved out of large slabs so that successive nodes are adjacent in memory,
+ * and released nodes are kept on a free list for reuse instead of being returned to the allocator.
+ * A pool can be private to a list or shared by several lists.
+ */
+struct ListNodePool {
+    struct ListNodeSlab * slabs;
+    struct ListNode * free_nodes;
+    unsigned slab_size;
+    unsigned slab_used;
+    unsigned users;
+};
+
 struct List {
     struct Collection collection;
     struct ListNode * head;
     struct ListNode * tail;
     unsigned size;
+    // Positional operations (get, set, insert, remove) start from this iterator, which also keeps track of its index
     struct {
-        struct ListNode * current_node;
+        struct ListIterator current;
         unsigned current_index;
     };
+    struct ListNodePool * pool;
+    bool owns_pool;
+    enum ListLayout layout;
+    // Unrolled lists use these instead of the nodes, and current_index is then the index of the first element of current_block
+    struct {
+        struct ListBlock * head_block;
+        struct ListBlock * tail_block;
+        struct ListBlock * current_block;
+    };
 };
 
 
@@ -50,6 +111,42 @@ struct List {
 struct List * newList();
 
 
+/**
+ * Initializes a list whose nodes are drawn from a slab pool rather than allocated one by one.
+ *
+ * @param       pool the pool to draw nodes from, shared with other lists. If NULL, the list gets a pool of its own.
+ *
+ * @return      the newly created list.
+ */
+struct List * newPooledList(struct ListNodePool * pool);
+
+
+/**
+ * Initializes a list that stores its elements in blocks of LIST_BLOCK_CAPACITY (unrolled) instead of one per node.
+ *
+ * @return      the newly created list.
+ */
+struct List * newUnrolledList();
+
+
+/**
+ * Initializes a pool of list nodes that can be shared by several lists.
+ *
+ * @param       slab_size the number of nodes in each slab, or zero to use list_pool_slab_size.
+ *
+ * @return      the newly created pool.
+ */
+struct ListNodePool * newListNodePool(unsigned slab_size);
+
+
+/**
+ * Frees the memory occupied by the pool. All lists using the pool must have been deleted first.
+ *
+ * @param       pool pointer to memory occupied by the pool.
+ */
+void deleteListNodePool(struct ListNodePool ** const pool);
+
+
 /**
  * Frees the memory occupied by the list.
  *
@@ -154,6 +251,146 @@ void listSet(struct List * const list, unsigned index, void * element);
 void listInsert(struct List * const list, unsigned index, void * element);
 
 
+/**
+ * Removes the element at the given position in the list, moving the other elements to the left.
+ *
+ * @param       list    pointer to list to remove the element from.
+ * @param       index   the index of the element to remove.
+ *
+ * @return      the removed element.
+ */
+void * listRemove(struct List * const list, unsigned index);
+
+
+/**
+ * Moves the nodes from first to last (included) out of the other list and into this one, before the given position.
+ * No node is allocated or freed, so both lists must be linked and allocate their nodes in the same way
+ * (with malloc, or from the same shared pool).
+ *
+ * @param       list     pointer to list to move the nodes into.
+ * @param       position the node of the list to insert the nodes before, or NULL to add them at the back.
+ * @param       other    pointer to list to move the nodes out of.
+ * @param       first    the first node to move.
+ * @param       last     the last node to move, which comes after first in the other list (or is first).
+ * @param       count    the number of nodes from first to last, which the lists need to keep their size.
+ */
+void listSplice(struct List * const list, struct ListNode * position, struct List * const other, struct ListNode * first, struct ListNode * last, unsigned count);
+
+
+/**
+ * Merges the other list, sorted, into this one, sorted as well, leaving the other list empty.
+ * Equal elements keep their order, the ones from this list coming first. Both lists must be as for listSplice.
+ *
+ * @param       list    pointer to list to merge into.
+ * @param       other   pointer to list to merge from.
+ * @param       compare function to use to compare elements.
+ */
+void listMerge(struct List * const list, struct List * const other, CComparator compare);
+
+
+/**
+ * Sorts the list with a stable merge sort that relinks the nodes, without allocating. The list must be linked.
+ *
+ * @param       list    pointer to list to sort.
+ * @param       compare function to use to compare elements.
+ */
+void listSort(struct List * const list, CComparator compare);
+
+
+/**
+ * Creates an iterator placed off the list, so that moving it forward goes to the first element
+ * and moving it backward goes to the last one. The list must be linked.
+ *
+ *     struct ListIterator iterator = listIterator(list);
+ *     while (listIteratorNext(&iterator))
+ *         use(listIteratorGet(&iterator));
+ *
+ * Any number of iterators can walk and modify the same list. Inserting elements doesn't invalidate them,
+ * erasing an element only invalidates the other iterators on that element.
+ *
+ * @param       list pointer to the list to walk.
+ *
+ * @return      the new iterator.
+ */
+struct ListIterator listIterator(struct List * const list);
+
+
+/**
+ * Moves the iterator to the next element, or off the list if it was on the last element.
+ *
+ * @param       iterator pointer to the iterator to move.
+ *
+ * @return      true if the iterator is on an element, false if it went off the list.
+ */
+bool listIteratorNext(struct ListIterator * const iterator);
+
+
+/**
+ * Moves the iterator to the previous element, or off the list if it was on the first element.
+ *
+ * @param       iterator pointer to the iterator to move.
+ *
+ * @return      true if the iterator is on an element, false if it went off the list.
+ */
+bool listIteratorPrev(struct ListIterator * const iterator);
+
+
+/**
+ * Gets the element the iterator is on.
+ *
+ * @param       iterator pointer to the iterator, which must be on an element.
+ *
+ * @return      the element the iterator is on.
+ */
+void * listIteratorGet(struct ListIterator const * const iterator);
+
+
+/**
+ * Replaces the element the iterator is on.
+ *
+ * @param       iterator pointer to the iterator, which must be on an element.
+ * @param       element  the new element.
+ */
+void listIteratorSet(struct ListIterator const * const iterator, void * element);
+
+
+/**
+ * Inserts the element before the one the iterator is on, or at the back of the list if the iterator is off the list.
+ * The iterator stays where it is.
+ *
+ * @param       iterator pointer to the iterator to insert at.
+ * @param       element  the element to insert.
+ */
+void listIteratorInsertBefore(struct ListIterator const * const iterator, void * element);
+
+
+/**
+ * Inserts the element after the one the iterator is on, or at the front of the list if the iterator is off the list.
+ * The iterator stays where it is.
+ *
+ * @param       iterator pointer to the iterator to insert at.
+ * @param       element  the element to insert.
+ */
+void listIteratorInsertAfter(struct ListIterator const * const iterator, void * element);
+
+
+/**
+ * Removes the element the iterator is on, moving the iterator back to the previous element (or off the list).
+ * So the next call to listIteratorNext goes to the element that followed the removed one, which makes filtering a list:
+ *
+ *     struct ListIterator iterator = listIterator(list);
+ *     while (listIteratorNext(&iterator)) {
+ *         if (keep(listIteratorGet(&iterator)) == false)
+ *             listIteratorErase(&iterator);
+ *     }
+ *
+ * @param       iterator pointer to the iterator, which must be on an element.
+ *
+ * @return      the removed element.
+ */
+void * listIteratorErase(struct ListIterator * const iterator);
+
+
 /**
  * Resets the current node and index to the beginning of the list.
  *
@@ -19,11 +19,13 @@
 #define CCOLLECTIONS_LSEARCH_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "common.h"
 
 /**
  * Performs a linear search on the given collection.
+ * Contiguous collections are scanned directly, the others are walked with their iterator if they have one.
  *
  * @param       collection  the collection to search from.
  * @param       element     the element to search for.
@@ -33,4 +35,27 @@
  */
 int lsearch(struct Collection const * const collection, void const * const element, CComparator compare);
 
+
+/**
+ * Performs a linear search for the element with the given address, without calling a comparator.
+ * On contiguous collections, several elements are compared per instruction (with AVX2 or SSE2, picked at runtime).
+ *
+ * @param       collection  the collection to search from.
+ * @param       element     the address to search for.
+ *
+ * @return      the index of the first element with that address if found, -1 otherwise.
+ */
+int lsearchPointer(struct Collection const * const collection, void const * const element);
+
+
+/**
+ * Performs a linear search for an integer stored directly in the element slots (e.g. with (void *) (intptr_t) key).
+ *
+ * @param       collection  the collection to search from.
+ * @param       key         the integer to search for.
+ *
+ * @return      the index of the first element holding that integer if found, -1 otherwise.
+ */
+int lsearchInteger(struct Collection const * const collection, intptr_t key);
+
 #endif
@@ -26,8 +26,14 @@
 #include "common.h"
 
 extern float map_growth_factor;
+extern unsigned hash_map_migration_steps;
 
 
+enum HashMapLayout {
+    HASH_MAP_CHAINED,
+    HASH_MAP_FLAT,
+};
+
 struct HashMapItem {
     void const * key;
     void * value;
@@ -37,6 +43,27 @@ struct HashMapItem {
     struct HashMapItem * next;
 };
 
+struct HashMapSlot {
+    void const * key;
+    void * value;
+    unsigned key_len;
+    uint64_t hash;
+};
+
+/*
+ * A position in a map, see hashMapCursor.
+ * The key, value and key_len members describe the entry the cursor is on.
+ */
+struct HashMapCursor {
+    void const * key;
+    void * value;
+    unsigned key_len;
+    // The struct HashMapItem (or struct HashMapSlot for flat maps) the cursor is on
+    void * entry;
+    // The next bucket (or slot) to visit
+    unsigned bucket;
+};
+
 struct HashMap {
     struct Collection collection;
     struct HashMapItem ** items;
@@ -44,6 +71,23 @@ struct HashMap {
     unsigned capacity;
     unsigned size;
     unsigned buckets_count;
+    CHasher hasher;
+    CEquals equals;
+    enum HashMapLayout layout;
+    bool incremental;
+    struct {
+        int8_t * controls;
+        struct HashMapSlot * slots;
+    };
+    struct {
+        struct HashMapItem ** old_items;
+        unsigned old_capacity;
+        unsigned migrated;
+    };
+    struct {
+        struct HashMapCursor cursor;
+        unsigned cursor_index;
+    };
 };
 
 
@@ -55,6 +99,40 @@ struct HashMap {
 struct HashMap * newHashMap(unsigned initial_capacity);
 
 
+/**
+ * Initializes a map that stores its entries in flat slot groups (open addressing) instead of chains.
+ * Entries are not allocated individually and lookups scan 16 control bytes at a time.
+ * The capacity is rounded up to a power of two (and at least 16).
+ * Through the collection interface, elements are of type struct HashMapSlot.
+ *
+ * @return      the newly created map.
+ */
+struct HashMap * newFlatHashMap(unsigned initial_capacity);
+
+
+/**
+ * Initializes a chained map that grows incrementally.
+ * When the map needs to grow, the old and new bucket arrays are kept side by side
+ * and each insert or delete moves at most hash_map_migration_steps buckets to the new array.
+ * This trades a little extra work per operation for the absence of long pauses.
+ *
+ * @return      the newly created map.
+ */
+struct HashMap * newIncrementalHashMap(unsigned initial_capacity);
+
+
+/**
+ * Replaces the hash function of the map and optionally sets the function used to compare keys.
+ * By default maps use SipHash-2-4 and consider keys with the same 64-bit hash identical.
+ * For trusted keys, a faster function from hash.h can be used, ideally alongside an equality function.
+ *
+ * @param       map     pointer to the map to configure, it must be empty.
+ * @param       hasher  the hash function to use.
+ * @param       equals  the function to compare keys with, or NULL to consider keys with the same hash identical.
+ */
+void hashMapUseHasher(struct HashMap * const map, CHasher hasher, CEquals equals);
+
+
 /**
  * Frees the memory occupied by the map.
  *
@@ -142,4 +220,32 @@ void * hashMapSet(struct HashMap * const map, unsigned key_len, void const * key
  */
 bool hashMapDelete(struct HashMap * const map, unsigned key_len, void const * key, CDeleter deleter);
 
+
+/**
+ * Creates a cursor placed before the first entry of the map.
+ * Entries are visited in no particular order and visiting all of them takes O(capacity + size):
+ *
+ *     struct HashMapCursor cursor = hashMapCursor(map);
+ *     while (hashMapCursorNext(map, &cursor))
+ *         use(cursor.key, cursor.value);
+ *
+ * Inserting or deleting entries invalidates the cursor.
+ *
+ * @param       map pointer to the map to walk.
+ *
+ * @return      the new cursor.
+ */
+struct HashMapCursor hashMapCursor(struct HashMap const * const map);
+
+
+/**
+ * Moves the cursor to the next entry of the map.
+ *
+ * @param       map     pointer to the map the cursor was created from.
+ * @param       cursor  pointer to the cursor to move.
+ *
+ * @return      true if the cursor is on an entry, false if all entries were visited.
+ */
+bool hashMapCursorNext(struct HashMap const * const map, struct HashMapCursor * const cursor);
+
 #endif
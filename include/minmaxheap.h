@@ -0,0 +1,164 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_MINMAXHEAP_H
+#define CCOLLECTIONS_MINMAXHEAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common.h"
+#include "vector.h"
+
+/*
+ * A double-ended priority queue kept as a min-max heap in a vector (Atkinson, Sack, Santoro and Strothotte).
+ *
+ * It is a binary heap whose levels alternate: every element on an even level (starting with the root) is the lowest
+ * of its subtree, and every element on an odd level is the highest of its subtree.
+ * The lowest element is therefore the root and the highest is one of its two children.
+ * Sifts move elements by two levels at a time, comparing against grandparents and grandchildren.
+ */
+struct MinMaxHeap {
+    struct Vector * vector;
+    CComparator compare;
+};
+
+
+/**
+ * Initializes the heap
+ *
+ * @param       initial_capacity    the number of elements to make room for.
+ * @param       compare             the function ordering the elements.
+ *
+ * @return      the newly created heap.
+ */
+struct MinMaxHeap * newMinMaxHeap(unsigned initial_capacity, CComparator compare);
+
+
+/**
+ * Initializes a heap holding the elements of the given vector, which it takes over. This takes linear time.
+ *
+ * @param       vector  the vector whose elements to reorder into a heap, owned by the heap from now on.
+ * @param       compare the function ordering the elements.
+ *
+ * @return      the newly created heap.
+ */
+struct MinMaxHeap * newMinMaxHeapFromVector(struct Vector * const vector, CComparator compare);
+
+
+/**
+ * Frees the memory occupied by the heap.
+ *
+ * @param       heap    pointer to memory occupied by the heap.
+ * @param       deleter function called on the elements still in the heap, if not NULL.
+ */
+void deleteMinMaxHeap(struct MinMaxHeap ** const heap, CDeleter deleter);
+
+
+/**
+ * Check if the heap is empty.
+ *
+ * @param       heap pointer to the heap which content to check.
+ *
+ * @return      true if the heap is empty, false otherwise.
+ */
+bool isMinMaxHeapEmpty(struct MinMaxHeap const * const heap);
+
+
+/**
+ * Returns the number of elements in the heap.
+ *
+ * @param       heap pointer to the heap which size to return.
+ *
+ * @return      the number of elements in the heap.
+ */
+unsigned minMaxHeapSize(struct MinMaxHeap const * const heap);
+
+
+/**
+ * Adds an element to the heap.
+ *
+ * @param       heap    pointer to the heap to push onto.
+ * @param       element pointer to the element to push.
+ *
+ * @return      true if the element was added, false otherwise (probably due to insufficient memory)
+ */
+bool minMaxHeapPush(struct MinMaxHeap * const heap, void * element);
+
+
+/**
+ * Removes the lowest element of the heap.
+ *
+ * @param       heap pointer to the heap to pop from.
+ *
+ * @return      the lowest element of the heap, or NULL if the heap is empty.
+ */
+void * minMaxHeapPopMin(struct MinMaxHeap * const heap);
+
+
+/**
+ * Removes the highest element of the heap.
+ *
+ * @param       heap pointer to the heap to pop from.
+ *
+ * @return      the highest element of the heap, or NULL if the heap is empty.
+ */
+void * minMaxHeapPopMax(struct MinMaxHeap * const heap);
+
+
+/**
+ * Returns the lowest element of the heap without removing it.
+ *
+ * @param       heap pointer to the heap to look into.
+ *
+ * @return      the lowest element of the heap, or NULL if the heap is empty.
+ */
+void * minMaxHeapPeekMin(struct MinMaxHeap const * const heap);
+
+
+/**
+ * Returns the highest element of the heap without removing it.
+ *
+ * @param       heap pointer to the heap to look into.
+ *
+ * @return      the highest element of the heap, or NULL if the heap is empty.
+ */
+void * minMaxHeapPeekMax(struct MinMaxHeap const * const heap);
+
+
+/**
+ * Replaces the lowest element of the heap with the given one, which is cheaper than a pop followed by a push.
+ *
+ * @param       heap    pointer to the heap to update.
+ * @param       element pointer to the element to push.
+ *
+ * @return      the lowest element of the heap before the replacement, or NULL if the heap was empty.
+ */
+void * minMaxHeapReplaceMin(struct MinMaxHeap * const heap, void * element);
+
+
+/**
+ * Replaces the highest element of the heap with the given one, which is cheaper than a pop followed by a push.
+ *
+ * @param       heap    pointer to the heap to update.
+ * @param       element pointer to the element to push.
+ *
+ * @return      the highest element of the heap before the replacement, or NULL if the heap was empty.
+ */
+void * minMaxHeapReplaceMax(struct MinMaxHeap * const heap, void * element);
+
+#endif
@@ -0,0 +1,122 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_MPMC_H
+#define CCOLLECTIONS_MPMC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common.h"
+
+/*
+ * A bounded queue that any number of producer and consumer threads can share without locks.
+ *
+ * This is Dmitry Vyukov's design: every slot carries a sequence number telling whose turn it is.
+ * A slot at position p is ready for the producer claiming p when its sequence equals p,
+ * and ready for the consumer claiming p when its sequence equals p + 1.
+ * Threads claim positions by advancing the tail (producers) or the head (consumers) with a compare-and-swap,
+ * then hand the slot over by bumping its sequence, so no thread ever waits on a lock held by another.
+ * Each slot takes a whole cache line so that threads working on neighbouring positions don't contend.
+ */
+struct MpmcSlot {
+    unsigned sequence;
+    void * element;
+} __attribute__((aligned(CACHE_LINE_SIZE)));
+
+struct MpmcQueue {
+    struct MpmcSlot * slots;
+    unsigned capacity;
+    unsigned mask;
+
+    // Next position to push to, shared by producers
+    __attribute__((aligned(CACHE_LINE_SIZE))) unsigned tail;
+
+    // Next position to pop from, shared by consumers
+    __attribute__((aligned(CACHE_LINE_SIZE))) unsigned head;
+};
+
+
+/**
+ * Initializes the queue
+ *
+ * @param       capacity the maximum number of elements in the queue, rounded up to a power of two no smaller than 2.
+ *
+ * @return      the newly created queue.
+ */
+struct MpmcQueue * newMpmcQueue(unsigned capacity);
+
+
+/**
+ * Frees the memory occupied by the queue. No thread may be using it anymore.
+ *
+ * @param       queue   pointer to memory occupied by the queue.
+ * @param       deleter function called on the elements still in the queue, if not NULL.
+ */
+void deleteMpmcQueue(struct MpmcQueue ** const queue, CDeleter deleter);
+
+
+/**
+ * Check if the queue is empty. The answer may be stale by the time it is returned if other threads are using the queue.
+ *
+ * @param       queue pointer to the queue which content to check.
+ *
+ * @return      true if the queue is empty, false otherwise.
+ */
+bool isMpmcQueueEmpty(struct MpmcQueue * const queue);
+
+
+/**
+ * Pushes an element to the back of the queue if there is room for it.
+ *
+ * @param       queue   pointer to queue to push back onto.
+ * @param       element pointer to the element to push back, which cannot be NULL since popping returns NULL for an empty queue.
+ *
+ * @return      true if the element was pushed, false if the queue is full.
+ */
+bool mpmcQueueTryPushBack(struct MpmcQueue * const queue, void * element);
+
+
+/**
+ * Pops the element at the front of the queue if there is one.
+ *
+ * @param       queue pointer to queue to pop front from.
+ *
+ * @return      the element at the front of the queue, or NULL if the queue is empty.
+ */
+void * mpmcQueueTryPopFront(struct MpmcQueue * const queue);
+
+
+/**
+ * Pushes an element to the back of the queue, waiting for room if the queue is full.
+ *
+ * @param       queue   pointer to queue to push back onto.
+ * @param       element pointer to the element to push back, which cannot be NULL since popping returns NULL for an empty queue.
+ */
+void mpmcQueuePushBack(struct MpmcQueue * const queue, void * element);
+
+
+/**
+ * Pops the element at the front of the queue, waiting for one if the queue is empty.
+ *
+ * @param       queue pointer to queue to pop front from.
+ *
+ * @return      the element at the front of the queue.
+ */
+void * mpmcQueuePopFront(struct MpmcQueue * const queue);
+
+#endif
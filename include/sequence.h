@@ -0,0 +1,195 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_SEQUENCE_H
+#define CCOLLECTIONS_SEQUENCE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common.h"
+
+// Maximum number of elements in a leaf, and of children in a branch, of a sequence
+#define SEQUENCE_LEAF_CAPACITY 32
+#define SEQUENCE_BRANCH_CAPACITY 32
+
+// Bound on the height of the tree, which no sequence indexable with an unsigned can reach
+#define SEQUENCE_MAX_HEIGHT 16
+
+
+/*
+ * Leaves hold the elements and are linked together in order, so a scan goes from one array of elements to the next.
+ */
+struct SequenceLeaf {
+    struct SequenceLeaf * prev;
+    struct SequenceLeaf * next;
+    unsigned count;
+    void * elements[SEQUENCE_LEAF_CAPACITY];
+};
+
+/*
+ * Branches record how many elements are under each of their children,
+ * which is what lets us find the element at a given index by going down a single path.
+ * The children of a branch are all branches or all leaves, depending on their depth.
+ */
+struct SequenceBranch {
+    unsigned count;
+    unsigned sizes[SEQUENCE_BRANCH_CAPACITY];
+    void * children[SEQUENCE_BRANCH_CAPACITY];
+};
+
+/*
+ * A sequence is a B+tree indexed by position rather than by key: get, set, insert and remove at any index are O(log n).
+ *
+ * The first and last leaves (head and tail) are kept out of the tree. Pushes and pops at either end only touch them,
+ * and a head or tail that fills up joins the tree whole, so that pushes at the ends are O(1) amortized.
+ * The head and the tail can be empty, the leaves in the tree never are.
+ */
+struct Sequence {
+    struct Collection collection;
+    void * root;
+    unsigned height;
+    unsigned tree_size;
+    struct SequenceLeaf * head;
+    struct SequenceLeaf * tail;
+    unsigned size;
+};
+
+
+/**
+ * Initializes the sequence
+ *
+ * @return      the newly created sequence.
+ */
+struct Sequence * newSequence();
+
+
+/**
+ * Frees the memory occupied by the sequence.
+ *
+ * @param       sequence pointer to memory occupied by the sequence.
+ * @param       deleter  function called on each element, if not NULL.
+ */
+void deleteSequence(struct Sequence ** const sequence, CDeleter deleter);
+
+
+/**
+ * Check if the sequence is empty.
+ *
+ * @param       sequence pointer to the sequence which content to check.
+ *
+ * @return      true if the sequence is empty, false otherwise.
+ */
+bool isSequenceEmpty(struct Sequence const * const sequence);
+
+
+/**
+ * Returns the number of elements in the sequence.
+ *
+ * @param       sequence pointer to the sequence which size to return.
+ *
+ * @return      the number of elements in the sequence.
+ */
+unsigned sequenceSize(struct Sequence const * const sequence);
+
+
+/**
+ * Pushes an element to the back of the sequence.
+ *
+ * @param       sequence pointer to the sequence to push back onto.
+ * @param       element  pointer to the element to push back.
+ *
+ * @return      true if the element was added, false otherwise (probably due to insufficient memory)
+ */
+bool sequencePushBack(struct Sequence * const sequence, void * element);
+
+
+/**
+ * Pushes an element to the front of the sequence.
+ *
+ * @param       sequence pointer to the sequence to push front onto.
+ * @param       element  pointer to the element to push at the front.
+ *
+ * @return      true if the element was added, false otherwise (probably due to insufficient memory)
+ */
+bool sequencePushFront(struct Sequence * const sequence, void * element);
+
+
+/**
+ * Pops the element at the back of the sequence.
+ *
+ * @param       sequence pointer to the sequence to pop back from.
+ *
+ * @return      the element at the back of the sequence, or NULL if the sequence is empty.
+ */
+void * sequencePopBack(struct Sequence * const sequence);
+
+
+/**
+ * Pops the element at the front of the sequence.
+ *
+ * @param       sequence pointer to the sequence to pop front from.
+ *
+ * @return      the element at the front of the sequence, or NULL if the sequence is empty.
+ */
+void * sequencePopFront(struct Sequence * const sequence);
+
+
+/**
+ * Gets the element at the given position in the sequence.
+ *
+ * @param       sequence pointer to the sequence to get the element from.
+ * @param       index    the index of the element.
+ *
+ * @return      the element at the given index.
+ */
+void * sequenceGet(struct Sequence * const sequence, unsigned index);
+
+
+/**
+ * Sets the element at the given position in the sequence, replacing the existing element.
+ *
+ * @param       sequence pointer to the sequence to set the element in.
+ * @param       index    the index of the element.
+ * @param       element  the new element.
+ */
+void sequenceSet(struct Sequence * const sequence, unsigned index, void * element);
+
+
+/**
+ * Inserts the element at the given position in the sequence, moving the other elements to the right.
+ *
+ * @param       sequence pointer to the sequence to insert into.
+ * @param       index    the index where to insert the element, up to the size of the sequence.
+ * @param       element  the element to insert.
+ *
+ * @return      true if the element was added, false otherwise (probably due to insufficient memory)
+ */
+bool sequenceInsert(struct Sequence * const sequence, unsigned index, void * element);
+
+
+/**
+ * Removes the element at the given position in the sequence, moving the other elements to the left.
+ *
+ * @param       sequence pointer to the sequence to remove the element from.
+ * @param       index    the index of the element to remove.
+ *
+ * @return      the removed element.
+ */
+void * sequenceRemove(struct Sequence * const sequence, unsigned index);
+
+#endif
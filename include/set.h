@@ -36,6 +36,18 @@ struct HashSetItem {
     struct HashSetItem * next;
 };
 
+/*
+ * A position in a set, see hashSetCursor.
+ * The value and value_len members describe the item the cursor is on.
+ */
+struct HashSetCursor {
+    void * value;
+    unsigned value_len;
+    struct HashSetItem * entry;
+    // The next bucket to visit
+    unsigned bucket;
+};
+
 struct HashSet {
     struct Collection collection;
     struct HashSetItem ** items;
@@ -43,6 +55,12 @@ struct HashSet {
     unsigned capacity;
     unsigned size;
     unsigned buckets_count;
+    CHasher hasher;
+    CEquals equals;
+    struct {
+        struct HashSetCursor cursor;
+        unsigned cursor_index;
+    };
 };
 
 
@@ -54,6 +72,18 @@ struct HashSet {
 struct HashSet * newHashSet(unsigned initial_capacity);
 
 
+/**
+ * Replaces the hash function of the set and optionally sets the function used to compare values.
+ * By default sets use SipHash-2-4 and consider values with the same 64-bit hash identical.
+ * For trusted values, a faster function from hash.h can be used, ideally alongside an equality function.
+ *
+ * @param       set     pointer to the set to configure, it must be empty.
+ * @param       hasher  the hash function to use.
+ * @param       equals  the function to compare values with, or NULL to consider values with the same hash identical.
+ */
+void hashSetUseHasher(struct HashSet * const set, CHasher hasher, CEquals equals);
+
+
 /**
  * Frees the memory occupied by the set.
  *
@@ -126,4 +156,32 @@ bool hashSetContains(struct HashSet const * const set, unsigned value_len, void
  */
 bool hashSetDelete(struct HashSet * const set, unsigned value_len, void * value, CDeleter deleter);
 
+
+/**
+ * Creates a cursor placed before the first value of the set.
+ * Values are visited in no particular order and visiting all of them takes O(capacity + size):
+ *
+ *     struct HashSetCursor cursor = hashSetCursor(set);
+ *     while (hashSetCursorNext(set, &cursor))
+ *         use(cursor.value);
+ *
+ * Inserting or deleting values invalidates the cursor.
+ *
+ * @param       set pointer to the set to walk.
+ *
+ * @return      the new cursor.
+ */
+struct HashSetCursor hashSetCursor(struct HashSet const * const set);
+
+
+/**
+ * Moves the cursor to the next value of the set.
+ *
+ * @param       set     pointer to the set the cursor was created from.
+ * @param       cursor  pointer to the cursor to move.
+ *
+ * @return      true if the cursor is on a value, false if all values were visited.
+ */
+bool hashSetCursorNext(struct HashSet const * const set, struct HashSetCursor * const cursor);
+
 #endif
@@ -0,0 +1,122 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_SPSC_H
+#define CCOLLECTIONS_SPSC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common.h"
+
+/*
+ * A bounded queue handing elements from exactly one producer thread to exactly one consumer thread without locks.
+ *
+ * Only the producer writes the tail and only the consumer writes the head, each on its own cache line.
+ * Each side also keeps the last value it read of the other side's index so that it only
+ * touches the other cache line when the queue looks full (for the producer) or empty (for the consumer).
+ * Indices run freely and are wrapped with the mask, so the queue holds up to capacity elements.
+ */
+struct SpscQueue {
+    void ** slots;
+    unsigned capacity;
+    unsigned mask;
+
+    // Owned by the producer
+    __attribute__((aligned(CACHE_LINE_SIZE))) unsigned tail;
+    unsigned cached_head;
+
+    // Owned by the consumer
+    __attribute__((aligned(CACHE_LINE_SIZE))) unsigned head;
+    unsigned cached_tail;
+};
+
+
+/**
+ * Initializes the queue
+ *
+ * @param       capacity the maximum number of elements in the queue, rounded up to a power of two.
+ *
+ * @return      the newly created queue.
+ */
+struct SpscQueue * newSpscQueue(unsigned capacity);
+
+
+/**
+ * Frees the memory occupied by the queue. Neither the producer nor the consumer may be using it anymore.
+ *
+ * @param       queue   pointer to memory occupied by the queue.
+ * @param       deleter function called on the elements still in the queue, if not NULL.
+ */
+void deleteSpscQueue(struct SpscQueue ** const queue, CDeleter deleter);
+
+
+/**
+ * Check if the queue is empty. Only the consumer gets an answer it can rely on.
+ *
+ * @param       queue pointer to the queue which content to check.
+ *
+ * @return      true if the queue is empty, false otherwise.
+ */
+bool isSpscQueueEmpty(struct SpscQueue * const queue);
+
+
+/**
+ * Pushes an element to the back of the queue. To be called from the producer thread only.
+ *
+ * @param       queue   pointer to queue to push back onto.
+ * @param       element pointer to the element to push back, which cannot be NULL since popping returns NULL for an empty queue.
+ *
+ * @return      true if the element was pushed, false if the queue is full.
+ */
+bool spscQueuePushBack(struct SpscQueue * const queue, void * element);
+
+
+/**
+ * Pops the element at the front of the queue. To be called from the consumer thread only.
+ *
+ * @param       queue pointer to queue to pop front from.
+ *
+ * @return      the element at the front of the queue, or NULL if the queue is empty.
+ */
+void * spscQueuePopFront(struct SpscQueue * const queue);
+
+
+/**
+ * Pushes as many of the given elements as fit to the back of the queue, in order. To be called from the producer thread only.
+ *
+ * @param       queue       pointer to queue to push back onto.
+ * @param       elements    the elements to push back, none of which can be NULL.
+ * @param       count       the number of elements to push back.
+ *
+ * @return      the number of elements pushed, which is less than count if the queue filled up.
+ */
+unsigned spscQueuePushBackN(struct SpscQueue * const queue, void * const * elements, unsigned count);
+
+
+/**
+ * Pops up to count elements from the front of the queue. To be called from the consumer thread only.
+ *
+ * @param       queue       pointer to queue to pop front from.
+ * @param       destination where to store the popped elements, the front of the queue first.
+ * @param       count       the maximum number of elements to pop.
+ *
+ * @return      the number of elements popped, which is less than count if the queue held fewer elements.
+ */
+unsigned spscQueuePopFrontN(struct SpscQueue * const queue, void ** destination, unsigned count);
+
+#endif
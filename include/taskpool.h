@@ -0,0 +1,106 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_TASKPOOL_H
+#define CCOLLECTIONS_TASKPOOL_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common.h"
+#include "mpmc.h"
+#include "wsdeque.h"
+
+/*
+ * A fixed set of worker threads running fork-join tasks.
+ *
+ * Each worker owns a work-stealing deque: tasks it spawns go to the back, and it runs its own tasks from the back too,
+ * so it keeps working on the most recent (and most cache-friendly) piece of the problem.
+ * A worker that runs out of tasks steals from the front of another worker's deque, picked at random,
+ * which is where the oldest and usually largest pieces are.
+ * Tasks spawned from threads outside the pool go through a shared queue instead.
+ * Waiting for a task doesn't block a worker: it runs other tasks until the one it waits for is done.
+ */
+struct TaskPool;
+
+typedef void (* TaskFunction)(struct TaskPool * const pool, void * argument);
+
+struct Task {
+    TaskFunction function;
+    void * argument;
+    bool done;
+};
+
+struct TaskPoolWorker {
+    struct TaskPool * pool;
+    struct WorkStealingDeque * deque;
+    pthread_t thread;
+    unsigned seed;
+} __attribute__((aligned(CACHE_LINE_SIZE)));
+
+struct TaskPool {
+    struct TaskPoolWorker * workers;
+    unsigned workers_count;
+    struct MpmcQueue * injected;
+
+    // Idle workers sleep on the condition variable, spawning a task wakes one of them up
+    pthread_mutex_t mutex;
+    pthread_cond_t wakeup;
+    unsigned sleepers;
+    bool stopping;
+};
+
+
+/**
+ * Initializes the pool and starts its workers
+ *
+ * @param       workers_count the number of worker threads, or 0 for one per online processor.
+ *
+ * @return      the newly created pool.
+ */
+struct TaskPool * newTaskPool(unsigned workers_count);
+
+
+/**
+ * Stops the workers and frees the memory occupied by the pool. Tasks that haven't started yet are never run.
+ *
+ * @param       pool pointer to memory occupied by the pool.
+ */
+void deleteTaskPool(struct TaskPool ** const pool);
+
+
+/**
+ * Schedules a task on the pool. The task must stay valid until taskPoolWait returns for it.
+ *
+ * @param       pool        pointer to the pool to run the task on.
+ * @param       task        the task to schedule.
+ * @param       function    the function the task runs.
+ * @param       argument    the argument passed to the function.
+ */
+void taskPoolSpawn(struct TaskPool * const pool, struct Task * const task, TaskFunction function, void * argument);
+
+
+/**
+ * Waits for a task to finish, running other tasks of the pool in the meantime.
+ *
+ * @param       pool    pointer to the pool the task was spawned on.
+ * @param       task    the task to wait for.
+ */
+void taskPoolWait(struct TaskPool * const pool, struct Task * const task);
+
+#endif
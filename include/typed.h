@@ -0,0 +1,335 @@
+/*  This file is part of the CCollections library.
+ * 
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_TYPED_H
+#define CCOLLECTIONS_TYPED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+/*
+ * Generators of type-specialized containers.
+ * They store elements by value and every function is static inline, so element access and
+ * key comparisons can be inlined (and loops vectorized) instead of going through void pointers and function pointers.
+ * The structs are plain values: initialize them with <name>Init and release them with <name>Destroy.
+ *
+ *     CC_VECTOR_DEFINE(IntVector, int)
+ *
+ *     struct IntVector vector;
+ *     IntVectorInit(&vector, 16);
+ *     IntVectorPushBack(&vector, 42);
+ *     int answer = IntVectorGet(&vector, 0);
+ *     IntVectorDestroy(&vector);
+ *
+ *     CC_HASHMAP_DEFINE(IdMap, uint64_t, double, ccHashInteger, CC_EQUALS)
+ *
+ *     struct IdMap map;
+ *     IdMapInit(&map, 16);
+ *     IdMapSet(&map, 7, 0.5);
+ *     double * value = IdMapGet(&map, 7);
+ *     IdMapDestroy(&map);
+ *
+ * Both macros expand to definitions, so each instantiation must appear once per translation unit.
+ */
+
+
+// Mixes the bits of an integer key (the finalizer of MurmurHash3), for use as a hash with CC_HASHMAP_DEFINE
+static inline uint64_t ccHashInteger(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+
+    return key;
+}
+
+// Compares keys with ==, for use as the equality with CC_HASHMAP_DEFINE when keys are scalars
+#define CC_EQUALS(a, b) ((a) == (b))
+
+// States of the slots of maps generated with CC_HASHMAP_DEFINE
+#define CC_SLOT_EMPTY 0
+#define CC_SLOT_FULL 1
+#define CC_SLOT_DELETED 2
+
+
+/*
+ * Defines struct name, a vector of elements of type T, along with:
+ * - bool nameInit(vector, initial_capacity) and void nameDestroy(vector),
+ * - bool nameReserve(vector, capacity),
+ * - bool namePushBack(vector, element) and T namePopBack(vector),
+ * - T nameGet(vector, index), T * nameAt(vector, index) and void nameSet(vector, index, element).
+ */
+#define CC_VECTOR_DEFINE(name, T)                                                                       \
+    struct name {                                                                                       \
+        T * elements;                                                                                   \
+        unsigned capacity;                                                                              \
+        unsigned size;                                                                                  \
+    };                                                                                                  \
+                                                                                                        \
+    static inline bool name##Init(struct name * const vector, unsigned initial_capacity) {              \
+        alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");                           \
+        alt_assert(initial_capacity > 0, "Initial vector capacity cannot be zero.");                    \
+                                                                                                        \
+        vector -> elements = (T *) malloc((size_t) initial_capacity * sizeof(T));                       \
+        vector -> capacity = vector -> elements != NULL ? initial_capacity : 0;                         \
+        vector -> size = 0;                                                                             \
+                                                                                                        \
+        return vector -> elements != NULL;                                                              \
+    }                                                                                                   \
+                                                                                                        \
+    static inline void name##Destroy(struct name * const vector) {                                      \
+        alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");                           \
+                                                                                                        \
+        free(vector -> elements);                                                                       \
+        vector -> elements = NULL;                                                                      \
+        vector -> capacity = 0;                                                                         \
+        vector -> size = 0;                                                                             \
+    }                                                                                                   \
+                                                                                                        \
+    static inline bool name##Reserve(struct name * const vector, unsigned capacity) {                   \
+        alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");                           \
+                                                                                                        \
+        if (capacity <= vector -> capacity)                                                             \
+            return true;                                                                                \
+                                                                                                        \
+        T * elements = (T *) realloc(vector -> elements, (size_t) capacity * sizeof(T));                \
+        if (elements == NULL)                                                                           \
+            return false;                                                                               \
+                                                                                                        \
+        vector -> elements = elements;                                                                  \
+        vector -> capacity = capacity;                                                                  \
+                                                                                                        \
+        return true;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    static inline bool name##PushBack(struct name * const vector, T element) {                          \
+        alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");                           \
+                                                                                                        \
+        /* Grow by 1.75 like Vector does, the growth factor being out of reach of a header */           \
+        if (vector -> size == vector -> capacity &&                                                     \
+            name##Reserve(vector, vector -> capacity + vector -> capacity * 3 / 4 + 1) == false)        \
+            return false;                                                                               \
+                                                                                                        \
+        vector -> elements[vector -> size++] = element;                                                 \
+                                                                                                        \
+        return true;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    static inline T name##PopBack(struct name * const vector) {                                         \
+        alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");                           \
+        alt_assert(vector -> size > 0, "The vector is empty, cannot pop elements.");                    \
+                                                                                                        \
+        return vector -> elements[--vector -> size];                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    static inline T name##Get(struct name const * const vector, unsigned index) {                       \
+        alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");                           \
+        alt_assert(index < vector -> size, "The index is out of bounds.");                              \
+                                                                                                        \
+        return vector -> elements[index];                                                               \
+    }                                                                                                   \
+                                                                                                        \
+    static inline T * name##At(struct name const * const vector, unsigned index) {                      \
+        alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");                           \
+        alt_assert(index < vector -> size, "The index is out of bounds.");                              \
+                                                                                                        \
+        return &vector -> elements[index];                                                              \
+    }                                                                                                   \
+                                                                                                        \
+    static inline void name##Set(struct name * const vector, unsigned index, T element) {               \
+        alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");                           \
+        alt_assert(index < vector -> size, "The index is out of bounds.");                              \
+                                                                                                        \
+        vector -> elements[index] = element;                                                            \
+    }
+
+
+/*
+ * Defines struct name, an open-addressing (linear probing) map from keys of type K to values of type V, along with:
+ * - bool nameInit(map, initial_capacity) and void nameDestroy(map),
+ * - V * nameGet(map, key), which returns NULL if the key is not in the map,
+ * - bool nameInsert(map, key, value) for new keys and bool nameSet(map, key, value) for any key,
+ * - bool nameDelete(map, key).
+ * hash(key) must return a uint64_t and equals(a, b) must be true for identical keys, both can be functions or macros.
+ * The capacity is a power of two, so hash should spread keys over its low bits (ccHashInteger does for integers).
+ */
+#define CC_HASHMAP_DEFINE(name, K, V, hash, equals)                                                                           \
+    struct name {                                                                                                             \
+        K * keys;                                                                                                             \
+        V * values;                                                                                                           \
+        uint8_t * states;                                                                                                     \
+        unsigned capacity;                                                                                                    \
+        unsigned size;                                                                                                        \
+        unsigned used;                                                                                                        \
+    };                                                                                                                        \
+                                                                                                                              \
+    static inline bool name##Init(struct name * const map, unsigned initial_capacity) {                                       \
+        alt_assert(map != NULL, "The parameter <map> cannot be NULL.");                                                       \
+        alt_assert(initial_capacity > 0, "Initial hash map capacity cannot be zero.");                                        \
+                                                                                                                              \
+        unsigned capacity = 8;                                                                                                \
+        while (capacity < initial_capacity)                                                                                   \
+            capacity *= 2;                                                                                                    \
+                                                                                                                              \
+        map -> keys = (K *) malloc((size_t) capacity * sizeof(K));                                                            \
+        map -> values = (V *) malloc((size_t) capacity * sizeof(V));                                                          \
+        map -> states = (uint8_t *) calloc(capacity, sizeof(uint8_t));                                                        \
+        map -> capacity = capacity;                                                                                           \
+        map -> size = 0;                                                                                                      \
+        map -> used = 0;                                                                                                      \
+                                                                                                                              \
+        if (map -> keys == NULL || map -> values == NULL || map -> states == NULL) {                                          \
+            free(map -> keys);                                                                                                \
+            free(map -> values);                                                                                              \
+            free(map -> states);                                                                                              \
+            map -> keys = NULL;                                                                                               \
+            map -> values = NULL;                                                                                             \
+            map -> states = NULL;                                                                                             \
+            map -> capacity = 0;                                                                                              \
+            return false;                                                                                                     \
+        }                                                                                                                     \
+                                                                                                                              \
+        return true;                                                                                                          \
+    }                                                                                                                         \
+                                                                                                                              \
+    static inline void name##Destroy(struct name * const map) {                                                               \
+        alt_assert(map != NULL, "The parameter <map> cannot be NULL.");                                                       \
+                                                                                                                              \
+        free(map -> keys);                                                                                                    \
+        free(map -> values);                                                                                                  \
+        free(map -> states);                                                                                                  \
+        map -> keys = NULL;                                                                                                   \
+        map -> values = NULL;                                                                                                 \
+        map -> states = NULL;                                                                                                 \
+        map -> capacity = 0;                                                                                                  \
+        map -> size = 0;                                                                                                      \
+        map -> used = 0;                                                                                                      \
+    }                                                                                                                         \
+                                                                                                                              \
+    /* Returns the slot holding the key, or the capacity if there is none */                                                  \
+    static inline unsigned name##Find(struct name const * const map, K key) {                                                 \
+        unsigned mask = map -> capacity - 1;                                                                                  \
+        unsigned index = (unsigned) (hash(key)) & mask;                                                                       \
+                                                                                                                              \
+        for (unsigned probes = 0; probes < map -> capacity; probes++, index = (index + 1) & mask) {                           \
+            if (map -> states[index] == CC_SLOT_EMPTY)                                                                        \
+                break;                                                                                                        \
+                                                                                                                              \
+            if (map -> states[index] == CC_SLOT_FULL && (equals(map -> keys[index], key)))                                    \
+                return index;                                                                                                 \
+        }                                                                                                                     \
+                                                                                                                              \
+        return map -> capacity;                                                                                               \
+    }                                                                                                                         \
+                                                                                                                              \
+    /* Returns the slot a new key goes to, the first tombstone on its way if any */                                           \
+    static inline unsigned name##Vacancy(struct name const * const map, K key) {                                              \
+        unsigned mask = map -> capacity - 1;                                                                                  \
+        unsigned index = (unsigned) (hash(key)) & mask;                                                                       \
+                                                                                                                              \
+        while (map -> states[index] == CC_SLOT_FULL)                                                                          \
+            index = (index + 1) & mask;                                                                                       \
+                                                                                                                              \
+        return index;                                                                                                         \
+    }                                                                                                                         \
+                                                                                                                              \
+    static inline bool name##Rehash(struct name * const map, unsigned capacity) {                                             \
+        struct name rehashed;                                                                                                 \
+        if (name##Init(&rehashed, capacity) == false)                                                                         \
+            return false;                                                                                                     \
+                                                                                                                              \
+        for (unsigned i = 0; i < map -> capacity; i++) {                                                                      \
+            if (map -> states[i] != CC_SLOT_FULL)                                                                             \
+                continue;                                                                                                     \
+                                                                                                                              \
+            unsigned index = name##Vacancy(&rehashed, map -> keys[i]);                                                        \
+            rehashed.keys[index] = map -> keys[i];                                                                            \
+            rehashed.values[index] = map -> values[i];                                                                        \
+            rehashed.states[index] = CC_SLOT_FULL;                                                                            \
+        }                                                                                                                     \
+                                                                                                                              \
+        rehashed.size = map -> size;                                                                                          \
+        rehashed.used = map -> size;                                                                                          \
+        name##Destroy(map);                                                                                                   \
+        * map = rehashed;                                                                                                     \
+                                                                                                                              \
+        return true;                                                                                                          \
+    }                                                                                                                         \
+                                                                                                                              \
+    static inline V * name##Get(struct name const * const map, K key) {                                                       \
+        alt_assert(map != NULL, "The parameter <map> cannot be NULL.");                                                       \
+                                                                                                                              \
+        unsigned index = name##Find(map, key);                                                                                \
+                                                                                                                              \
+        return index < map -> capacity ? &map -> values[index] : NULL;                                                        \
+    }                                                                                                                         \
+                                                                                                                              \
+    /* Associates the value to the key, replacing the previous value if the key is already in the map */                      \
+    static inline bool name##Set(struct name * const map, K key, V value) {                                                   \
+        alt_assert(map != NULL, "The parameter <map> cannot be NULL.");                                                       \
+                                                                                                                              \
+        unsigned index = name##Find(map, key);                                                                                \
+        if (index < map -> capacity) {                                                                                        \
+            map -> values[index] = value;                                                                                     \
+            return true;                                                                                                      \
+        }                                                                                                                     \
+                                                                                                                              \
+        /* At most 7/8 of the slots are full or deleted, we only grow if tombstones are not the reason */                     \
+        if ((map -> used + 1) * 8 > map -> capacity * 7) {                                                                    \
+            unsigned capacity = (map -> size + 1) * 2 > map -> capacity ? map -> capacity * 2 : map -> capacity;              \
+            if (name##Rehash(map, capacity) == false)                                                                         \
+                return false;                                                                                                 \
+        }                                                                                                                     \
+                                                                                                                              \
+        index = name##Vacancy(map, key);                                                                                      \
+        if (map -> states[index] == CC_SLOT_EMPTY)                                                                            \
+            map -> used++;                                                                                                    \
+                                                                                                                              \
+        map -> keys[index] = key;                                                                                             \
+        map -> values[index] = value;                                                                                         \
+        map -> states[index] = CC_SLOT_FULL;                                                                                  \
+        map -> size++;                                                                                                        \
+                                                                                                                              \
+        return true;                                                                                                          \
+    }                                                                                                                         \
+                                                                                                                              \
+    static inline bool name##Insert(struct name * const map, K key, V value) {                                                \
+        alt_assert(map != NULL, "The parameter <map> cannot be NULL.");                                                       \
+        alt_assert(name##Find(map, key) == map -> capacity, "An element with the given key already exists in the hash map."); \
+                                                                                                                              \
+        return name##Set(map, key, value);                                                                                    \
+    }                                                                                                                         \
+                                                                                                                              \
+    static inline bool name##Delete(struct name * const map, K key) {                                                         \
+        alt_assert(map != NULL, "The parameter <map> cannot be NULL.");                                                       \
+                                                                                                                              \
+        unsigned index = name##Find(map, key);                                                                                \
+        if (index == map -> capacity)                                                                                         \
+            return false;                                                                                                     \
+                                                                                                                              \
+        map -> states[index] = CC_SLOT_DELETED;                                                                               \
+        map -> size--;                                                                                                        \
+                                                                                                                              \
+        return true;                                                                                                          \
+    }
+
+#endif
@@ -33,6 +33,18 @@ struct Vector {
     unsigned size;
 };
 
+/*
+ * A vector that stores its elements by value, one after the other, instead of pointers to them.
+ * Through the collection interface, elements are pointers into the vector's storage.
+ */
+struct ValueVector {
+    struct Collection collection;
+    char * elements;
+    unsigned element_size;
+    unsigned capacity;
+    unsigned size;
+};
+
 
 /**
  * Initializes the vector
@@ -102,4 +114,146 @@ void * vectorGet(struct Vector * const vector, unsigned index);
  */
 void vectorSet(struct Vector * const vector, unsigned index, void * element);
 
+
+/**
+ * Initializes a vector that stores elements of the given size by value.
+ *
+ * @param       element_size        the size of each element in bytes.
+ * @param       initial_capacity    the number of elements to make room for.
+ *
+ * @return      the newly created vector.
+ */
+struct ValueVector * newValueVector(unsigned element_size, unsigned initial_capacity);
+
+
+/**
+ * Frees the memory occupied by the vector.
+ *
+ * @param       vector  pointer to memory occupied by the vector.
+ * @param       deleter called with a pointer to each element, to release what the elements own.
+ */
+void deleteValueVector(struct ValueVector ** const vector, CDeleter deleter);
+
+
+/**
+ * Resizes the given vector to higher capacity.
+ *
+ * @param       vector pointer to vector to resize.
+ * @param       new_capacity the new capacity of the vector.
+ *
+ * @return      the newly resized vector.
+ */
+struct ValueVector * resizeValueVector(struct ValueVector * const vector, unsigned new_capacity);
+
+
+/**
+ * Check if the vector is empty.
+ *
+ * @param       vector pointer to the vector which content to check.
+ *
+ * @return      true if the vector is empty, false otherwise.
+ */
+bool isValueVectorEmpty(struct ValueVector const * const vector);
+
+
+/**
+ * Copies an element at the end of the vector.
+ *
+ * @param       vector  pointer to vector to append an element to.
+ * @param       element pointer to the element to copy.
+ *
+ * @return      true if the element was added, false otherwise (probably due to insufficient memory)
+ */
+bool valueVectorPushBack(struct ValueVector * const vector, void const * element);
+
+
+/**
+ * Copies several elements at the end of the vector at once.
+ *
+ * @param       vector      pointer to vector to append the elements to.
+ * @param       elements    pointer to the first of the elements to copy, which are laid out one after the other.
+ * @param       count       the number of elements to copy.
+ *
+ * @return      true if the elements were added, false otherwise (probably due to insufficient memory)
+ */
+bool valueVectorPushBackMany(struct ValueVector * const vector, void const * elements, unsigned count);
+
+
+/**
+ * Get the element at the specified index.
+ *
+ * @param       vector pointer to vector to use.
+ * @param       index the index at which to look.
+ *
+ * @return      a pointer to the element, valid until the vector is modified.
+ */
+void * valueVectorGet(struct ValueVector const * const vector, unsigned index);
+
+
+/**
+ * Copies elements starting at the specified index out of the vector.
+ *
+ * @param       vector      pointer to vector to use.
+ * @param       index       the index of the first element to copy.
+ * @param       count       the number of elements to copy.
+ * @param       destination where to copy the elements to, it must have room for count elements.
+ */
+void valueVectorGetMany(struct ValueVector const * const vector, unsigned index, unsigned count, void * destination);
+
+
+/**
+ * Overwrites the element at the specified index with a copy of the given one.
+ *
+ * @param       vector pointer to vector to use.
+ * @param       index the index at which to write.
+ * @param       element pointer to the element to copy.
+ */
+void valueVectorSet(struct ValueVector * const vector, unsigned index, void const * element);
+
+
+/**
+ * Copies an element at the given position, moving the following elements to the right.
+ *
+ * @param       vector  pointer to vector to use.
+ * @param       index   the index where to insert the element, at most the size of the vector.
+ * @param       element pointer to the element to copy.
+ *
+ * @return      true if the element was inserted, false otherwise (probably due to insufficient memory)
+ */
+bool valueVectorInsert(struct ValueVector * const vector, unsigned index, void const * element);
+
+
+/**
+ * Copies several elements at the given position at once, moving the following elements to the right.
+ *
+ * @param       vector      pointer to vector to use.
+ * @param       index       the index where to insert the elements, at most the size of the vector.
+ * @param       elements    pointer to the first of the elements to copy, which are laid out one after the other.
+ * @param       count       the number of elements to copy.
+ *
+ * @return      true if the elements were inserted, false otherwise (probably due to insufficient memory)
+ */
+bool valueVectorInsertMany(struct ValueVector * const vector, unsigned index, void const * elements, unsigned count);
+
+
+/**
+ * Removes the element at the given position, moving the following elements to the left.
+ *
+ * @param       vector  pointer to vector to use.
+ * @param       index   the index of the element to remove.
+ * @param       deleter called with a pointer to the element before it is removed, can be NULL.
+ */
+void valueVectorErase(struct ValueVector * const vector, unsigned index, CDeleter deleter);
+
+
+/**
+ * Removes several consecutive elements at once, moving the following elements to the left.
+ *
+ * @param       vector  pointer to vector to use.
+ * @param       index   the index of the first element to remove.
+ * @param       count   the number of elements to remove.
+ * @param       deleter called with a pointer to each element before it is removed, can be NULL.
+ */
+void valueVectorEraseMany(struct ValueVector * const vector, unsigned index, unsigned count, CDeleter deleter);
+
 #endif
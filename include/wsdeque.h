@@ -0,0 +1,109 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_WSDEQUE_H
+#define CCOLLECTIONS_WSDEQUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common.h"
+
+/*
+ * A lock-free work-stealing deque, after Chase and Lev and the C11 formulation by Lê, Pop, Cohen and Zappa Nardelli.
+ *
+ * One thread owns the deque: it pushes and pops at the back, which costs no more than a few plain stores in the common case.
+ * Any number of other threads (thieves) steal from the front, racing with each other and with the owner for the last element.
+ * Elements live in a circular array which the owner doubles when it fills up.
+ * Thieves may still be reading an array the owner replaced, so replaced arrays are only freed with the deque.
+ */
+struct WsArray {
+    struct WsArray * previous;
+    long capacity;
+    long mask;
+    void * slots[];
+};
+
+struct WorkStealingDeque {
+    struct WsArray * array;
+
+    // Front of the deque, advanced by thieves and by the owner when it takes the last element
+    __attribute__((aligned(CACHE_LINE_SIZE))) long top;
+
+    // Back of the deque, written by the owner only
+    __attribute__((aligned(CACHE_LINE_SIZE))) long bottom;
+};
+
+
+/**
+ * Initializes the deque
+ *
+ * @param       capacity the number of elements the deque can hold before growing, rounded up to a power of two.
+ *
+ * @return      the newly created deque.
+ */
+struct WorkStealingDeque * newWorkStealingDeque(unsigned capacity);
+
+
+/**
+ * Frees the memory occupied by the deque. No thread may be using it anymore.
+ *
+ * @param       deque   pointer to memory occupied by the deque.
+ * @param       deleter function called on the elements still in the deque, if not NULL.
+ */
+void deleteWorkStealingDeque(struct WorkStealingDeque ** const deque, CDeleter deleter);
+
+
+/**
+ * Check if the deque is empty. The answer may be stale by the time it is returned if other threads are using the deque.
+ *
+ * @param       deque pointer to the deque which content to check.
+ *
+ * @return      true if the deque is empty, false otherwise.
+ */
+bool isWorkStealingDequeEmpty(struct WorkStealingDeque * const deque);
+
+
+/**
+ * Pushes an element to the back of the deque, growing it if needed. To be called from the owner thread only.
+ *
+ * @param       deque   pointer to deque to push back onto.
+ * @param       element pointer to the element to push back, which cannot be NULL since popping and stealing return NULL when there is nothing to take.
+ */
+void workStealingDequePushBack(struct WorkStealingDeque * const deque, void * element);
+
+
+/**
+ * Pops the element at the back of the deque. To be called from the owner thread only.
+ *
+ * @param       deque pointer to deque to pop back from.
+ *
+ * @return      the element at the back of the deque, or NULL if the deque is empty.
+ */
+void * workStealingDequePopBack(struct WorkStealingDeque * const deque);
+
+
+/**
+ * Steals the element at the front of the deque. Can be called from any thread.
+ *
+ * @param       deque pointer to deque to steal from.
+ *
+ * @return      the element at the front of the deque, or NULL if the deque is empty or another thread took the element first.
+ */
+void * workStealingDequeSteal(struct WorkStealingDeque * const deque);
+
+#endif
@@ -0,0 +1,225 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <nmmintrin.h>
+#define HAS_CRC32C_INSTRUCTION
+#endif
+
+#include "common.h"
+#include "siphash.h"
+#include "hash.h"
+
+static inline uint64_t read64(uint8_t const * p);
+static inline uint64_t read32(uint8_t const * p);
+static uint32_t crc32cSoftware(uint32_t crc, uint8_t const * data, unsigned length);
+
+
+/**
+ * Hashes the given data with SipHash-2-4.
+ *
+ * @param       data    the bytes to hash.
+ * @param       length  the number of bytes to hash.
+ * @param       key     the 128-bit key of the hash function.
+ *
+ * @return      the 64-bit hash of the data.
+ */
+uint64_t sipHash24(void const * data, unsigned length, char const key[16]) {
+    return siphash24((char const *) data, length, key);
+}
+
+
+/*
+ * wyhash is the work of Wang Yi and released in the public domain.
+ * Original location: https://github.com/wangyi-fudan/wyhash
+ * What follows is adapted from the final version 4 of the algorithm, with its default secret.
+ */
+
+static uint64_t const wy_secret[4] = {
+    0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+};
+
+static inline void wyMultiply(uint64_t * a, uint64_t * b) {
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = (__uint128_t) * a * * b;
+    * a = (uint64_t) r;
+    * b = (uint64_t) (r >> 64);
+#else
+    uint64_t ha = * a >> 32, hb = * b >> 32, la = (uint32_t) * a, lb = (uint32_t) * b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32), c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    * a = lo;
+    * b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline uint64_t wyMix(uint64_t a, uint64_t b) {
+    wyMultiply(&a, &b);
+    return a ^ b;
+}
+
+
+/**
+ * Hashes the given data with wyhash, seeded with the first 8 bytes of the key.
+ *
+ * @param       data    the bytes to hash.
+ * @param       length  the number of bytes to hash.
+ * @param       key     the key whose first 8 bytes are used as seed.
+ *
+ * @return      the 64-bit hash of the data.
+ */
+uint64_t wyHash(void const * data, unsigned length, char const key[16]) {
+    uint8_t const * p = data;
+    uint64_t seed = read64((uint8_t const *) key);
+    uint64_t a = 0, b = 0;
+
+    seed ^= wyMix(seed ^ wy_secret[0], wy_secret[1]);
+
+    if (length <= 16) {
+        if (length >= 4) {
+            a = (read32(p) << 32) | read32(p + ((length >> 3) << 2));
+            b = (read32(p + length - 4) << 32) | read32(p + length - 4 - ((length >> 3) << 2));
+        }
+        else if (length > 0) {
+            a = ((uint64_t) p[0] << 16) | ((uint64_t) p[length >> 1] << 8) | p[length - 1];
+        }
+    }
+    else {
+        unsigned i = length;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = wyMix(read64(p) ^ wy_secret[1], read64(p + 8) ^ seed);
+                see1 = wyMix(read64(p + 16) ^ wy_secret[2], read64(p + 24) ^ see1);
+                see2 = wyMix(read64(p + 32) ^ wy_secret[3], read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+
+        while (i > 16) {
+            seed = wyMix(read64(p) ^ wy_secret[1], read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+
+    a ^= wy_secret[1];
+    b ^= seed;
+    wyMultiply(&a, &b);
+
+    return wyMix(a ^ wy_secret[0] ^ length, b ^ wy_secret[1]);
+}
+
+
+#ifdef HAS_CRC32C_INSTRUCTION
+
+__attribute__((target("sse4.2")))
+static uint64_t crc32cHardware(uint32_t crc_low, uint32_t crc_high, uint8_t const * p, unsigned length) {
+    uint64_t low = crc_low, high = crc_high;
+
+    // The two lanes don't depend on each other so the processor runs them side by side
+    for (; length >= 8; length -= 8, p += 8) {
+        uint64_t word = read64(p);
+        low = _mm_crc32_u64(low, word);
+        high = _mm_crc32_u64(high, word);
+    }
+
+    for (; length > 0; length--, p++) {
+        low = _mm_crc32_u8((uint32_t) low, * p);
+        high = _mm_crc32_u8((uint32_t) high, * p);
+    }
+
+    return ((uint64_t) ~(uint32_t) high << 32) | (uint32_t) ~(uint32_t) low;
+}
+
+#endif
+
+
+/**
+ * Hashes the given data with two CRC32C lanes, seeded with the first and second 4 bytes of the key.
+ *
+ * @param       data    the bytes to hash.
+ * @param       length  the number of bytes to hash.
+ * @param       key     the key whose first 8 bytes are used as seeds.
+ *
+ * @return      the 64-bit hash of the data.
+ */
+uint64_t crc32cHash(void const * data, unsigned length, char const key[16]) {
+    uint32_t crc_low = ~(uint32_t) read32((uint8_t const *) key);
+    // We perturb the second seed so that both lanes differ even if the key is all zeros
+    uint32_t crc_high = ~((uint32_t) read32((uint8_t const *) key + 4) ^ 0x9e3779b9);
+
+#ifdef HAS_CRC32C_INSTRUCTION
+    if (__builtin_cpu_supports("sse4.2"))
+        return crc32cHardware(crc_low, crc_high, data, length);
+#endif
+
+    uint32_t low = ~crc32cSoftware(crc_low, data, length);
+    uint32_t high = ~crc32cSoftware(crc_high, data, length);
+
+    return ((uint64_t) high << 32) | low;
+}
+
+
+/**
+ * Compares two keys byte per byte.
+ *
+ * @param       a       the first key.
+ * @param       b       the second key.
+ * @param       length  the length of both keys in bytes.
+ *
+ * @return      true if the keys are identical, false otherwise.
+ */
+bool bytesEqual(void const * a, void const * b, unsigned length) {
+    return memcmp(a, b, length) == 0;
+}
+
+
+static inline uint64_t read64(uint8_t const * p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof value);
+    return value;
+}
+
+static inline uint64_t read32(uint8_t const * p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof value);
+    return value;
+}
+
+// Bitwise fallback for processors without the crc32 instruction, using the reflected Castagnoli polynomial
+static uint32_t crc32cSoftware(uint32_t crc, uint8_t const * data, unsigned length) {
+    for (unsigned i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (unsigned bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (0x82f63b78 & (0 - (crc & 1)));
+    }
+
+    return crc;
+}
@@ -16,15 +16,29 @@
  */
 
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define HAS_SIMD_SCAN
+#endif
+
 #include "common.h"
 #include "lsearch.h"
 
+static int lsearchSpan(struct Collection const * const collection, void const * const needle, CComparator compare);
+static int lsearchIterator(struct Collection const * const collection, void const * const needle, CComparator compare);
+static int lsearchIndex(struct Collection const * const collection, void const * const needle, CComparator compare);
+static int scanPointers(void * const * elements, unsigned length, void const * needle);
+
+
 /**
  * Performs a linear search on the given collection.
+ * Contiguous collections are scanned directly, the others are walked with their iterator if they have one.
  *
  * @param       collection  the collection to search from.
  * @param       element     the element to search for.
@@ -41,6 +55,13 @@ int lsearch(
         collection != NULL,
         "The parameter <collection> cannot be NULL."
     );
+
+    if (collection -> span != NULL)
+        return lsearchSpan(collection, needle, compare);
+
+    if (collection -> begin != NULL && collection -> next != NULL && collection -> deref != NULL)
+        return lsearchIterator(collection, needle, compare);
+
     alt_assert(
         collection -> get != NULL,
         "The collection doesn't provide a mechanism for obtain elements "
@@ -52,9 +73,107 @@ int lsearch(
         "one is at the end of the content it holds, and therefore unsearchable."
     );
 
+    return lsearchIndex(collection, needle, compare);
+}
+
+
+/**
+ * Performs a linear search for the element with the given address, without calling a comparator.
+ *
+ * @param       collection  the collection to search from.
+ * @param       element     the address to search for.
+ *
+ * @return      the index of the first element with that address if found, -1 otherwise.
+ */
+int lsearchPointer(struct Collection const * const collection, void const * const needle) {
+    alt_assert(
+        collection != NULL,
+        "The parameter <collection> cannot be NULL."
+    );
+
+    if (collection -> span != NULL) {
+        unsigned length = 0;
+        void * const * elements = collection -> span(collection, &length);
+        return scanPointers(elements, length, needle);
+    }
+
+    if (collection -> begin != NULL && collection -> next != NULL && collection -> deref != NULL) {
+        struct CIterator iterator;
+
+        int index = 0;
+        for (bool more = collection -> begin(collection, &iterator); more; more = collection -> next(&iterator)) {
+            if (collection -> deref(&iterator) == needle)
+                return index;
+
+            index++;
+        }
+
+        return -1;
+    }
+
+    alt_assert(
+        collection -> get != NULL && collection -> atEnd != NULL,
+        "The collection provides neither iterators nor access by index, and therefore unsearchable."
+    );
+
+    struct Collection * const mutable_collection = (struct Collection *) collection;
+    for (unsigned index = 0; collection -> atEnd(collection, index) == false; index++) {
+        if (collection -> get(mutable_collection, index) == needle)
+            return index;
+    }
+
+    return -1;
+}
+
+
+/**
+ * Performs a linear search for an integer stored directly in the element slots.
+ *
+ * @param       collection  the collection to search from.
+ * @param       key         the integer to search for.
+ *
+ * @return      the index of the first element holding that integer if found, -1 otherwise.
+ */
+int lsearchInteger(struct Collection const * const collection, intptr_t key) {
+    // Slots are words, so an integer stored in one compares exactly like an address
+    return lsearchPointer(collection, (void const *) key);
+}
+
+
+// The elements are in a single array, so the only indirect call left is the comparison
+static int lsearchSpan(struct Collection const * const collection, void const * const needle, CComparator compare) {
+    unsigned length = 0;
+    void * const * elements = collection -> span(collection, &length);
+
+    for (unsigned index = 0; index < length; index++) {
+        if (compare(elements[index], needle) == 0)
+            return index;
+    }
+
+    return -1;
+}
+
+static int lsearchIterator(struct Collection const * const collection, void const * const needle, CComparator compare) {
+    struct CIterator iterator;
+
+    int index = 0;
+    for (bool more = collection -> begin(collection, &iterator); more; more = collection -> next(&iterator)) {
+        if (compare(collection -> deref(&iterator), needle) == 0)
+            return index;
+
+        index++;
+    }
+
+    return -1;
+}
+
+static int lsearchIndex(struct Collection const * const collection, void const * const needle, CComparator compare) {
+    // get may update a cursor inside the collection, hence the cast
+    struct Collection * const mutable_collection = (struct Collection *) collection;
+
     size_t index = 0;
     while (collection -> atEnd(collection, index) == false) {
-        void * element = collection -> get(collection, index);
+        void * element = collection -> get(mutable_collection, index);
         
         if (compare(element, needle) == 0)
             return index;
@@ -64,3 +183,74 @@ int lsearch(
 
     return -1;
 }
+
+
+static int scanPointersScalar(void * const * elements, unsigned start, unsigned length, void const * needle) {
+    for (unsigned index = start; index < length; index++) {
+        if (elements[index] == needle)
+            return index;
+    }
+
+    return -1;
+}
+
+#ifdef HAS_SIMD_SCAN
+
+/*
+ * Both versions compare 8 slots per iteration and leave the remaining ones to the scalar loop.
+ * On a match, the mask of each vector tells which of its slots matched first.
+ */
+
+__attribute__((target("avx2")))
+static int scanPointersAvx2(void * const * elements, unsigned length, void const * needle) {
+    __m256i wanted = _mm256_set1_epi64x((int64_t) (intptr_t) needle);
+
+    unsigned index = 0;
+    for (; index + 8 <= length; index += 8) {
+        __m256i low = _mm256_cmpeq_epi64(_mm256_loadu_si256((__m256i const *) (elements + index)), wanted);
+        __m256i high = _mm256_cmpeq_epi64(_mm256_loadu_si256((__m256i const *) (elements + index + 4)), wanted);
+
+        unsigned mask = _mm256_movemask_pd(_mm256_castsi256_pd(low)) | (_mm256_movemask_pd(_mm256_castsi256_pd(high)) << 4);
+        if (mask != 0)
+            return index + __builtin_ctz(mask);
+    }
+
+    return scanPointersScalar(elements, index, length, needle);
+}
+
+// SSE2 only compares 32-bit lanes, so a slot matches when both of its halves do
+static inline unsigned matchPairSse2(void * const * elements, __m128i wanted) {
+    __m128i halves = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i const *) elements), wanted);
+    __m128i both = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    return _mm_movemask_pd(_mm_castsi128_pd(both));
+}
+
+static int scanPointersSse2(void * const * elements, unsigned length, void const * needle) {
+    __m128i wanted = _mm_set1_epi64x((int64_t) (intptr_t) needle);
+
+    unsigned index = 0;
+    for (; index + 8 <= length; index += 8) {
+        unsigned mask = matchPairSse2(elements + index, wanted)
+            | (matchPairSse2(elements + index + 2, wanted) << 2)
+            | (matchPairSse2(elements + index + 4, wanted) << 4)
+            | (matchPairSse2(elements + index + 6, wanted) << 6);
+        if (mask != 0)
+            return index + __builtin_ctz(mask);
+    }
+
+    return scanPointersScalar(elements, index, length, needle);
+}
+
+#endif
+
+static int scanPointers(void * const * elements, unsigned length, void const * needle) {
+#ifdef HAS_SIMD_SCAN
+    if (__builtin_cpu_supports("avx2"))
+        return scanPointersAvx2(elements, length, needle);
+
+    return scanPointersSse2(elements, length, needle);
+#else
+    return scanPointersScalar(elements, 0, length, needle);
+#endif
+}
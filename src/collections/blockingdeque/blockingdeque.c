@@ -0,0 +1,271 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "common.h"
+#include "deque.h"
+#include "blockingdeque.h"
+
+/*
+ * Waits are measured against the monotonic clock so that changes to the wall clock don't stretch or cut them short.
+ * A timeout is turned into a deadline once, before the first wait, so spurious wake-ups don't restart it.
+ */
+
+// Elements per block of the underlying deque
+#define BLOCKING_DEQUE_BLOCK_CAPACITY 64
+
+static void deadlineAfter(struct timespec * const deadline, long timeout_ms);
+static bool waitOn(struct BlockingDeque * const deque, pthread_cond_t * const condition, unsigned * const waiting,
+    struct timespec const * const deadline, long timeout_ms);
+
+
+/**
+ * Initializes the deque
+ *
+ * @param       capacity the number of elements after which producers wait, or 0 for no limit.
+ *
+ * @return      the newly created deque.
+ */
+struct BlockingDeque * newBlockingDeque(unsigned capacity) {
+    struct BlockingDeque * deque = malloc(sizeof *deque);
+    if (deque == NULL)
+        return NULL;
+
+    deque -> deque = newDeque(BLOCKING_DEQUE_BLOCK_CAPACITY);
+    if (deque -> deque == NULL) {
+        free(deque);
+        return NULL;
+    }
+
+    deque -> capacity = capacity;
+    deque -> closed = false;
+    deque -> waiting_consumers = 0;
+    deque -> waiting_producers = 0;
+
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_mutex_init(&deque -> mutex, NULL);
+    pthread_cond_init(&deque -> not_empty, &attributes);
+    pthread_cond_init(&deque -> not_full, &attributes);
+    pthread_condattr_destroy(&attributes);
+
+    return deque;
+}
+
+
+/**
+ * Frees the memory occupied by the deque. No thread may be using it anymore.
+ *
+ * @param       deque   pointer to memory occupied by the deque.
+ * @param       deleter function called on the elements still in the deque, if not NULL.
+ */
+void deleteBlockingDeque(struct BlockingDeque ** const deque, CDeleter deleter) {
+    if (deque == NULL)
+        return;
+
+    if (* deque == NULL)
+        return;
+
+    deleteDeque(&(* deque) -> deque, deleter);
+    pthread_cond_destroy(&(* deque) -> not_full);
+    pthread_cond_destroy(&(* deque) -> not_empty);
+    pthread_mutex_destroy(&(* deque) -> mutex);
+    free(* deque);
+    * deque = NULL;
+}
+
+
+/**
+ * Closes the deque and wakes up every waiting thread. Elements already in the deque can still be popped.
+ *
+ * @param       deque pointer to the deque to close.
+ */
+void closeBlockingDeque(struct BlockingDeque * const deque) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+
+    pthread_mutex_lock(&deque -> mutex);
+    deque -> closed = true;
+    pthread_cond_broadcast(&deque -> not_empty);
+    pthread_cond_broadcast(&deque -> not_full);
+    pthread_mutex_unlock(&deque -> mutex);
+}
+
+
+/**
+ * Check if the deque was closed.
+ *
+ * @param       deque pointer to the deque to check.
+ *
+ * @return      true if the deque is closed, false otherwise.
+ */
+bool isBlockingDequeClosed(struct BlockingDeque * const deque) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+
+    pthread_mutex_lock(&deque -> mutex);
+    bool closed = deque -> closed;
+    pthread_mutex_unlock(&deque -> mutex);
+
+    return closed;
+}
+
+
+/**
+ * Returns the number of elements in the deque.
+ *
+ * @param       deque pointer to the deque which size to return.
+ *
+ * @return      the number of elements in the deque.
+ */
+unsigned blockingDequeSize(struct BlockingDeque * const deque) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+
+    pthread_mutex_lock(&deque -> mutex);
+    unsigned size = deque -> deque -> size;
+    pthread_mutex_unlock(&deque -> mutex);
+
+    return size;
+}
+
+
+/**
+ * Pushes an element to the back of the deque, waiting for room if the deque is bounded and full.
+ *
+ * @param       deque       pointer to deque to push back onto.
+ * @param       element     pointer to the element to push back.
+ * @param       timeout_ms  how long to wait for room in milliseconds, 0 not to wait, or BLOCKING_DEQUE_FOREVER.
+ *
+ * @return      true if the element was pushed, false if the deque is closed or the timeout expired.
+ */
+bool blockingDequePushBack(struct BlockingDeque * const deque, void * element, long timeout_ms) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+
+    struct timespec deadline;
+    deadlineAfter(&deadline, timeout_ms);
+
+    pthread_mutex_lock(&deque -> mutex);
+    while (deque -> closed == false && deque -> capacity != 0 && (unsigned) deque -> deque -> size >= deque -> capacity) {
+        if (waitOn(deque, &deque -> not_full, &deque -> waiting_producers, &deadline, timeout_ms) == false)
+            break;
+    }
+
+    bool pushed = deque -> closed == false && (deque -> capacity == 0 || (unsigned) deque -> deque -> size < deque -> capacity);
+    if (pushed) {
+        dequePushBack(deque -> deque, element);
+        if (deque -> waiting_consumers > 0)
+            pthread_cond_signal(&deque -> not_empty);
+    }
+
+    pthread_mutex_unlock(&deque -> mutex);
+    return pushed;
+}
+
+
+/**
+ * Pops the element at the front of the deque, waiting for one if the deque is empty.
+ *
+ * @param       deque       pointer to deque to pop front from.
+ * @param       timeout_ms  how long to wait for an element in milliseconds, 0 not to wait, or BLOCKING_DEQUE_FOREVER.
+ *
+ * @return      the element at the front of the deque, or NULL if the deque is closed and empty or the timeout expired.
+ */
+void * blockingDequePopFront(struct BlockingDeque * const deque, long timeout_ms) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+
+    void * element = NULL;
+    return blockingDequeDrain(deque, &element, 1, timeout_ms) == 1 ? element : NULL;
+}
+
+
+/**
+ * Pops up to count elements from the front of the deque, waiting for at least one if the deque is empty.
+ *
+ * @param       deque       pointer to deque to pop front from.
+ * @param       destination where to store the popped elements, the front of the deque first.
+ * @param       count       the maximum number of elements to pop.
+ * @param       timeout_ms  how long to wait for an element in milliseconds, 0 not to wait, or BLOCKING_DEQUE_FOREVER.
+ *
+ * @return      the number of elements popped, 0 if the deque is closed and empty or the timeout expired.
+ */
+unsigned blockingDequeDrain(struct BlockingDeque * const deque, void ** destination, unsigned count, long timeout_ms) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+    alt_assert(destination != NULL || count == 0, "The parameter <destination> cannot be NULL.");
+
+    if (count == 0)
+        return 0;
+
+    struct timespec deadline;
+    deadlineAfter(&deadline, timeout_ms);
+
+    pthread_mutex_lock(&deque -> mutex);
+    while (deque -> closed == false && deque -> deque -> size == 0) {
+        if (waitOn(deque, &deque -> not_empty, &deque -> waiting_consumers, &deadline, timeout_ms) == false)
+            break;
+    }
+
+    unsigned popped = dequePopFrontN(deque -> deque, destination, count);
+
+    // Several elements popped at once may be enough room for several producers
+    if (popped > 0 && deque -> waiting_producers > 0) {
+        if (popped == 1)
+            pthread_cond_signal(&deque -> not_full);
+        else
+            pthread_cond_broadcast(&deque -> not_full);
+    }
+
+    pthread_mutex_unlock(&deque -> mutex);
+    return popped;
+}
+
+
+// Computes the deadline of a wait starting now, if it has one
+static void deadlineAfter(struct timespec * const deadline, long timeout_ms) {
+    if (timeout_ms <= 0)
+        return;
+
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline -> tv_sec += timeout_ms / 1000;
+    deadline -> tv_nsec += (timeout_ms % 1000) * 1000000L;
+    if (deadline -> tv_nsec >= 1000000000L) {
+        deadline -> tv_sec += 1;
+        deadline -> tv_nsec -= 1000000000L;
+    }
+}
+
+// Waits once on the condition with the mutex held, returns false if the caller should stop waiting
+static bool waitOn(struct BlockingDeque * const deque, pthread_cond_t * const condition, unsigned * const waiting,
+    struct timespec const * const deadline, long timeout_ms) {
+    if (timeout_ms == 0)
+        return false;
+
+    int error = 0;
+    (* waiting)++;
+    if (timeout_ms < 0)
+        pthread_cond_wait(condition, &deque -> mutex);
+    else
+        error = pthread_cond_timedwait(condition, &deque -> mutex, deadline);
+    (* waiting)--;
+
+    return error != ETIMEDOUT;
+}
@@ -35,20 +35,36 @@
  * - If the deque is used a queue, no memory is left unused (one half could be)
  *
  * It could be argued that the memory allocations and deallocations are expensive,
- * but that can be managed per application basis by allocating as much capacity as needed upfront.
+ * so blocks that empty are kept in a small cache (up to deque -> spare_limit of them) and reused by the next push,
+ * which keeps a queue going back and forth around a block boundary from hitting the allocator.
  *
  * So this solution seems like a good trade-off between:
  * 1. Code clarity and implementation,
  * 2. Efficiency of resource utilization.
+ *
+ * The first element is at deque -> front in the first block and the last one at deque -> back in the last block.
+ * An empty deque holds no block at all.
  */
 
 
 static void * _dequeCollectionGet(struct Collection * const collection, unsigned index);
 static void _dequeCollectionSet(struct Collection * const collection, unsigned index, void * element);
 static bool _dequeCollectionAtEnd(struct Collection const * const collection, unsigned index);
+static bool _dequeCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator);
+static bool _dequeCollectionNext(struct CIterator * const iterator);
+static void * _dequeCollectionDeref(struct CIterator const * const iterator);
+
+static struct Deque * createDeque(unsigned capacity, bool power_of_two);
+static inline void ** elementAt(struct Deque const * const deque, unsigned pos);
+static inline unsigned blockOffset(struct Deque const * const deque, unsigned pos);
+static void copyElements(struct Deque const * const deque, unsigned * const block, unsigned * const offset, void ** elements, unsigned count, bool into_deque);
+static void addBlocks(struct Deque * const deque, unsigned count, bool at_back);
+static void ** acquireBlock(struct Deque * const deque);
+static void releaseBlock(struct Deque * const deque, void ** block);
 
 static void * newBuffer(unsigned capacity);
 static void deleteBuffer(struct Buffer * buffer);
+static bool bufferReserve(struct Buffer * const buffer, unsigned count, bool at_back);
 static bool bufferPushBack(struct Buffer * const buffer, void * content);
 static bool bufferPushFront(struct Buffer * const buffer, void * content);
 static void * bufferPopBack(struct Buffer * const buffer);
@@ -56,6 +72,7 @@ static void * bufferPopFront(struct Buffer * const buffer);
 static inline void * bufferGet(struct Buffer const * const buffer, unsigned index);
 
 float deque_growth_factor = 2;
+unsigned deque_max_spare_blocks = 4;
 
 
 /**
@@ -65,6 +82,30 @@ float deque_growth_factor = 2;
  */
 struct Deque * newDeque(unsigned capacity) {
     alt_assert(capacity != 0, "Deque capacity cannot be zero.");
+    return createDeque(capacity, false);
+}
+
+
+/**
+ * Initializes a deque whose block capacity is rounded up to a power of two,
+ * so that locating an element by index takes a shift and a mask instead of a division.
+ *
+ * @param       capacity the minimum number of elements in each block.
+ *
+ * @return      the newly created deque.
+ */
+struct Deque * newPowerOfTwoDeque(unsigned capacity) {
+    alt_assert(capacity != 0, "Deque capacity cannot be zero.");
+    return createDeque(capacity, true);
+}
+
+static struct Deque * createDeque(unsigned capacity, bool power_of_two) {
+    unsigned block_shift = 0;
+    if (power_of_two) {
+        while ((1u << block_shift) < capacity)
+            block_shift++;
+        capacity = 1u << block_shift;
+    }
 
     struct Deque * deque = malloc(sizeof *deque);
     if (deque == NULL)
@@ -81,12 +122,19 @@ struct Deque * newDeque(unsigned capacity) {
         .get = _dequeCollectionGet,
         .set = _dequeCollectionSet,
         .atEnd = _dequeCollectionAtEnd,
+        .begin = _dequeCollectionBegin,
+        .next = _dequeCollectionNext,
+        .deref = _dequeCollectionDeref,
+        .span = NULL,
     };
 
     deque -> collection = collection;
     deque -> buffer = buffer;
-    deque -> front_empty = true;
-    deque -> back_empty = true;
+    deque -> spare_blocks = NULL;
+    deque -> spare_count = 0;
+    deque -> spare_limit = deque_max_spare_blocks;
+    deque -> power_of_two = power_of_two;
+    deque -> block_shift = block_shift;
     deque -> front = 0;
     deque -> back = 0;
     deque -> capacity = capacity;
@@ -109,13 +157,24 @@ void deleteDeque(struct Deque ** const deque, CDeleter deleter) {
         return;
     
     if (deleter != NULL) {
-        for(unsigned i = 0; i < (* deque) -> size; i++) {
-            void * element = dequeGet(* deque, i);
-            deleter(element);
+        struct DequeSegment segment = dequeSegment(* deque);
+        while (dequeSegmentNext(* deque, &segment)) {
+            for (unsigned i = 0; i < segment.length; i++)
+                deleter(segment.elements[i]);
         }
     }
 
-    deleteBuffer((* deque) -> buffer);
+    struct Buffer * buffer = (* deque) -> buffer;
+    for (unsigned i = 0; i < buffer -> size; i++)
+        free(bufferGet(buffer, i));
+
+    while ((* deque) -> spare_blocks != NULL) {
+        void ** block = (* deque) -> spare_blocks;
+        (* deque) -> spare_blocks = block[0];
+        free(block);
+    }
+
+    deleteBuffer(buffer);
     free(* deque);
     * deque = NULL;
 }
@@ -164,41 +223,25 @@ bool isDequeFull(struct Deque const * const deque) {
 void dequePushBack(struct Deque * const deque, void * element) {
     alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
 
-    unsigned index = 0;
-
-    // If we don't have space for back elements, we request it
-    // Same if we ran out of space for back elements
-    if (deque -> back_empty || deque -> back == deque -> capacity - 1) {
-        bool back_buffer_ready = bufferPushBack(deque -> buffer, malloc(deque -> capacity * sizeof(void *)));
+    // If the deque is empty or the last block is full, we start a new block
+    if (deque -> size == 0 || deque -> back == deque -> capacity - 1) {
+        void ** block = acquireBlock(deque);
+        bool back_buffer_ready = block != NULL && bufferPushBack(deque -> buffer, block);
         alt_assert(back_buffer_ready, "Failed to allocate space for new elements to push to the back.");
-    }
 
-    // If we haven't pushed anything on the back buffer, we start now
-    if (deque -> back_empty)
-        index = 0;
-
-    // If we are the end of the current back buffer, we start anew on the next one
-    else if (deque -> back == deque  -> capacity - 1)
-        index = 0;
+        deque -> back = 0;
+        if (deque -> size == 0)
+            deque -> front = 0;
+    }
 
-    // Otherwise, we are in the middle of the current back buffer, we advance
-    else
-        index = deque -> back + 1;
+    // Otherwise, we are in the middle of the current back block, we advance
+    else {
+        deque -> back += 1;
+    }
 
-    // Add the element to the deque and update our position in the back
-    ((void **) bufferGet(deque -> buffer, (deque -> buffer) -> size - 1))[index] = element;
-    deque -> back = index;
-    deque -> back_empty = false;
+    ((void **) bufferGet(deque -> buffer, deque -> buffer -> size - 1))[deque -> back] = element;
     deque -> size += 1;
 
-    // If we have only one element on the deque, we make sure that we can pop it from any direction
-    if (deque -> size == 1)
-        deque -> front = deque -> back;
-    
-    // TODO: explain the code below
-    if (deque -> buffer -> size == 1)
-        deque -> front_empty = false;
-
     return;
 }
 
@@ -212,41 +255,25 @@ void dequePushBack(struct Deque * const deque, void * element) {
 void dequePushFront(struct Deque * const deque, void * element) {
     alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
 
-    unsigned index = deque -> capacity - 1;
-
-    // If we don't have space for front elements, we request it
-    // Same if we ran out of space for front elements
-    if (deque -> front_empty || deque -> front == 0) {
-        bool front_buffer_ready = bufferPushFront(deque -> buffer, malloc(deque -> capacity * sizeof(void *)));
+    // If the deque is empty or the first block is full, we start a new block which we fill from its end
+    if (deque -> size == 0 || deque -> front == 0) {
+        void ** block = acquireBlock(deque);
+        bool front_buffer_ready = block != NULL && bufferPushFront(deque -> buffer, block);
         alt_assert(front_buffer_ready, "Failed to allocate space for new elements to push to the front.");
-    }
 
-    // If we haven't pushed anything on the front buffer, we start now
-    if (deque -> front_empty)
-        index = deque -> capacity - 1;
-
-    // If we are the end of the current front buffer, we start anew on the next one
-    else if (deque -> front == 0)
-        index = deque -> capacity - 1;
+        deque -> front = deque -> capacity - 1;
+        if (deque -> size == 0)
+            deque -> back = deque -> front;
+    }
 
-    // Otherwise, we are in the middle of the current front buffer, we move backwards
-    else
-        index = deque -> front - 1;
+    // Otherwise, we are in the middle of the current front block, we move backwards
+    else {
+        deque -> front -= 1;
+    }
 
-    // Add the element to the deque and update our position in the front
-    ((void **) bufferGet(deque -> buffer, 0))[index] = element;
-    deque -> front = index;
-    deque -> front_empty = false;
+    ((void **) bufferGet(deque -> buffer, 0))[deque -> front] = element;
     deque -> size += 1;
 
-    // If we have only one element on the deque, we make sure that we can pop it from any direction
-    if (deque -> size == 1)
-        deque -> back = deque -> front;
-
-    // TODO: explain the code below
-    if (deque -> buffer -> size == 1)
-        deque -> back_empty = false;
-    
     return;
 }
 
@@ -260,11 +287,6 @@ void dequePushFront(struct Deque * const deque, void * element) {
  */
 void * dequePopBack(struct Deque * const deque) {
     alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
-    
-    if (deque -> back_empty && deque -> buffer -> size > 1) {
-        free(bufferPopBack(deque -> buffer));
-        deque -> back_empty = false;
-    }
 
     if (deque -> size == 0)
         return NULL;
@@ -272,20 +294,14 @@ void * dequePopBack(struct Deque * const deque) {
     void * element = ((void **) bufferGet(deque -> buffer, deque -> buffer -> size - 1))[deque -> back];
     deque -> size -= 1;
 
-    if (deque -> back == 0) {
+    // If we emptied the last block, we let go of it and continue from the end of the one before
+    if (deque -> size == 0 || deque -> back == 0) {
+        releaseBlock(deque, bufferPopBack(deque -> buffer));
         deque -> back = deque -> capacity - 1;
-        deque -> back_empty = true;
     }
     else {
         deque -> back -= 1;
-        deque -> back_empty = false;
     }
-    
-    if (deque -> size == 1)
-        deque -> front = deque -> back;
-
-    if (deque -> size == 0)
-        free(bufferPopBack(deque -> buffer));
 
     return element;
 }
@@ -300,11 +316,6 @@ void * dequePopBack(struct Deque * const deque) {
  */
 void * dequePopFront(struct Deque * const deque) {
     alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
-    
-    if (deque -> front_empty && deque -> buffer -> size > 1) {
-        free(bufferPopFront(deque -> buffer));
-        deque -> front_empty = false;
-    }
 
     if (deque -> size == 0)
         return NULL;
@@ -312,23 +323,194 @@ void * dequePopFront(struct Deque * const deque) {
     void * element = ((void **) bufferGet(deque -> buffer, 0))[deque -> front];
     deque -> size -= 1;
 
-    if (deque -> front == deque -> capacity - 1) {
+    // If we emptied the first block, we let go of it and continue from the start of the one after
+    if (deque -> size == 0 || deque -> front == deque -> capacity - 1) {
+        releaseBlock(deque, bufferPopFront(deque -> buffer));
         deque -> front = 0;
-        deque -> front_empty = true;
     }
     else {
         deque -> front += 1;
-        deque -> front_empty = false;
     }
 
-    if (deque -> size == 1)
-        deque -> back = deque -> front;
+    return element;
+}
+
+
+/**
+ * Pushes several elements to the back of the deque, in the order they are given.
+ *
+ * @param       deque       pointer to deque to push back onto.
+ * @param       elements    the elements to push back.
+ * @param       count       the number of elements to push back.
+ */
+void dequePushBackN(struct Deque * const deque, void * const * elements, unsigned count) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+    alt_assert(elements != NULL || count == 0, "The parameter <elements> cannot be NULL.");
+
+    if (count == 0)
+        return;
+
+    // The single element path is cheaper when there is nothing to batch
+    if (count == 1) {
+        dequePushBack(deque, elements[0]);
+        return;
+    }
+
+    // We start right after the back, which is at the start of a new block if the last one is full
+    unsigned block = deque -> buffer -> size;
+    unsigned offset = 0;
+    if (deque -> size > 0 && deque -> back < deque -> capacity - 1) {
+        block -= 1;
+        offset = deque -> back + 1;
+    }
+
+    // We get all the blocks the batch needs before copying anything
+    unsigned room = block < deque -> buffer -> size ? deque -> capacity - offset : 0;
+    if (count > room)
+        addBlocks(deque, (count - room + deque -> capacity - 1) / deque -> capacity, true);
 
-    // If we exhausted all the elements, we delete the current front index buffer
     if (deque -> size == 0)
-        free(bufferPopFront(deque -> buffer));
+        deque -> front = 0;
 
-    return element;
+    copyElements(deque, &block, &offset, (void **) elements, count, true);
+    deque -> size += count;
+    deque -> back = offset == 0 ? deque -> capacity - 1 : (int) offset - 1;
+
+    return;
+}
+
+
+/**
+ * Pushes several elements to the front of the deque, so that they end up at the front in the order they are given.
+ * The first of the elements becomes the front of the deque.
+ *
+ * @param       deque       pointer to deque to push front onto.
+ * @param       elements    the elements to push front.
+ * @param       count       the number of elements to push front.
+ */
+void dequePushFrontN(struct Deque * const deque, void * const * elements, unsigned count) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+    alt_assert(elements != NULL || count == 0, "The parameter <elements> cannot be NULL.");
+
+    if (count == 0)
+        return;
+
+    if (count == 1) {
+        dequePushFront(deque, elements[0]);
+        return;
+    }
+
+    // Like a single push front, an empty deque is filled from the end of its first block
+    if (deque -> size == 0) {
+        deque -> front = deque -> capacity;
+        deque -> back = deque -> capacity - 1;
+    }
+
+    unsigned room = deque -> size == 0 ? 0 : deque -> front;
+    unsigned blocks = 0;
+    if (count > room) {
+        blocks = (count - room + deque -> capacity - 1) / deque -> capacity;
+        addBlocks(deque, blocks, false);
+    }
+
+    // The new blocks shifted every position by as many blocks
+    unsigned front = deque -> front + blocks * deque -> capacity - count;
+    if (deque -> size == 0)
+        front -= deque -> capacity;
+
+    unsigned block = 0;
+    unsigned offset = front;
+    copyElements(deque, &block, &offset, (void **) elements, count, true);
+    deque -> front = front;
+    deque -> size += count;
+
+    return;
+}
+
+
+/**
+ * Pops up to count elements from the front of the deque.
+ *
+ * @param       deque       pointer to deque to pop front from.
+ * @param       destination where to store the popped elements, the front of the deque first.
+ * @param       count       the maximum number of elements to pop.
+ *
+ * @return      the number of elements popped, which is less than count if the deque held fewer elements.
+ */
+unsigned dequePopFrontN(struct Deque * const deque, void ** destination, unsigned count) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+    alt_assert(destination != NULL || count == 0, "The parameter <destination> cannot be NULL.");
+
+    if (count > (unsigned) deque -> size)
+        count = deque -> size;
+
+    if (count == 0)
+        return 0;
+
+    if (count == 1) {
+        destination[0] = dequePopFront(deque);
+        return 1;
+    }
+
+    unsigned block = 0;
+    unsigned offset = deque -> front;
+    copyElements(deque, &block, &offset, destination, count, false);
+    deque -> size -= count;
+
+    // We let go of every block we emptied, which is all of them if nothing is left
+    unsigned emptied = deque -> size == 0 ? deque -> buffer -> size : block;
+    for (unsigned i = 0; i < emptied; i++)
+        releaseBlock(deque, bufferPopFront(deque -> buffer));
+
+    deque -> front = deque -> size == 0 ? 0 : offset;
+
+    return count;
+}
+
+
+/**
+ * Pops up to count elements from the back of the deque.
+ *
+ * @param       deque       pointer to deque to pop back from.
+ * @param       destination where to store the popped elements, in the order they were in the deque, so the back of the deque last.
+ * @param       count       the maximum number of elements to pop.
+ *
+ * @return      the number of elements popped, which is less than count if the deque held fewer elements.
+ */
+unsigned dequePopBackN(struct Deque * const deque, void ** destination, unsigned count) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+    alt_assert(destination != NULL || count == 0, "The parameter <destination> cannot be NULL.");
+
+    if (count > (unsigned) deque -> size)
+        count = deque -> size;
+
+    if (count == 0)
+        return 0;
+
+    if (count == 1) {
+        destination[0] = dequePopBack(deque);
+        return 1;
+    }
+
+    deque -> size -= count;
+
+    unsigned pos = deque -> front + deque -> size;
+    unsigned block = deque -> power_of_two ? pos >> deque -> block_shift : pos / deque -> capacity;
+    unsigned offset = blockOffset(deque, pos);
+
+    // The new back is right before where the popped elements start
+    unsigned kept = offset == 0 ? block : block + 1;
+    deque -> back = offset == 0 ? deque -> capacity - 1 : (int) offset - 1;
+
+    copyElements(deque, &block, &offset, destination, count, false);
+
+    // We let go of every block past the one now holding the back, which is all of them if nothing is left
+    if (deque -> size == 0)
+        kept = 0;
+    while (deque -> buffer -> size > kept)
+        releaseBlock(deque, bufferPopBack(deque -> buffer));
+
+    return count;
 }
 
 
@@ -386,8 +568,7 @@ static void * _dequeCollectionGet(struct Collection * const collection, unsigned
     
     alt_assert(index < deque -> size, "Index is out of bounds.");
 
-    unsigned pos = index + deque -> front;
-    return ((void **) bufferGet(deque -> buffer, (pos / deque -> capacity) + deque -> front_empty))[pos % deque -> capacity];
+    return * elementAt(deque, index + deque -> front);
 }
 
 /**
@@ -406,8 +587,7 @@ static void _dequeCollectionSet(struct Collection * const collection, unsigned i
     alt_assert(deque -> size != 0,  "Cannot set onto an empty deque.");
     alt_assert(index < deque -> size,  "Index is out of bounds.");
 
-    unsigned pos = index + deque -> front;
-    ((void **) bufferGet(deque -> buffer, (pos / deque -> capacity) + deque -> front_empty))[pos % deque -> capacity] = element;
+    * elementAt(deque, index + deque -> front) = element;
 
     return;
 }
@@ -423,6 +603,187 @@ static bool _dequeCollectionAtEnd(struct Collection const * const collection, un
 }
 
 
+/*
+ * The iterator keeps a pointer into the current block and only goes through the buffer when it crosses into the next one.
+ * Its index is the position of the element relative to the start of the first block, like pos in _dequeCollectionGet.
+ */
+static bool _dequeCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator) {
+    alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+
+    struct Deque const * const deque = (struct Deque const * const) collection;
+
+    iterator -> collection = collection;
+    iterator -> position = NULL;
+    iterator -> index = deque -> front;
+
+    if (deque -> size == 0)
+        return false;
+
+    iterator -> position = elementAt(deque, iterator -> index);
+
+    return true;
+}
+
+static bool _dequeCollectionNext(struct CIterator * const iterator) {
+    struct Deque const * const deque = (struct Deque const * const) iterator -> collection;
+
+    unsigned pos = ++iterator -> index;
+    if (pos - deque -> front >= (unsigned) deque -> size)
+        return false;
+
+    if (blockOffset(deque, pos) == 0)
+        iterator -> position = elementAt(deque, pos);
+    else
+        iterator -> position = (void **) iterator -> position + 1;
+
+    return true;
+}
+
+static void * _dequeCollectionDeref(struct CIterator const * const iterator) {
+    return * (void **) iterator -> position;
+}
+
+
+/**
+ * Creates a segment from which to walk the deque block by block:
+ *
+ *     struct DequeSegment segment = dequeSegment(deque);
+ *     while (dequeSegmentNext(deque, &segment))
+ *         for (unsigned i = 0; i < segment.length; i++)
+ *             use(segment.elements[i]);
+ *
+ * Pushing or popping elements invalidates the segment.
+ *
+ * @param       deque pointer to the deque to walk.
+ *
+ * @return      the new segment, which is empty until moved to the first block.
+ */
+struct DequeSegment dequeSegment(struct Deque const * const deque) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+
+    struct DequeSegment segment = {
+        .elements = NULL,
+        .length = 0,
+        .block = 0,
+    };
+
+    return segment;
+}
+
+
+/**
+ * Moves the segment to the elements of the next block.
+ *
+ * @param       deque   pointer to the deque the segment was created from.
+ * @param       segment pointer to the segment to move.
+ *
+ * @return      true if the segment holds elements, false if all blocks were visited.
+ */
+bool dequeSegmentNext(struct Deque const * const deque, struct DequeSegment * const segment) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+    alt_assert(segment != NULL, "The parameter <segment> cannot be NULL.");
+
+    unsigned block = segment -> block;
+    if (block >= deque -> buffer -> size) {
+        segment -> elements = NULL;
+        segment -> length = 0;
+        return false;
+    }
+
+    // Only the first and the last blocks can be partially filled
+    unsigned first = block == 0 ? deque -> front : 0;
+    unsigned last = block == deque -> buffer -> size - 1 ? deque -> back : deque -> capacity - 1;
+
+    segment -> elements = (void **) bufferGet(deque -> buffer, block) + first;
+    segment -> length = last - first + 1;
+    segment -> block = block + 1;
+
+    return true;
+}
+
+
+// Locates the element at the given position counted from the start of the first block
+static inline void ** elementAt(struct Deque const * const deque, unsigned pos) {
+    if (deque -> power_of_two)
+        return (void **) bufferGet(deque -> buffer, pos >> deque -> block_shift) + (pos & (deque -> capacity - 1));
+
+    return (void **) bufferGet(deque -> buffer, pos / deque -> capacity) + pos % deque -> capacity;
+}
+
+
+static inline unsigned blockOffset(struct Deque const * const deque, unsigned pos) {
+    return deque -> power_of_two ? pos & (deque -> capacity - 1) : pos % deque -> capacity;
+}
+
+/*
+ * Copies elements to or from the deque starting at the given block and offset, one block segment at a time.
+ * Block and offset are left on the position right after the last element copied.
+ */
+static void copyElements(struct Deque const * const deque, unsigned * const block, unsigned * const offset, void ** elements, unsigned count, bool into_deque) {
+    while (count > 0) {
+        unsigned length = deque -> capacity - * offset;
+        if (length > count)
+            length = count;
+
+        void ** segment = (void **) bufferGet(deque -> buffer, * block) + * offset;
+        if (into_deque)
+            memcpy(segment, elements, length * sizeof(void *));
+        else
+            memcpy(elements, segment, length * sizeof(void *));
+
+        * offset += length;
+        if (* offset == (unsigned) deque -> capacity) {
+            * block += 1;
+            * offset = 0;
+        }
+
+        elements += length;
+        count -= length;
+    }
+}
+
+// Adds the given number of blocks at one end, making room in the buffer for all of them at once
+static void addBlocks(struct Deque * const deque, unsigned count, bool at_back) {
+    bool buffer_ready = bufferReserve(deque -> buffer, count, at_back);
+    alt_assert(buffer_ready, "Failed to allocate space for new elements.");
+
+    for (unsigned i = 0; i < count; i++) {
+        void ** block = acquireBlock(deque);
+        alt_assert(block != NULL, "Failed to allocate space for new elements.");
+
+        if (at_back)
+            bufferPushBack(deque -> buffer, block);
+        else
+            bufferPushFront(deque -> buffer, block);
+    }
+}
+
+
+// Takes a block from the spare ones if there is any, the spare blocks are chained through their first slot
+static void ** acquireBlock(struct Deque * const deque) {
+    if (deque -> spare_blocks == NULL)
+        return malloc(deque -> capacity * sizeof(void *));
+
+    void ** block = deque -> spare_blocks;
+    deque -> spare_blocks = block[0];
+    deque -> spare_count--;
+
+    return block;
+}
+
+static void releaseBlock(struct Deque * const deque, void ** block) {
+    if (deque -> spare_count >= deque -> spare_limit) {
+        free(block);
+        return;
+    }
+
+    block[0] = deque -> spare_blocks;
+    deque -> spare_blocks = block;
+    deque -> spare_count++;
+}
+
+
 /*
  * /!\
  * Note that in the functions below operating on the buffer we don't have many checks.
@@ -435,13 +796,14 @@ static void * newBuffer(unsigned capacity) {
     if (buffer == NULL)
         return NULL;
 
-    void ** contents = malloc(capacity * sizeof(void *));
-    if (contents == NULL) {
+    void ** storage = malloc(capacity * sizeof(void *));
+    if (storage == NULL) {
         free(buffer);
         return NULL;
     }
 
-    buffer -> contents = contents;
+    buffer -> storage = storage;
+    buffer -> contents = storage + capacity / 2;
     buffer -> capacity = capacity;
     buffer -> size = 0;
     
@@ -452,26 +814,58 @@ static void deleteBuffer(struct Buffer * buffer) {
     if (buffer == NULL)
         return;
     
-    free(buffer -> contents);
+    free(buffer -> storage);
     free(buffer);
 }
 
-static void * resizeBuffer(struct Buffer * buffer) {
-    unsigned new_capacity = deque_growth_factor * buffer -> capacity;
-    void **contents = realloc(buffer -> contents, new_capacity * sizeof(void *));
+/*
+ * Makes room at both ends of the buffer, leaving at least the given number of free slots on each side.
+ * If at most half the storage is used, we only move the blocks back to the middle,
+ * which leaves a quarter of the storage free on each side so that this happens at most once every capacity / 4 pushes.
+ * Otherwise we grow the storage. Either way the cost is amortized O(1) per push.
+ */
+static void * recenterBuffer(struct Buffer * buffer, unsigned room) {
+    unsigned new_capacity = buffer -> capacity;
+    void ** storage = buffer -> storage;
 
-    // If we could not resize the buffer, we return NULL
-    if (contents == NULL)
-        return NULL;
-        
+    if (buffer -> size >= buffer -> capacity / 2 || (buffer -> capacity - buffer -> size) / 2 < room) {
+        new_capacity = deque_growth_factor * buffer -> capacity;
+        if (new_capacity < buffer -> size + 2 * room)
+            new_capacity = buffer -> size + 2 * room;
+
+        storage = malloc(new_capacity * sizeof(void *));
+
+        // If we could not resize the buffer, we return NULL
+        if (storage == NULL)
+            return NULL;
+    }
+
+    void ** contents = storage + (new_capacity - buffer -> size) / 2;
+    memmove(contents, buffer -> contents, buffer -> size * sizeof(void *));
+
+    if (storage != buffer -> storage)
+        free(buffer -> storage);
+
+    buffer -> storage = storage;
     buffer -> contents = contents;
     buffer -> capacity = new_capacity;
     return buffer;
 }
 
+static bool bufferReserve(struct Buffer * const buffer, unsigned count, bool at_back) {
+    unsigned room = at_back
+        ? buffer -> capacity - buffer -> size - (buffer -> contents - buffer -> storage)
+        : buffer -> contents - buffer -> storage;
+
+    if (room < count)
+        return recenterBuffer(buffer, count) != NULL;
+
+    return true;
+}
+
 static bool bufferPushBack(struct Buffer * const buffer, void * content) {
-    if (buffer -> size == buffer -> capacity) {
-        if (resizeBuffer(buffer) == NULL)
+    if (buffer -> contents + buffer -> size == buffer -> storage + buffer -> capacity) {
+        if (recenterBuffer(buffer, 1) == NULL)
             return false;
     }
 
@@ -481,15 +875,12 @@ static bool bufferPushBack(struct Buffer * const buffer, void * content) {
 }
 
 static bool bufferPushFront(struct Buffer * const buffer, void * content) {
-    if (buffer -> size == buffer -> capacity) {
-        if (resizeBuffer(buffer) == NULL)
+    if (buffer -> contents == buffer -> storage) {
+        if (recenterBuffer(buffer, 1) == NULL)
             return false;
     }
 
-    if (buffer -> size > 0)
-        memmove(buffer -> contents + 1, buffer -> contents, buffer -> size * sizeof(void *));
-
-    buffer -> contents[0] = content;
+    * --buffer -> contents = content;
     buffer -> size++;
 
     return true;
@@ -500,9 +891,8 @@ static void * bufferPopBack(struct Buffer * const buffer) {
 }
 
 static void * bufferPopFront(struct Buffer * const buffer) {
-    void * content = buffer -> contents[0];
-    memmove(buffer -> contents, buffer -> contents + 1, --buffer -> size * sizeof(void *));
-    return content;
+    buffer -> size--;
+    return * buffer -> contents++;
 }
 
 static inline void * bufferGet(struct Buffer const * const buffer, unsigned index) {
@@ -0,0 +1,319 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "vector.h"
+#include "heap.h"
+
+/*
+ * Both sifts move a hole rather than swapping: the element being placed is held aside,
+ * the elements it passes over are shifted into the hole, and it is written once at the end.
+ * Heaps that keep data alongside their elements are told about every write through the moved callback.
+ */
+
+unsigned heap_default_arity = 2;
+
+static struct Heap * createHeap(struct Vector * const vector, unsigned arity, CComparator compare);
+
+
+/**
+ * Initializes the heap
+ *
+ * @param       initial_capacity    the number of elements to make room for.
+ * @param       arity               the number of children per node, a power of two, or 0 for heap_default_arity.
+ * @param       compare             the function ordering the elements, the lowest comes out first.
+ *
+ * @return      the newly created heap.
+ */
+struct Heap * newHeap(unsigned initial_capacity, unsigned arity, CComparator compare) {
+    alt_assert(initial_capacity > 0, "Initial heap capacity cannot be zero.");
+
+    struct Vector * vector = newVector(initial_capacity);
+    if (vector == NULL)
+        return NULL;
+
+    struct Heap * heap = createHeap(vector, arity, compare);
+    if (heap == NULL)
+        deleteVector(&vector, NULL);
+
+    return heap;
+}
+
+
+/**
+ * Initializes a heap holding the elements of the given vector, which it takes over. This takes linear time.
+ *
+ * @param       vector  the vector whose elements to reorder into a heap, owned by the heap from now on.
+ * @param       arity   the number of children per node, a power of two, or 0 for heap_default_arity.
+ * @param       compare the function ordering the elements, the lowest comes out first.
+ *
+ * @return      the newly created heap.
+ */
+struct Heap * newHeapFromVector(struct Vector * const vector, unsigned arity, CComparator compare) {
+    alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");
+
+    struct Heap * heap = createHeap(vector, arity, compare);
+    if (heap == NULL)
+        return NULL;
+
+    // Sifting down every internal node, from the last one up, costs O(n) overall since most nodes sit near the bottom
+    if (vector -> size > 1) {
+        unsigned last_parent = (vector -> size - 2) >> heap -> arity_shift;
+        for (unsigned i = last_parent + 1; i-- > 0; )
+            heapSiftDown(heap, i, vector -> elements[i]);
+    }
+
+    return heap;
+}
+
+
+/**
+ * Initializes a heap in place over the given vector, whose elements must already be in heap order.
+ * This is for structures that embed a heap and follow its elements around through the moved callback.
+ *
+ * @param       heap    pointer to the heap to initialize.
+ * @param       vector  the vector holding the elements, owned by the heap from now on.
+ * @param       arity   the number of children per node, a power of two, or 0 for heap_default_arity.
+ * @param       compare the function ordering the elements, the lowest comes out first.
+ * @param       moved   the function called after every element the sifts write, or NULL.
+ */
+void initHeap(struct Heap * const heap, struct Vector * const vector, unsigned arity, CComparator compare, CHeapMoved moved) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+    alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");
+    alt_assert(compare != NULL, "The parameter <compare> cannot be NULL.");
+
+    if (arity == 0)
+        arity = heap_default_arity;
+    alt_assert(arity >= 2 && (arity & (arity - 1)) == 0, "Heap arity must be a power of two no smaller than 2.");
+
+    heap -> vector = vector;
+    heap -> compare = compare;
+    heap -> moved = moved;
+    heap -> arity = arity;
+    heap -> arity_shift = __builtin_ctz(arity);
+}
+
+
+/**
+ * Frees the memory occupied by the heap.
+ *
+ * @param       heap    pointer to memory occupied by the heap.
+ * @param       deleter function called on the elements still in the heap, if not NULL.
+ */
+void deleteHeap(struct Heap ** const heap, CDeleter deleter) {
+    if (heap == NULL)
+        return;
+
+    if (* heap == NULL)
+        return;
+
+    deleteVector(&(* heap) -> vector, deleter);
+    free(* heap);
+    * heap = NULL;
+}
+
+
+/**
+ * Check if the heap is empty.
+ *
+ * @param       heap pointer to the heap which content to check.
+ *
+ * @return      true if the heap is empty, false otherwise.
+ */
+bool isHeapEmpty(struct Heap const * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    return heap -> vector -> size == 0;
+}
+
+
+/**
+ * Returns the number of elements in the heap.
+ *
+ * @param       heap pointer to the heap which size to return.
+ *
+ * @return      the number of elements in the heap.
+ */
+unsigned heapSize(struct Heap const * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    return heap -> vector -> size;
+}
+
+
+/**
+ * Adds an element to the heap.
+ *
+ * @param       heap    pointer to the heap to push onto.
+ * @param       element pointer to the element to push.
+ *
+ * @return      true if the element was added, false otherwise (probably due to insufficient memory)
+ */
+bool heapPush(struct Heap * const heap, void * element) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    // We let the vector grow the storage, then move the new element up from the last index
+    if (vectorPushBack(heap -> vector, element) == false)
+        return false;
+
+    heapSiftUp(heap, heap -> vector -> size - 1, element);
+    return true;
+}
+
+
+/**
+ * Removes the lowest element of the heap.
+ *
+ * @param       heap pointer to the heap to pop from.
+ *
+ * @return      the lowest element of the heap, or NULL if the heap is empty.
+ */
+void * heapPop(struct Heap * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    struct Vector * vector = heap -> vector;
+    if (vector -> size == 0)
+        return NULL;
+
+    void * lowest = vector -> elements[0];
+    void * last = vector -> elements[--vector -> size];
+    if (vector -> size > 0)
+        heapSiftDown(heap, 0, last);
+
+    return lowest;
+}
+
+
+/**
+ * Returns the lowest element of the heap without removing it.
+ *
+ * @param       heap pointer to the heap to look into.
+ *
+ * @return      the lowest element of the heap, or NULL if the heap is empty.
+ */
+void * heapPeek(struct Heap const * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    return heap -> vector -> size == 0 ? NULL : heap -> vector -> elements[0];
+}
+
+
+/**
+ * Replaces the lowest element of the heap with the given one, which is cheaper than a pop followed by a push.
+ *
+ * @param       heap    pointer to the heap to update.
+ * @param       element pointer to the element to push.
+ *
+ * @return      the lowest element of the heap before the replacement, or NULL if the heap was empty.
+ */
+void * heapReplace(struct Heap * const heap, void * element) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    if (heap -> vector -> size == 0) {
+        heapPush(heap, element);
+        return NULL;
+    }
+
+    void * lowest = heap -> vector -> elements[0];
+    heapSiftDown(heap, 0, element);
+
+    return lowest;
+}
+
+
+/**
+ * Places an element in the hole at the given index or above it, moving down the parents that compare higher.
+ *
+ * @param       heap    pointer to the heap to sift in.
+ * @param       index   the index of the hole, below the vector's size.
+ * @param       element the element to place.
+ */
+void heapSiftUp(struct Heap * const heap, unsigned index, void * element) {
+    void ** elements = heap -> vector -> elements;
+
+    while (index > 0) {
+        unsigned parent = (index - 1) >> heap -> arity_shift;
+        if (heap -> compare(element, elements[parent]) >= 0)
+            break;
+
+        elements[index] = elements[parent];
+        if (heap -> moved != NULL)
+            heap -> moved(heap, parent, index);
+        index = parent;
+    }
+
+    elements[index] = element;
+    if (heap -> moved != NULL)
+        heap -> moved(heap, HEAP_HELD_ELEMENT, index);
+}
+
+
+/**
+ * Places an element in the hole at the given index or below it, moving up the lowest child while it compares lower.
+ *
+ * @param       heap    pointer to the heap to sift in.
+ * @param       index   the index of the hole, below the vector's size.
+ * @param       element the element to place.
+ */
+void heapSiftDown(struct Heap * const heap, unsigned index, void * element) {
+    void ** elements = heap -> vector -> elements;
+    unsigned size = heap -> vector -> size;
+
+    for (;;) {
+        unsigned first = (index << heap -> arity_shift) + 1;
+        if (first >= size)
+            break;
+
+        unsigned end = first + heap -> arity;
+        if (end > size)
+            end = size;
+
+        unsigned lowest = first;
+        for (unsigned child = first + 1; child < end; child++) {
+            if (heap -> compare(elements[child], elements[lowest]) < 0)
+                lowest = child;
+        }
+
+        if (heap -> compare(elements[lowest], element) >= 0)
+            break;
+
+        elements[index] = elements[lowest];
+        if (heap -> moved != NULL)
+            heap -> moved(heap, lowest, index);
+        index = lowest;
+    }
+
+    elements[index] = element;
+    if (heap -> moved != NULL)
+        heap -> moved(heap, HEAP_HELD_ELEMENT, index);
+}
+
+
+static struct Heap * createHeap(struct Vector * const vector, unsigned arity, CComparator compare) {
+    struct Heap * heap = malloc(sizeof *heap);
+    if (heap == NULL)
+        return NULL;
+
+    initHeap(heap, vector, arity, compare, NULL);
+
+    return heap;
+}
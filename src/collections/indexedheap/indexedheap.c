@@ -0,0 +1,351 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "vector.h"
+#include "heap.h"
+#include "indexedheap.h"
+
+/*
+ * Elements live in the heap's vector and are moved by its sifts. The handles follow them through
+ * followElement, and a handle stays given out as long as positions[handle] is not NO_POSITION.
+ */
+
+#define NO_POSITION UINT_MAX
+
+static bool growHandles(struct IndexedHeap * const heap);
+static void releaseHandle(struct IndexedHeap * const heap, unsigned handle);
+static void followElement(struct Heap * const heap, unsigned from, unsigned to);
+static void place(struct IndexedHeap * const heap, unsigned index, void * element, unsigned handle);
+
+
+/**
+ * Initializes the heap
+ *
+ * @param       initial_capacity    the number of elements to make room for.
+ * @param       arity               the number of children per node, a power of two, or 0 for heap_default_arity.
+ * @param       compare             the function ordering the elements, the lowest comes out first.
+ *
+ * @return      the newly created heap.
+ */
+struct IndexedHeap * newIndexedHeap(unsigned initial_capacity, unsigned arity, CComparator compare) {
+    alt_assert(initial_capacity > 0, "Initial heap capacity cannot be zero.");
+
+    struct IndexedHeap * heap = malloc(sizeof *heap);
+    if (heap == NULL)
+        return NULL;
+
+    struct Vector * vector = newVector(initial_capacity);
+    heap -> handles = malloc(initial_capacity * sizeof *heap -> handles);
+    heap -> positions = malloc(initial_capacity * sizeof *heap -> positions);
+    heap -> free_handles = malloc(initial_capacity * sizeof *heap -> free_handles);
+    if (vector == NULL || heap -> handles == NULL || heap -> positions == NULL || heap -> free_handles == NULL) {
+        deleteVector(&vector, NULL);
+        free(heap -> handles);
+        free(heap -> positions);
+        free(heap -> free_handles);
+        free(heap);
+        return NULL;
+    }
+
+    initHeap(&heap -> heap, vector, arity, compare, followElement);
+    heap -> free_count = 0;
+    heap -> handles_count = 0;
+    heap -> capacity = initial_capacity;
+    heap -> held_handle = 0;
+
+    return heap;
+}
+
+
+/**
+ * Frees the memory occupied by the heap.
+ *
+ * @param       heap    pointer to memory occupied by the heap.
+ * @param       deleter function called on the elements still in the heap, if not NULL.
+ */
+void deleteIndexedHeap(struct IndexedHeap ** const heap, CDeleter deleter) {
+    if (heap == NULL)
+        return;
+
+    if (* heap == NULL)
+        return;
+
+    deleteVector(&(* heap) -> heap.vector, deleter);
+    free((* heap) -> handles);
+    free((* heap) -> positions);
+    free((* heap) -> free_handles);
+    free(* heap);
+    * heap = NULL;
+}
+
+
+/**
+ * Check if the heap is empty.
+ *
+ * @param       heap pointer to the heap which content to check.
+ *
+ * @return      true if the heap is empty, false otherwise.
+ */
+bool isIndexedHeapEmpty(struct IndexedHeap const * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    return isHeapEmpty(&heap -> heap);
+}
+
+
+/**
+ * Returns the number of elements in the heap.
+ *
+ * @param       heap pointer to the heap which size to return.
+ *
+ * @return      the number of elements in the heap.
+ */
+unsigned indexedHeapSize(struct IndexedHeap const * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    return heapSize(&heap -> heap);
+}
+
+
+/**
+ * Check if the element with the given handle is still in the heap.
+ *
+ * @param       heap    pointer to the heap to look into.
+ * @param       handle  the handle returned when the element was pushed.
+ *
+ * @return      true if the element is in the heap, false if it was popped or removed.
+ */
+bool indexedHeapContains(struct IndexedHeap const * const heap, unsigned handle) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    return handle < heap -> handles_count && heap -> positions[handle] != NO_POSITION;
+}
+
+
+/**
+ * Adds an element to the heap.
+ *
+ * @param       heap    pointer to the heap to push onto.
+ * @param       element pointer to the element to push.
+ *
+ * @return      the handle of the element, or INDEXED_HEAP_NO_HANDLE if it couldn't be added (probably due to insufficient memory)
+ */
+unsigned indexedHeapPush(struct IndexedHeap * const heap, void * element) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    struct Vector * vector = heap -> heap.vector;
+    if (vector -> size == heap -> capacity && growHandles(heap) == false)
+        return INDEXED_HEAP_NO_HANDLE;
+
+    // We let the vector grow the storage, then move the new element up from the last index
+    if (vectorPushBack(vector, element) == false)
+        return INDEXED_HEAP_NO_HANDLE;
+
+    // Handles of elements that left are handed out again first, so there are never more handles than elements fit
+    unsigned handle = heap -> free_count > 0 ? heap -> free_handles[--heap -> free_count] : heap -> handles_count++;
+    heap -> held_handle = handle;
+    heapSiftUp(&heap -> heap, vector -> size - 1, element);
+
+    return handle;
+}
+
+
+/**
+ * Removes the lowest element of the heap. Its handle becomes invalid.
+ *
+ * @param       heap pointer to the heap to pop from.
+ *
+ * @return      the lowest element of the heap, or NULL if the heap is empty.
+ */
+void * indexedHeapPop(struct IndexedHeap * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    struct Vector * vector = heap -> heap.vector;
+    if (vector -> size == 0)
+        return NULL;
+
+    void * lowest = vector -> elements[0];
+    releaseHandle(heap, heap -> handles[0]);
+
+    vector -> size--;
+    if (vector -> size > 0) {
+        heap -> held_handle = heap -> handles[vector -> size];
+        heapSiftDown(&heap -> heap, 0, vector -> elements[vector -> size]);
+    }
+
+    return lowest;
+}
+
+
+/**
+ * Returns the lowest element of the heap without removing it.
+ *
+ * @param       heap pointer to the heap to look into.
+ *
+ * @return      the lowest element of the heap, or NULL if the heap is empty.
+ */
+void * indexedHeapPeek(struct IndexedHeap const * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    return heapPeek(&heap -> heap);
+}
+
+
+/**
+ * Returns the element with the given handle.
+ *
+ * @param       heap    pointer to the heap to look into.
+ * @param       handle  the handle of an element in the heap.
+ *
+ * @return      the element with the given handle.
+ */
+void * indexedHeapGet(struct IndexedHeap const * const heap, unsigned handle) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+    alt_assert(indexedHeapContains(heap, handle), "The handle does not belong to an element in the heap.");
+
+    return heap -> heap.vector -> elements[heap -> positions[handle]];
+}
+
+
+/**
+ * Replaces the element with the given handle by one that compares lower or equal, or signals
+ * that the element compares lower than it did, if the same element is passed after changing it in place.
+ *
+ * @param       heap    pointer to the heap to update.
+ * @param       handle  the handle of an element in the heap.
+ * @param       element the new element, which keeps the handle.
+ */
+void indexedHeapDecreaseKey(struct IndexedHeap * const heap, unsigned handle, void * element) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+    alt_assert(indexedHeapContains(heap, handle), "The handle does not belong to an element in the heap.");
+
+    heap -> held_handle = handle;
+    heapSiftUp(&heap -> heap, heap -> positions[handle], element);
+}
+
+
+/**
+ * Replaces the element with the given handle by one that compares higher or equal, or signals
+ * that the element compares higher than it did, if the same element is passed after changing it in place.
+ *
+ * @param       heap    pointer to the heap to update.
+ * @param       handle  the handle of an element in the heap.
+ * @param       element the new element, which keeps the handle.
+ */
+void indexedHeapIncreaseKey(struct IndexedHeap * const heap, unsigned handle, void * element) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+    alt_assert(indexedHeapContains(heap, handle), "The handle does not belong to an element in the heap.");
+
+    heap -> held_handle = handle;
+    heapSiftDown(&heap -> heap, heap -> positions[handle], element);
+}
+
+
+/**
+ * Replaces the element with the given handle by any other, moving it up or down as needed.
+ *
+ * @param       heap    pointer to the heap to update.
+ * @param       handle  the handle of an element in the heap.
+ * @param       element the new element, which keeps the handle.
+ */
+void indexedHeapUpdate(struct IndexedHeap * const heap, unsigned handle, void * element) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+    alt_assert(indexedHeapContains(heap, handle), "The handle does not belong to an element in the heap.");
+
+    place(heap, heap -> positions[handle], element, handle);
+}
+
+
+/**
+ * Removes the element with the given handle from the heap. The handle becomes invalid.
+ *
+ * @param       heap    pointer to the heap to remove from.
+ * @param       handle  the handle of an element in the heap.
+ *
+ * @return      the removed element.
+ */
+void * indexedHeapRemove(struct IndexedHeap * const heap, unsigned handle) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+    alt_assert(indexedHeapContains(heap, handle), "The handle does not belong to an element in the heap.");
+
+    struct Vector * vector = heap -> heap.vector;
+    unsigned index = heap -> positions[handle];
+    void * removed = vector -> elements[index];
+    releaseHandle(heap, handle);
+
+    // The last element fills the hole, and may belong above or below it
+    vector -> size--;
+    if (index < vector -> size)
+        place(heap, index, vector -> elements[vector -> size], heap -> handles[vector -> size]);
+
+    return removed;
+}
+
+
+// The vector grows on its own when pushed onto, the arrays of handles are grown to match it ahead of time
+static bool growHandles(struct IndexedHeap * const heap) {
+    unsigned new_capacity = heap -> capacity * 2;
+
+    // Arrays that grew stay grown if a later one fails, which is harmless since the capacity doesn't change
+    unsigned * handles = realloc(heap -> handles, new_capacity * sizeof *handles);
+    if (handles == NULL)
+        return false;
+    heap -> handles = handles;
+
+    unsigned * positions = realloc(heap -> positions, new_capacity * sizeof *positions);
+    if (positions == NULL)
+        return false;
+    heap -> positions = positions;
+
+    unsigned * free_handles = realloc(heap -> free_handles, new_capacity * sizeof *free_handles);
+    if (free_handles == NULL)
+        return false;
+    heap -> free_handles = free_handles;
+
+    heap -> capacity = new_capacity;
+    return true;
+}
+
+static void releaseHandle(struct IndexedHeap * const heap, unsigned handle) {
+    heap -> positions[handle] = NO_POSITION;
+    heap -> free_handles[heap -> free_count++] = handle;
+}
+
+// Moves the handle along with the element the heap just wrote to index to
+static void followElement(struct Heap * const heap, unsigned from, unsigned to) {
+    struct IndexedHeap * const indexed = (struct IndexedHeap *) heap;
+
+    unsigned handle = from == HEAP_HELD_ELEMENT ? indexed -> held_handle : indexed -> handles[from];
+    indexed -> handles[to] = handle;
+    indexed -> positions[handle] = to;
+}
+
+// Places the element in the hole at the given index, then moves it whichever way it belongs
+static void place(struct IndexedHeap * const heap, unsigned index, void * element, unsigned handle) {
+    void ** elements = heap -> heap.vector -> elements;
+
+    heap -> held_handle = handle;
+    if (index > 0 && heap -> heap.compare(element, elements[(index - 1) >> heap -> heap.arity_shift]) < 0)
+        heapSiftUp(&heap -> heap, index, element);
+    else
+        heapSiftDown(&heap -> heap, index, element);
+}
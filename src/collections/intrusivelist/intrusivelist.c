@@ -0,0 +1,271 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common.h"
+#include "intrusivelist.h"
+
+static inline void linkBetween(struct IntrusiveList * const list, struct ListLink * prev, struct ListLink * next, struct ListLink * const link);
+static inline void detachLink(struct IntrusiveList * const list, struct ListLink * const link);
+
+
+/**
+ * Initializes an empty list in memory provided by the caller.
+ *
+ * @param       list pointer to the list to initialize.
+ */
+void initIntrusiveList(struct IntrusiveList * const list) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+
+    list -> head = NULL;
+    list -> tail = NULL;
+    list -> size = 0;
+}
+
+
+/**
+ * Check if the list is empty.
+ *
+ * @param       list pointer to the list which content to check.
+ *
+ * @return      true if the list is empty, false otherwise.
+ */
+bool isIntrusiveListEmpty(struct IntrusiveList const * const list) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+
+    return list -> size == 0;
+}
+
+
+/**
+ * Pushes a link to the back of the list.
+ *
+ * @param       list pointer to list to push back onto.
+ * @param       link pointer to the link to push back, which must not be in a list.
+ */
+void intrusiveListPushBack(struct IntrusiveList * const list, struct ListLink * const link) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+    alt_assert(link != NULL, "The parameter <link> cannot be NULL.");
+
+    linkBetween(list, list -> tail, NULL, link);
+}
+
+
+/**
+ * Pushes a link to the front of the list.
+ *
+ * @param       list pointer to list to push front onto.
+ * @param       link pointer to the link to push at the front, which must not be in a list.
+ */
+void intrusiveListPushFront(struct IntrusiveList * const list, struct ListLink * const link) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+    alt_assert(link != NULL, "The parameter <link> cannot be NULL.");
+
+    linkBetween(list, NULL, list -> head, link);
+}
+
+
+/**
+ * Pops the link at the back of the list.
+ *
+ * @param       list pointer to list to pop back from.
+ *
+ * @return      the link at the back of the list, or NULL if the list is empty.
+ */
+struct ListLink * intrusiveListPopBack(struct IntrusiveList * const list) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+
+    struct ListLink * link = list -> tail;
+    if (link != NULL)
+        detachLink(list, link);
+
+    return link;
+}
+
+
+/**
+ * Pops the link at the front of the list.
+ *
+ * @param       list pointer to list to pop front from.
+ *
+ * @return      the link at the front of the list, or NULL if the list is empty.
+ */
+struct ListLink * intrusiveListPopFront(struct IntrusiveList * const list) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+
+    struct ListLink * link = list -> head;
+    if (link != NULL)
+        detachLink(list, link);
+
+    return link;
+}
+
+
+/**
+ * Gets the link at the back of the list.
+ *
+ * @param       list pointer to list to get the back link from.
+ *
+ * @return      the link at the back of the list, or NULL if the list is empty.
+ */
+struct ListLink * intrusiveListBack(struct IntrusiveList const * const list) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+
+    return list -> tail;
+}
+
+
+/**
+ * Gets the link at the front of the list.
+ *
+ * @param       list pointer to list to get the front link from.
+ *
+ * @return      the link at the front of the list, or NULL if the list is empty.
+ */
+struct ListLink * intrusiveListFront(struct IntrusiveList const * const list) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+
+    return list -> head;
+}
+
+
+/**
+ * Inserts a link before the given position.
+ *
+ * @param       list     pointer to the list to insert into.
+ * @param       position pointer to a link of the list, or NULL to insert at the back.
+ * @param       link     pointer to the link to insert, which must not be in a list.
+ */
+void intrusiveListInsertBefore(struct IntrusiveList * const list, struct ListLink * const position, struct ListLink * const link) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+    alt_assert(link != NULL, "The parameter <link> cannot be NULL.");
+
+    if (position == NULL)
+        linkBetween(list, list -> tail, NULL, link);
+    else
+        linkBetween(list, position -> prev, position, link);
+}
+
+
+/**
+ * Removes a link from the list. Removing a link that was already removed is caught by an assertion.
+ *
+ * @param       list pointer to the list to remove from.
+ * @param       link pointer to a link of the list.
+ */
+void intrusiveListRemove(struct IntrusiveList * const list, struct ListLink * const link) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+    alt_assert(link != NULL, "The parameter <link> cannot be NULL.");
+
+    detachLink(list, link);
+}
+
+
+/**
+ * Moves a link of the list to its front, as an LRU cache does on every access.
+ *
+ * @param       list pointer to the list to update.
+ * @param       link pointer to a link of the list.
+ */
+void intrusiveListMoveToFront(struct IntrusiveList * const list, struct ListLink * const link) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+    alt_assert(link != NULL, "The parameter <link> cannot be NULL.");
+
+    if (link == list -> head)
+        return;
+
+    detachLink(list, link);
+    linkBetween(list, NULL, list -> head, link);
+}
+
+
+/**
+ * Moves all the links of another list before the given position, leaving the other list empty.
+ *
+ * @param       list     pointer to the list to splice into.
+ * @param       position pointer to a link of the list, or NULL to splice at the back.
+ * @param       other    pointer to the list to take the links from.
+ */
+void intrusiveListSplice(struct IntrusiveList * const list, struct ListLink * const position, struct IntrusiveList * const other) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+    alt_assert(other != NULL, "The parameter <other> cannot be NULL.");
+
+    if (other -> size == 0 || other == list)
+        return;
+
+    struct ListLink * prev = position == NULL ? list -> tail : position -> prev;
+
+    other -> head -> prev = prev;
+    if (prev == NULL)
+        list -> head = other -> head;
+    else
+        prev -> next = other -> head;
+
+    other -> tail -> next = position;
+    if (position == NULL)
+        list -> tail = other -> tail;
+    else
+        position -> prev = other -> tail;
+
+    list -> size += other -> size;
+
+    other -> head = NULL;
+    other -> tail = NULL;
+    other -> size = 0;
+}
+
+
+// Links the given link between two neighbours, either of which is NULL at the ends of the list
+static inline void linkBetween(struct IntrusiveList * const list, struct ListLink * prev, struct ListLink * next, struct ListLink * const link) {
+    link -> prev = prev;
+    link -> next = next;
+
+    if (prev == NULL)
+        list -> head = link;
+    else
+        prev -> next = link;
+
+    if (next == NULL)
+        list -> tail = link;
+    else
+        next -> prev = link;
+
+    list -> size++;
+}
+
+// The links of a removed element are cleared, so removing it again fails the checks below instead of emptying the list
+static inline void detachLink(struct IntrusiveList * const list, struct ListLink * const link) {
+    alt_assert(link -> prev != NULL || list -> head == link, "The link is not in the list.");
+    alt_assert(link -> next != NULL || list -> tail == link, "The link is not in the list.");
+
+    if (link -> prev == NULL)
+        list -> head = link -> next;
+    else
+        link -> prev -> next = link -> next;
+
+    if (link -> next == NULL)
+        list -> tail = link -> prev;
+    else
+        link -> next -> prev = link -> prev;
+
+    link -> prev = NULL;
+    link -> next = NULL;
+    list -> size--;
+}
@@ -23,13 +23,24 @@
 
 #include "common.h"
 #include "list.h"
+#include "pool.h"
+#include "unrolled.h"
 
 static void * _listCollectionGet(struct Collection * const collection, unsigned index);
 static void _listCollectionSet(struct Collection * const collection, unsigned index, void * element);
 static bool _listCollectionAtEnd(struct Collection const * const collection, unsigned index);
+static bool _listCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator);
+static bool _listCollectionNext(struct CIterator * const iterator);
+static void * _listCollectionDeref(struct CIterator const * const iterator);
 
-static void * createListNode(void * element);
-static void deleteListNode(struct ListNode * node, CDeleter deleter);
+static struct List * createList(struct ListNodePool * pool, bool owns_pool);
+static void * createListNode(struct List * const list, void * element);
+static void deleteListNode(struct List * const list, struct ListNode * node, CDeleter deleter);
+static void moveCurrentNode(struct List * const list, unsigned index);
+static struct ListNode * mergeNodes(struct ListNode * left, struct ListNode * right, CComparator compare);
+static void relinkNodes(struct List * const list, struct ListNode * head);
+static void linkNode(struct List * const list, struct ListNode * prev_node, struct ListNode * next_node, struct ListNode * node);
+static void unlinkNode(struct List * const list, struct ListNode * node);
 
 
 /**
@@ -38,6 +49,52 @@ static void deleteListNode(struct ListNode * node, CDeleter deleter);
  * @return      the newly created list.
  */
 struct List * newList() {
+    return createList(NULL, false);
+}
+
+
+/**
+ * Initializes a list whose nodes are drawn from a slab pool rather than allocated one by one.
+ *
+ * @param       pool the pool to draw nodes from, shared with other lists. If NULL, the list gets a pool of its own.
+ *
+ * @return      the newly created list.
+ */
+struct List * newPooledList(struct ListNodePool * pool) {
+    if (pool != NULL)
+        return createList(pool, false);
+
+    pool = newListNodePool(0);
+    if (pool == NULL)
+        return NULL;
+
+    struct List * list = createList(pool, true);
+    if (list == NULL)
+        deleteListNodePool(&pool);
+
+    return list;
+}
+
+
+/**
+ * Initializes a list that stores its elements in blocks of LIST_BLOCK_CAPACITY (unrolled) instead of one per node.
+ *
+ * @return      the newly created list.
+ */
+struct List * newUnrolledList() {
+    struct List * list = createList(NULL, false);
+    if (list == NULL)
+        return NULL;
+
+    list -> layout = LIST_UNROLLED;
+    list -> collection.begin = unrolledListBegin;
+    list -> collection.next = unrolledListNext;
+    list -> collection.deref = unrolledListDeref;
+
+    return list;
+}
+
+static struct List * createList(struct ListNodePool * pool, bool owns_pool) {
     struct List * list = malloc(sizeof *list);
     if (list == NULL)
         return NULL;
@@ -46,14 +103,28 @@ struct List * newList() {
         .get = _listCollectionGet,
         .set = _listCollectionSet,
         .atEnd = _listCollectionAtEnd,
+        .begin = _listCollectionBegin,
+        .next = _listCollectionNext,
+        .deref = _listCollectionDeref,
+        .span = NULL,
     };
 
     list -> collection = collection;
     list -> head = NULL;
     list -> tail = NULL;
     list -> size = 0;
-    list -> current_node = NULL;
+    list -> current.list = list;
+    list -> current.node = NULL;
     list -> current_index = 0;
+    list -> pool = pool;
+    list -> owns_pool = owns_pool;
+    list -> layout = LIST_LINKED;
+    list -> head_block = NULL;
+    list -> tail_block = NULL;
+    list -> current_block = NULL;
+
+    if (pool != NULL)
+        pool -> users++;
 
     return list;
 }
@@ -71,11 +142,32 @@ void deleteList(struct List ** const list, CDeleter deleter) {
     if (* list == NULL)
         return;
 
-    struct ListNode * current = (* list) -> head;
-    while (current != NULL) {
-        struct ListNode * next = current -> next;
-        deleteListNode(current, deleter);
-        current = next;
+    if ((* list) -> layout == LIST_UNROLLED) {
+        unrolledListDestroy(* list, deleter);
+        free(* list);
+        * list = NULL;
+        return;
+    }
+
+    struct ListNodePool * pool = (* list) -> pool;
+
+    // Nodes from a private pool go away with its slabs, so we only need to walk them if there is a deleter to call
+    if ((* list) -> owns_pool == false || deleter != NULL) {
+        struct ListNode * current = (* list) -> head;
+        while (current != NULL) {
+            struct ListNode * next = current -> next;
+            if ((* list) -> owns_pool)
+                deleter(current -> element);
+            else
+                deleteListNode(* list, current, deleter);
+            current = next;
+        }
+    }
+
+    if (pool != NULL) {
+        pool -> users--;
+        if ((* list) -> owns_pool)
+            deleteListNodePool(&pool);
     }
 
     free(* list);
@@ -106,11 +198,16 @@ bool isListEmpty(struct List const * const list) {
 void listPushBack(struct List * const list, void * element) {
     alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
 
-    struct ListNode * new_tail = createListNode(element);
+    if (list -> layout == LIST_UNROLLED) {
+        unrolledListPushBack(list, element);
+        return;
+    }
+
+    struct ListNode * new_tail = createListNode(list, element);
     if (list -> size == 0) {
         list -> head = new_tail;
         list -> tail = new_tail;
-        list -> current_node = new_tail;
+        list -> current.node = new_tail;
         list -> current_index = 0;
     }
     else {
@@ -134,17 +231,24 @@ void listPushBack(struct List * const list, void * element) {
 void listPushFront(struct List * const list, void * element) {
     alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
 
-    struct ListNode * new_head = createListNode(element);
+    if (list -> layout == LIST_UNROLLED) {
+        unrolledListPushFront(list, element);
+        return;
+    }
+
+    struct ListNode * new_head = createListNode(list, element);
     if (list -> size == 0) {
         list -> head = new_head;
         list -> tail = new_head;
-        list -> current_node = new_head;
+        list -> current.node = new_head;
         list -> current_index = 0;
     }
     else {
         new_head -> next = list -> head;
         list -> head -> prev = new_head;
         list -> head = new_head;
+        // The current node moved one position to the right
+        list -> current_index++;
     }
 
     list -> size++;
@@ -165,19 +269,26 @@ void * listPopBack(struct List * const list) {
 
     if (list -> size == 0)
         return NULL;
+
+    if (list -> layout == LIST_UNROLLED)
+        return unrolledListPopBack(list);
     
     struct ListNode * old_tail = list -> tail;
     list -> tail = old_tail -> prev;
-    list -> tail -> next = NULL;
-    if (list -> current_node == old_tail) {
-        list -> current_node = list -> head;
-        list -> current_index = list -> size - 1;
+    if (list -> tail != NULL)
+        list -> tail -> next = NULL;
+    else
+        list -> head = NULL;
+
+    if (list -> current.node == old_tail) {
+        list -> current.node = list -> head;
+        list -> current_index = 0;
     }
 
     list -> size--;
 
     void * element = old_tail -> element;
-    deleteListNode(old_tail, NULL);
+    deleteListNode(list, old_tail, NULL);
 
     return element;
 }
@@ -195,19 +306,30 @@ void * listPopFront(struct List * const list) {
 
     if (list -> size == 0)
         return NULL;
+
+    if (list -> layout == LIST_UNROLLED)
+        return unrolledListPopFront(list);
     
     struct ListNode * old_head = list -> head;
     list -> head = old_head -> next;
-    list -> head -> prev = NULL;
-    if (list -> current_node == old_head) {
-        list -> current_node = list -> head;
-        list -> current_index = list -> size - 1;
+    if (list -> head != NULL)
+        list -> head -> prev = NULL;
+    else
+        list -> tail = NULL;
+
+    // Every remaining node moves one position to the left
+    if (list -> current.node == old_head) {
+        list -> current.node = list -> head;
+        list -> current_index = 0;
+    }
+    else {
+        list -> current_index--;
     }
     
     list -> size--;
 
     void * element = old_head -> element;
-    deleteListNode(old_head, NULL);
+    deleteListNode(list, old_head, NULL);
 
     return element;
 }
@@ -225,6 +347,9 @@ void * listBack(struct List const * const list) {
 
     if (list -> size == 0)
         return NULL;
+
+    if (list -> layout == LIST_UNROLLED)
+        return list -> tail_block -> elements[list -> tail_block -> count - 1];
     
     return list -> tail -> element;
 }
@@ -242,6 +367,9 @@ void * listFront(struct List const * const list) {
 
     if (list -> size == 0)
         return NULL;
+
+    if (list -> layout == LIST_UNROLLED)
+        return list -> head_block -> elements[0];
     
     return list -> head -> element;
 }
@@ -266,14 +394,13 @@ static void * _listCollectionGet(struct Collection * const collection, unsigned
 
     if (list -> size == 0)
         return NULL;
+
+    if (list -> layout == LIST_UNROLLED)
+        return * unrolledListSeek(list, index);
     
-    bool move_right = (index > list -> current_index) ? true : false;
-    while (list -> current_index != index) {
-        list -> current_node = move_right ? list -> current_node -> next : list -> current_node -> prev;
-        list -> current_index = move_right ? list -> current_index + 1 : list -> current_index - 1;
-    }
+    moveCurrentNode(list, index);
 
-    return list -> current_node -> element;
+    return list -> current.node -> element;
 }
 
 
@@ -291,14 +418,15 @@ static void _listCollectionSet(struct Collection * const collection, unsigned in
     struct List * const list = (struct List * const) collection;
 
     alt_assert(index < list -> size,  "Index is out of bounds.");
-    
-    bool move_right = (index > list -> current_index) ? true : false;
-    while (list -> current_index != index) {
-        list -> current_node = move_right ? list -> current_node -> next : list -> current_node -> prev;
-        list -> current_index = move_right ? list -> current_index + 1 : list -> current_index - 1;
+
+    if (list -> layout == LIST_UNROLLED) {
+        * unrolledListSeek(list, index) = element;
+        return;
     }
+    
+    moveCurrentNode(list, index);
 
-    list -> current_node -> element = element;
+    list -> current.node -> element = element;
     return;
 }
 
@@ -313,37 +441,371 @@ static void _listCollectionSet(struct Collection * const collection, unsigned in
 void listInsert(struct List * const list, unsigned index, void * element) {
     alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
     alt_assert(index < list -> size,  "Index is out of bounds.");
+
+    if (list -> layout == LIST_UNROLLED) {
+        unrolledListInsert(list, index, element);
+        return;
+    }
     
-    bool move_right = (index > list -> current_index) ? true : false;
-    while (list -> current_index != index) {
-        list -> current_node = move_right ? list -> current_node -> next : list -> current_node -> prev;
-        list -> current_index = move_right ? list -> current_index + 1 : list -> current_index - 1;
+    moveCurrentNode(list, index);
+
+    struct ListNode * new_node = createListNode(list, element);
+
+    linkNode(list, list -> current.node -> prev, list -> current.node, new_node);
+    list -> current.node = new_node;
+
+    return;
+}
+
+
+/**
+ * Removes the element at the given position in the list, moving the other elements to the left.
+ *
+ * @param       list    pointer to list to remove the element from.
+ * @param       index   the index of the element to remove.
+ *
+ * @return      the removed element.
+ */
+void * listRemove(struct List * const list, unsigned index) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+    alt_assert(index < list -> size,  "Index is out of bounds.");
+
+    if (list -> layout == LIST_UNROLLED)
+        return unrolledListRemove(list, index);
+
+    moveCurrentNode(list, index);
+
+    struct ListNode * old_node = list -> current.node;
+    unlinkNode(list, old_node);
+
+    // The next node takes the index of the removed one, failing that we fall back to the previous node
+    if (old_node -> next != NULL) {
+        list -> current.node = old_node -> next;
+    }
+    else if (old_node -> prev != NULL) {
+        list -> current.node = old_node -> prev;
+        list -> current_index--;
     }
+    else {
+        list -> current.node = NULL;
+        list -> current_index = 0;
+    }
+
+    void * element = old_node -> element;
+    deleteListNode(list, old_node, NULL);
 
-    struct ListNode * new_node = createListNode(element);
+    return element;
+}
 
-    struct ListNode * prev_node = list -> current_node -> prev;
-    struct ListNode * next_node = list -> current_node;
+
+/**
+ * Moves the nodes from first to last (included) out of the other list and into this one, before the given position.
+ * No node is allocated or freed, so both lists must be linked and allocate their nodes in the same way
+ * (with malloc, or from the same shared pool).
+ *
+ * @param       list     pointer to list to move the nodes into.
+ * @param       position the node of the list to insert the nodes before, or NULL to add them at the back.
+ * @param       other    pointer to list to move the nodes out of.
+ * @param       first    the first node to move.
+ * @param       last     the last node to move, which comes after first in the other list (or is first).
+ * @param       count    the number of nodes from first to last, which the lists need to keep their size.
+ */
+void listSplice(struct List * const list, struct ListNode * position, struct List * const other, struct ListNode * first, struct ListNode * last, unsigned count) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+    alt_assert(other != NULL, "The parameter <other> cannot be NULL.");
+    alt_assert(first != NULL, "The parameter <first> cannot be NULL.");
+    alt_assert(last != NULL, "The parameter <last> cannot be NULL.");
+    alt_assert(list != other, "The nodes must be moved to a different list.");
+    alt_assert(list -> layout == LIST_LINKED && other -> layout == LIST_LINKED, "Only linked lists can exchange nodes.");
+    alt_assert(list -> pool == other -> pool, "The lists must allocate their nodes in the same way.");
+    alt_assert(count > 0 && count <= other -> size, "The number of nodes is out of bounds.");
+
+    if (first -> prev != NULL)
+        first -> prev -> next = last -> next;
+    else
+        other -> head = last -> next;
+
+    if (last -> next != NULL)
+        last -> next -> prev = first -> prev;
+    else
+        other -> tail = first -> prev;
+
+    struct ListNode * prev_node = position != NULL ? position -> prev : list -> tail;
+    first -> prev = prev_node;
+    last -> next = position;
 
     if (prev_node != NULL)
-        prev_node -> next = new_node;
-    next_node -> prev = new_node;
-    new_node -> prev = prev_node;
-    new_node -> next = next_node;
-    list -> current_node = new_node;
+        prev_node -> next = first;
+    else
+        list -> head = first;
 
-    if (list -> current_index == 0)
-        list -> head = new_node;
+    if (position != NULL)
+        position -> prev = last;
+    else
+        list -> tail = last;
 
-    if (list -> current_index == list -> size - 1)
-        list -> tail = new_node;
+    list -> size += count;
+    other -> size -= count;
 
-    list -> size++;
+    // We don't know the index of the position, nor if the current node of the other list moved, so we start over in both
+    listResetCurrent(list);
+    listResetCurrent(other);
+
+    return;
+}
+
+
+/**
+ * Merges the other list, sorted, into this one, sorted as well, leaving the other list empty.
+ * Equal elements keep their order, the ones from this list coming first. Both lists must be as for listSplice.
+ *
+ * @param       list    pointer to list to merge into.
+ * @param       other   pointer to list to merge from.
+ * @param       compare function to use to compare elements.
+ */
+void listMerge(struct List * const list, struct List * const other, CComparator compare) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+    alt_assert(other != NULL, "The parameter <other> cannot be NULL.");
+    alt_assert(compare != NULL, "The parameter <compare> cannot be NULL.");
+    alt_assert(list != other, "The nodes must be moved to a different list.");
+    alt_assert(list -> layout == LIST_LINKED && other -> layout == LIST_LINKED, "Only linked lists can exchange nodes.");
+    alt_assert(list -> pool == other -> pool, "The lists must allocate their nodes in the same way.");
+
+    if (other -> size == 0)
+        return;
+
+    relinkNodes(list, mergeNodes(list -> head, other -> head, compare));
+    list -> size += other -> size;
+
+    other -> head = NULL;
+    other -> tail = NULL;
+    other -> size = 0;
+    listResetCurrent(other);
 
     return;
 }
 
 
+/**
+ * Sorts the list with a stable merge sort that relinks the nodes, without allocating. The list must be linked.
+ *
+ * @param       list    pointer to list to sort.
+ * @param       compare function to use to compare elements.
+ */
+void listSort(struct List * const list, CComparator compare) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+    alt_assert(compare != NULL, "The parameter <compare> cannot be NULL.");
+    alt_assert(list -> layout == LIST_LINKED, "Only linked lists can be sorted.");
+
+    if (list -> size < 2)
+        return;
+
+    /*
+     * Bottom-up merge sort: runs[i] is either empty or a sorted run of 2^i nodes, like the bits of a binary counter.
+     * Each node is added as a run of one, which merges with runs of the same length until it finds an empty slot.
+     * Longer runs hold earlier nodes, so they always go on the left of a merge and the sort is stable.
+     */
+    struct ListNode * runs[sizeof(unsigned) * 8 + 1] = {NULL};
+    unsigned runs_count = 0;
+
+    struct ListNode * node = list -> head;
+    while (node != NULL) {
+        struct ListNode * next = node -> next;
+        node -> next = NULL;
+
+        struct ListNode * carry = node;
+        unsigned i = 0;
+        for (; i < runs_count && runs[i] != NULL; i++) {
+            carry = mergeNodes(runs[i], carry, compare);
+            runs[i] = NULL;
+        }
+
+        runs[i] = carry;
+        if (i == runs_count)
+            runs_count++;
+
+        node = next;
+    }
+
+    struct ListNode * sorted = NULL;
+    for (unsigned i = 0; i < runs_count; i++) {
+        if (runs[i] != NULL)
+            sorted = mergeNodes(runs[i], sorted, compare);
+    }
+
+    relinkNodes(list, sorted);
+
+    return;
+}
+
+
+/**
+ * Creates an iterator placed off the list, so that moving it forward goes to the first element
+ * and moving it backward goes to the last one. The list must be linked.
+ *
+ *     struct ListIterator iterator = listIterator(list);
+ *     while (listIteratorNext(&iterator))
+ *         use(listIteratorGet(&iterator));
+ *
+ * Any number of iterators can walk and modify the same list. Inserting elements doesn't invalidate them,
+ * erasing an element only invalidates the other iterators on that element.
+ *
+ * @param       list pointer to the list to walk.
+ *
+ * @return      the new iterator.
+ */
+struct ListIterator listIterator(struct List * const list) {
+    alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
+    alt_assert(list -> layout == LIST_LINKED, "Only linked lists have iterators.");
+
+    struct ListIterator iterator = {
+        .list = list,
+        .node = NULL,
+    };
+
+    return iterator;
+}
+
+
+/**
+ * Moves the iterator to the next element, or off the list if it was on the last element.
+ *
+ * @param       iterator pointer to the iterator to move.
+ *
+ * @return      true if the iterator is on an element, false if it went off the list.
+ */
+bool listIteratorNext(struct ListIterator * const iterator) {
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+
+    iterator -> node = iterator -> node != NULL ? iterator -> node -> next : iterator -> list -> head;
+
+    return iterator -> node != NULL;
+}
+
+
+/**
+ * Moves the iterator to the previous element, or off the list if it was on the first element.
+ *
+ * @param       iterator pointer to the iterator to move.
+ *
+ * @return      true if the iterator is on an element, false if it went off the list.
+ */
+bool listIteratorPrev(struct ListIterator * const iterator) {
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+
+    iterator -> node = iterator -> node != NULL ? iterator -> node -> prev : iterator -> list -> tail;
+
+    return iterator -> node != NULL;
+}
+
+
+/**
+ * Gets the element the iterator is on.
+ *
+ * @param       iterator pointer to the iterator, which must be on an element.
+ *
+ * @return      the element the iterator is on.
+ */
+void * listIteratorGet(struct ListIterator const * const iterator) {
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+    alt_assert(iterator -> node != NULL, "The iterator is off the list.");
+
+    return iterator -> node -> element;
+}
+
+
+/**
+ * Replaces the element the iterator is on.
+ *
+ * @param       iterator pointer to the iterator, which must be on an element.
+ * @param       element  the new element.
+ */
+void listIteratorSet(struct ListIterator const * const iterator, void * element) {
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+    alt_assert(iterator -> node != NULL, "The iterator is off the list.");
+
+    iterator -> node -> element = element;
+
+    return;
+}
+
+
+/**
+ * Inserts the element before the one the iterator is on, or at the back of the list if the iterator is off the list.
+ * The iterator stays where it is.
+ *
+ * @param       iterator pointer to the iterator to insert at.
+ * @param       element  the element to insert.
+ */
+void listIteratorInsertBefore(struct ListIterator const * const iterator, void * element) {
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+
+    struct List * const list = iterator -> list;
+    struct ListNode * next_node = iterator -> node;
+    struct ListNode * prev_node = next_node != NULL ? next_node -> prev : list -> tail;
+
+    linkNode(list, prev_node, next_node, createListNode(list, element));
+
+    // We don't know if the new node went before the current node of the list, so the list starts over from its head
+    listResetCurrent(list);
+
+    return;
+}
+
+
+/**
+ * Inserts the element after the one the iterator is on, or at the front of the list if the iterator is off the list.
+ * The iterator stays where it is.
+ *
+ * @param       iterator pointer to the iterator to insert at.
+ * @param       element  the element to insert.
+ */
+void listIteratorInsertAfter(struct ListIterator const * const iterator, void * element) {
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+
+    struct List * const list = iterator -> list;
+    struct ListNode * prev_node = iterator -> node;
+    struct ListNode * next_node = prev_node != NULL ? prev_node -> next : list -> head;
+
+    linkNode(list, prev_node, next_node, createListNode(list, element));
+    listResetCurrent(list);
+
+    return;
+}
+
+
+/**
+ * Removes the element the iterator is on, moving the iterator back to the previous element (or off the list).
+ * So the next call to listIteratorNext goes to the element that followed the removed one, which makes filtering a list:
+ *
+ *     struct ListIterator iterator = listIterator(list);
+ *     while (listIteratorNext(&iterator)) {
+ *         if (keep(listIteratorGet(&iterator)) == false)
+ *             listIteratorErase(&iterator);
+ *     }
+ *
+ * @param       iterator pointer to the iterator, which must be on an element.
+ *
+ * @return      the removed element.
+ */
+void * listIteratorErase(struct ListIterator * const iterator) {
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+    alt_assert(iterator -> node != NULL, "The iterator is off the list.");
+
+    struct List * const list = iterator -> list;
+    struct ListNode * old_node = iterator -> node;
+
+    iterator -> node = old_node -> prev;
+    unlinkNode(list, old_node);
+    listResetCurrent(list);
+
+    void * element = old_node -> element;
+    deleteListNode(list, old_node, NULL);
+
+    return element;
+}
+
+
 /**
  * Resets the current node and index to the beginning of the list.
  *
@@ -352,7 +814,8 @@ void listInsert(struct List * const list, unsigned index, void * element) {
 void listResetCurrent(struct List * const list) {
     alt_assert(list != NULL, "The parameter <list> cannot be NULL.");
 
-    list -> current_node = list -> head;
+    list -> current.node = list -> head;
+    list -> current_block = list -> head_block;
     list -> current_index = 0;
 
     return;
@@ -369,8 +832,118 @@ static bool _listCollectionAtEnd(struct Collection const * const collection, uns
 }
 
 
-static void * createListNode(void * element) {
-    struct ListNode * node = malloc(sizeof *node);
+// Iterators follow the links directly, so unlike get they don't disturb the current node
+static bool _listCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator) {
+    alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+
+    struct List const * const list = (struct List const * const) collection;
+
+    iterator -> collection = collection;
+    iterator -> position = list -> head;
+    iterator -> index = 0;
+
+    return iterator -> position != NULL;
+}
+
+static bool _listCollectionNext(struct CIterator * const iterator) {
+    struct ListNode const * const node = iterator -> position;
+
+    iterator -> position = node -> next;
+    iterator -> index++;
+
+    return iterator -> position != NULL;
+}
+
+static void * _listCollectionDeref(struct CIterator const * const iterator) {
+    struct ListNode const * const node = iterator -> position;
+
+    return node -> element;
+}
+
+
+// Walks the current iterator of the list to the given index, one node at a time
+static void moveCurrentNode(struct List * const list, unsigned index) {
+    bool move_right = (index > list -> current_index) ? true : false;
+    while (list -> current_index != index) {
+        if (move_right)
+            listIteratorNext(&list -> current);
+        else
+            listIteratorPrev(&list -> current);
+        list -> current_index = move_right ? list -> current_index + 1 : list -> current_index - 1;
+    }
+}
+
+// Merges two sorted chains of nodes following their next links only, taking from the left one first on ties
+static struct ListNode * mergeNodes(struct ListNode * left, struct ListNode * right, CComparator compare) {
+    struct ListNode head = {.next = NULL};
+    struct ListNode * tail = &head;
+
+    while (left != NULL && right != NULL) {
+        if (compare(right -> element, left -> element) < 0) {
+            tail -> next = right;
+            right = right -> next;
+        }
+        else {
+            tail -> next = left;
+            left = left -> next;
+        }
+        tail = tail -> next;
+    }
+
+    tail -> next = left != NULL ? left : right;
+
+    return head.next;
+}
+
+// Makes the chain of nodes starting at head the content of the list, restoring the prev links along the way
+static void relinkNodes(struct List * const list, struct ListNode * head) {
+    struct ListNode * prev = NULL;
+    for (struct ListNode * node = head; node != NULL; node = node -> next) {
+        node -> prev = prev;
+        prev = node;
+    }
+
+    list -> head = head;
+    list -> tail = prev;
+    listResetCurrent(list);
+}
+
+// Links the node between two neighbours, either of which is NULL at the ends of the list
+static void linkNode(struct List * const list, struct ListNode * prev_node, struct ListNode * next_node, struct ListNode * node) {
+    node -> prev = prev_node;
+    node -> next = next_node;
+
+    if (prev_node != NULL)
+        prev_node -> next = node;
+    else
+        list -> head = node;
+
+    if (next_node != NULL)
+        next_node -> prev = node;
+    else
+        list -> tail = node;
+
+    list -> size++;
+}
+
+// Takes the node out of the list, leaving its own links untouched
+static void unlinkNode(struct List * const list, struct ListNode * node) {
+    if (node -> prev != NULL)
+        node -> prev -> next = node -> next;
+    else
+        list -> head = node -> next;
+
+    if (node -> next != NULL)
+        node -> next -> prev = node -> prev;
+    else
+        list -> tail = node -> prev;
+
+    list -> size--;
+}
+
+static void * createListNode(struct List * const list, void * element) {
+    struct ListNode * node = list -> pool != NULL ? listNodePoolAcquire(list -> pool) : malloc(sizeof *node);
     if (node == NULL)
         return NULL;
     
@@ -381,9 +954,12 @@ static void * createListNode(void * element) {
     return node;
 }
 
-static void deleteListNode(struct ListNode * node, CDeleter deleter) {
+static void deleteListNode(struct List * const list, struct ListNode * node, CDeleter deleter) {
     if (deleter != NULL)
         deleter(node -> element);
     
-    free(node);
+    if (list -> pool != NULL)
+        listNodePoolRelease(list -> pool, node);
+    else
+        free(node);
 }
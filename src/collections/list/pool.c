@@ -0,0 +1,105 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "list.h"
+#include "pool.h"
+
+unsigned list_pool_slab_size = 256;
+
+
+/**
+ * Initializes a pool of list nodes that can be shared by several lists.
+ *
+ * @param       slab_size the number of nodes in each slab, or zero to use list_pool_slab_size.
+ *
+ * @return      the newly created pool.
+ */
+struct ListNodePool * newListNodePool(unsigned slab_size) {
+    struct ListNodePool * pool = malloc(sizeof *pool);
+    if (pool == NULL)
+        return NULL;
+
+    pool -> slabs = NULL;
+    pool -> free_nodes = NULL;
+    pool -> slab_size = slab_size > 0 ? slab_size : list_pool_slab_size;
+    // There is no slab yet, so we pretend the current one is exhausted
+    pool -> slab_used = pool -> slab_size;
+    pool -> users = 0;
+
+    return pool;
+}
+
+
+/**
+ * Frees the memory occupied by the pool. All lists using the pool must have been deleted first.
+ *
+ * @param       pool pointer to memory occupied by the pool.
+ */
+void deleteListNodePool(struct ListNodePool ** const pool) {
+    if (pool == NULL)
+        return;
+
+    if (* pool == NULL)
+        return;
+
+    alt_assert((* pool) -> users == 0, "The pool is still used by a list.");
+
+    struct ListNodeSlab * slab = (* pool) -> slabs;
+    while (slab != NULL) {
+        struct ListNodeSlab * next = slab -> next;
+        free(slab);
+        slab = next;
+    }
+
+    free(* pool);
+    * pool = NULL;
+}
+
+
+struct ListNode * listNodePoolAcquire(struct ListNodePool * const pool) {
+    // Released nodes are reused first since they are likely still in cache
+    if (pool -> free_nodes != NULL) {
+        struct ListNode * node = pool -> free_nodes;
+        pool -> free_nodes = node -> next;
+        return node;
+    }
+
+    // Otherwise we hand out the next untouched node of the newest slab, so nodes pushed one after the other end up side by side
+    if (pool -> slab_used == pool -> slab_size) {
+        struct ListNodeSlab * slab = malloc(sizeof *slab + pool -> slab_size * sizeof *slab -> nodes);
+        if (slab == NULL)
+            return NULL;
+
+        slab -> next = pool -> slabs;
+        pool -> slabs = slab;
+        pool -> slab_used = 0;
+    }
+
+    return &pool -> slabs -> nodes[pool -> slab_used++];
+}
+
+
+void listNodePoolRelease(struct ListNodePool * const pool, struct ListNode * const node) {
+    node -> next = pool -> free_nodes;
+    pool -> free_nodes = node;
+}
@@ -0,0 +1,33 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_LIST_POOL_H
+#define CCOLLECTIONS_LIST_POOL_H
+
+#include "common.h"
+#include "list.h"
+
+/*
+ * Internal node allocation for lists created with newPooledList.
+ * None of these functions validate their arguments: list.c does that before calling them.
+ */
+
+struct ListNode * listNodePoolAcquire(struct ListNodePool * const pool);
+
+void listNodePoolRelease(struct ListNodePool * const pool, struct ListNode * const node);
+
+#endif
@@ -0,0 +1,330 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "list.h"
+#include "unrolled.h"
+
+/*
+ * An unrolled list is a doubly linked list of blocks, each holding up to LIST_BLOCK_CAPACITY elements.
+ *
+ * Pushes at the ends fill the end blocks before allocating new ones.
+ * An insert into a full block splits it in two halves, and a removal that leaves a block less than half full
+ * merges it with a neighbour when their elements fit in one block. So blocks stay reasonably full
+ * and moving elements within a block never costs more than LIST_BLOCK_CAPACITY pointer copies.
+ *
+ * The current block plays the role of the current node of linked lists:
+ * positional operations start from it, and current_index is the index of its first element.
+ */
+
+static struct ListBlock * createListBlock(void);
+static void linkListBlockAfter(struct List * const list, struct ListBlock * const after, struct ListBlock * const block);
+static void unlinkListBlock(struct List * const list, struct ListBlock * const block);
+
+
+void unrolledListDestroy(struct List * const list, CDeleter deleter) {
+    struct ListBlock * block = list -> head_block;
+    while (block != NULL) {
+        struct ListBlock * next = block -> next;
+        if (deleter != NULL) {
+            for (unsigned i = 0; i < block -> count; i++)
+                deleter(block -> elements[i]);
+        }
+
+        free(block);
+        block = next;
+    }
+
+    list -> head_block = NULL;
+    list -> tail_block = NULL;
+    list -> current_block = NULL;
+}
+
+
+void unrolledListPushBack(struct List * const list, void * element) {
+    struct ListBlock * tail = list -> tail_block;
+    if (tail == NULL || tail -> count == LIST_BLOCK_CAPACITY) {
+        tail = createListBlock();
+        if (tail == NULL)
+            return;
+
+        linkListBlockAfter(list, list -> tail_block, tail);
+        if (list -> current_block == NULL) {
+            list -> current_block = tail;
+            list -> current_index = 0;
+        }
+    }
+
+    tail -> elements[tail -> count++] = element;
+    list -> size++;
+}
+
+
+void unrolledListPushFront(struct List * const list, void * element) {
+    struct ListBlock * head = list -> head_block;
+    if (head == NULL || head -> count == LIST_BLOCK_CAPACITY) {
+        head = createListBlock();
+        if (head == NULL)
+            return;
+
+        linkListBlockAfter(list, NULL, head);
+        if (list -> current_block == NULL) {
+            list -> current_block = head;
+            list -> current_index = 0;
+        }
+    }
+
+    // Every block after the head starts one position further to the right
+    if (list -> current_block != head)
+        list -> current_index++;
+
+    memmove(head -> elements + 1, head -> elements, head -> count * sizeof *head -> elements);
+    head -> elements[0] = element;
+    head -> count++;
+    list -> size++;
+}
+
+
+void * unrolledListPopBack(struct List * const list) {
+    struct ListBlock * tail = list -> tail_block;
+    void * element = tail -> elements[--tail -> count];
+    list -> size--;
+
+    if (tail -> count == 0) {
+        unlinkListBlock(list, tail);
+        if (list -> current_block == tail) {
+            list -> current_block = list -> head_block;
+            list -> current_index = 0;
+        }
+    }
+
+    return element;
+}
+
+
+void * unrolledListPopFront(struct List * const list) {
+    struct ListBlock * head = list -> head_block;
+    void * element = head -> elements[0];
+    head -> count--;
+    memmove(head -> elements, head -> elements + 1, head -> count * sizeof *head -> elements);
+    list -> size--;
+
+    if (list -> current_block != head)
+        list -> current_index--;
+
+    if (head -> count == 0) {
+        if (list -> current_block == head)
+            list -> current_block = head -> next;
+        unlinkListBlock(list, head);
+    }
+
+    return element;
+}
+
+
+void ** unrolledListSeek(struct List * const list, unsigned index) {
+    struct ListBlock * block = list -> current_block;
+    unsigned first = list -> current_index;
+
+    // We start from whichever of the current block and the ends of the list is closest
+    if (index < first && index < first - index) {
+        block = list -> head_block;
+        first = 0;
+    }
+    else if (index >= first + block -> count && list -> size - index < index - first) {
+        block = list -> tail_block;
+        first = list -> size - block -> count;
+    }
+
+    while (index < first) {
+        block = block -> prev;
+        first -= block -> count;
+    }
+
+    while (index >= first + block -> count) {
+        first += block -> count;
+        block = block -> next;
+    }
+
+    list -> current_block = block;
+    list -> current_index = first;
+
+    return &block -> elements[index - first];
+}
+
+
+void unrolledListInsert(struct List * const list, unsigned index, void * element) {
+    unrolledListSeek(list, index);
+
+    struct ListBlock * block = list -> current_block;
+    unsigned offset = index - list -> current_index;
+
+    // A full block gives its upper half to a new block right after it
+    if (block -> count == LIST_BLOCK_CAPACITY) {
+        struct ListBlock * sibling = createListBlock();
+        if (sibling == NULL)
+            return;
+
+        unsigned half = LIST_BLOCK_CAPACITY / 2;
+        sibling -> count = LIST_BLOCK_CAPACITY - half;
+        memcpy(sibling -> elements, block -> elements + half, sibling -> count * sizeof *block -> elements);
+        block -> count = half;
+        linkListBlockAfter(list, block, sibling);
+
+        if (offset > half) {
+            list -> current_block = sibling;
+            list -> current_index += half;
+            offset -= half;
+            block = sibling;
+        }
+    }
+
+    memmove(block -> elements + offset + 1, block -> elements + offset, (block -> count - offset) * sizeof *block -> elements);
+    block -> elements[offset] = element;
+    block -> count++;
+    list -> size++;
+}
+
+
+void * unrolledListRemove(struct List * const list, unsigned index) {
+    unrolledListSeek(list, index);
+
+    struct ListBlock * block = list -> current_block;
+    unsigned offset = index - list -> current_index;
+    void * element = block -> elements[offset];
+
+    block -> count--;
+    memmove(block -> elements + offset, block -> elements + offset + 1, (block -> count - offset) * sizeof *block -> elements);
+    list -> size--;
+
+    if (block -> count == 0) {
+        // The next block now starts where this one did
+        if (block -> next != NULL) {
+            list -> current_block = block -> next;
+        }
+        else if (block -> prev != NULL) {
+            list -> current_block = block -> prev;
+            list -> current_index -= block -> prev -> count;
+        }
+        else {
+            list -> current_block = NULL;
+            list -> current_index = 0;
+        }
+
+        unlinkListBlock(list, block);
+    }
+    else if (block -> count < LIST_BLOCK_CAPACITY / 2) {
+        struct ListBlock * next = block -> next;
+        struct ListBlock * prev = block -> prev;
+
+        if (next != NULL && block -> count + next -> count <= LIST_BLOCK_CAPACITY) {
+            memcpy(block -> elements + block -> count, next -> elements, next -> count * sizeof *next -> elements);
+            block -> count += next -> count;
+            unlinkListBlock(list, next);
+        }
+        else if (prev != NULL && prev -> count + block -> count <= LIST_BLOCK_CAPACITY) {
+            memcpy(prev -> elements + prev -> count, block -> elements, block -> count * sizeof *block -> elements);
+            list -> current_block = prev;
+            list -> current_index -= prev -> count;
+            prev -> count += block -> count;
+            unlinkListBlock(list, block);
+        }
+    }
+
+    return element;
+}
+
+
+bool unrolledListBegin(struct Collection const * const collection, struct CIterator * const iterator) {
+    alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+
+    struct List const * const list = (struct List const * const) collection;
+
+    iterator -> collection = collection;
+    iterator -> position = list -> head_block;
+    iterator -> index = 0;
+
+    return iterator -> position != NULL;
+}
+
+bool unrolledListNext(struct CIterator * const iterator) {
+    struct ListBlock const * const block = iterator -> position;
+
+    if (++iterator -> index < block -> count)
+        return true;
+
+    iterator -> position = block -> next;
+    iterator -> index = 0;
+
+    return iterator -> position != NULL;
+}
+
+void * unrolledListDeref(struct CIterator const * const iterator) {
+    struct ListBlock const * const block = iterator -> position;
+
+    return block -> elements[iterator -> index];
+}
+
+
+static struct ListBlock * createListBlock(void) {
+    struct ListBlock * block = malloc(sizeof *block);
+    if (block == NULL)
+        return NULL;
+
+    block -> prev = NULL;
+    block -> next = NULL;
+    block -> count = 0;
+
+    return block;
+}
+
+// Links the block after the given one, or at the front of the list if that one is NULL
+static void linkListBlockAfter(struct List * const list, struct ListBlock * const after, struct ListBlock * const block) {
+    block -> prev = after;
+    block -> next = after != NULL ? after -> next : list -> head_block;
+
+    if (block -> next != NULL)
+        block -> next -> prev = block;
+    else
+        list -> tail_block = block;
+
+    if (after != NULL)
+        after -> next = block;
+    else
+        list -> head_block = block;
+}
+
+static void unlinkListBlock(struct List * const list, struct ListBlock * const block) {
+    if (block -> prev != NULL)
+        block -> prev -> next = block -> next;
+    else
+        list -> head_block = block -> next;
+
+    if (block -> next != NULL)
+        block -> next -> prev = block -> prev;
+    else
+        list -> tail_block = block -> prev;
+
+    free(block);
+}
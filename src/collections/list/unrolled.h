@@ -0,0 +1,55 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_LIST_UNROLLED_H
+#define CCOLLECTIONS_LIST_UNROLLED_H
+
+#include <stdbool.h>
+
+#include "common.h"
+#include "list.h"
+
+/*
+ * Internal engine backing lists created with newUnrolledList.
+ * None of these functions validate their arguments: list.c does that before dispatching here.
+ */
+
+void unrolledListDestroy(struct List * const list, CDeleter deleter);
+
+void unrolledListPushBack(struct List * const list, void * element);
+
+void unrolledListPushFront(struct List * const list, void * element);
+
+void * unrolledListPopBack(struct List * const list);
+
+void * unrolledListPopFront(struct List * const list);
+
+// Moves the current block to the one holding the element at the given index and returns the slot of that element
+void ** unrolledListSeek(struct List * const list, unsigned index);
+
+void unrolledListInsert(struct List * const list, unsigned index, void * element);
+
+void * unrolledListRemove(struct List * const list, unsigned index);
+
+// Iterators hold the block they are on as their position and the offset in that block as their index
+bool unrolledListBegin(struct Collection const * const collection, struct CIterator * const iterator);
+
+bool unrolledListNext(struct CIterator * const iterator);
+
+void * unrolledListDeref(struct CIterator const * const iterator);
+
+#endif
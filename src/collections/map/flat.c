@@ -0,0 +1,279 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "common.h"
+#include "map.h"
+#include "flat.h"
+
+/*
+ * This is an open-addressing table modelled after Abseil's SwissTable.
+ *
+ * Slots are split into groups of 16 and each slot has a matching control byte:
+ * - a full slot stores the low 7 bits of the hash (so the byte is never negative),
+ * - an empty slot stores CONTROL_EMPTY,
+ * - a deleted slot (tombstone) stores CONTROL_DELETED.
+ *
+ * A probe loads the 16 control bytes of a group at once and compares them against the 7-bit tag,
+ * so in the common case only the matching slot is ever touched.
+ * Groups are visited in triangular order which, with a power of two number of groups, reaches all of them.
+ *
+ * In this layout, map -> buckets_count is the number of control bytes that are not empty (full or deleted).
+ * That's what bounds the length of probe sequences so that's what we use to decide when to grow.
+ */
+
+#define GROUP_WIDTH 16
+#define CONTROL_EMPTY ((int8_t) -128)
+#define CONTROL_DELETED ((int8_t) -2)
+
+static unsigned normalizeCapacity(unsigned capacity);
+static inline uint16_t groupMatch(int8_t const * const controls, int8_t tag);
+static inline uint16_t groupMatchEmpty(int8_t const * const controls);
+static inline uint16_t groupMatchEmptyOrDeleted(int8_t const * const controls);
+
+static inline int8_t hashTag(uint64_t hash) {
+    return (int8_t) (hash & 0x7f);
+}
+
+static inline unsigned hashGroup(uint64_t hash) {
+    return (unsigned) (hash >> 7);
+}
+
+
+bool flatHashMapInit(struct HashMap * const map, unsigned capacity) {
+    capacity = normalizeCapacity(capacity);
+
+    int8_t * controls = malloc(capacity * sizeof *controls);
+    if (controls == NULL)
+        return false;
+
+    struct HashMapSlot * slots = malloc(capacity * sizeof *slots);
+    if (slots == NULL) {
+        free(controls);
+        return false;
+    }
+
+    memset(controls, CONTROL_EMPTY, capacity * sizeof *controls);
+
+    map -> controls = controls;
+    map -> slots = slots;
+    map -> capacity = capacity;
+    map -> buckets_count = 0;
+
+    return true;
+}
+
+
+void flatHashMapDestroy(struct HashMap * const map, CDeleter deleter) {
+    if (deleter != NULL) {
+        for (unsigned i = 0; i < map -> capacity; i++) {
+            if (map -> controls[i] >= 0)
+                deleter(map -> slots[i].value);
+        }
+    }
+
+    free(map -> controls);
+    free(map -> slots);
+    map -> controls = NULL;
+    map -> slots = NULL;
+}
+
+
+bool flatHashMapResize(struct HashMap * const map, unsigned new_capacity) {
+    int8_t * old_controls = map -> controls;
+    struct HashMapSlot * old_slots = map -> slots;
+    unsigned old_capacity = map -> capacity;
+
+    // On failure the map is left untouched
+    if (flatHashMapInit(map, new_capacity) == false)
+        return false;
+
+    // We move the slots using the hash they carry, so keys are never hashed again
+    for (unsigned i = 0; i < old_capacity; i++) {
+        if (old_controls[i] < 0)
+            continue;
+
+        struct HashMapSlot * slot = flatHashMapInsert(map, old_slots[i].hash);
+        * slot = old_slots[i];
+    }
+
+    free(old_controls);
+    free(old_slots);
+
+    return true;
+}
+
+
+struct HashMapSlot * flatHashMapFind(struct HashMap const * const map, uint64_t hash, unsigned key_len, void const * key) {
+    unsigned groups_mask = map -> capacity / GROUP_WIDTH - 1;
+    unsigned group = hashGroup(hash) & groups_mask;
+    int8_t tag = hashTag(hash);
+
+    for (unsigned step = 1; step <= groups_mask + 1; step++) {
+        int8_t const * controls = map -> controls + group * GROUP_WIDTH;
+
+        uint16_t matches = groupMatch(controls, tag);
+        while (matches != 0) {
+            struct HashMapSlot * slot = &map -> slots[group * GROUP_WIDTH + __builtin_ctz(matches)];
+            if (slot -> hash == hash && (map -> equals == NULL ||
+                (slot -> key_len == key_len && map -> equals(slot -> key, key, key_len))))
+                return slot;
+
+            matches &= matches - 1;
+        }
+
+        // An empty slot in the group means the key would have been placed here, so we stop looking
+        if (groupMatchEmpty(controls) != 0)
+            return NULL;
+
+        group = (group + step) & groups_mask;
+    }
+
+    return NULL;
+}
+
+
+struct HashMapSlot * flatHashMapInsert(struct HashMap * const map, uint64_t hash) {
+    // We keep at least one slot in eight empty so that probe sequences stay short and always terminate
+    if (map -> buckets_count + 1 > map -> capacity - map -> capacity / 8) {
+        // If most of the used control bytes are tombstones, we clean them up in place rather than grow
+        unsigned new_capacity = map -> size + 1 > map -> capacity / 2 ? map -> capacity * 2 : map -> capacity;
+        if (flatHashMapResize(map, new_capacity) == false)
+            return NULL;
+    }
+
+    unsigned groups_mask = map -> capacity / GROUP_WIDTH - 1;
+    unsigned group = hashGroup(hash) & groups_mask;
+
+    for (unsigned step = 1; ; step++) {
+        int8_t * controls = map -> controls + group * GROUP_WIDTH;
+
+        uint16_t available = groupMatchEmptyOrDeleted(controls);
+        if (available != 0) {
+            unsigned index = group * GROUP_WIDTH + __builtin_ctz(available);
+
+            // Reusing a tombstone doesn't change the number of used control bytes
+            if (map -> controls[index] == CONTROL_EMPTY)
+                map -> buckets_count++;
+
+            map -> controls[index] = hashTag(hash);
+            map -> slots[index].hash = hash;
+            return &map -> slots[index];
+        }
+
+        group = (group + step) & groups_mask;
+    }
+}
+
+
+void flatHashMapErase(struct HashMap * const map, struct HashMapSlot * const slot) {
+    unsigned index = slot - map -> slots;
+    int8_t const * controls = map -> controls + (index / GROUP_WIDTH) * GROUP_WIDTH;
+
+    // If the group still has an empty slot, probes already stop here so we can mark this one empty too
+    if (groupMatchEmpty(controls) != 0) {
+        map -> controls[index] = CONTROL_EMPTY;
+        map -> buckets_count--;
+    }
+    else {
+        map -> controls[index] = CONTROL_DELETED;
+    }
+}
+
+
+struct HashMapSlot * flatHashMapNext(struct HashMap const * const map, unsigned * const index) {
+    unsigned i = * index;
+
+    while (i < map -> capacity) {
+        unsigned group = i / GROUP_WIDTH;
+        // Full slots are the ones whose control byte is not negative, we drop those before our position
+        uint16_t full = ~groupMatchEmptyOrDeleted(map -> controls + group * GROUP_WIDTH);
+        full &= (uint16_t) (0xffff << (i % GROUP_WIDTH));
+
+        if (full != 0) {
+            unsigned found = group * GROUP_WIDTH + __builtin_ctz(full);
+            * index = found + 1;
+            return &map -> slots[found];
+        }
+
+        i = (group + 1) * GROUP_WIDTH;
+    }
+
+    * index = map -> capacity;
+    return NULL;
+}
+
+
+static unsigned normalizeCapacity(unsigned capacity) {
+    unsigned normalized = GROUP_WIDTH;
+    while (normalized < capacity)
+        normalized *= 2;
+
+    return normalized;
+}
+
+
+#ifdef __SSE2__
+
+static inline uint16_t groupMatch(int8_t const * const controls, int8_t tag) {
+    __m128i group = _mm_loadu_si128((__m128i const *) controls);
+    return (uint16_t) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), group));
+}
+
+static inline uint16_t groupMatchEmpty(int8_t const * const controls) {
+    return groupMatch(controls, CONTROL_EMPTY);
+}
+
+static inline uint16_t groupMatchEmptyOrDeleted(int8_t const * const controls) {
+    // Both special control bytes are negative while full ones are not, so the sign bits are all we need
+    __m128i group = _mm_loadu_si128((__m128i const *) controls);
+    return (uint16_t) _mm_movemask_epi8(group);
+}
+
+#else
+
+static inline uint16_t groupMatch(int8_t const * const controls, int8_t tag) {
+    uint16_t matches = 0;
+    for (unsigned i = 0; i < GROUP_WIDTH; i++)
+        matches |= (uint16_t) (controls[i] == tag) << i;
+
+    return matches;
+}
+
+static inline uint16_t groupMatchEmpty(int8_t const * const controls) {
+    return groupMatch(controls, CONTROL_EMPTY);
+}
+
+static inline uint16_t groupMatchEmptyOrDeleted(int8_t const * const controls) {
+    uint16_t matches = 0;
+    for (unsigned i = 0; i < GROUP_WIDTH; i++)
+        matches |= (uint16_t) (controls[i] < 0) << i;
+
+    return matches;
+}
+
+#endif
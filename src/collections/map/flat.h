@@ -0,0 +1,47 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CCOLLECTIONS_MAP_FLAT_H
+#define CCOLLECTIONS_MAP_FLAT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "map.h"
+
+/*
+ * Internal engine backing maps created with newFlatHashMap.
+ * None of these functions validate their arguments: map.c does that before dispatching here.
+ */
+
+bool flatHashMapInit(struct HashMap * const map, unsigned capacity);
+
+void flatHashMapDestroy(struct HashMap * const map, CDeleter deleter);
+
+bool flatHashMapResize(struct HashMap * const map, unsigned new_capacity);
+
+struct HashMapSlot * flatHashMapFind(struct HashMap const * const map, uint64_t hash, unsigned key_len, void const * key);
+
+struct HashMapSlot * flatHashMapInsert(struct HashMap * const map, uint64_t hash);
+
+void flatHashMapErase(struct HashMap * const map, struct HashMapSlot * const slot);
+
+// Returns the first full slot at or after the given index and moves the index past it
+struct HashMapSlot * flatHashMapNext(struct HashMap const * const map, unsigned * const index);
+
+#endif
@@ -24,17 +24,36 @@
 #include <stdio.h>
 
 #include "common.h"
-#include "siphash.h"
+#include "hash.h"
 #include "map.h"
+#include "flat.h"
 
 static void * _hashMapCollectionGet(struct Collection * const collection, unsigned index);
 static bool _hashMapCollectionAtEnd(struct Collection const * const collection, unsigned index);
+static bool _hashMapCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator);
+static bool _hashMapCollectionNext(struct CIterator * const iterator);
+static void * _hashMapCollectionDeref(struct CIterator const * const iterator);
 
 static void * createItem(unsigned key_len, void const * key, void * value,
     uint64_t hash, struct HashMapItem * prev, struct HashMapItem * next);
 static void deleteItem(struct HashMapItem * item, CDeleter deleter);
+static void deleteItems(struct HashMapItem ** items, unsigned capacity, CDeleter deleter);
+static struct HashMapItem * findItem(struct HashMap const * const map, struct HashMapItem * const * items, unsigned capacity,
+    uint64_t hash, unsigned key_len, void const * key);
+static bool unlinkItem(struct HashMapItem ** bucket, struct HashMapItem * item);
+static inline bool keysMatch(struct HashMap const * const map, struct HashMapItem const * item,
+    uint64_t hash, unsigned key_len, void const * key);
+static unsigned moveChain(struct HashMapItem * item, struct HashMapItem ** items, unsigned capacity);
+
+static bool startMigration(struct HashMap * const map, unsigned new_capacity);
+static void migrateHashMap(struct HashMap * const map, unsigned steps);
+static inline void forgetCursor(struct HashMap * const map);
 
 float hash_map_growth_factor = 1.75;
+unsigned hash_map_migration_steps = 8;
+
+// How many buckets ahead we prefetch when redistributing items
+#define PREFETCH_DISTANCE 4
 
 
 /**
@@ -59,6 +78,10 @@ struct HashMap * newHashMap(unsigned initial_capacity) {
         .get = _hashMapCollectionGet,
         .set = NULL,
         .atEnd = _hashMapCollectionAtEnd,
+        .begin = _hashMapCollectionBegin,
+        .next = _hashMapCollectionNext,
+        .deref = _hashMapCollectionDeref,
+        .span = NULL,
     };
 
     map -> collection = collection;
@@ -68,11 +91,102 @@ struct HashMap * newHashMap(unsigned initial_capacity) {
     map -> capacity = initial_capacity;
     map -> size = 0;
     map -> buckets_count = 0;
+    map -> hasher = sipHash24;
+    map -> equals = NULL;
+    map -> layout = HASH_MAP_CHAINED;
+    map -> incremental = false;
+    map -> controls = NULL;
+    map -> slots = NULL;
+    map -> old_items = NULL;
+    map -> old_capacity = 0;
+    map -> migrated = 0;
+    map -> cursor = hashMapCursor(map);
+    map -> cursor_index = 0;
 
     return map;
 }
 
 
+/**
+ * Initializes a map that stores its entries in flat slot groups (open addressing) instead of chains.
+ *
+ * @return      the newly created map.
+ */
+struct HashMap * newFlatHashMap(unsigned initial_capacity) {
+    alt_assert(initial_capacity > 0, "Initial hash map capacity cannot be zero.");
+
+    struct HashMap * map = malloc(sizeof *map);
+    if (map == NULL)
+       return NULL;
+
+    if (flatHashMapInit(map, initial_capacity) == false) {
+        free(map);
+        return NULL;
+    }
+
+    struct Collection collection = {
+        .get = _hashMapCollectionGet,
+        .set = NULL,
+        .atEnd = _hashMapCollectionAtEnd,
+        .begin = _hashMapCollectionBegin,
+        .next = _hashMapCollectionNext,
+        .deref = _hashMapCollectionDeref,
+        .span = NULL,
+    };
+
+    map -> collection = collection;
+    // At the moment we fix the hash key but in the future we will randomize it
+    char hash_key[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0xa, 0xb, 0xc, 0xd, 0xe, 0xf};
+    memcpy(map -> hash_key, hash_key, sizeof(map -> hash_key));
+    map -> items = NULL;
+    map -> size = 0;
+    map -> hasher = sipHash24;
+    map -> equals = NULL;
+    map -> layout = HASH_MAP_FLAT;
+    map -> incremental = false;
+    map -> old_items = NULL;
+    map -> old_capacity = 0;
+    map -> migrated = 0;
+    map -> cursor = hashMapCursor(map);
+    map -> cursor_index = 0;
+
+    return map;
+}
+
+
+/**
+ * Initializes a chained map that spreads the cost of growing over subsequent operations.
+ *
+ * @return      the newly created map.
+ */
+struct HashMap * newIncrementalHashMap(unsigned initial_capacity) {
+    struct HashMap * map = newHashMap(initial_capacity);
+    if (map == NULL)
+        return NULL;
+
+    map -> incremental = true;
+
+    return map;
+}
+
+
+/**
+ * Replaces the hash function of the map and optionally sets the function used to compare keys.
+ *
+ * @param       map     pointer to the map to configure, it must be empty.
+ * @param       hasher  the hash function to use.
+ * @param       equals  the function to compare keys with, or NULL to consider keys with the same hash identical.
+ */
+void hashMapUseHasher(struct HashMap * const map, CHasher hasher, CEquals equals) {
+    alt_assert(map != NULL, "The parameter <map> cannot be NULL.");
+    alt_assert(hasher != NULL, "The parameter <hasher> cannot be NULL.");
+    alt_assert(map -> size == 0, "The hash function of a non-empty hash map cannot be changed.");
+
+    map -> hasher = hasher;
+    map -> equals = equals;
+}
+
+
 /**
  * Frees the memory occupied by the map.
  *
@@ -84,21 +198,22 @@ void deleteHashMap(struct HashMap ** const map, CDeleter deleter) {
 
     if (* map == NULL)
         return;
-    
-    for (unsigned i = 0; i < (* map) -> capacity; i++) {
-        struct HashMapItem * item = (* map) -> items[i];
-        if (item == NULL)
-            continue;
-
-        struct HashMapItem * next = NULL;
-        do {
-            next = item -> next;
-            deleteItem(item, deleter);
-            item = next;
-        } while (next != NULL);
+
+    if ((* map) -> layout == HASH_MAP_FLAT) {
+        flatHashMapDestroy(* map, deleter);
+        free(* map);
+        * map = NULL;
+        return;
     }
 
+    deleteItems((* map) -> items, (* map) -> capacity, deleter);
     free((* map) -> items);
+
+    if ((* map) -> old_items != NULL) {
+        deleteItems((* map) -> old_items, (* map) -> old_capacity, deleter);
+        free((* map) -> old_items);
+    }
+
     free(* map);
     * map = NULL;
 }
@@ -116,34 +231,33 @@ struct HashMap * resizeHashMap(struct HashMap * const map, unsigned new_capacity
     alt_assert(map != NULL, "The parameter <map> cannot be NULL.");
     alt_assert(new_capacity > map -> capacity, "The new capacity cannot be less or equal to the existing capacity.");
 
+    forgetCursor(map);
+
+    if (map -> layout == HASH_MAP_FLAT)
+        return flatHashMapResize(map, new_capacity) ? map : NULL;
+
+    // If the map is still growing incrementally, we finish that first
+    if (map -> old_items != NULL)
+        migrateHashMap(map, map -> old_capacity);
+
     struct HashMapItem ** items = calloc(new_capacity, sizeof *items);
     if (items == NULL)
         return NULL;
 
+    // Items carry their hash, so growing costs O(entries) no matter how long the keys are
+    unsigned buckets_count = 0;
     for (unsigned i = 0; i < map -> capacity; i++) {
-        struct HashMapItem * item = map -> items[i];
-        if (item == NULL)
-            continue;
-        
-        struct HashMapItem * next_item = NULL;
-        do {
-            next_item = item -> next;
-
-            uint64_t hash = siphash24((char const *) item -> key, item -> key_len, map -> hash_key);
-            uint64_t hash_key = hash % new_capacity;
-            item -> hash = hash;
-            if (items[hash_key] != NULL)
-                items[hash_key] -> prev = item;
-            item -> next = items[hash_key];
-            items[hash_key] = item;
-
-            item = next_item;
-        } while (next_item != NULL);
+        // The chains of the buckets a little further ahead are fetched while we move the current one
+        if (i + PREFETCH_DISTANCE < map -> capacity)
+            __builtin_prefetch(map -> items[i + PREFETCH_DISTANCE]);
+
+        buckets_count += moveChain(map -> items[i], items, new_capacity);
     }
 
     free(map -> items);
     map -> items = items;
     map -> capacity = new_capacity;
+    map -> buckets_count = buckets_count;
 
     return map;
 }
@@ -189,21 +303,47 @@ bool hashMapInsert(struct HashMap * const map, unsigned key_len, void const * ke
     alt_assert(map != NULL, "The parameter <map> cannot be NULL.");
     alt_assert(key_len > 0, "The key (via key_len) cannot be zero.");
 
+    forgetCursor(map);
+
+    if (map -> layout == HASH_MAP_FLAT) {
+        uint64_t hash = map -> hasher(key, key_len, map -> hash_key);
+        alt_assert(flatHashMapFind(map, hash, key_len, key) == NULL, "An element with the given key already exists in the hash map.");
+
+        struct HashMapSlot * slot = flatHashMapInsert(map, hash);
+        if (slot == NULL)
+            return false;
+
+        slot -> key = key;
+        slot -> value = value;
+        slot -> key_len = key_len;
+        map -> size++;
+
+        return true;
+    }
+
     // If the load factor exceeds 0.69, we resize the map
+    // Unless we are already growing incrementally, in which case we do some more of that
     float load_factor = (float)map -> buckets_count / (float)map -> capacity;
+    if (map -> old_items != NULL) {
+        migrateHashMap(map, hash_map_migration_steps);
+    }
     // Maximum load factor pulled from: https://stackoverflow.com/a/31401836
-    if (load_factor > 0.693) {
+    else if (load_factor > 0.693) {
         int new_capacity = map -> capacity * hash_map_growth_factor;
-        if (resizeHashMap(map, new_capacity) == NULL)
+        if (map -> incremental) {
+            if (startMigration(map, new_capacity) == false)
+                return false;
+        }
+        else if (resizeHashMap(map, new_capacity) == NULL)
             return false;
     }
 
-    uint64_t hash = siphash24((char const *) key, key_len, map -> hash_key);
+    uint64_t hash = map -> hasher(key, key_len, map -> hash_key);
     uint64_t hash_key = hash % map -> capacity;
 
     struct HashMapItem * existing_item = map -> items[hash_key];
     if (existing_item != NULL)
-        alt_assert(existing_item -> hash != hash, "An element with the given key already exists in the hash map.");
+        alt_assert(keysMatch(map, existing_item, hash, key_len, key) == false, "An element with the given key already exists in the hash map.");
 
     // Update load_factor independent variable buckets_count
     if (existing_item == NULL)
@@ -231,24 +371,17 @@ void * hashMapGet(struct HashMap const * const map, unsigned key_len, void const
     alt_assert(map != NULL, "The parameter <map> cannot be NULL.");
     alt_assert(map -> size > 0, "The hash map is empty, cannot get elements.");
 
-    uint64_t hash = siphash24((char const *) key, key_len, map -> hash_key);
-    uint64_t hash_key = hash % map -> capacity;
-    struct HashMapItem * item = map -> items[hash_key];
-
-    if (item == NULL)
-        return NULL;
-
-    bool found = false;
-    while (item != NULL) {
-        if (item -> hash == hash) {
-            found = true;
-            break;
-        }
-
-        item = item -> next;
+    uint64_t hash = map -> hasher(key, key_len, map -> hash_key);
+    if (map -> layout == HASH_MAP_FLAT) {
+        struct HashMapSlot * slot = flatHashMapFind(map, hash, key_len, key);
+        return slot != NULL ? slot -> value : NULL;
     }
 
-    return found ? item -> value : NULL;
+    struct HashMapItem * item = findItem(map, map -> items, map -> capacity, hash, key_len, key);
+    if (item == NULL && map -> old_items != NULL)
+        item = findItem(map, map -> old_items, map -> old_capacity, hash, key_len, key);
+
+    return item != NULL ? item -> value : NULL;
 }
 
 
@@ -266,35 +399,37 @@ void * hashMapSet(struct HashMap * const map, unsigned key_len, void const * key
     alt_assert(map != NULL, "The parameter <map> cannot be NULL.");
     alt_assert(key_len > 0, "The key (via key_len) cannot be zero.");
 
-    uint64_t hash = siphash24((char const *) key, key_len, map -> hash_key);
-    uint64_t hash_key = hash % map -> capacity;
+    uint64_t hash = map -> hasher(key, key_len, map -> hash_key);
+    if (map -> layout == HASH_MAP_FLAT) {
+        struct HashMapSlot * slot = flatHashMapFind(map, hash, key_len, key);
+        if (slot == NULL) {
+            hashMapInsert(map, key_len, key, value);
+            return NULL;
+        }
 
-    struct HashMapItem * existing_item = map -> items[hash_key];
+        void * old_value = slot -> value;
+        slot -> key = key;
+        slot -> key_len = key_len;
+        slot -> value = value;
+        return old_value;
+    }
+
+    struct HashMapItem * existing_item = findItem(map, map -> items, map -> capacity, hash, key_len, key);
+    if (existing_item == NULL && map -> old_items != NULL)
+        existing_item = findItem(map, map -> old_items, map -> old_capacity, hash, key_len, key);
+
+    // If we couldn't find an item with the exact hash, the key-value pair needs to be added
     if (existing_item == NULL) {
         hashMapInsert(map, key_len, key, value);
         return NULL;
     }
-    
-    do {
-        if (existing_item -> hash == hash) {
-            struct HashMapItem * new_item = createItem(
-                key_len, key, value, hash,
-                existing_item -> prev,  existing_item -> next
-            );
-            map -> items[hash_key] = new_item;
-
-            void * value = existing_item -> value;
-            deleteItem(existing_item, NULL);
-            return value;
-        }
 
-        existing_item = existing_item -> next;
-    } while(existing_item != NULL);
+    void * old_value = existing_item -> value;
+    existing_item -> key = key;
+    existing_item -> key_len = key_len;
+    existing_item -> value = value;
 
-    // If we reach here, then we couldn't find an item with the exact has but the approximate one
-    // In this case, the key-value pair needs to be added to the existing items bucket
-    hashMapInsert(map, key_len, key, value);
-    return NULL;
+    return old_value;
 }
 
 
@@ -310,73 +445,146 @@ bool hashMapDelete(struct HashMap * const map, unsigned key_len, void const * ke
     alt_assert(map != NULL, "The parameter <map> cannot be NULL.");
     alt_assert(key_len > 0, "The key (via key_len) cannot be zero.");
 
-    uint64_t hash = siphash24((char const *) key, key_len, map -> hash_key);
-    uint64_t hash_key = hash % map -> capacity;
+    forgetCursor(map);
+
+    uint64_t hash = map -> hasher(key, key_len, map -> hash_key);
+    if (map -> layout == HASH_MAP_FLAT) {
+        struct HashMapSlot * slot = flatHashMapFind(map, hash, key_len, key);
+        if (slot == NULL)
+            return false;
+
+        if (deleter != NULL)
+            deleter(slot -> value);
+        flatHashMapErase(map, slot);
+
+        map -> size--;
+        return true;
+    }
+
+    if (map -> old_items != NULL)
+        migrateHashMap(map, hash_map_migration_steps);
+
+    struct HashMapItem * existing_item = findItem(map, map -> items, map -> capacity, hash, key_len, key);
+    if (existing_item != NULL) {
+        // Only buckets of the current array count towards the load factor
+        if (unlinkItem(&map -> items[hash % map -> capacity], existing_item))
+            map -> buckets_count--;
+    }
+    else if (map -> old_items != NULL) {
+        existing_item = findItem(map, map -> old_items, map -> old_capacity, hash, key_len, key);
+        if (existing_item != NULL)
+            unlinkItem(&map -> old_items[hash % map -> old_capacity], existing_item);
+    }
 
-    struct HashMapItem * existing_item = map -> items[hash_key];
     if (existing_item == NULL)
         return false;
-    
-    do {
-        if (existing_item -> hash == hash) {
-            struct HashMapItem * prev = existing_item -> prev;
-            struct HashMapItem * next = existing_item -> next;
-            if (prev != NULL) {
-                prev -> next = next;
-                if (prev -> prev == NULL)
-                    map -> items[hash_key] = prev;
-            }
-
-            if (next != NULL) {
-                next -> prev = prev;
-                if (prev == NULL)
-                    map -> items[hash_key] = next;
-            }
-
-            if (prev == NULL && next == NULL) {
-                map -> items[hash_key] = NULL;
-                map -> buckets_count--;
-            }
-
-            deleteItem(existing_item, deleter);
-
-            map -> size--;
-            return true;
+
+    deleteItem(existing_item, deleter);
+    map -> size--;
+
+    return true;
+}
+
+
+/**
+ * Creates a cursor placed before the first entry of the map.
+ *
+ * @param       map pointer to the map to walk.
+ *
+ * @return      the new cursor.
+ */
+struct HashMapCursor hashMapCursor(struct HashMap const * const map) {
+    alt_assert(map != NULL, "The parameter <map> cannot be NULL.");
+
+    struct HashMapCursor cursor = {
+        .key = NULL,
+        .value = NULL,
+        .key_len = 0,
+        .entry = NULL,
+        .bucket = 0,
+    };
+
+    return cursor;
+}
+
+
+/**
+ * Moves the cursor to the next entry of the map.
+ *
+ * @param       map     pointer to the map the cursor was created from.
+ * @param       cursor  pointer to the cursor to move.
+ *
+ * @return      true if the cursor is on an entry, false if all entries were visited.
+ */
+bool hashMapCursorNext(struct HashMap const * const map, struct HashMapCursor * const cursor) {
+    alt_assert(map != NULL, "The parameter <map> cannot be NULL.");
+    alt_assert(cursor != NULL, "The parameter <cursor> cannot be NULL.");
+
+    if (map -> layout == HASH_MAP_FLAT) {
+        struct HashMapSlot * slot = flatHashMapNext(map, &cursor -> bucket);
+        cursor -> entry = slot;
+        if (slot == NULL)
+            return false;
+
+        cursor -> key = slot -> key;
+        cursor -> value = slot -> value;
+        cursor -> key_len = slot -> key_len;
+        return true;
+    }
+
+    struct HashMapItem * item = cursor -> entry;
+    if (item != NULL)
+        item = item -> next;
+
+    // Buckets past the capacity are those of the old array, of which only the ones not yet migrated hold items
+    while (item == NULL) {
+        unsigned bucket = cursor -> bucket;
+        if (bucket < map -> capacity) {
+            item = map -> items[bucket];
+        }
+        else if (map -> old_items != NULL && bucket - map -> capacity < map -> old_capacity) {
+            if (bucket - map -> capacity < map -> migrated)
+                bucket = map -> capacity + map -> migrated;
+            item = map -> old_items[bucket - map -> capacity];
+        }
+        else {
+            cursor -> entry = NULL;
+            return false;
         }
 
-        existing_item = existing_item -> next;
-    } while(existing_item != NULL);
+        cursor -> bucket = bucket + 1;
+    }
 
-    return false;
+    cursor -> entry = item;
+    cursor -> key = item -> key;
+    cursor -> value = item -> value;
+    cursor -> key_len = item -> key_len;
+
+    return true;
 }
 
 
 static void * _hashMapCollectionGet(struct Collection * const collection, unsigned index) {
     alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
 
-    struct HashMap const * const map = (struct HashMap const * const) collection;
+    struct HashMap * const map = (struct HashMap * const) collection;
 
     if (map -> size == 0)
         return NULL;
 
     alt_assert(index < map -> size, "The index is out of bounds.");
 
-    unsigned shadow_index = 0;
-    for (int i = 0; i < map -> capacity; i++) {
-        struct HashMapItem * item = map -> items[i];
-        if (item == NULL)
-            continue;
-
-        while (item != NULL) {
-            if (shadow_index == index)
-                return item;
-
-            shadow_index++;
-            item = item -> next;
-        }
+    // We resume from the entry reached by the previous call, so visiting entries in order is amortized O(1)
+    if (map -> cursor.entry == NULL || index < map -> cursor_index) {
+        map -> cursor = hashMapCursor(map);
+        hashMapCursorNext(map, &map -> cursor);
+        map -> cursor_index = 0;
     }
 
-    return NULL;
+    for (; map -> cursor_index < index; map -> cursor_index++)
+        hashMapCursorNext(map, &map -> cursor);
+
+    return map -> cursor.entry;
 }
 
 
@@ -389,6 +597,37 @@ static bool _hashMapCollectionAtEnd(struct Collection const * const collection,
 }
 
 
+// Iterators are cursors in disguise: the position is the entry the cursor is on and the index its next bucket
+static bool _hashMapCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator) {
+    alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+
+    iterator -> collection = collection;
+    iterator -> position = NULL;
+    iterator -> index = 0;
+
+    return _hashMapCollectionNext(iterator);
+}
+
+static bool _hashMapCollectionNext(struct CIterator * const iterator) {
+    struct HashMap const * const map = (struct HashMap const * const) iterator -> collection;
+
+    struct HashMapCursor cursor = hashMapCursor(map);
+    cursor.entry = iterator -> position;
+    cursor.bucket = iterator -> index;
+
+    bool found = hashMapCursorNext(map, &cursor);
+    iterator -> position = cursor.entry;
+    iterator -> index = cursor.bucket;
+
+    return found;
+}
+
+static void * _hashMapCollectionDeref(struct CIterator const * const iterator) {
+    return iterator -> position;
+}
+
+
 static void * createItem(
     unsigned key_len,
     void const * key,
@@ -417,3 +656,134 @@ static void deleteItem(struct HashMapItem * item, CDeleter deleter) {
 
     free(item);
 }
+
+static void deleteItems(struct HashMapItem ** items, unsigned capacity, CDeleter deleter) {
+    for (unsigned i = 0; i < capacity; i++) {
+        struct HashMapItem * item = items[i];
+        while (item != NULL) {
+            struct HashMapItem * next = item -> next;
+            deleteItem(item, deleter);
+            item = next;
+        }
+    }
+}
+
+static struct HashMapItem * findItem(
+    struct HashMap const * const map,
+    struct HashMapItem * const * items,
+    unsigned capacity,
+    uint64_t hash,
+    unsigned key_len,
+    void const * key
+) {
+    struct HashMapItem * item = items[hash % capacity];
+    while (item != NULL && keysMatch(map, item, hash, key_len, key) == false)
+        item = item -> next;
+
+    return item;
+}
+
+/*
+ * Without an equality function, two keys with the same 64-bit hash are considered identical.
+ * Otherwise the hash only serves as a quick filter before the keys themselves are compared.
+ */
+static inline bool keysMatch(struct HashMap const * const map, struct HashMapItem const * item,
+    uint64_t hash, unsigned key_len, void const * key) {
+    if (item -> hash != hash)
+        return false;
+
+    if (map -> equals == NULL)
+        return true;
+
+    return item -> key_len == key_len && map -> equals(item -> key, key, key_len);
+}
+
+/*
+ * Removes the item from the chain starting at the given bucket.
+ * Returns true if the bucket became empty.
+ */
+static bool unlinkItem(struct HashMapItem ** bucket, struct HashMapItem * item) {
+    if (item -> prev != NULL)
+        item -> prev -> next = item -> next;
+    else
+        * bucket = item -> next;
+
+    if (item -> next != NULL)
+        item -> next -> prev = item -> prev;
+
+    return * bucket == NULL;
+}
+
+
+/*
+ * Moves every item of the chain starting at the given item into the given bucket array, using their stored hash.
+ * Returns the number of buckets that went from empty to occupied.
+ */
+static unsigned moveChain(struct HashMapItem * item, struct HashMapItem ** items, unsigned capacity) {
+    unsigned buckets_count = 0;
+
+    while (item != NULL) {
+        // We read the link before relinking the item and start fetching the next node right away
+        struct HashMapItem * next = item -> next;
+        __builtin_prefetch(next);
+
+        struct HashMapItem ** bucket = &items[item -> hash % capacity];
+        if (* bucket == NULL)
+            buckets_count++;
+        else
+            (* bucket) -> prev = item;
+
+        item -> prev = NULL;
+        item -> next = * bucket;
+        * bucket = item;
+
+        item = next;
+    }
+
+    return buckets_count;
+}
+
+
+/*
+ * Incremental growth keeps the old bucket array around next to the new one.
+ * Every insert and delete then moves a few old buckets over (see hash_map_migration_steps),
+ * and lookups check the new array first then the old one until all buckets have moved.
+ */
+static bool startMigration(struct HashMap * const map, unsigned new_capacity) {
+    struct HashMapItem ** items = calloc(new_capacity, sizeof *items);
+    if (items == NULL)
+        return false;
+
+    map -> old_items = map -> items;
+    map -> old_capacity = map -> capacity;
+    map -> migrated = 0;
+    map -> items = items;
+    map -> capacity = new_capacity;
+    map -> buckets_count = 0;
+
+    return true;
+}
+
+static void migrateHashMap(struct HashMap * const map, unsigned steps) {
+    forgetCursor(map);
+
+    for (; steps > 0 && map -> migrated < map -> old_capacity; steps--, map -> migrated++) {
+        struct HashMapItem * item = map -> old_items[map -> migrated];
+        map -> old_items[map -> migrated] = NULL;
+
+        map -> buckets_count += moveChain(item, map -> items, map -> capacity);
+    }
+
+    if (map -> migrated == map -> old_capacity) {
+        free(map -> old_items);
+        map -> old_items = NULL;
+        map -> old_capacity = 0;
+        map -> migrated = 0;
+    }
+}
+
+
+// Entries may move or disappear, so the position remembered by the collection interface no longer holds
+static inline void forgetCursor(struct HashMap * const map) {
+    map -> cursor.entry = NULL;
+}
@@ -0,0 +1,391 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "vector.h"
+#include "minmaxheap.h"
+
+/*
+ * All sifts move a hole rather than swapping, as in heap.c.
+ * The code for min levels and max levels is shared: on max levels, comparisons are made with the arguments swapped,
+ * which is what the `sign` parameter does (1 on min levels, -1 on max levels).
+ */
+
+static struct MinMaxHeap * createMinMaxHeap(struct Vector * const vector, CComparator compare);
+static int levelSign(unsigned index);
+static unsigned maxIndex(struct MinMaxHeap const * const heap);
+static void * removeAt(struct MinMaxHeap * const heap, unsigned index);
+static void bubbleUp(struct MinMaxHeap * const heap, unsigned index, void * element);
+static void trickleDown(struct MinMaxHeap * const heap, unsigned index, void * element);
+
+
+/**
+ * Initializes the heap
+ *
+ * @param       initial_capacity    the number of elements to make room for.
+ * @param       compare             the function ordering the elements.
+ *
+ * @return      the newly created heap.
+ */
+struct MinMaxHeap * newMinMaxHeap(unsigned initial_capacity, CComparator compare) {
+    alt_assert(initial_capacity > 0, "Initial heap capacity cannot be zero.");
+
+    struct Vector * vector = newVector(initial_capacity);
+    if (vector == NULL)
+        return NULL;
+
+    struct MinMaxHeap * heap = createMinMaxHeap(vector, compare);
+    if (heap == NULL)
+        deleteVector(&vector, NULL);
+
+    return heap;
+}
+
+
+/**
+ * Initializes a heap holding the elements of the given vector, which it takes over. This takes linear time.
+ *
+ * @param       vector  the vector whose elements to reorder into a heap, owned by the heap from now on.
+ * @param       compare the function ordering the elements.
+ *
+ * @return      the newly created heap.
+ */
+struct MinMaxHeap * newMinMaxHeapFromVector(struct Vector * const vector, CComparator compare) {
+    alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");
+
+    struct MinMaxHeap * heap = createMinMaxHeap(vector, compare);
+    if (heap == NULL)
+        return NULL;
+
+    // As with a plain heap, trickling down every internal node from the last one up costs O(n) overall
+    if (vector -> size > 1) {
+        for (unsigned i = vector -> size / 2; i-- > 0; )
+            trickleDown(heap, i, vector -> elements[i]);
+    }
+
+    return heap;
+}
+
+
+/**
+ * Frees the memory occupied by the heap.
+ *
+ * @param       heap    pointer to memory occupied by the heap.
+ * @param       deleter function called on the elements still in the heap, if not NULL.
+ */
+void deleteMinMaxHeap(struct MinMaxHeap ** const heap, CDeleter deleter) {
+    if (heap == NULL)
+        return;
+
+    if (* heap == NULL)
+        return;
+
+    deleteVector(&(* heap) -> vector, deleter);
+    free(* heap);
+    * heap = NULL;
+}
+
+
+/**
+ * Check if the heap is empty.
+ *
+ * @param       heap pointer to the heap which content to check.
+ *
+ * @return      true if the heap is empty, false otherwise.
+ */
+bool isMinMaxHeapEmpty(struct MinMaxHeap const * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    return heap -> vector -> size == 0;
+}
+
+
+/**
+ * Returns the number of elements in the heap.
+ *
+ * @param       heap pointer to the heap which size to return.
+ *
+ * @return      the number of elements in the heap.
+ */
+unsigned minMaxHeapSize(struct MinMaxHeap const * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    return heap -> vector -> size;
+}
+
+
+/**
+ * Adds an element to the heap.
+ *
+ * @param       heap    pointer to the heap to push onto.
+ * @param       element pointer to the element to push.
+ *
+ * @return      true if the element was added, false otherwise (probably due to insufficient memory)
+ */
+bool minMaxHeapPush(struct MinMaxHeap * const heap, void * element) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    if (vectorPushBack(heap -> vector, element) == false)
+        return false;
+
+    bubbleUp(heap, heap -> vector -> size - 1, element);
+    return true;
+}
+
+
+/**
+ * Removes the lowest element of the heap.
+ *
+ * @param       heap pointer to the heap to pop from.
+ *
+ * @return      the lowest element of the heap, or NULL if the heap is empty.
+ */
+void * minMaxHeapPopMin(struct MinMaxHeap * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    if (heap -> vector -> size == 0)
+        return NULL;
+
+    return removeAt(heap, 0);
+}
+
+
+/**
+ * Removes the highest element of the heap.
+ *
+ * @param       heap pointer to the heap to pop from.
+ *
+ * @return      the highest element of the heap, or NULL if the heap is empty.
+ */
+void * minMaxHeapPopMax(struct MinMaxHeap * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    if (heap -> vector -> size == 0)
+        return NULL;
+
+    return removeAt(heap, maxIndex(heap));
+}
+
+
+/**
+ * Returns the lowest element of the heap without removing it.
+ *
+ * @param       heap pointer to the heap to look into.
+ *
+ * @return      the lowest element of the heap, or NULL if the heap is empty.
+ */
+void * minMaxHeapPeekMin(struct MinMaxHeap const * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    return heap -> vector -> size == 0 ? NULL : heap -> vector -> elements[0];
+}
+
+
+/**
+ * Returns the highest element of the heap without removing it.
+ *
+ * @param       heap pointer to the heap to look into.
+ *
+ * @return      the highest element of the heap, or NULL if the heap is empty.
+ */
+void * minMaxHeapPeekMax(struct MinMaxHeap const * const heap) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    return heap -> vector -> size == 0 ? NULL : heap -> vector -> elements[maxIndex(heap)];
+}
+
+
+/**
+ * Replaces the lowest element of the heap with the given one, which is cheaper than a pop followed by a push.
+ *
+ * @param       heap    pointer to the heap to update.
+ * @param       element pointer to the element to push.
+ *
+ * @return      the lowest element of the heap before the replacement, or NULL if the heap was empty.
+ */
+void * minMaxHeapReplaceMin(struct MinMaxHeap * const heap, void * element) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    if (heap -> vector -> size == 0) {
+        minMaxHeapPush(heap, element);
+        return NULL;
+    }
+
+    void * lowest = heap -> vector -> elements[0];
+    trickleDown(heap, 0, element);
+
+    return lowest;
+}
+
+
+/**
+ * Replaces the highest element of the heap with the given one, which is cheaper than a pop followed by a push.
+ *
+ * @param       heap    pointer to the heap to update.
+ * @param       element pointer to the element to push.
+ *
+ * @return      the highest element of the heap before the replacement, or NULL if the heap was empty.
+ */
+void * minMaxHeapReplaceMax(struct MinMaxHeap * const heap, void * element) {
+    alt_assert(heap != NULL, "The parameter <heap> cannot be NULL.");
+
+    if (heap -> vector -> size == 0) {
+        minMaxHeapPush(heap, element);
+        return NULL;
+    }
+
+    void ** elements = heap -> vector -> elements;
+    unsigned index = maxIndex(heap);
+    void * highest = elements[index];
+
+    // Unlike the last element used by a pop, the new one may be lower than the root, in which case they trade places
+    if (index != 0 && heap -> compare(element, elements[0]) < 0) {
+        void * lowest = elements[0];
+        elements[0] = element;
+        element = lowest;
+    }
+
+    trickleDown(heap, index, element);
+
+    return highest;
+}
+
+
+static struct MinMaxHeap * createMinMaxHeap(struct Vector * const vector, CComparator compare) {
+    alt_assert(compare != NULL, "The parameter <compare> cannot be NULL.");
+
+    struct MinMaxHeap * heap = malloc(sizeof *heap);
+    if (heap == NULL)
+        return NULL;
+
+    heap -> vector = vector;
+    heap -> compare = compare;
+
+    return heap;
+}
+
+// 1 if the element at the given index is on a min level, -1 if it is on a max level
+static int levelSign(unsigned index) {
+    unsigned level = 31 - __builtin_clz(index + 1);
+    return (level & 1) == 0 ? 1 : -1;
+}
+
+// Index of the highest element of a heap that isn't empty
+static unsigned maxIndex(struct MinMaxHeap const * const heap) {
+    void ** elements = heap -> vector -> elements;
+    unsigned size = heap -> vector -> size;
+
+    if (size == 1)
+        return 0;
+
+    if (size == 2 || heap -> compare(elements[1], elements[2]) >= 0)
+        return 1;
+
+    return 2;
+}
+
+// Takes out the element at the given index, which is the root or one of its children, and fills the hole with the last element
+static void * removeAt(struct MinMaxHeap * const heap, unsigned index) {
+    void ** elements = heap -> vector -> elements;
+    void * removed = elements[index];
+    void * last = elements[--heap -> vector -> size];
+
+    if (index < heap -> vector -> size)
+        trickleDown(heap, index, last);
+
+    return removed;
+}
+
+static void bubbleUp(struct MinMaxHeap * const heap, unsigned index, void * element) {
+    void ** elements = heap -> vector -> elements;
+    int sign = levelSign(index);
+
+    // If the element belongs on the other kind of level, it trades places with its parent first
+    if (index > 0) {
+        unsigned parent = (index - 1) / 2;
+        if (sign * heap -> compare(element, elements[parent]) > 0) {
+            elements[index] = elements[parent];
+            index = parent;
+            sign = -sign;
+        }
+    }
+
+    // Then it moves up the levels of its own kind, two at a time
+    while (index > 2) {
+        unsigned grandparent = ((index - 1) / 2 - 1) / 2;
+        if (sign * heap -> compare(element, elements[grandparent]) >= 0)
+            break;
+
+        elements[index] = elements[grandparent];
+        index = grandparent;
+    }
+
+    elements[index] = element;
+}
+
+static void trickleDown(struct MinMaxHeap * const heap, unsigned index, void * element) {
+    void ** elements = heap -> vector -> elements;
+    unsigned size = heap -> vector -> size;
+    int sign = levelSign(index);
+
+    for (;;) {
+        unsigned first_child = 2 * index + 1;
+        if (first_child >= size)
+            break;
+
+        // The lowest (or highest, on a max level) of the children and grandchildren.
+        // A child with children of its own is on the other kind of level, so it can't beat them and we skip it.
+        unsigned best = size;
+        for (unsigned child = first_child; child <= first_child + 1 && child < size; child++) {
+            unsigned candidate = child;
+            unsigned grandchild = 2 * child + 1;
+            if (grandchild < size) {
+                candidate = grandchild;
+                if (grandchild + 1 < size && sign * heap -> compare(elements[grandchild + 1], elements[grandchild]) < 0)
+                    candidate = grandchild + 1;
+            }
+
+            if (best == size || sign * heap -> compare(elements[candidate], elements[best]) < 0)
+                best = candidate;
+        }
+
+        if (sign * heap -> compare(elements[best], element) >= 0)
+            break;
+
+        elements[index] = elements[best];
+        index = best;
+
+        // A child is a leaf of the two-level subtree, so the element settles there
+        if (best <= first_child + 1)
+            break;
+
+        // Below a grandchild, the element must stay on the right side of the parent in between
+        unsigned parent = (best - 1) / 2;
+        if (sign * heap -> compare(element, elements[parent]) > 0) {
+            void * displaced = elements[parent];
+            elements[parent] = element;
+            element = displaced;
+        }
+    }
+
+    elements[index] = element;
+}
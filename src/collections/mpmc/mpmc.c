@@ -0,0 +1,247 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <sched.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "mpmc.h"
+
+/*
+ * The sequence of a slot is stored with release semantics once its element has been written (by a producer)
+ * or read (by a consumer), and loaded with acquire semantics before a thread claims the slot.
+ * The head and the tail only order claims between threads of the same side, so they are relaxed.
+ *
+ * The blocking functions spin for a while before yielding the processor:
+ * a slot is usually released within a few instructions, but its owner may also have been preempted.
+ */
+
+#define SPINS_BEFORE_YIELD 64
+
+static void backOff(unsigned * const attempts);
+
+
+/**
+ * Initializes the queue
+ *
+ * @param       capacity the maximum number of elements in the queue, rounded up to a power of two no smaller than 2.
+ *
+ * @return      the newly created queue.
+ */
+struct MpmcQueue * newMpmcQueue(unsigned capacity) {
+    alt_assert(capacity != 0, "Queue capacity cannot be zero.");
+    alt_assert(capacity <= (1u << 30), "Queue capacity cannot exceed 2^30.");
+
+    // With a single slot, the sequence a consumer waits for would be the one the next producer waits for
+    unsigned rounded = 2;
+    while (rounded < capacity)
+        rounded *= 2;
+
+    struct MpmcQueue * queue = aligned_alloc(CACHE_LINE_SIZE, sizeof *queue);
+    if (queue == NULL)
+        return NULL;
+
+    struct MpmcSlot * slots = aligned_alloc(CACHE_LINE_SIZE, rounded * sizeof *slots);
+    if (slots == NULL) {
+        free(queue);
+        return NULL;
+    }
+
+    for (unsigned i = 0; i < rounded; i++) {
+        slots[i].sequence = i;
+        slots[i].element = NULL;
+    }
+
+    queue -> slots = slots;
+    queue -> capacity = rounded;
+    queue -> mask = rounded - 1;
+    queue -> tail = 0;
+    queue -> head = 0;
+
+    return queue;
+}
+
+
+/**
+ * Frees the memory occupied by the queue. No thread may be using it anymore.
+ *
+ * @param       queue   pointer to memory occupied by the queue.
+ * @param       deleter function called on the elements still in the queue, if not NULL.
+ */
+void deleteMpmcQueue(struct MpmcQueue ** const queue, CDeleter deleter) {
+    if (queue == NULL)
+        return;
+
+    if (* queue == NULL)
+        return;
+
+    if (deleter != NULL) {
+        for (unsigned i = (* queue) -> head; i != (* queue) -> tail; i++)
+            deleter((* queue) -> slots[i & (* queue) -> mask].element);
+    }
+
+    free((* queue) -> slots);
+    free(* queue);
+    * queue = NULL;
+}
+
+
+/**
+ * Check if the queue is empty. The answer may be stale by the time it is returned if other threads are using the queue.
+ *
+ * @param       queue pointer to the queue which content to check.
+ *
+ * @return      true if the queue is empty, false otherwise.
+ */
+bool isMpmcQueueEmpty(struct MpmcQueue * const queue) {
+    alt_assert(queue != NULL, "The parameter <queue> cannot be NULL.");
+
+    // The front slot is ready for a consumer exactly when the queue holds something
+    unsigned head = __atomic_load_n(&queue -> head, __ATOMIC_RELAXED);
+    struct MpmcSlot * slot = &queue -> slots[head & queue -> mask];
+
+    return __atomic_load_n(&slot -> sequence, __ATOMIC_ACQUIRE) != head + 1;
+}
+
+
+/**
+ * Pushes an element to the back of the queue if there is room for it.
+ *
+ * @param       queue   pointer to queue to push back onto.
+ * @param       element pointer to the element to push back, which cannot be NULL since popping returns NULL for an empty queue.
+ *
+ * @return      true if the element was pushed, false if the queue is full.
+ */
+bool mpmcQueueTryPushBack(struct MpmcQueue * const queue, void * element) {
+    alt_assert(queue != NULL, "The parameter <queue> cannot be NULL.");
+    alt_assert(element != NULL, "The parameter <element> cannot be NULL.");
+
+    unsigned position = __atomic_load_n(&queue -> tail, __ATOMIC_RELAXED);
+    struct MpmcSlot * slot;
+
+    for (;;) {
+        slot = &queue -> slots[position & queue -> mask];
+        int difference = (int) (__atomic_load_n(&slot -> sequence, __ATOMIC_ACQUIRE) - position);
+
+        if (difference == 0) {
+            // On failure, position is updated with the current tail and we try again from there
+            if (__atomic_compare_exchange_n(&queue -> tail, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                break;
+        }
+        else if (difference < 0) {
+            // The slot still holds the element pushed one lap ago
+            return false;
+        }
+        else {
+            // Another producer claimed this position already
+            position = __atomic_load_n(&queue -> tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot -> element = element;
+    __atomic_store_n(&slot -> sequence, position + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+
+/**
+ * Pops the element at the front of the queue if there is one.
+ *
+ * @param       queue pointer to queue to pop front from.
+ *
+ * @return      the element at the front of the queue, or NULL if the queue is empty.
+ */
+void * mpmcQueueTryPopFront(struct MpmcQueue * const queue) {
+    alt_assert(queue != NULL, "The parameter <queue> cannot be NULL.");
+
+    unsigned position = __atomic_load_n(&queue -> head, __ATOMIC_RELAXED);
+    struct MpmcSlot * slot;
+
+    for (;;) {
+        slot = &queue -> slots[position & queue -> mask];
+        int difference = (int) (__atomic_load_n(&slot -> sequence, __ATOMIC_ACQUIRE) - (position + 1));
+
+        if (difference == 0) {
+            if (__atomic_compare_exchange_n(&queue -> head, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                break;
+        }
+        else if (difference < 0) {
+            // No producer has filled this slot yet
+            return NULL;
+        }
+        else {
+            position = __atomic_load_n(&queue -> head, __ATOMIC_RELAXED);
+        }
+    }
+
+    void * element = slot -> element;
+    // The slot becomes available to the producer that will reach it on the next lap
+    __atomic_store_n(&slot -> sequence, position + queue -> capacity, __ATOMIC_RELEASE);
+
+    return element;
+}
+
+
+/**
+ * Pushes an element to the back of the queue, waiting for room if the queue is full.
+ *
+ * @param       queue   pointer to queue to push back onto.
+ * @param       element pointer to the element to push back, which cannot be NULL since popping returns NULL for an empty queue.
+ */
+void mpmcQueuePushBack(struct MpmcQueue * const queue, void * element) {
+    alt_assert(queue != NULL, "The parameter <queue> cannot be NULL.");
+
+    unsigned attempts = 0;
+    while (mpmcQueueTryPushBack(queue, element) == false)
+        backOff(&attempts);
+}
+
+
+/**
+ * Pops the element at the front of the queue, waiting for one if the queue is empty.
+ *
+ * @param       queue pointer to queue to pop front from.
+ *
+ * @return      the element at the front of the queue.
+ */
+void * mpmcQueuePopFront(struct MpmcQueue * const queue) {
+    alt_assert(queue != NULL, "The parameter <queue> cannot be NULL.");
+
+    unsigned attempts = 0;
+    void * element;
+    while ((element = mpmcQueueTryPopFront(queue)) == NULL)
+        backOff(&attempts);
+
+    return element;
+}
+
+
+static void backOff(unsigned * const attempts) {
+    if (* attempts < SPINS_BEFORE_YIELD) {
+        (* attempts)++;
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+    else {
+        sched_yield();
+    }
+}
@@ -0,0 +1,929 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "sequence.h"
+
+/*
+ * Leaves are split in two halves when they overflow, and so are branches.
+ * When a removal leaves a node less than half full, it is merged with a sibling if they fit in one node,
+ * otherwise the two share their elements (or children) evenly. So every node but the root is at least half full.
+ *
+ * Nothing points up the tree: operations go down from the root and remember the path they took,
+ * then walk that path back up to fix the sizes and split or merge nodes.
+ */
+
+struct SequencePath {
+    struct SequenceBranch * branches[SEQUENCE_MAX_HEIGHT];
+    unsigned slots[SEQUENCE_MAX_HEIGHT];
+    // Branches allocated before a split starts, so that it can't fail half way through
+    struct SequenceBranch * spares[SEQUENCE_MAX_HEIGHT + 1];
+    unsigned spares_count;
+};
+
+static void * _sequenceCollectionGet(struct Collection * const collection, unsigned index);
+static void _sequenceCollectionSet(struct Collection * const collection, unsigned index, void * element);
+static bool _sequenceCollectionAtEnd(struct Collection const * const collection, unsigned index);
+static bool _sequenceCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator);
+static bool _sequenceCollectionNext(struct CIterator * const iterator);
+static void * _sequenceCollectionDeref(struct CIterator const * const iterator);
+
+static void ** elementAt(struct Sequence * const sequence, unsigned index);
+static bool flushHead(struct Sequence * const sequence);
+static bool flushTail(struct Sequence * const sequence);
+static bool treeInsert(struct Sequence * const sequence, unsigned index, void * element);
+static bool treeInsertEdgeLeaf(struct Sequence * const sequence, struct SequenceLeaf * const leaf, bool front);
+static void * treeRemove(struct Sequence * const sequence, unsigned index);
+static struct SequenceLeaf * treeRemoveEdgeLeaf(struct Sequence * const sequence, bool front);
+static struct SequenceLeaf * descend(struct Sequence const * const sequence, unsigned index, struct SequencePath * const path, unsigned * const offset);
+static struct SequenceLeaf * descendEdge(struct Sequence const * const sequence, bool front, struct SequencePath * const path);
+static void addToSizes(struct SequencePath * const path, unsigned depth, int delta);
+static bool reserveSpares(struct SequencePath * const path, int depth);
+static void releaseSpares(struct SequencePath * const path);
+static void insertIntoBranch(struct Sequence * const sequence, struct SequencePath * const path, unsigned depth, unsigned position, void * child, unsigned size);
+static void splitUp(struct Sequence * const sequence, struct SequencePath * const path, unsigned depth, void * left, void * right, unsigned left_size, unsigned right_size);
+static void rebalance(struct Sequence * const sequence, struct SequencePath * const path, unsigned depth);
+static void freeBranches(void * node, unsigned height);
+static struct SequenceLeaf * createLeaf(void);
+static void leafInsertAt(struct SequenceLeaf * const leaf, unsigned position, void * element);
+static void * leafRemoveAt(struct SequenceLeaf * const leaf, unsigned position);
+static void linkLeafAfter(struct SequenceLeaf * const leaf, struct SequenceLeaf * const new_leaf);
+static void linkLeafBefore(struct SequenceLeaf * const leaf, struct SequenceLeaf * const new_leaf);
+static void unlinkLeaf(struct SequenceLeaf * const leaf);
+static void branchInsertAt(struct SequenceBranch * const branch, unsigned position, void * child, unsigned size);
+static void branchRemoveAt(struct SequenceBranch * const branch, unsigned position);
+static unsigned branchSize(struct SequenceBranch const * const branch);
+
+
+/**
+ * Initializes the sequence
+ *
+ * @return      the newly created sequence.
+ */
+struct Sequence * newSequence() {
+    struct Sequence * sequence = malloc(sizeof *sequence);
+    if (sequence == NULL)
+        return NULL;
+
+    sequence -> head = createLeaf();
+    sequence -> tail = createLeaf();
+    if (sequence -> head == NULL || sequence -> tail == NULL) {
+        free(sequence -> head);
+        free(sequence -> tail);
+        free(sequence);
+        return NULL;
+    }
+
+    linkLeafAfter(sequence -> head, sequence -> tail);
+
+    struct Collection collection = {
+        .get = _sequenceCollectionGet,
+        .set = _sequenceCollectionSet,
+        .atEnd = _sequenceCollectionAtEnd,
+        .begin = _sequenceCollectionBegin,
+        .next = _sequenceCollectionNext,
+        .deref = _sequenceCollectionDeref,
+        .span = NULL,
+    };
+
+    sequence -> collection = collection;
+    sequence -> root = NULL;
+    sequence -> height = 0;
+    sequence -> tree_size = 0;
+    sequence -> size = 0;
+
+    return sequence;
+}
+
+
+/**
+ * Frees the memory occupied by the sequence.
+ *
+ * @param       sequence pointer to memory occupied by the sequence.
+ * @param       deleter  function called on each element, if not NULL.
+ */
+void deleteSequence(struct Sequence ** const sequence, CDeleter deleter) {
+    if (sequence == NULL)
+        return;
+
+    if (* sequence == NULL)
+        return;
+
+    // Branches only point down, so we free them before the leaves go away
+    if ((* sequence) -> root != NULL)
+        freeBranches((* sequence) -> root, (* sequence) -> height);
+
+    struct SequenceLeaf * leaf = (* sequence) -> head;
+    while (leaf != NULL) {
+        struct SequenceLeaf * next = leaf -> next;
+        if (deleter != NULL) {
+            for (unsigned i = 0; i < leaf -> count; i++)
+                deleter(leaf -> elements[i]);
+        }
+
+        free(leaf);
+        leaf = next;
+    }
+
+    free(* sequence);
+    * sequence = NULL;
+}
+
+
+/**
+ * Check if the sequence is empty.
+ *
+ * @param       sequence pointer to the sequence which content to check.
+ *
+ * @return      true if the sequence is empty, false otherwise.
+ */
+bool isSequenceEmpty(struct Sequence const * const sequence) {
+    alt_assert(sequence != NULL, "The parameter <sequence> cannot be NULL.");
+
+    return sequence -> size == 0;
+}
+
+
+/**
+ * Returns the number of elements in the sequence.
+ *
+ * @param       sequence pointer to the sequence which size to return.
+ *
+ * @return      the number of elements in the sequence.
+ */
+unsigned sequenceSize(struct Sequence const * const sequence) {
+    alt_assert(sequence != NULL, "The parameter <sequence> cannot be NULL.");
+
+    return sequence -> size;
+}
+
+
+/**
+ * Pushes an element to the back of the sequence.
+ *
+ * @param       sequence pointer to the sequence to push back onto.
+ * @param       element  pointer to the element to push back.
+ *
+ * @return      true if the element was added, false otherwise (probably due to insufficient memory)
+ */
+bool sequencePushBack(struct Sequence * const sequence, void * element) {
+    alt_assert(sequence != NULL, "The parameter <sequence> cannot be NULL.");
+
+    if (sequence -> tail -> count == SEQUENCE_LEAF_CAPACITY && flushTail(sequence) == false)
+        return false;
+
+    sequence -> tail -> elements[sequence -> tail -> count++] = element;
+    sequence -> size++;
+
+    return true;
+}
+
+
+/**
+ * Pushes an element to the front of the sequence.
+ *
+ * @param       sequence pointer to the sequence to push front onto.
+ * @param       element  pointer to the element to push at the front.
+ *
+ * @return      true if the element was added, false otherwise (probably due to insufficient memory)
+ */
+bool sequencePushFront(struct Sequence * const sequence, void * element) {
+    alt_assert(sequence != NULL, "The parameter <sequence> cannot be NULL.");
+
+    if (sequence -> head -> count == SEQUENCE_LEAF_CAPACITY && flushHead(sequence) == false)
+        return false;
+
+    leafInsertAt(sequence -> head, 0, element);
+    sequence -> size++;
+
+    return true;
+}
+
+
+/**
+ * Pops the element at the back of the sequence.
+ *
+ * @param       sequence pointer to the sequence to pop back from.
+ *
+ * @return      the element at the back of the sequence, or NULL if the sequence is empty.
+ */
+void * sequencePopBack(struct Sequence * const sequence) {
+    alt_assert(sequence != NULL, "The parameter <sequence> cannot be NULL.");
+
+    if (sequence -> size == 0)
+        return NULL;
+
+    sequence -> size--;
+
+    if (sequence -> tail -> count == 0) {
+        // With nothing in the tree either, the last element is at the back of the head
+        if (sequence -> root == NULL)
+            return leafRemoveAt(sequence -> head, sequence -> head -> count - 1);
+
+        // The last leaf of the tree becomes the tail, which amortizes the walk down the tree over a whole leaf
+        struct SequenceLeaf * leaf = treeRemoveEdgeLeaf(sequence, false);
+        unlinkLeaf(sequence -> tail);
+        free(sequence -> tail);
+        sequence -> tail = leaf;
+    }
+
+    return leafRemoveAt(sequence -> tail, sequence -> tail -> count - 1);
+}
+
+
+/**
+ * Pops the element at the front of the sequence.
+ *
+ * @param       sequence pointer to the sequence to pop front from.
+ *
+ * @return      the element at the front of the sequence, or NULL if the sequence is empty.
+ */
+void * sequencePopFront(struct Sequence * const sequence) {
+    alt_assert(sequence != NULL, "The parameter <sequence> cannot be NULL.");
+
+    if (sequence -> size == 0)
+        return NULL;
+
+    sequence -> size--;
+
+    if (sequence -> head -> count == 0) {
+        if (sequence -> root == NULL)
+            return leafRemoveAt(sequence -> tail, 0);
+
+        struct SequenceLeaf * leaf = treeRemoveEdgeLeaf(sequence, true);
+        unlinkLeaf(sequence -> head);
+        free(sequence -> head);
+        sequence -> head = leaf;
+    }
+
+    return leafRemoveAt(sequence -> head, 0);
+}
+
+
+/**
+ * Gets the element at the given position in the sequence.
+ *
+ * @param       sequence pointer to the sequence to get the element from.
+ * @param       index    the index of the element.
+ *
+ * @return      the element at the given index.
+ */
+void * sequenceGet(struct Sequence * const sequence, unsigned index) {
+    alt_assert(sequence != NULL, "The parameter <sequence> cannot be NULL.");
+    return _sequenceCollectionGet(&sequence -> collection, index);
+}
+
+static void * _sequenceCollectionGet(struct Collection * const collection, unsigned index) {
+    struct Sequence * const sequence = (struct Sequence * const) collection;
+
+    alt_assert(index < sequence -> size, "Index is out of bounds.");
+
+    return * elementAt(sequence, index);
+}
+
+
+/**
+ * Sets the element at the given position in the sequence, replacing the existing element.
+ *
+ * @param       sequence pointer to the sequence to set the element in.
+ * @param       index    the index of the element.
+ * @param       element  the new element.
+ */
+void sequenceSet(struct Sequence * const sequence, unsigned index, void * element) {
+    alt_assert(sequence != NULL, "The parameter <sequence> cannot be NULL.");
+    _sequenceCollectionSet(&sequence -> collection, index, element);
+}
+
+static void _sequenceCollectionSet(struct Collection * const collection, unsigned index, void * element) {
+    struct Sequence * const sequence = (struct Sequence * const) collection;
+
+    alt_assert(index < sequence -> size, "Index is out of bounds.");
+
+    * elementAt(sequence, index) = element;
+}
+
+
+/**
+ * Inserts the element at the given position in the sequence, moving the other elements to the right.
+ *
+ * @param       sequence pointer to the sequence to insert into.
+ * @param       index    the index where to insert the element, up to the size of the sequence.
+ * @param       element  the element to insert.
+ *
+ * @return      true if the element was added, false otherwise (probably due to insufficient memory)
+ */
+bool sequenceInsert(struct Sequence * const sequence, unsigned index, void * element) {
+    alt_assert(sequence != NULL, "The parameter <sequence> cannot be NULL.");
+    alt_assert(index <= sequence -> size, "Index is out of bounds.");
+
+    struct SequenceLeaf * const head = sequence -> head;
+    struct SequenceLeaf * const tail = sequence -> tail;
+
+    // A full head or tail joins the tree and we look for the position again
+    if (index <= head -> count && head -> count == SEQUENCE_LEAF_CAPACITY) {
+        if (flushHead(sequence) == false)
+            return false;
+        return sequenceInsert(sequence, index, element);
+    }
+
+    if (index <= head -> count) {
+        leafInsertAt(head, index, element);
+    }
+    else if (index - head -> count >= sequence -> tree_size) {
+        if (tail -> count == SEQUENCE_LEAF_CAPACITY) {
+            if (flushTail(sequence) == false)
+                return false;
+            return sequenceInsert(sequence, index, element);
+        }
+
+        leafInsertAt(tail, index - head -> count - sequence -> tree_size, element);
+    }
+    else if (treeInsert(sequence, index - head -> count, element) == false) {
+        return false;
+    }
+
+    sequence -> size++;
+
+    return true;
+}
+
+
+/**
+ * Removes the element at the given position in the sequence, moving the other elements to the left.
+ *
+ * @param       sequence pointer to the sequence to remove the element from.
+ * @param       index    the index of the element to remove.
+ *
+ * @return      the removed element.
+ */
+void * sequenceRemove(struct Sequence * const sequence, unsigned index) {
+    alt_assert(sequence != NULL, "The parameter <sequence> cannot be NULL.");
+    alt_assert(index < sequence -> size, "Index is out of bounds.");
+
+    sequence -> size--;
+
+    if (index < sequence -> head -> count)
+        return leafRemoveAt(sequence -> head, index);
+
+    index -= sequence -> head -> count;
+    if (index < sequence -> tree_size)
+        return treeRemove(sequence, index);
+
+    return leafRemoveAt(sequence -> tail, index - sequence -> tree_size);
+}
+
+
+static bool _sequenceCollectionAtEnd(struct Collection const * const collection, unsigned index) {
+    alt_assert(collection != NULL, "The parameter <sequence> cannot be NULL.");
+    struct Sequence const * const sequence = (struct Sequence const * const) collection;
+
+    alt_assert(sequence -> size > 0, "The sequence is empty, cannot check if at end.");
+
+    return index >= sequence -> size - 1;
+}
+
+
+// Iterators go from leaf to leaf, holding the leaf as their position and the offset in that leaf as their index
+static bool _sequenceCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator) {
+    alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+
+    struct Sequence const * const sequence = (struct Sequence const * const) collection;
+
+    // Only the head and the tail can be empty
+    struct SequenceLeaf * leaf = sequence -> head;
+    while (leaf != NULL && leaf -> count == 0)
+        leaf = leaf -> next;
+
+    iterator -> collection = collection;
+    iterator -> position = leaf;
+    iterator -> index = 0;
+
+    return leaf != NULL;
+}
+
+static bool _sequenceCollectionNext(struct CIterator * const iterator) {
+    struct SequenceLeaf const * leaf = iterator -> position;
+
+    if (++iterator -> index < leaf -> count)
+        return true;
+
+    do {
+        leaf = leaf -> next;
+    } while (leaf != NULL && leaf -> count == 0);
+
+    iterator -> position = (void *) leaf;
+    iterator -> index = 0;
+
+    return leaf != NULL;
+}
+
+static void * _sequenceCollectionDeref(struct CIterator const * const iterator) {
+    struct SequenceLeaf const * const leaf = iterator -> position;
+
+    return leaf -> elements[iterator -> index];
+}
+
+
+static void ** elementAt(struct Sequence * const sequence, unsigned index) {
+    if (index < sequence -> head -> count)
+        return &sequence -> head -> elements[index];
+
+    index -= sequence -> head -> count;
+    if (index >= sequence -> tree_size)
+        return &sequence -> tail -> elements[index - sequence -> tree_size];
+
+    struct SequencePath path;
+    unsigned offset;
+    struct SequenceLeaf * leaf = descend(sequence, index, &path, &offset);
+
+    return &leaf -> elements[offset];
+}
+
+// The full head joins the tree as its first leaf and an empty head takes its place
+static bool flushHead(struct Sequence * const sequence) {
+    struct SequenceLeaf * head = createLeaf();
+    if (head == NULL)
+        return false;
+
+    if (treeInsertEdgeLeaf(sequence, sequence -> head, true) == false) {
+        free(head);
+        return false;
+    }
+
+    linkLeafBefore(sequence -> head, head);
+    sequence -> head = head;
+
+    return true;
+}
+
+static bool flushTail(struct Sequence * const sequence) {
+    struct SequenceLeaf * tail = createLeaf();
+    if (tail == NULL)
+        return false;
+
+    if (treeInsertEdgeLeaf(sequence, sequence -> tail, false) == false) {
+        free(tail);
+        return false;
+    }
+
+    linkLeafAfter(sequence -> tail, tail);
+    sequence -> tail = tail;
+
+    return true;
+}
+
+
+static bool treeInsert(struct Sequence * const sequence, unsigned index, void * element) {
+    struct SequencePath path;
+    unsigned offset;
+    struct SequenceLeaf * leaf = descend(sequence, index, &path, &offset);
+
+    if (leaf -> count < SEQUENCE_LEAF_CAPACITY) {
+        leafInsertAt(leaf, offset, element);
+        addToSizes(&path, sequence -> height, 1);
+        sequence -> tree_size++;
+        return true;
+    }
+
+    // A full leaf gives its upper half to a new leaf, which its parent may not have room for
+    struct SequenceLeaf * sibling = createLeaf();
+    if (sibling == NULL)
+        return false;
+
+    if (reserveSpares(&path, (int) sequence -> height - 1) == false) {
+        free(sibling);
+        return false;
+    }
+
+    addToSizes(&path, sequence -> height, 1);
+    sequence -> tree_size++;
+
+    unsigned half = SEQUENCE_LEAF_CAPACITY / 2;
+    sibling -> count = SEQUENCE_LEAF_CAPACITY - half;
+    memcpy(sibling -> elements, leaf -> elements + half, sibling -> count * sizeof *leaf -> elements);
+    leaf -> count = half;
+    linkLeafAfter(leaf, sibling);
+
+    if (offset <= half)
+        leafInsertAt(leaf, offset, element);
+    else
+        leafInsertAt(sibling, offset - half, element);
+
+    splitUp(sequence, &path, sequence -> height, leaf, sibling, leaf -> count, sibling -> count);
+    releaseSpares(&path);
+
+    return true;
+}
+
+// Adds a leaf before the first (or after the last) leaf of the tree
+static bool treeInsertEdgeLeaf(struct Sequence * const sequence, struct SequenceLeaf * const leaf, bool front) {
+    if (sequence -> root == NULL) {
+        sequence -> root = leaf;
+        sequence -> height = 0;
+        sequence -> tree_size = leaf -> count;
+        return true;
+    }
+
+    struct SequencePath path;
+    struct SequenceLeaf * edge = descendEdge(sequence, front, &path);
+
+    if (reserveSpares(&path, (int) sequence -> height - 1) == false)
+        return false;
+
+    sequence -> tree_size += leaf -> count;
+
+    if (sequence -> height == 0) {
+        if (front)
+            splitUp(sequence, &path, 0, leaf, edge, leaf -> count, edge -> count);
+        else
+            splitUp(sequence, &path, 0, edge, leaf, edge -> count, leaf -> count);
+    }
+    else {
+        unsigned bottom = sequence -> height - 1;
+        addToSizes(&path, bottom, leaf -> count);
+        insertIntoBranch(sequence, &path, bottom, front ? 0 : path.branches[bottom] -> count, leaf, leaf -> count);
+    }
+
+    releaseSpares(&path);
+
+    return true;
+}
+
+static void * treeRemove(struct Sequence * const sequence, unsigned index) {
+    struct SequencePath path;
+    unsigned offset;
+    struct SequenceLeaf * leaf = descend(sequence, index, &path, &offset);
+
+    void * element = leafRemoveAt(leaf, offset);
+    addToSizes(&path, sequence -> height, -1);
+    sequence -> tree_size--;
+
+    rebalance(sequence, &path, sequence -> height);
+
+    return element;
+}
+
+// Takes the first (or last) leaf out of the tree, leaving it linked to its neighbours
+static struct SequenceLeaf * treeRemoveEdgeLeaf(struct Sequence * const sequence, bool front) {
+    struct SequencePath path;
+    struct SequenceLeaf * leaf = descendEdge(sequence, front, &path);
+
+    sequence -> tree_size -= leaf -> count;
+
+    if (sequence -> height == 0) {
+        sequence -> root = NULL;
+        return leaf;
+    }
+
+    unsigned bottom = sequence -> height - 1;
+    addToSizes(&path, bottom, -(int) leaf -> count);
+    branchRemoveAt(path.branches[bottom], path.slots[bottom]);
+    rebalance(sequence, &path, bottom);
+
+    return leaf;
+}
+
+
+static struct SequenceLeaf * descend(struct Sequence const * const sequence, unsigned index, struct SequencePath * const path, unsigned * const offset) {
+    void * node = sequence -> root;
+
+    for (unsigned depth = 0; depth < sequence -> height; depth++) {
+        struct SequenceBranch * branch = node;
+        unsigned slot = 0;
+        while (index >= branch -> sizes[slot]) {
+            index -= branch -> sizes[slot];
+            slot++;
+        }
+
+        path -> branches[depth] = branch;
+        path -> slots[depth] = slot;
+        node = branch -> children[slot];
+    }
+
+    * offset = index;
+    return node;
+}
+
+static struct SequenceLeaf * descendEdge(struct Sequence const * const sequence, bool front, struct SequencePath * const path) {
+    void * node = sequence -> root;
+
+    for (unsigned depth = 0; depth < sequence -> height; depth++) {
+        struct SequenceBranch * branch = node;
+        unsigned slot = front ? 0 : branch -> count - 1;
+
+        path -> branches[depth] = branch;
+        path -> slots[depth] = slot;
+        node = branch -> children[slot];
+    }
+
+    return node;
+}
+
+// Updates the sizes recorded along the path for the nodes above the given depth
+static void addToSizes(struct SequencePath * const path, unsigned depth, int delta) {
+    for (unsigned i = 0; i < depth; i++)
+        path -> branches[i] -> sizes[path -> slots[i]] += delta;
+}
+
+// Allocates as many branches as inserting a child into the branch at the given depth of the path may need
+static bool reserveSpares(struct SequencePath * const path, int depth) {
+    unsigned needed = 0;
+    while (depth >= 0 && path -> branches[depth] -> count == SEQUENCE_BRANCH_CAPACITY) {
+        needed++;
+        depth--;
+    }
+
+    // Every branch up to the root is full, so the root splits and we need a new one
+    if (depth < 0)
+        needed++;
+
+    path -> spares_count = 0;
+    while (path -> spares_count < needed) {
+        struct SequenceBranch * branch = malloc(sizeof *branch);
+        if (branch == NULL) {
+            releaseSpares(path);
+            return false;
+        }
+
+        path -> spares[path -> spares_count++] = branch;
+    }
+
+    return true;
+}
+
+static void releaseSpares(struct SequencePath * const path) {
+    while (path -> spares_count > 0)
+        free(path -> spares[--path -> spares_count]);
+}
+
+// Inserts a child into the branch at the given depth of the path, whose ancestors already account for its size
+static void insertIntoBranch(struct Sequence * const sequence, struct SequencePath * const path, unsigned depth, unsigned position, void * child, unsigned size) {
+    struct SequenceBranch * branch = path -> branches[depth];
+
+    if (branch -> count < SEQUENCE_BRANCH_CAPACITY) {
+        branchInsertAt(branch, position, child, size);
+        return;
+    }
+
+    struct SequenceBranch * sibling = path -> spares[--path -> spares_count];
+    unsigned half = SEQUENCE_BRANCH_CAPACITY / 2;
+    sibling -> count = SEQUENCE_BRANCH_CAPACITY - half;
+    memcpy(sibling -> children, branch -> children + half, sibling -> count * sizeof *branch -> children);
+    memcpy(sibling -> sizes, branch -> sizes + half, sibling -> count * sizeof *branch -> sizes);
+    branch -> count = half;
+
+    if (position <= half)
+        branchInsertAt(branch, position, child, size);
+    else
+        branchInsertAt(sibling, position - half, child, size);
+
+    splitUp(sequence, path, depth, branch, sibling, branchSize(branch), branchSize(sibling));
+}
+
+// Puts the right half of a node that just split next to its left half, which stays where the node was
+static void splitUp(struct Sequence * const sequence, struct SequencePath * const path, unsigned depth, void * left, void * right, unsigned left_size, unsigned right_size) {
+    if (depth == 0) {
+        struct SequenceBranch * root = path -> spares[--path -> spares_count];
+        root -> count = 2;
+        root -> children[0] = left;
+        root -> children[1] = right;
+        root -> sizes[0] = left_size;
+        root -> sizes[1] = right_size;
+
+        sequence -> root = root;
+        sequence -> height++;
+        return;
+    }
+
+    struct SequenceBranch * parent = path -> branches[depth - 1];
+    unsigned slot = path -> slots[depth - 1];
+
+    parent -> sizes[slot] = left_size;
+    insertIntoBranch(sequence, path, depth - 1, slot + 1, right, right_size);
+}
+
+// Restores the minimum occupancy of the node at the given depth of the path after it lost an element or a child
+static void rebalance(struct Sequence * const sequence, struct SequencePath * const path, unsigned depth) {
+    bool leaves = depth == sequence -> height;
+
+    if (depth == 0) {
+        if (leaves) {
+            struct SequenceLeaf * root = sequence -> root;
+            if (root -> count == 0) {
+                unlinkLeaf(root);
+                free(root);
+                sequence -> root = NULL;
+            }
+            return;
+        }
+
+        // A root with a single child is useless, and one without children means the tree is empty
+        while (sequence -> height > 0 && ((struct SequenceBranch *) sequence -> root) -> count <= 1) {
+            struct SequenceBranch * root = sequence -> root;
+            sequence -> root = root -> count == 1 ? root -> children[0] : NULL;
+            sequence -> height = root -> count == 1 ? sequence -> height - 1 : 0;
+            free(root);
+        }
+        return;
+    }
+
+    struct SequenceBranch * parent = path -> branches[depth - 1];
+    unsigned slot = path -> slots[depth - 1];
+    void * node = parent -> children[slot];
+    unsigned capacity = leaves ? SEQUENCE_LEAF_CAPACITY : SEQUENCE_BRANCH_CAPACITY;
+    unsigned count = leaves ? ((struct SequenceLeaf *) node) -> count : ((struct SequenceBranch *) node) -> count;
+
+    if (count >= capacity / 2)
+        return;
+
+    if (count == 0 || parent -> count == 1) {
+        if (count == 0) {
+            if (leaves)
+                unlinkLeaf(node);
+            free(node);
+            branchRemoveAt(parent, slot);
+        }
+
+        rebalance(sequence, path, depth - 1);
+        return;
+    }
+
+    // We pair the node with its right sibling, or its left one if it is the last child
+    unsigned left_slot = slot + 1 < parent -> count ? slot : slot - 1;
+    unsigned right_slot = left_slot + 1;
+
+    if (leaves) {
+        struct SequenceLeaf * left = parent -> children[left_slot];
+        struct SequenceLeaf * right = parent -> children[right_slot];
+        unsigned total = left -> count + right -> count;
+
+        if (total <= capacity) {
+            memcpy(left -> elements + left -> count, right -> elements, right -> count * sizeof *right -> elements);
+            left -> count = total;
+            unlinkLeaf(right);
+            free(right);
+        }
+        else if (left -> count > total / 2) {
+            unsigned moved = left -> count - total / 2;
+            memmove(right -> elements + moved, right -> elements, right -> count * sizeof *right -> elements);
+            memcpy(right -> elements, left -> elements + total / 2, moved * sizeof *left -> elements);
+            left -> count -= moved;
+            right -> count += moved;
+        }
+        else {
+            unsigned moved = total / 2 - left -> count;
+            memcpy(left -> elements + left -> count, right -> elements, moved * sizeof *right -> elements);
+            memmove(right -> elements, right -> elements + moved, (right -> count - moved) * sizeof *right -> elements);
+            left -> count += moved;
+            right -> count -= moved;
+        }
+
+        parent -> sizes[left_slot] = left -> count;
+        if (total <= capacity)
+            branchRemoveAt(parent, right_slot);
+        else
+            parent -> sizes[right_slot] = right -> count;
+    }
+    else {
+        struct SequenceBranch * left = parent -> children[left_slot];
+        struct SequenceBranch * right = parent -> children[right_slot];
+        unsigned total = left -> count + right -> count;
+
+        if (total <= capacity) {
+            memcpy(left -> children + left -> count, right -> children, right -> count * sizeof *right -> children);
+            memcpy(left -> sizes + left -> count, right -> sizes, right -> count * sizeof *right -> sizes);
+            left -> count = total;
+            free(right);
+        }
+        else if (left -> count > total / 2) {
+            unsigned moved = left -> count - total / 2;
+            memmove(right -> children + moved, right -> children, right -> count * sizeof *right -> children);
+            memmove(right -> sizes + moved, right -> sizes, right -> count * sizeof *right -> sizes);
+            memcpy(right -> children, left -> children + total / 2, moved * sizeof *left -> children);
+            memcpy(right -> sizes, left -> sizes + total / 2, moved * sizeof *left -> sizes);
+            left -> count -= moved;
+            right -> count += moved;
+        }
+        else {
+            unsigned moved = total / 2 - left -> count;
+            memcpy(left -> children + left -> count, right -> children, moved * sizeof *right -> children);
+            memcpy(left -> sizes + left -> count, right -> sizes, moved * sizeof *right -> sizes);
+            memmove(right -> children, right -> children + moved, (right -> count - moved) * sizeof *right -> children);
+            memmove(right -> sizes, right -> sizes + moved, (right -> count - moved) * sizeof *right -> sizes);
+            left -> count += moved;
+            right -> count -= moved;
+        }
+
+        parent -> sizes[left_slot] = branchSize(left);
+        if (total <= capacity)
+            branchRemoveAt(parent, right_slot);
+        else
+            parent -> sizes[right_slot] = branchSize(right);
+    }
+
+    rebalance(sequence, path, depth - 1);
+}
+
+static void freeBranches(void * node, unsigned height) {
+    if (height == 0)
+        return;
+
+    struct SequenceBranch * branch = node;
+    for (unsigned i = 0; i < branch -> count; i++)
+        freeBranches(branch -> children[i], height - 1);
+
+    free(branch);
+}
+
+
+static struct SequenceLeaf * createLeaf(void) {
+    struct SequenceLeaf * leaf = malloc(sizeof *leaf);
+    if (leaf == NULL)
+        return NULL;
+
+    leaf -> prev = NULL;
+    leaf -> next = NULL;
+    leaf -> count = 0;
+
+    return leaf;
+}
+
+static void leafInsertAt(struct SequenceLeaf * const leaf, unsigned position, void * element) {
+    memmove(leaf -> elements + position + 1, leaf -> elements + position, (leaf -> count - position) * sizeof *leaf -> elements);
+    leaf -> elements[position] = element;
+    leaf -> count++;
+}
+
+static void * leafRemoveAt(struct SequenceLeaf * const leaf, unsigned position) {
+    void * element = leaf -> elements[position];
+    leaf -> count--;
+    memmove(leaf -> elements + position, leaf -> elements + position + 1, (leaf -> count - position) * sizeof *leaf -> elements);
+
+    return element;
+}
+
+static void linkLeafAfter(struct SequenceLeaf * const leaf, struct SequenceLeaf * const new_leaf) {
+    new_leaf -> prev = leaf;
+    new_leaf -> next = leaf -> next;
+    if (leaf -> next != NULL)
+        leaf -> next -> prev = new_leaf;
+    leaf -> next = new_leaf;
+}
+
+static void linkLeafBefore(struct SequenceLeaf * const leaf, struct SequenceLeaf * const new_leaf) {
+    new_leaf -> next = leaf;
+    new_leaf -> prev = leaf -> prev;
+    if (leaf -> prev != NULL)
+        leaf -> prev -> next = new_leaf;
+    leaf -> prev = new_leaf;
+}
+
+static void unlinkLeaf(struct SequenceLeaf * const leaf) {
+    if (leaf -> prev != NULL)
+        leaf -> prev -> next = leaf -> next;
+    if (leaf -> next != NULL)
+        leaf -> next -> prev = leaf -> prev;
+}
+
+static void branchInsertAt(struct SequenceBranch * const branch, unsigned position, void * child, unsigned size) {
+    memmove(branch -> children + position + 1, branch -> children + position, (branch -> count - position) * sizeof *branch -> children);
+    memmove(branch -> sizes + position + 1, branch -> sizes + position, (branch -> count - position) * sizeof *branch -> sizes);
+    branch -> children[position] = child;
+    branch -> sizes[position] = size;
+    branch -> count++;
+}
+
+static void branchRemoveAt(struct SequenceBranch * const branch, unsigned position) {
+    branch -> count--;
+    memmove(branch -> children + position, branch -> children + position + 1, (branch -> count - position) * sizeof *branch -> children);
+    memmove(branch -> sizes + position, branch -> sizes + position + 1, (branch -> count - position) * sizeof *branch -> sizes);
+}
+
+static unsigned branchSize(struct SequenceBranch const * const branch) {
+    unsigned size = 0;
+    for (unsigned i = 0; i < branch -> count; i++)
+        size += branch -> sizes[i];
+
+    return size;
+}
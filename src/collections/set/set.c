@@ -24,17 +24,27 @@
 #include <stdio.h>
 
 #include "common.h"
-#include "siphash.h"
+#include "hash.h"
 #include "set.h"
 
 static void * _hashSetCollectionGet(struct Collection * const collection, unsigned index);
 static bool _hashSetCollectionAtEnd(struct Collection const * const collection, unsigned index);
+static bool _hashSetCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator);
+static bool _hashSetCollectionNext(struct CIterator * const iterator);
+static void * _hashSetCollectionDeref(struct CIterator const * const iterator);
 
 static void * createItem(unsigned value_len, void * value, uint64_t hash, struct HashSetItem * prev, struct HashSetItem * next);
 static void deleteItem(struct HashSetItem * item, CDeleter deleter);
+static unsigned moveChain(struct HashSetItem * item, struct HashSetItem ** items, unsigned capacity);
+static inline bool valuesMatch(struct HashSet const * const set, struct HashSetItem const * item,
+    uint64_t hash, unsigned value_len, void const * value);
+static inline void forgetCursor(struct HashSet * const set);
 
 float hash_set_growth_factor = 1.75;
 
+// How many buckets ahead we prefetch when redistributing items
+#define PREFETCH_DISTANCE 4
+
 
 /**
  * Initializes the set
@@ -58,6 +68,10 @@ struct HashSet * newHashSet(unsigned initial_capacity) {
         .get = _hashSetCollectionGet,
         .set = NULL,
         .atEnd = _hashSetCollectionAtEnd,
+        .begin = _hashSetCollectionBegin,
+        .next = _hashSetCollectionNext,
+        .deref = _hashSetCollectionDeref,
+        .span = NULL,
     };
 
     set -> collection = collection;
@@ -67,11 +81,32 @@ struct HashSet * newHashSet(unsigned initial_capacity) {
     set -> capacity = initial_capacity;
     set -> size = 0;
     set -> buckets_count = 0;
+    set -> hasher = sipHash24;
+    set -> equals = NULL;
+    set -> cursor = hashSetCursor(set);
+    set -> cursor_index = 0;
 
     return set;
 }
 
 
+/**
+ * Replaces the hash function of the set and optionally sets the function used to compare values.
+ *
+ * @param       set     pointer to the set to configure, it must be empty.
+ * @param       hasher  the hash function to use.
+ * @param       equals  the function to compare values with, or NULL to consider values with the same hash identical.
+ */
+void hashSetUseHasher(struct HashSet * const set, CHasher hasher, CEquals equals) {
+    alt_assert(set != NULL, "The parameter <set> cannot be NULL.");
+    alt_assert(hasher != NULL, "The parameter <hasher> cannot be NULL.");
+    alt_assert(set -> size == 0, "The hash function of a non-empty hash set cannot be changed.");
+
+    set -> hasher = hasher;
+    set -> equals = equals;
+}
+
+
 /**
  * Frees the memory occupied by the set.
  *
@@ -115,34 +150,26 @@ struct HashSet * resizeHashSet(struct HashSet * const set, unsigned new_capacity
     alt_assert(set != NULL, "The parameter <set> cannot be NULL.");
     alt_assert(new_capacity > set -> capacity, "The new capacity cannot less or equal to the existing capacity.");
 
+    forgetCursor(set);
+
     struct HashSetItem ** items = calloc(new_capacity, sizeof *items);
     if (items == NULL)
         return NULL;
 
+    // Items carry their hash, so growing costs O(entries) no matter how long the values are
+    unsigned buckets_count = 0;
     for (unsigned i = 0; i < set -> capacity; i++) {
-        struct HashSetItem * item = set -> items[i];
-        if (item == NULL)
-            continue;
-        
-        struct HashSetItem * next_item = NULL;
-        do {
-            next_item = item -> next;
-
-            uint64_t hash = siphash24((char const *) item -> value, item -> value_len, set -> hash_key);
-            uint64_t hash_value = hash % new_capacity;
-            item -> hash = hash;
-            if (items[hash_value] != NULL)
-                items[hash_value] -> prev = item;
-            item -> next = items[hash_value];
-            items[hash_value] = item;
-
-            item = next_item;
-        } while (next_item != NULL);
+        // The chains of the buckets a little further ahead are fetched while we move the current one
+        if (i + PREFETCH_DISTANCE < set -> capacity)
+            __builtin_prefetch(set -> items[i + PREFETCH_DISTANCE]);
+
+        buckets_count += moveChain(set -> items[i], items, new_capacity);
     }
 
     free(set -> items);
     set -> items = items;
     set -> capacity = new_capacity;
+    set -> buckets_count = buckets_count;
 
     return set;
 }
@@ -187,6 +214,8 @@ bool hashSetInsert(struct HashSet * const set, unsigned value_len, void * value)
     alt_assert(set != NULL, "The parameter <set> cannot be NULL.");
     alt_assert(value_len != 0, "The size of the value (via value_len) cannot be zero.");
 
+    forgetCursor(set);
+
     // If the load factor exceeds 0.69, we resize the set
     float load_factor = (float)set -> buckets_count / (float)set -> capacity;
     // Maximum load factor pulled from: https://stackoverflow.com/a/31401836
@@ -196,13 +225,15 @@ bool hashSetInsert(struct HashSet * const set, unsigned value_len, void * value)
             return false;
     }
 
-    uint64_t hash = siphash24((char const *) value, value_len, set -> hash_key);
+    uint64_t hash = set -> hasher(value, value_len, set -> hash_key);
     uint64_t hash_value = hash % set -> capacity;
     struct HashSetItem * existing_item = set -> items[hash_value];
 
     // If the value already exists in the set, no need to add it again
-    if (existing_item != NULL && existing_item -> hash == hash)
-        return true;
+    for (struct HashSetItem * item = existing_item; item != NULL; item = item -> next) {
+        if (valuesMatch(set, item, hash, value_len, value))
+            return true;
+    }
         
     // Incremement the number of buckets so we can calculate the load factor
     if (existing_item == NULL)
@@ -232,7 +263,7 @@ bool hashSetContains(struct HashSet const * const set, unsigned value_len, void
     if (set -> size == 0)
         return false;
 
-    uint64_t hash = siphash24((char const *) value, value_len, set -> hash_key);
+    uint64_t hash = set -> hasher(value, value_len, set -> hash_key);
     uint64_t hash_value = hash % set -> capacity;
     struct HashSetItem * item = set -> items[hash_value];
 
@@ -241,7 +272,7 @@ bool hashSetContains(struct HashSet const * const set, unsigned value_len, void
 
     bool found = false;
     while (item != NULL) {
-        if (item -> hash == hash) {
+        if (valuesMatch(set, item, hash, value_len, value)) {
             found = true;
             break;
         }
@@ -265,7 +296,9 @@ bool hashSetDelete(struct HashSet * const set, unsigned value_len, void * value,
     alt_assert(set != NULL, "The parameter <set> cannot be NULL.");
     alt_assert(value_len != 0, "The size of the value (via value_len) cannot be zero.");
 
-    uint64_t hash = siphash24((char const *) value, value_len, set -> hash_key);
+    forgetCursor(set);
+
+    uint64_t hash = set -> hasher(value, value_len, set -> hash_key);
     uint64_t hash_value = hash % set -> capacity;
 
     struct HashSetItem * existing_item = set -> items[hash_value];
@@ -273,7 +306,7 @@ bool hashSetDelete(struct HashSet * const set, unsigned value_len, void * value,
         return false;
     
     do {
-        if (existing_item -> hash == hash) {
+        if (valuesMatch(set, existing_item, hash, value_len, value)) {
             struct HashSetItem * prev = existing_item -> prev;
             struct HashSetItem * next = existing_item -> next;
             if (prev != NULL) {
@@ -306,30 +339,76 @@ bool hashSetDelete(struct HashSet * const set, unsigned value_len, void * value,
 }
 
 
+/**
+ * Creates a cursor placed before the first value of the set.
+ *
+ * @param       set pointer to the set to walk.
+ *
+ * @return      the new cursor.
+ */
+struct HashSetCursor hashSetCursor(struct HashSet const * const set) {
+    alt_assert(set != NULL, "The parameter <set> cannot be NULL.");
+
+    struct HashSetCursor cursor = {
+        .value = NULL,
+        .value_len = 0,
+        .entry = NULL,
+        .bucket = 0,
+    };
+
+    return cursor;
+}
+
+
+/**
+ * Moves the cursor to the next value of the set.
+ *
+ * @param       set     pointer to the set the cursor was created from.
+ * @param       cursor  pointer to the cursor to move.
+ *
+ * @return      true if the cursor is on a value, false if all values were visited.
+ */
+bool hashSetCursorNext(struct HashSet const * const set, struct HashSetCursor * const cursor) {
+    alt_assert(set != NULL, "The parameter <set> cannot be NULL.");
+    alt_assert(cursor != NULL, "The parameter <cursor> cannot be NULL.");
+
+    struct HashSetItem * item = cursor -> entry;
+    if (item != NULL)
+        item = item -> next;
+
+    while (item == NULL && cursor -> bucket < set -> capacity)
+        item = set -> items[cursor -> bucket++];
+
+    cursor -> entry = item;
+    if (item == NULL)
+        return false;
+
+    cursor -> value = item -> value;
+    cursor -> value_len = item -> value_len;
+
+    return true;
+}
+
+
 static void * _hashSetCollectionGet(struct Collection * const collection, unsigned index) {
     alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
 
-    struct HashSet const * const set = (struct HashSet const * const) collection;
+    struct HashSet * const set = (struct HashSet * const) collection;
     
     alt_assert(set -> size > 0, "The hash set is empty, cannot get items.");
     alt_assert(index < set -> size, "The index is out of bounds.");
 
-    unsigned shadow_index = 0;
-    for (int i = 0; i < set -> capacity; i++) {
-        struct HashSetItem * item = set -> items[i];
-        if (item == NULL)
-            continue;
-
-        while (item != NULL) {
-            if (shadow_index == index)
-                return item;
-
-            shadow_index++;
-            item = item -> next;
-        }
+    // We resume from the item reached by the previous call, so visiting items in order is amortized O(1)
+    if (set -> cursor.entry == NULL || index < set -> cursor_index) {
+        set -> cursor = hashSetCursor(set);
+        hashSetCursorNext(set, &set -> cursor);
+        set -> cursor_index = 0;
     }
 
-    return NULL;
+    for (; set -> cursor_index < index; set -> cursor_index++)
+        hashSetCursorNext(set, &set -> cursor);
+
+    return set -> cursor.entry;
 }
 
 
@@ -342,6 +421,37 @@ static bool _hashSetCollectionAtEnd(struct Collection const * const collection,
 }
 
 
+// Iterators are cursors in disguise: the position is the item the cursor is on and the index its next bucket
+static bool _hashSetCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator) {
+    alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+
+    iterator -> collection = collection;
+    iterator -> position = NULL;
+    iterator -> index = 0;
+
+    return _hashSetCollectionNext(iterator);
+}
+
+static bool _hashSetCollectionNext(struct CIterator * const iterator) {
+    struct HashSet const * const set = (struct HashSet const * const) iterator -> collection;
+
+    struct HashSetCursor cursor = hashSetCursor(set);
+    cursor.entry = iterator -> position;
+    cursor.bucket = iterator -> index;
+
+    bool found = hashSetCursorNext(set, &cursor);
+    iterator -> position = cursor.entry;
+    iterator -> index = cursor.bucket;
+
+    return found;
+}
+
+static void * _hashSetCollectionDeref(struct CIterator const * const iterator) {
+    return iterator -> position;
+}
+
+
 static void * createItem(unsigned value_len, void * value, uint64_t hash, struct HashSetItem * prev, struct HashSetItem * next) {
     struct HashSetItem * item = malloc(sizeof *item);
     if (item == NULL)
@@ -362,3 +472,53 @@ static void deleteItem(struct HashSetItem * item, CDeleter deleter) {
 
     free(item);
 }
+
+
+/*
+ * Moves every item of the chain starting at the given item into the given bucket array, using their stored hash.
+ * Returns the number of buckets that went from empty to occupied.
+ */
+static unsigned moveChain(struct HashSetItem * item, struct HashSetItem ** items, unsigned capacity) {
+    unsigned buckets_count = 0;
+
+    while (item != NULL) {
+        // We read the link before relinking the item and start fetching the next node right away
+        struct HashSetItem * next = item -> next;
+        __builtin_prefetch(next);
+
+        struct HashSetItem ** bucket = &items[item -> hash % capacity];
+        if (* bucket == NULL)
+            buckets_count++;
+        else
+            (* bucket) -> prev = item;
+
+        item -> prev = NULL;
+        item -> next = * bucket;
+        * bucket = item;
+
+        item = next;
+    }
+
+    return buckets_count;
+}
+
+/*
+ * Without an equality function, two values with the same 64-bit hash are considered identical.
+ * Otherwise the hash only serves as a quick filter before the values themselves are compared.
+ */
+static inline bool valuesMatch(struct HashSet const * const set, struct HashSetItem const * item,
+    uint64_t hash, unsigned value_len, void const * value) {
+    if (item -> hash != hash)
+        return false;
+
+    if (set -> equals == NULL)
+        return true;
+
+    return item -> value_len == value_len && set -> equals(item -> value, value, value_len);
+}
+
+
+// Items may move or disappear, so the position remembered by the collection interface no longer holds
+static inline void forgetCursor(struct HashSet * const set) {
+    set -> cursor.entry = NULL;
+}
@@ -1,39 +0,0 @@
-/* <MIT License>
- Copyright (c) 2013  Marek Majkowski <marek@popcount.org>
-
- Permission is hereby granted, free of charge, to any person obtaining a copy
- of this software and associated documentation files (the "Software"), to deal
- in the Software without restriction, including without limitation the rights
- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
- copies of the Software, and to permit persons to whom the Software is
- furnished to do so, subject to the following conditions:
-
- The above copyright notice and this permission notice shall be included in
- all copies or substantial portions of the Software.
-
- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
- THE SOFTWARE.
- </MIT License>
-
- Original location:
-    https://github.com/majek/csiphash/
-
- Solution inspired by code from:
-    Samuel Neves (supercop/crypto_auth/siphash24/little)
-    djb (supercop/crypto_auth/siphash24/little2)
-    Jean-Philippe Aumasson (https://131002.net/siphash/siphash24.c)
-*/
-
-#ifndef __MAJEK_SIPHASH_H
-#define __MAJEK_SIPHASH_H
-
-#include <stdint.h>
-
-uint64_t siphash24(const char *in, unsigned long inlen, const char k[16]);
-
-#endif
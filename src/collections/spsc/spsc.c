@@ -0,0 +1,250 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "spsc.h"
+
+/*
+ * The producer publishes elements by storing the tail with release semantics after writing the slots,
+ * and the consumer reads the tail with acquire semantics before reading the slots. The head works the other way around.
+ * Each side reads its own index without any ordering since nobody else writes it.
+ */
+
+static void copySlots(struct SpscQueue const * const queue, unsigned index, void ** elements, unsigned count, bool into_queue);
+
+
+/**
+ * Initializes the queue
+ *
+ * @param       capacity the maximum number of elements in the queue, rounded up to a power of two.
+ *
+ * @return      the newly created queue.
+ */
+struct SpscQueue * newSpscQueue(unsigned capacity) {
+    alt_assert(capacity != 0, "Queue capacity cannot be zero.");
+    alt_assert(capacity <= (1u << 31), "Queue capacity cannot exceed 2^31.");
+
+    unsigned rounded = 1;
+    while (rounded < capacity)
+        rounded *= 2;
+
+    // The indices must not share a cache line with whatever the allocator puts next to the queue
+    struct SpscQueue * queue = aligned_alloc(CACHE_LINE_SIZE, sizeof *queue);
+    if (queue == NULL)
+        return NULL;
+
+    void ** slots = malloc(rounded * sizeof *slots);
+    if (slots == NULL) {
+        free(queue);
+        return NULL;
+    }
+
+    queue -> slots = slots;
+    queue -> capacity = rounded;
+    queue -> mask = rounded - 1;
+    queue -> tail = 0;
+    queue -> cached_head = 0;
+    queue -> head = 0;
+    queue -> cached_tail = 0;
+
+    return queue;
+}
+
+
+/**
+ * Frees the memory occupied by the queue. Neither the producer nor the consumer may be using it anymore.
+ *
+ * @param       queue   pointer to memory occupied by the queue.
+ * @param       deleter function called on the elements still in the queue, if not NULL.
+ */
+void deleteSpscQueue(struct SpscQueue ** const queue, CDeleter deleter) {
+    if (queue == NULL)
+        return;
+
+    if (* queue == NULL)
+        return;
+
+    if (deleter != NULL) {
+        for (unsigned i = (* queue) -> head; i != (* queue) -> tail; i++)
+            deleter((* queue) -> slots[i & (* queue) -> mask]);
+    }
+
+    free((* queue) -> slots);
+    free(* queue);
+    * queue = NULL;
+}
+
+
+/**
+ * Check if the queue is empty. Only the consumer gets an answer it can rely on.
+ *
+ * @param       queue pointer to the queue which content to check.
+ *
+ * @return      true if the queue is empty, false otherwise.
+ */
+bool isSpscQueueEmpty(struct SpscQueue * const queue) {
+    alt_assert(queue != NULL, "The parameter <queue> cannot be NULL.");
+
+    return __atomic_load_n(&queue -> head, __ATOMIC_RELAXED) == __atomic_load_n(&queue -> tail, __ATOMIC_ACQUIRE);
+}
+
+
+/**
+ * Pushes an element to the back of the queue. To be called from the producer thread only.
+ *
+ * @param       queue   pointer to queue to push back onto.
+ * @param       element pointer to the element to push back, which cannot be NULL since popping returns NULL for an empty queue.
+ *
+ * @return      true if the element was pushed, false if the queue is full.
+ */
+bool spscQueuePushBack(struct SpscQueue * const queue, void * element) {
+    alt_assert(queue != NULL, "The parameter <queue> cannot be NULL.");
+    alt_assert(element != NULL, "The parameter <element> cannot be NULL.");
+
+    unsigned tail = __atomic_load_n(&queue -> tail, __ATOMIC_RELAXED);
+
+    // We only look at the consumer's index when the queue seems full
+    if (tail - queue -> cached_head == queue -> capacity) {
+        queue -> cached_head = __atomic_load_n(&queue -> head, __ATOMIC_ACQUIRE);
+        if (tail - queue -> cached_head == queue -> capacity)
+            return false;
+    }
+
+    queue -> slots[tail & queue -> mask] = element;
+    __atomic_store_n(&queue -> tail, tail + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+
+/**
+ * Pops the element at the front of the queue. To be called from the consumer thread only.
+ *
+ * @param       queue pointer to queue to pop front from.
+ *
+ * @return      the element at the front of the queue, or NULL if the queue is empty.
+ */
+void * spscQueuePopFront(struct SpscQueue * const queue) {
+    alt_assert(queue != NULL, "The parameter <queue> cannot be NULL.");
+
+    unsigned head = __atomic_load_n(&queue -> head, __ATOMIC_RELAXED);
+
+    // We only look at the producer's index when the queue seems empty
+    if (head == queue -> cached_tail) {
+        queue -> cached_tail = __atomic_load_n(&queue -> tail, __ATOMIC_ACQUIRE);
+        if (head == queue -> cached_tail)
+            return NULL;
+    }
+
+    void * element = queue -> slots[head & queue -> mask];
+    __atomic_store_n(&queue -> head, head + 1, __ATOMIC_RELEASE);
+
+    return element;
+}
+
+
+/**
+ * Pushes as many of the given elements as fit to the back of the queue, in order. To be called from the producer thread only.
+ *
+ * @param       queue       pointer to queue to push back onto.
+ * @param       elements    the elements to push back, none of which can be NULL.
+ * @param       count       the number of elements to push back.
+ *
+ * @return      the number of elements pushed, which is less than count if the queue filled up.
+ */
+unsigned spscQueuePushBackN(struct SpscQueue * const queue, void * const * elements, unsigned count) {
+    alt_assert(queue != NULL, "The parameter <queue> cannot be NULL.");
+    alt_assert(elements != NULL || count == 0, "The parameter <elements> cannot be NULL.");
+    for (unsigned i = 0; i < count; i++)
+        alt_assert(elements[i] != NULL, "The parameter <elements> cannot contain NULL.");
+
+    unsigned tail = __atomic_load_n(&queue -> tail, __ATOMIC_RELAXED);
+    unsigned room = queue -> capacity - (tail - queue -> cached_head);
+    if (room < count) {
+        queue -> cached_head = __atomic_load_n(&queue -> head, __ATOMIC_ACQUIRE);
+        room = queue -> capacity - (tail - queue -> cached_head);
+    }
+
+    if (count > room)
+        count = room;
+
+    if (count == 0)
+        return 0;
+
+    // The whole batch is published with a single store
+    copySlots(queue, tail, (void **) elements, count, true);
+    __atomic_store_n(&queue -> tail, tail + count, __ATOMIC_RELEASE);
+
+    return count;
+}
+
+
+/**
+ * Pops up to count elements from the front of the queue. To be called from the consumer thread only.
+ *
+ * @param       queue       pointer to queue to pop front from.
+ * @param       destination where to store the popped elements, the front of the queue first.
+ * @param       count       the maximum number of elements to pop.
+ *
+ * @return      the number of elements popped, which is less than count if the queue held fewer elements.
+ */
+unsigned spscQueuePopFrontN(struct SpscQueue * const queue, void ** destination, unsigned count) {
+    alt_assert(queue != NULL, "The parameter <queue> cannot be NULL.");
+    alt_assert(destination != NULL || count == 0, "The parameter <destination> cannot be NULL.");
+
+    unsigned head = __atomic_load_n(&queue -> head, __ATOMIC_RELAXED);
+    unsigned available = queue -> cached_tail - head;
+    if (available < count) {
+        queue -> cached_tail = __atomic_load_n(&queue -> tail, __ATOMIC_ACQUIRE);
+        available = queue -> cached_tail - head;
+    }
+
+    if (count > available)
+        count = available;
+
+    if (count == 0)
+        return 0;
+
+    copySlots(queue, head, destination, count, false);
+    __atomic_store_n(&queue -> head, head + count, __ATOMIC_RELEASE);
+
+    return count;
+}
+
+
+// Copies elements to or from the slots starting at the given index, in two parts if they wrap around the end
+static void copySlots(struct SpscQueue const * const queue, unsigned index, void ** elements, unsigned count, bool into_queue) {
+    unsigned start = index & queue -> mask;
+    unsigned first = queue -> capacity - start;
+    if (first > count)
+        first = count;
+
+    if (into_queue) {
+        memcpy(queue -> slots + start, elements, first * sizeof(void *));
+        memcpy(queue -> slots, elements + first, (count - first) * sizeof(void *));
+    }
+    else {
+        memcpy(elements, queue -> slots + start, first * sizeof(void *));
+        memcpy(elements + first, queue -> slots, (count - first) * sizeof(void *));
+    }
+}
@@ -0,0 +1,272 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "mpmc.h"
+#include "wsdeque.h"
+#include "taskpool.h"
+
+/*
+ * A worker about to sleep first registers itself as a sleeper, then looks for tasks one last time.
+ * A thread spawning a task first publishes it, then checks for sleepers.
+ * Both sides put a sequentially consistent fence between their two steps, so either the worker finds the task
+ * or the spawner sees the sleeper and signals it. The worker looks and waits while holding the mutex,
+ * which the spawner takes to signal, so the signal cannot fall between the two.
+ */
+
+#define SPINS_BEFORE_SLEEP 64
+#define INJECTED_QUEUE_CAPACITY 1024
+
+// The worker running on the current thread, if any
+static _Thread_local struct TaskPoolWorker * current_worker = NULL;
+
+static void * runWorker(void * argument);
+static struct Task * findTask(struct TaskPool * const pool, struct TaskPoolWorker * const worker, unsigned * const seed);
+static void runTask(struct TaskPool * const pool, struct Task * const task);
+static void wakeSleeper(struct TaskPool * const pool);
+static unsigned nextRandom(unsigned * const seed);
+
+
+/**
+ * Initializes the pool and starts its workers
+ *
+ * @param       workers_count the number of worker threads, or 0 for one per online processor.
+ *
+ * @return      the newly created pool.
+ */
+struct TaskPool * newTaskPool(unsigned workers_count) {
+    if (workers_count == 0) {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        workers_count = processors > 0 ? processors : 1;
+    }
+
+    struct TaskPool * pool = malloc(sizeof *pool);
+    if (pool == NULL)
+        return NULL;
+
+    pool -> workers = aligned_alloc(CACHE_LINE_SIZE, workers_count * sizeof *pool -> workers);
+    pool -> injected = newMpmcQueue(INJECTED_QUEUE_CAPACITY);
+    if (pool -> workers == NULL || pool -> injected == NULL) {
+        deleteMpmcQueue(&pool -> injected, NULL);
+        free(pool -> workers);
+        free(pool);
+        return NULL;
+    }
+
+    pool -> workers_count = workers_count;
+    pool -> sleepers = 0;
+    pool -> stopping = false;
+    pthread_mutex_init(&pool -> mutex, NULL);
+    pthread_cond_init(&pool -> wakeup, NULL);
+
+    // All deques must exist before any worker starts stealing
+    for (unsigned i = 0; i < workers_count; i++) {
+        pool -> workers[i].pool = pool;
+        pool -> workers[i].deque = newWorkStealingDeque(64);
+        pool -> workers[i].seed = 2 * i + 1;
+        alt_assert(pool -> workers[i].deque != NULL, "Failed to allocate the deque of a worker.");
+    }
+
+    for (unsigned i = 0; i < workers_count; i++) {
+        int error = pthread_create(&pool -> workers[i].thread, NULL, runWorker, &pool -> workers[i]);
+        alt_assert(error == 0, "Failed to start a worker.");
+    }
+
+    return pool;
+}
+
+
+/**
+ * Stops the workers and frees the memory occupied by the pool. Tasks that haven't started yet are never run.
+ *
+ * @param       pool pointer to memory occupied by the pool.
+ */
+void deleteTaskPool(struct TaskPool ** const pool) {
+    if (pool == NULL)
+        return;
+
+    if (* pool == NULL)
+        return;
+
+    pthread_mutex_lock(&(* pool) -> mutex);
+    __atomic_store_n(&(* pool) -> stopping, true, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&(* pool) -> wakeup);
+    pthread_mutex_unlock(&(* pool) -> mutex);
+
+    for (unsigned i = 0; i < (* pool) -> workers_count; i++)
+        pthread_join((* pool) -> workers[i].thread, NULL);
+
+    for (unsigned i = 0; i < (* pool) -> workers_count; i++)
+        deleteWorkStealingDeque(&(* pool) -> workers[i].deque, NULL);
+
+    deleteMpmcQueue(&(* pool) -> injected, NULL);
+    pthread_cond_destroy(&(* pool) -> wakeup);
+    pthread_mutex_destroy(&(* pool) -> mutex);
+    free((* pool) -> workers);
+    free(* pool);
+    * pool = NULL;
+}
+
+
+/**
+ * Schedules a task on the pool. The task must stay valid until taskPoolWait returns for it.
+ *
+ * @param       pool        pointer to the pool to run the task on.
+ * @param       task        the task to schedule.
+ * @param       function    the function the task runs.
+ * @param       argument    the argument passed to the function.
+ */
+void taskPoolSpawn(struct TaskPool * const pool, struct Task * const task, TaskFunction function, void * argument) {
+    alt_assert(pool != NULL, "The parameter <pool> cannot be NULL.");
+    alt_assert(task != NULL, "The parameter <task> cannot be NULL.");
+    alt_assert(function != NULL, "The parameter <function> cannot be NULL.");
+
+    task -> function = function;
+    task -> argument = argument;
+    task -> done = false;
+
+    if (current_worker != NULL && current_worker -> pool == pool)
+        workStealingDequePushBack(current_worker -> deque, task);
+    else
+        mpmcQueuePushBack(pool -> injected, task);
+
+    wakeSleeper(pool);
+}
+
+
+/**
+ * Waits for a task to finish, running other tasks of the pool in the meantime.
+ *
+ * @param       pool    pointer to the pool the task was spawned on.
+ * @param       task    the task to wait for.
+ */
+void taskPoolWait(struct TaskPool * const pool, struct Task * const task) {
+    alt_assert(pool != NULL, "The parameter <pool> cannot be NULL.");
+    alt_assert(task != NULL, "The parameter <task> cannot be NULL.");
+
+    struct TaskPoolWorker * worker = current_worker != NULL && current_worker -> pool == pool ? current_worker : NULL;
+    // Threads outside the pool pick their victims with a seed of their own
+    unsigned outside_seed = (unsigned) (uintptr_t) task | 1;
+    unsigned * seed = worker != NULL ? &worker -> seed : &outside_seed;
+
+    while (__atomic_load_n(&task -> done, __ATOMIC_ACQUIRE) == false) {
+        struct Task * other = findTask(pool, worker, seed);
+        if (other != NULL)
+            runTask(pool, other);
+        else
+            // The task is running on another thread, which may need our processor to finish it
+            sched_yield();
+    }
+}
+
+
+static void * runWorker(void * argument) {
+    struct TaskPoolWorker * worker = argument;
+    struct TaskPool * pool = worker -> pool;
+    unsigned idle = 0;
+
+    current_worker = worker;
+
+    while (__atomic_load_n(&pool -> stopping, __ATOMIC_ACQUIRE) == false) {
+        struct Task * task = findTask(pool, worker, &worker -> seed);
+        if (task != NULL) {
+            runTask(pool, task);
+            idle = 0;
+            continue;
+        }
+
+        if (idle < SPINS_BEFORE_SLEEP) {
+            idle++;
+            sched_yield();
+            continue;
+        }
+
+        pthread_mutex_lock(&pool -> mutex);
+        __atomic_fetch_add(&pool -> sleepers, 1, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        task = findTask(pool, worker, &worker -> seed);
+        if (task == NULL && __atomic_load_n(&pool -> stopping, __ATOMIC_ACQUIRE) == false)
+            pthread_cond_wait(&pool -> wakeup, &pool -> mutex);
+
+        __atomic_fetch_sub(&pool -> sleepers, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&pool -> mutex);
+
+        if (task != NULL)
+            runTask(pool, task);
+        idle = 0;
+    }
+
+    current_worker = NULL;
+    return NULL;
+}
+
+
+// Looks for a task in the deque of the worker first, then in the shared queue, then in the deques of the other workers
+static struct Task * findTask(struct TaskPool * const pool, struct TaskPoolWorker * const worker, unsigned * const seed) {
+    struct Task * task;
+
+    if (worker != NULL && (task = workStealingDequePopBack(worker -> deque)) != NULL)
+        return task;
+
+    if ((task = mpmcQueueTryPopFront(pool -> injected)) != NULL)
+        return task;
+
+    unsigned start = nextRandom(seed) % pool -> workers_count;
+
+    for (unsigned i = 0; i < pool -> workers_count; i++) {
+        struct TaskPoolWorker * victim = &pool -> workers[(start + i) % pool -> workers_count];
+        if (victim != worker && (task = workStealingDequeSteal(victim -> deque)) != NULL)
+            return task;
+    }
+
+    return NULL;
+}
+
+static void runTask(struct TaskPool * const pool, struct Task * const task) {
+    task -> function(pool, task -> argument);
+    __atomic_store_n(&task -> done, true, __ATOMIC_RELEASE);
+}
+
+static void wakeSleeper(struct TaskPool * const pool) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&pool -> sleepers, __ATOMIC_SEQ_CST) == 0)
+        return;
+
+    pthread_mutex_lock(&pool -> mutex);
+    pthread_cond_signal(&pool -> wakeup);
+    pthread_mutex_unlock(&pool -> mutex);
+}
+
+// xorshift32, which is plenty for picking victims
+static unsigned nextRandom(unsigned * const seed) {
+    unsigned x = * seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    * seed = x;
+    return x;
+}
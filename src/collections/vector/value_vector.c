@@ -0,0 +1,365 @@
+/*  This file is part of the CCollections library.
+ * 
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "vector.h"
+
+static void * _valueVectorCollectionGet(struct Collection * const collection, unsigned index);
+static void _valueVectorCollectionSet(struct Collection * const collection, unsigned index, void * element);
+static bool _valueVectorCollectionAtEnd(struct Collection const * const collection, unsigned index);
+static bool _valueVectorCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator);
+static bool _valueVectorCollectionNext(struct CIterator * const iterator);
+static void * _valueVectorCollectionDeref(struct CIterator const * const iterator);
+
+static bool reserve(struct ValueVector * const vector, unsigned count);
+static inline char * elementAt(struct ValueVector const * const vector, unsigned index);
+
+
+/**
+ * Initializes a vector that stores elements of the given size by value.
+ *
+ * @param       element_size        the size of each element in bytes.
+ * @param       initial_capacity    the number of elements to make room for.
+ *
+ * @return      the newly created vector.
+ */
+struct ValueVector * newValueVector(unsigned element_size, unsigned initial_capacity) {
+    alt_assert(element_size > 0, "The size of the elements cannot be zero.");
+    alt_assert(initial_capacity > 0, "Initial vector capacity cannot be zero.");
+
+    struct ValueVector * vector = malloc(sizeof *vector);
+    if (vector == NULL)
+       return NULL;
+
+    vector -> elements = malloc((size_t) initial_capacity * element_size);
+    if (vector -> elements == NULL) {
+        free(vector);
+        return NULL;
+    }
+
+    struct Collection collection = {
+        .get = _valueVectorCollectionGet,
+        .set = _valueVectorCollectionSet,
+        .atEnd = _valueVectorCollectionAtEnd,
+        .begin = _valueVectorCollectionBegin,
+        .next = _valueVectorCollectionNext,
+        .deref = _valueVectorCollectionDeref,
+        // Elements are stored by value, so there is no array of pointers to hand out
+        .span = NULL,
+    };
+
+    vector -> collection = collection;
+    vector -> element_size = element_size;
+    vector -> capacity = initial_capacity;
+    vector -> size = 0;
+
+    return vector;
+}
+
+
+/**
+ * Frees the memory occupied by the vector.
+ *
+ * @param       vector  pointer to memory occupied by the vector.
+ * @param       deleter called with a pointer to each element, to release what the elements own.
+ */
+void deleteValueVector(struct ValueVector ** const vector, CDeleter deleter) {
+    if (vector == NULL)
+        return;
+
+    if (* vector == NULL)
+        return;
+
+    if (deleter != NULL) {
+        for (unsigned i = 0; i < (* vector) -> size; i++)
+            deleter(elementAt(* vector, i));
+    }
+
+    free((* vector) -> elements);
+    free(* vector);
+    * vector = NULL;
+}
+
+
+/**
+ * Resizes the given vector to higher capacity.
+ *
+ * @param       vector pointer to vector to resize.
+ * @param       new_capacity the new capacity of the vector.
+ *
+ * @return      the newly resized vector.
+ */
+struct ValueVector * resizeValueVector(struct ValueVector * const vector, unsigned new_capacity) {
+    alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");
+    alt_assert(new_capacity > vector -> capacity, "The new capacity cannot be less or equal to the existing capacity.");
+
+    char * new_elements = realloc(vector -> elements, (size_t) new_capacity * vector -> element_size);
+    if (new_elements == NULL)
+        return NULL;
+
+    vector -> elements = new_elements;
+    vector -> capacity = new_capacity;
+
+    return vector;
+}
+
+
+/**
+ * Check if the vector is empty.
+ *
+ * @param       vector pointer to the vector which content to check.
+ *
+ * @return      true if the vector is empty, false otherwise.
+ */
+bool isValueVectorEmpty(struct ValueVector const * const vector) {
+    alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");
+
+    return vector -> size == 0;
+}
+
+
+/**
+ * Copies an element at the end of the vector.
+ *
+ * @param       vector  pointer to vector to append an element to.
+ * @param       element pointer to the element to copy.
+ *
+ * @return      true if the element was added, false otherwise (probably due to insufficient memory)
+ */
+bool valueVectorPushBack(struct ValueVector * const vector, void const * element) {
+    return valueVectorPushBackMany(vector, element, 1);
+}
+
+
+/**
+ * Copies several elements at the end of the vector at once.
+ *
+ * @param       vector      pointer to vector to append the elements to.
+ * @param       elements    pointer to the first of the elements to copy, which are laid out one after the other.
+ * @param       count       the number of elements to copy.
+ *
+ * @return      true if the elements were added, false otherwise (probably due to insufficient memory)
+ */
+bool valueVectorPushBackMany(struct ValueVector * const vector, void const * elements, unsigned count) {
+    alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");
+    alt_assert(elements != NULL || count == 0, "The parameter <elements> cannot be NULL.");
+
+    if (reserve(vector, count) == false)
+        return false;
+
+    memcpy(elementAt(vector, vector -> size), elements, (size_t) count * vector -> element_size);
+    vector -> size += count;
+
+    return true;
+}
+
+
+/**
+ * Get the element at the specified index.
+ *
+ * @param       vector pointer to vector to use.
+ * @param       index the index at which to look.
+ *
+ * @return      a pointer to the element, valid until the vector is modified.
+ */
+void * valueVectorGet(struct ValueVector const * const vector, unsigned index) {
+    alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");
+    alt_assert(vector -> size > 0, "The vector is empty, cannot get elements.");
+    alt_assert(index < vector -> size, "The index is out of bounds.");
+
+    return elementAt(vector, index);
+}
+
+
+/**
+ * Copies elements starting at the specified index out of the vector.
+ *
+ * @param       vector      pointer to vector to use.
+ * @param       index       the index of the first element to copy.
+ * @param       count       the number of elements to copy.
+ * @param       destination where to copy the elements to, it must have room for count elements.
+ */
+void valueVectorGetMany(struct ValueVector const * const vector, unsigned index, unsigned count, void * destination) {
+    alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");
+    alt_assert(destination != NULL || count == 0, "The parameter <destination> cannot be NULL.");
+    alt_assert(index <= vector -> size && count <= vector -> size - index, "The index is out of bounds.");
+
+    memcpy(destination, elementAt(vector, index), (size_t) count * vector -> element_size);
+}
+
+
+/**
+ * Overwrites the element at the specified index with a copy of the given one.
+ *
+ * @param       vector pointer to vector to use.
+ * @param       index the index at which to write.
+ * @param       element pointer to the element to copy.
+ */
+void valueVectorSet(struct ValueVector * const vector, unsigned index, void const * element) {
+    alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");
+    alt_assert(vector -> size > 0, "The vector is empty, cannot set elements.");
+    alt_assert(index < vector -> size, "The index is out of bounds.");
+
+    memcpy(elementAt(vector, index), element, vector -> element_size);
+}
+
+
+/**
+ * Copies an element at the given position, moving the following elements to the right.
+ *
+ * @param       vector  pointer to vector to use.
+ * @param       index   the index where to insert the element, at most the size of the vector.
+ * @param       element pointer to the element to copy.
+ *
+ * @return      true if the element was inserted, false otherwise (probably due to insufficient memory)
+ */
+bool valueVectorInsert(struct ValueVector * const vector, unsigned index, void const * element) {
+    return valueVectorInsertMany(vector, index, element, 1);
+}
+
+
+/**
+ * Copies several elements at the given position at once, moving the following elements to the right.
+ *
+ * @param       vector      pointer to vector to use.
+ * @param       index       the index where to insert the elements, at most the size of the vector.
+ * @param       elements    pointer to the first of the elements to copy, which are laid out one after the other.
+ * @param       count       the number of elements to copy.
+ *
+ * @return      true if the elements were inserted, false otherwise (probably due to insufficient memory)
+ */
+bool valueVectorInsertMany(struct ValueVector * const vector, unsigned index, void const * elements, unsigned count) {
+    alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");
+    alt_assert(elements != NULL || count == 0, "The parameter <elements> cannot be NULL.");
+    alt_assert(index <= vector -> size, "The index is out of bounds.");
+
+    if (reserve(vector, count) == false)
+        return false;
+
+    // The elements to insert cannot come from the vector itself since moving the tail could overwrite them
+    memmove(elementAt(vector, index + count), elementAt(vector, index), (size_t) (vector -> size - index) * vector -> element_size);
+    memcpy(elementAt(vector, index), elements, (size_t) count * vector -> element_size);
+    vector -> size += count;
+
+    return true;
+}
+
+
+/**
+ * Removes the element at the given position, moving the following elements to the left.
+ *
+ * @param       vector  pointer to vector to use.
+ * @param       index   the index of the element to remove.
+ * @param       deleter called with a pointer to the element before it is removed, can be NULL.
+ */
+void valueVectorErase(struct ValueVector * const vector, unsigned index, CDeleter deleter) {
+    valueVectorEraseMany(vector, index, 1, deleter);
+}
+
+
+/**
+ * Removes several consecutive elements at once, moving the following elements to the left.
+ *
+ * @param       vector  pointer to vector to use.
+ * @param       index   the index of the first element to remove.
+ * @param       count   the number of elements to remove.
+ * @param       deleter called with a pointer to each element before it is removed, can be NULL.
+ */
+void valueVectorEraseMany(struct ValueVector * const vector, unsigned index, unsigned count, CDeleter deleter) {
+    alt_assert(vector != NULL, "The parameter <vector> cannot be NULL.");
+    alt_assert(index <= vector -> size && count <= vector -> size - index, "The index is out of bounds.");
+
+    if (deleter != NULL) {
+        for (unsigned i = index; i < index + count; i++)
+            deleter(elementAt(vector, i));
+    }
+
+    memmove(elementAt(vector, index), elementAt(vector, index + count), (size_t) (vector -> size - index - count) * vector -> element_size);
+    vector -> size -= count;
+}
+
+
+static void * _valueVectorCollectionGet(struct Collection * const collection, unsigned index) {
+    alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
+
+    return valueVectorGet((struct ValueVector const * const) collection, index);
+}
+
+static void _valueVectorCollectionSet(struct Collection * const collection, unsigned index, void * element) {
+    alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
+
+    valueVectorSet((struct ValueVector * const) collection, index, element);
+}
+
+static bool _valueVectorCollectionAtEnd(struct Collection const * const collection, unsigned index) {
+    alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
+
+    struct ValueVector const * const vector = (struct ValueVector const * const) collection;
+
+    return index >= vector -> size;
+}
+
+// The position is the address of the current element, so each step is a single addition
+static bool _valueVectorCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator) {
+    alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+
+    struct ValueVector const * const vector = (struct ValueVector const * const) collection;
+
+    iterator -> collection = collection;
+    iterator -> position = vector -> elements;
+    iterator -> index = 0;
+
+    return vector -> size > 0;
+}
+
+static bool _valueVectorCollectionNext(struct CIterator * const iterator) {
+    struct ValueVector const * const vector = (struct ValueVector const * const) iterator -> collection;
+
+    iterator -> position = (char *) iterator -> position + vector -> element_size;
+
+    return ++iterator -> index < vector -> size;
+}
+
+static void * _valueVectorCollectionDeref(struct CIterator const * const iterator) {
+    return iterator -> position;
+}
+
+
+// Makes room for count more elements, growing geometrically so that appending stays amortized O(1)
+static bool reserve(struct ValueVector * const vector, unsigned count) {
+    if (vector -> size + count <= vector -> capacity)
+        return true;
+
+    unsigned new_capacity = vector -> capacity;
+    while (new_capacity < vector -> size + count) {
+        unsigned grown = vector_growth_factor * new_capacity;
+        new_capacity = grown > new_capacity ? grown : new_capacity + 1;
+    }
+
+    return resizeValueVector(vector, new_capacity) != NULL;
+}
+
+static inline char * elementAt(struct ValueVector const * const vector, unsigned index) {
+    return vector -> elements + (size_t) index * vector -> element_size;
+}
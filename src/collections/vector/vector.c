@@ -27,6 +27,10 @@
 static void * _vectorCollectionGet(struct Collection * const collection, unsigned index);
 static void _vectorCollectionSet(struct Collection * const collection, unsigned index, void * element);
 static bool _vectorCollectionAtEnd(struct Collection const * const collection, unsigned index);
+static bool _vectorCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator);
+static bool _vectorCollectionNext(struct CIterator * const iterator);
+static void * _vectorCollectionDeref(struct CIterator const * const iterator);
+static void * const * _vectorCollectionSpan(struct Collection const * const collection, unsigned * const length);
 
 float vector_growth_factor = 1.75;
 
@@ -53,6 +57,10 @@ struct Vector * newVector(unsigned initial_capacity) {
         .get = _vectorCollectionGet,
         .set = _vectorCollectionSet,
         .atEnd = _vectorCollectionAtEnd,
+        .begin = _vectorCollectionBegin,
+        .next = _vectorCollectionNext,
+        .deref = _vectorCollectionDeref,
+        .span = _vectorCollectionSpan,
     };
 
     vector -> collection = collection;
@@ -138,6 +146,9 @@ bool vectorPushBack(struct Vector * const vector, void * element) {
 
     if (vector -> size == vector -> capacity) {
         unsigned new_capacity = vector_growth_factor * vector -> capacity;
+        // Small capacities may not grow at all once multiplied and truncated
+        if (new_capacity <= vector -> capacity)
+            new_capacity = vector -> capacity + 1;
         void ** new_elements = realloc(vector -> elements, new_capacity * sizeof *vector -> elements);
         if (new_elements == NULL)
             return false;
@@ -210,3 +221,39 @@ static bool _vectorCollectionAtEnd(struct Collection const * const collection, u
     return index >= vector -> size;
 }
 
+
+static bool _vectorCollectionBegin(struct Collection const * const collection, struct CIterator * const iterator) {
+    alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
+    alt_assert(iterator != NULL, "The parameter <iterator> cannot be NULL.");
+
+    struct Vector const * const vector = (struct Vector const * const) collection;
+
+    iterator -> collection = collection;
+    iterator -> position = NULL;
+    iterator -> index = 0;
+
+    return vector -> size > 0;
+}
+
+static bool _vectorCollectionNext(struct CIterator * const iterator) {
+    struct Vector const * const vector = (struct Vector const * const) iterator -> collection;
+
+    return ++iterator -> index < vector -> size;
+}
+
+static void * _vectorCollectionDeref(struct CIterator const * const iterator) {
+    struct Vector const * const vector = (struct Vector const * const) iterator -> collection;
+
+    return vector -> elements[iterator -> index];
+}
+
+static void * const * _vectorCollectionSpan(struct Collection const * const collection, unsigned * const length) {
+    alt_assert(collection != NULL, "The parameter <collection> cannot be NULL.");
+    alt_assert(length != NULL, "The parameter <length> cannot be NULL.");
+
+    struct Vector const * const vector = (struct Vector const * const) collection;
+
+    * length = vector -> size;
+    return vector -> elements;
+}
+
@@ -0,0 +1,231 @@
+/*  This file is part of the CCollections library.
+ *
+ *  Copyright (c) 2022- Ntwali B. Toussaint
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "wsdeque.h"
+
+/*
+ * The owner publishes an element by storing the bottom with release semantics once the slot is written,
+ * and thieves load the bottom with acquire semantics before reading the slot.
+ * The owner taking an element and a thief stealing one each announce themselves (the owner by moving the bottom,
+ * the thief by reading the top) then look at the other index, and a sequentially consistent fence between the two
+ * guarantees at least one of them sees the other. If both go for the last element, the compare-and-swap on the top decides.
+ * Slots are accessed atomically, without ordering, because a thief may read a slot the owner is overwriting:
+ * its compare-and-swap then fails and it drops what it read.
+ */
+
+static struct WsArray * newWsArray(long capacity);
+static struct WsArray * growWsArray(struct WsArray * array, long top, long bottom);
+
+
+/**
+ * Initializes the deque
+ *
+ * @param       capacity the number of elements the deque can hold before growing, rounded up to a power of two.
+ *
+ * @return      the newly created deque.
+ */
+struct WorkStealingDeque * newWorkStealingDeque(unsigned capacity) {
+    alt_assert(capacity != 0, "Deque capacity cannot be zero.");
+
+    long rounded = 1;
+    while (rounded < capacity)
+        rounded *= 2;
+
+    struct WorkStealingDeque * deque = aligned_alloc(CACHE_LINE_SIZE, sizeof *deque);
+    if (deque == NULL)
+        return NULL;
+
+    deque -> array = newWsArray(rounded);
+    if (deque -> array == NULL) {
+        free(deque);
+        return NULL;
+    }
+
+    deque -> top = 0;
+    deque -> bottom = 0;
+
+    return deque;
+}
+
+
+/**
+ * Frees the memory occupied by the deque. No thread may be using it anymore.
+ *
+ * @param       deque   pointer to memory occupied by the deque.
+ * @param       deleter function called on the elements still in the deque, if not NULL.
+ */
+void deleteWorkStealingDeque(struct WorkStealingDeque ** const deque, CDeleter deleter) {
+    if (deque == NULL)
+        return;
+
+    if (* deque == NULL)
+        return;
+
+    struct WsArray * array = (* deque) -> array;
+    if (deleter != NULL) {
+        for (long i = (* deque) -> top; i < (* deque) -> bottom; i++)
+            deleter(array -> slots[i & array -> mask]);
+    }
+
+    while (array != NULL) {
+        struct WsArray * previous = array -> previous;
+        free(array);
+        array = previous;
+    }
+
+    free(* deque);
+    * deque = NULL;
+}
+
+
+/**
+ * Check if the deque is empty. The answer may be stale by the time it is returned if other threads are using the deque.
+ *
+ * @param       deque pointer to the deque which content to check.
+ *
+ * @return      true if the deque is empty, false otherwise.
+ */
+bool isWorkStealingDequeEmpty(struct WorkStealingDeque * const deque) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+
+    long top = __atomic_load_n(&deque -> top, __ATOMIC_ACQUIRE);
+    long bottom = __atomic_load_n(&deque -> bottom, __ATOMIC_ACQUIRE);
+
+    return bottom <= top;
+}
+
+
+/**
+ * Pushes an element to the back of the deque, growing it if needed. To be called from the owner thread only.
+ *
+ * @param       deque   pointer to deque to push back onto.
+ * @param       element pointer to the element to push back, which cannot be NULL since popping and stealing return NULL when there is nothing to take.
+ */
+void workStealingDequePushBack(struct WorkStealingDeque * const deque, void * element) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+    alt_assert(element != NULL, "The parameter <element> cannot be NULL.");
+
+    long bottom = __atomic_load_n(&deque -> bottom, __ATOMIC_RELAXED);
+    long top = __atomic_load_n(&deque -> top, __ATOMIC_ACQUIRE);
+    struct WsArray * array = __atomic_load_n(&deque -> array, __ATOMIC_RELAXED);
+
+    if (bottom - top > array -> mask) {
+        array = growWsArray(array, top, bottom);
+        alt_assert(array != NULL, "Failed to allocate space for new elements to push to the back.");
+        __atomic_store_n(&deque -> array, array, __ATOMIC_RELEASE);
+    }
+
+    __atomic_store_n(&array -> slots[bottom & array -> mask], element, __ATOMIC_RELAXED);
+    __atomic_store_n(&deque -> bottom, bottom + 1, __ATOMIC_RELEASE);
+}
+
+
+/**
+ * Pops the element at the back of the deque. To be called from the owner thread only.
+ *
+ * @param       deque pointer to deque to pop back from.
+ *
+ * @return      the element at the back of the deque, or NULL if the deque is empty.
+ */
+void * workStealingDequePopBack(struct WorkStealingDeque * const deque) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+
+    long bottom = __atomic_load_n(&deque -> bottom, __ATOMIC_RELAXED) - 1;
+    struct WsArray * array = __atomic_load_n(&deque -> array, __ATOMIC_RELAXED);
+
+    // We reserve the back element before looking at what thieves are doing
+    __atomic_store_n(&deque -> bottom, bottom, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    long top = __atomic_load_n(&deque -> top, __ATOMIC_RELAXED);
+
+    if (top > bottom) {
+        // The deque was empty, we put the bottom back where it was
+        __atomic_store_n(&deque -> bottom, bottom + 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    void * element = __atomic_load_n(&array -> slots[bottom & array -> mask], __ATOMIC_RELAXED);
+    if (top < bottom)
+        return element;
+
+    // This is the last element, thieves may be after it too so we take it the way they do
+    if (__atomic_compare_exchange_n(&deque -> top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED) == false)
+        element = NULL;
+
+    __atomic_store_n(&deque -> bottom, bottom + 1, __ATOMIC_RELAXED);
+    return element;
+}
+
+
+/**
+ * Steals the element at the front of the deque. Can be called from any thread.
+ *
+ * @param       deque pointer to deque to steal from.
+ *
+ * @return      the element at the front of the deque, or NULL if the deque is empty or another thread took the element first.
+ */
+void * workStealingDequeSteal(struct WorkStealingDeque * const deque) {
+    alt_assert(deque != NULL, "The parameter <deque> cannot be NULL.");
+
+    long top = __atomic_load_n(&deque -> top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    long bottom = __atomic_load_n(&deque -> bottom, __ATOMIC_ACQUIRE);
+
+    if (top >= bottom)
+        return NULL;
+
+    struct WsArray * array = __atomic_load_n(&deque -> array, __ATOMIC_ACQUIRE);
+    void * element = __atomic_load_n(&array -> slots[top & array -> mask], __ATOMIC_RELAXED);
+
+    // Losing the race means the owner or another thief has the element
+    if (__atomic_compare_exchange_n(&deque -> top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED) == false)
+        return NULL;
+
+    return element;
+}
+
+
+static struct WsArray * newWsArray(long capacity) {
+    struct WsArray * array = malloc(sizeof *array + capacity * sizeof(void *));
+    if (array == NULL)
+        return NULL;
+
+    array -> previous = NULL;
+    array -> capacity = capacity;
+    array -> mask = capacity - 1;
+
+    return array;
+}
+
+// Returns an array twice as large holding the elements between top and bottom at the same positions
+static struct WsArray * growWsArray(struct WsArray * array, long top, long bottom) {
+    struct WsArray * grown = newWsArray(array -> capacity * 2);
+    if (grown == NULL)
+        return NULL;
+
+    for (long i = top; i < bottom; i++)
+        grown -> slots[i & grown -> mask] = __atomic_load_n(&array -> slots[i & array -> mask], __ATOMIC_RELAXED);
+
+    grown -> previous = array;
+    return grown;
+}
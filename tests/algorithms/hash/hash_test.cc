@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <set>
+#include <vector>
+
+extern "C" {
+    #include "hash.h"
+}
+
+
+class HashTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            for (int i = 0; i < 16; i++)
+                key[i] = i;
+
+            for (int i = 0; i < 1024; i++)
+                data[i] = (char) (i * 31 + 7);
+        }
+
+        char key[16];
+        char data[1024];
+};
+
+// sipHash24
+TEST_F(HashTest, sipHash24Test) {
+    // Reference vector from the SipHash paper: the key is 00..0f and the message is 00..0e
+    char message[15];
+    for (int i = 0; i < 15; i++)
+        message[i] = i;
+
+    EXPECT_EQ(sipHash24(message, sizeof message, key), 0xa129ca6149be45e5ULL);
+}
+
+// wyHash
+TEST_F(HashTest, wyHashTest) {
+    // Test vectors of the reference wyhash final version 4, message i hashed with seed i
+    char const * messages[] = {
+        "", "a", "abc", "message digest", "abcdefghijklmnopqrstuvwxyz",
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+        "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+    };
+    uint64_t expected[] = {
+        0x93228a4de0eec5a2ULL, 0xc5bac3db178713c4ULL, 0xa97f2f7b1d9b3314ULL, 0x786d1f1df3801df4ULL,
+        0xdca5a8138ad37c87ULL, 0xb9e734f117cfaf70ULL, 0x6cc5eab49a92d617ULL
+    };
+
+    for (uint64_t i = 0; i < 7; i++) {
+        // The seed is read from the first 8 bytes of the key, in the machine's byte order
+        char seed_key[16] = {0};
+        memcpy(seed_key, &i, sizeof i);
+        EXPECT_EQ(wyHash(messages[i], strlen(messages[i]), seed_key), expected[i]);
+    }
+}
+
+// crc32cHash
+TEST_F(HashTest, crc32cHashTest) {
+    // With the first lane unseeded, the low 32 bits are the standard CRC32C check value
+    char zero_key[16] = {0};
+    EXPECT_EQ(crc32cHash("123456789", 9, zero_key) & 0xffffffff, 0xe3069283);
+
+    // Both lanes differ so the high 32 bits are not a copy of the low ones
+    uint64_t hash = crc32cHash("123456789", 9, zero_key);
+    EXPECT_NE(hash >> 32, hash & 0xffffffff);
+}
+
+// Every hash function must be deterministic, depend on the key and spread prefixes of the same data
+TEST_F(HashTest, hashFunctionsTest) {
+    std::vector<CHasher> hashers = {sipHash24, wyHash, crc32cHash};
+
+    for (CHasher hasher : hashers) {
+        std::set<uint64_t> hashes;
+        for (unsigned length = 0; length <= sizeof data; length++) {
+            uint64_t hash = hasher(data, length, key);
+            EXPECT_EQ(hasher(data, length, key), hash);
+            hashes.insert(hash);
+        }
+        EXPECT_EQ(hashes.size(), sizeof data + 1);
+
+        char other_key[16];
+        memcpy(other_key, key, sizeof key);
+        other_key[0] ^= 1;
+        EXPECT_NE(hasher(data, 64, key), hasher(data, 64, other_key));
+    }
+}
+
+// bytesEqual
+TEST_F(HashTest, bytesEqualTest) {
+    char copy[1024];
+    memcpy(copy, data, sizeof data);
+
+    EXPECT_EQ(bytesEqual(data, copy, sizeof data), true);
+
+    copy[1023] ^= 1;
+    EXPECT_EQ(bytesEqual(data, copy, sizeof data), false);
+    EXPECT_EQ(bytesEqual(data, copy, sizeof data - 1), true);
+}
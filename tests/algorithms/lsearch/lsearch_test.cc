@@ -2,9 +2,14 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
 
 extern "C" {
+    #include "deque.h"
+    #include "list.h"
     #include "lsearch.h"
+    #include "map.h"
+    #include "set.h"
     #include "vector.h"
 }
 
@@ -15,6 +20,15 @@ int int_comparator(void const * a, void const * b) {
     return (*a_int > *b_int) - (*a_int < *b_int);
 }
 
+// Maps and sets hand out their items, so we compare the values they hold
+int map_item_comparator(void const * a, void const * b) {
+    return int_comparator(((struct HashMapItem const *) a) -> value, b);
+}
+
+int set_item_comparator(void const * a, void const * b) {
+    return int_comparator(((struct HashSetItem const *) a) -> value, b);
+}
+
 
 class LSearchTest: public ::testing::Test {
     protected:
@@ -48,3 +62,129 @@ TEST_F(LSearchTest, lsearchTest) {
     index = lsearch(&vector -> collection, &needle, &int_comparator);
     EXPECT_EQ(index, -1);
 }
+
+TEST_F(LSearchTest, lsearchListTest) {
+    struct List * list = newList();
+    for (int i = 0; i < 10; i++)
+        listPushBack(list, &elements[i]);
+
+    // The last element is found too
+    int needle = 10;
+    EXPECT_EQ(lsearch(&list -> collection, &needle, &int_comparator), 9);
+
+    needle = 11;
+    EXPECT_EQ(lsearch(&list -> collection, &needle, &int_comparator), -1);
+
+    deleteList(&list, NULL);
+}
+
+TEST_F(LSearchTest, lsearchDequeTest) {
+    struct Deque * deque = newDeque(3);
+    for (int i = 4; i < 10; i++)
+        dequePushBack(deque, &elements[i]);
+    for (int i = 3; i >= 0; i--)
+        dequePushFront(deque, &elements[i]);
+
+    int needle = 7;
+    EXPECT_EQ(lsearch(&deque -> collection, &needle, &int_comparator), 6);
+
+    needle = 11;
+    EXPECT_EQ(lsearch(&deque -> collection, &needle, &int_comparator), -1);
+
+    deleteDeque(&deque, NULL);
+}
+
+TEST_F(LSearchTest, lsearchHashMapTest) {
+    struct HashMap * map = newHashMap(10);
+    for (int i = 0; i < 10; i++)
+        hashMapInsert(map, sizeof elements[i], &elements[i], &elements[i]);
+
+    // The index is the position through the collection interface
+    int needle = 4;
+    int index = lsearch(&map -> collection, &needle, &map_item_comparator);
+    ASSERT_NE(index, -1);
+    EXPECT_EQ(((struct HashMapItem *) map -> collection.get(&map -> collection, index)) -> value, &elements[3]);
+
+    needle = 11;
+    EXPECT_EQ(lsearch(&map -> collection, &needle, &map_item_comparator), -1);
+
+    deleteHashMap(&map, NULL);
+}
+
+TEST_F(LSearchTest, lsearchHashSetTest) {
+    struct HashSet * set = newHashSet(10);
+    for (int i = 0; i < 10; i++)
+        hashSetInsert(set, sizeof elements[i], &elements[i]);
+
+    int needle = 4;
+    int index = lsearch(&set -> collection, &needle, &set_item_comparator);
+    ASSERT_NE(index, -1);
+    EXPECT_EQ(((struct HashSetItem *) set -> collection.get(&set -> collection, index)) -> value, &elements[3]);
+
+    needle = 11;
+    EXPECT_EQ(lsearch(&set -> collection, &needle, &set_item_comparator), -1);
+
+    deleteHashSet(&set, NULL);
+}
+
+TEST_F(LSearchTest, lsearchPointerTest) {
+    // Sizes around the vector width make sure the tail after the last full vector is searched too
+    for (int size = 0; size <= 40; size++) {
+        struct Vector * haystack = newVector(size + 1);
+        std::vector<int> values(size);
+        for (int i = 0; i < size; i++)
+            vectorPushBack(haystack, &values[i]);
+
+        for (int i = 0; i < size; i++)
+            EXPECT_EQ(lsearchPointer(&haystack -> collection, &values[i]), i);
+
+        // Only the address matters, an equal value elsewhere is not a match
+        int other = 0;
+        EXPECT_EQ(lsearchPointer(&haystack -> collection, &other), -1);
+
+        deleteVector(&haystack, NULL);
+    }
+
+    // The first occurrence wins
+    vectorPushBack(vector, &elements[2]);
+    EXPECT_EQ(lsearchPointer(&vector -> collection, &elements[2]), 2);
+
+    // Collections without a span are walked with their iterator
+    struct List * list = newList();
+    for (int i = 0; i < 10; i++)
+        listPushBack(list, &elements[i]);
+    int missing = 10;
+    EXPECT_EQ(lsearchPointer(&list -> collection, &elements[9]), 9);
+    EXPECT_EQ(lsearchPointer(&list -> collection, &missing), -1);
+    deleteList(&list, NULL);
+}
+
+TEST_F(LSearchTest, lsearchIntegerTest) {
+    struct Vector * keys = newVector(100);
+    for (intptr_t key = -50; key < 50; key++)
+        vectorPushBack(keys, (void *) key);
+
+    EXPECT_EQ(lsearchInteger(&keys -> collection, -50), 0);
+    EXPECT_EQ(lsearchInteger(&keys -> collection, -1), 49);
+    EXPECT_EQ(lsearchInteger(&keys -> collection, 49), 99);
+    EXPECT_EQ(lsearchInteger(&keys -> collection, 50), -1);
+
+    // 64-bit keys must match on both halves
+    EXPECT_EQ(lsearchInteger(&keys -> collection, ((intptr_t) 1 << 32) + 1), -1);
+
+    deleteVector(&keys, NULL);
+}
+
+TEST_F(LSearchTest, lsearchValueVectorTest) {
+    // Elements are stored by value and the comparator receives pointers to them
+    struct ValueVector * values = newValueVector(sizeof(int), 4);
+    valueVectorPushBackMany(values, elements, 10);
+
+    int needle = 7;
+    EXPECT_EQ(lsearch(&values -> collection, &needle, &int_comparator), 6);
+
+    needle = 11;
+    EXPECT_EQ(lsearch(&values -> collection, &needle, &int_comparator), -1);
+
+    deleteValueVector(&values, NULL);
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+    #include "blockingdeque.h"
+}
+
+class BlockingDequeTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            deque = newBlockingDeque(4);
+        }
+
+        void TearDown() override {
+            deleteBlockingDeque(&deque, nullptr);
+        }
+
+        struct BlockingDeque * deque;
+};
+
+static double elapsedMilliseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// newBlockingDeque
+TEST_F(BlockingDequeTest, newBlockingDequeTest) {
+    EXPECT_NE(deque, nullptr);
+    EXPECT_EQ(deque -> capacity, 4);
+    EXPECT_EQ(blockingDequeSize(deque), 0);
+    EXPECT_EQ(isBlockingDequeClosed(deque), false);
+}
+
+// blockingDequePushBack, blockingDequePopFront without waiting
+TEST_F(BlockingDequeTest, pushPopTest) {
+    int values[5];
+    EXPECT_EQ(blockingDequePopFront(deque, 0), nullptr);
+
+    for (int i = 0; i < 4; i++)
+        EXPECT_EQ(blockingDequePushBack(deque, &values[i], 0), true);
+
+    // The deque is bounded
+    EXPECT_EQ(blockingDequePushBack(deque, &values[4], 0), false);
+    EXPECT_EQ(blockingDequeSize(deque), 4);
+
+    for (int i = 0; i < 4; i++)
+        EXPECT_EQ(blockingDequePopFront(deque, 0), &values[i]);
+    EXPECT_EQ(blockingDequePopFront(deque, 0), nullptr);
+
+    // An unbounded deque never refuses elements
+    struct BlockingDeque * unbounded = newBlockingDeque(0);
+    for (int i = 0; i < 1000; i++)
+        EXPECT_EQ(blockingDequePushBack(unbounded, &values[0], 0), true);
+    EXPECT_EQ(blockingDequeSize(unbounded), 1000);
+    deleteBlockingDeque(&unbounded, nullptr);
+
+    deleteBlockingDeque(&deque, nullptr);
+    EXPECT_DEATH(blockingDequePushBack(deque, &values[0], 0), ::testing::HasSubstr("The parameter <deque> cannot be NULL."));
+    EXPECT_DEATH(blockingDequePopFront(deque, 0), ::testing::HasSubstr("The parameter <deque> cannot be NULL."));
+}
+
+// Timeouts expire when nobody comes along
+TEST_F(BlockingDequeTest, timeoutTest) {
+    int values[4];
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(blockingDequePopFront(deque, 20), nullptr);
+    EXPECT_GE(elapsedMilliseconds(start), 19);
+
+    for (int i = 0; i < 4; i++)
+        blockingDequePushBack(deque, &values[i], 0);
+
+    start = std::chrono::steady_clock::now();
+    EXPECT_EQ(blockingDequePushBack(deque, &values[0], 20), false);
+    EXPECT_GE(elapsedMilliseconds(start), 19);
+}
+
+// Waiting threads are woken up by the other side
+TEST_F(BlockingDequeTest, wakeUpTest) {
+    int values[5];
+
+    // A consumer waits for a producer
+    std::thread consumer([this, &values]() {
+        EXPECT_EQ(blockingDequePopFront(deque, BLOCKING_DEQUE_FOREVER), &values[0]);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(blockingDequePushBack(deque, &values[0], 0), true);
+    consumer.join();
+
+    // A producer waits for a consumer to make room
+    for (int i = 0; i < 4; i++)
+        blockingDequePushBack(deque, &values[i], 0);
+
+    std::thread producer([this, &values]() {
+        EXPECT_EQ(blockingDequePushBack(deque, &values[4], 10000), true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(blockingDequePopFront(deque, 0), &values[0]);
+    producer.join();
+
+    for (int i = 1; i < 5; i++)
+        EXPECT_EQ(blockingDequePopFront(deque, 0), &values[i]);
+}
+
+// closeBlockingDeque, isBlockingDequeClosed
+TEST_F(BlockingDequeTest, closeTest) {
+    int values[4];
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < 3; i++) {
+        consumers.emplace_back([this]() {
+            EXPECT_EQ(blockingDequePopFront(deque, BLOCKING_DEQUE_FOREVER), nullptr);
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    closeBlockingDeque(deque);
+    for (std::thread & consumer : consumers)
+        consumer.join();
+
+    EXPECT_EQ(isBlockingDequeClosed(deque), true);
+    EXPECT_EQ(blockingDequePushBack(deque, &values[0], BLOCKING_DEQUE_FOREVER), false);
+
+    // Producers waiting for room are woken up too
+    struct BlockingDeque * full = newBlockingDeque(2);
+    blockingDequePushBack(full, &values[0], 0);
+    blockingDequePushBack(full, &values[1], 0);
+
+    std::thread producer([full, &values]() {
+        EXPECT_EQ(blockingDequePushBack(full, &values[2], BLOCKING_DEQUE_FOREVER), false);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    closeBlockingDeque(full);
+    producer.join();
+
+    // What was pushed before closing can still be popped
+    EXPECT_EQ(blockingDequePopFront(full, BLOCKING_DEQUE_FOREVER), &values[0]);
+    EXPECT_EQ(blockingDequePopFront(full, BLOCKING_DEQUE_FOREVER), &values[1]);
+    EXPECT_EQ(blockingDequePopFront(full, BLOCKING_DEQUE_FOREVER), nullptr);
+    deleteBlockingDeque(&full, nullptr);
+}
+
+// blockingDequeDrain
+TEST_F(BlockingDequeTest, drainTest) {
+    int values[4];
+    void * popped[8];
+
+    EXPECT_EQ(blockingDequeDrain(deque, popped, 8, 0), 0);
+
+    for (int i = 0; i < 3; i++)
+        blockingDequePushBack(deque, &values[i], 0);
+
+    EXPECT_EQ(blockingDequeDrain(deque, popped, 2, 0), 2);
+    EXPECT_EQ(popped[0], &values[0]);
+    EXPECT_EQ(popped[1], &values[1]);
+    EXPECT_EQ(blockingDequeDrain(deque, popped, 8, 0), 1);
+    EXPECT_EQ(popped[0], &values[2]);
+
+    // Draining waits for the first element only
+    std::thread producer([this, &values]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        blockingDequePushBack(deque, &values[3], 0);
+    });
+    EXPECT_EQ(blockingDequeDrain(deque, popped, 8, BLOCKING_DEQUE_FOREVER), 1);
+    EXPECT_EQ(popped[0], &values[3]);
+    producer.join();
+}
+
+// Elements still in the deque when it is deleted are given to the deleter, popped ones are not
+static std::vector<int> freed_values;
+
+static void freeValue(void * element) {
+    freed_values.push_back(* (int *) element);
+    free(element);
+}
+
+TEST_F(BlockingDequeTest, deleteBlockingDequeTest) {
+    for (int i = 0; i < 4; i++) {
+        int * value = (int *) malloc(sizeof * value);
+        * value = i;
+        blockingDequePushBack(deque, value, 0);
+    }
+    free(blockingDequePopFront(deque, 0));
+
+    freed_values.clear();
+    deleteBlockingDeque(&deque, freeValue);
+    EXPECT_EQ(deque, nullptr);
+    EXPECT_THAT(freed_values, ::testing::ElementsAre(1, 2, 3));
+}
+
+// Several producers and consumers through a small bounded deque, every element arrives exactly once
+TEST_F(BlockingDequeTest, manyThreadsTest) {
+    const unsigned producers_count = 3, consumers_count = 3;
+    const uintptr_t per_producer = 20000;
+
+    std::vector<std::thread> producers;
+    for (uintptr_t p = 0; p < producers_count; p++) {
+        producers.emplace_back([this, p, per_producer]() {
+            for (uintptr_t i = 0; i < per_producer; i++)
+                blockingDequePushBack(deque, (void *) (p * per_producer + i + 1), BLOCKING_DEQUE_FOREVER);
+        });
+    }
+
+    std::vector<std::vector<uintptr_t>> received(consumers_count);
+    std::vector<std::thread> consumers;
+    for (unsigned c = 0; c < consumers_count; c++) {
+        consumers.emplace_back([this, c, &received]() {
+            void * popped[3];
+            unsigned length;
+            while ((length = blockingDequeDrain(deque, popped, c + 1, BLOCKING_DEQUE_FOREVER)) > 0) {
+                for (unsigned i = 0; i < length; i++)
+                    received[c].push_back((uintptr_t) popped[i]);
+            }
+        });
+    }
+
+    for (std::thread & producer : producers)
+        producer.join();
+    closeBlockingDeque(deque);
+    for (std::thread & consumer : consumers)
+        consumer.join();
+
+    std::vector<unsigned> seen(producers_count * per_producer + 1, 0);
+    for (std::vector<uintptr_t> & values : received) {
+        for (uintptr_t value : values)
+            seen[value]++;
+    }
+
+    for (uintptr_t i = 1; i <= producers_count * per_producer; i++)
+        ASSERT_EQ(seen[i], 1);
+}
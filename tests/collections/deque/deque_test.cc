@@ -4,6 +4,9 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <deque>
+#include <random>
+#include <vector>
 
 extern "C" {
     #include "deque.h"
@@ -166,7 +169,7 @@ TEST_F(DequeTest, dequePopBackTest) {
     EXPECT_EQ(*((int *)(dequePopBack(deque))), 1);
 
     EXPECT_EQ(deque -> size, 0);
-    EXPECT_EQ(deque -> back_empty, true);
+    EXPECT_EQ(isDequeEmpty(deque), true);
     EXPECT_EQ(deque -> buffer -> size, 0);
 
 
@@ -194,7 +197,7 @@ TEST_F(DequeTest, dequePopFrontTest) {
     EXPECT_EQ(*((int *)(dequePopFront(deque))), 4);
 
     EXPECT_EQ(deque -> size, 3);
-    EXPECT_EQ(deque -> front_empty, false);
+    EXPECT_EQ(deque -> front, 1);
     EXPECT_EQ(deque -> buffer -> size, 1);
 
     EXPECT_EQ(*((int *)(dequePopFront(deque))), 3);
@@ -202,7 +205,7 @@ TEST_F(DequeTest, dequePopFrontTest) {
     EXPECT_EQ(*((int *)(dequePopFront(deque))), 1);
 
     EXPECT_EQ(deque -> size, 0);
-    EXPECT_EQ(deque -> front_empty, true);
+    EXPECT_EQ(isDequeEmpty(deque), true);
     EXPECT_EQ(deque -> buffer -> size, 0);
 
 
@@ -314,3 +317,251 @@ TEST_F(DequeTest, dequeSetTest) {
     deleteDeque(&deque, nullptr);
     EXPECT_DEATH(dequeSet(deque, 0, &values[0]), "The parameter <deque> cannot be NULL.");
 }
+
+// ->begin, ->next, ->deref
+TEST_F(DequeTest, deque_iterator_Test) {
+    int values[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    struct Collection const * collection = &deque -> collection;
+    struct CIterator iterator;
+
+    // An empty deque has nothing to iterate over
+    EXPECT_EQ(collection -> begin(collection, &iterator), false);
+
+    // Elements span several blocks on both sides of the first one
+    for (int i = 5; i < 11; i++)
+        dequePushBack(deque, &values[i]);
+    for (int i = 4; i >= 0; i--)
+        dequePushFront(deque, &values[i]);
+
+    int expected = 1;
+    for (bool more = collection -> begin(collection, &iterator); more; more = collection -> next(&iterator)) {
+        EXPECT_EQ(collection -> deref(&iterator), dequeGet(deque, expected - 1));
+        EXPECT_EQ(* (int *) collection -> deref(&iterator), expected++);
+    }
+    EXPECT_EQ(expected, 12);
+}
+
+// Pushes and pops in any order, checked against std::deque
+static void checkMixedOperations(struct Deque * deque) {
+    std::vector<int> values(1000);
+    std::deque<int *> expected;
+    std::mt19937 random(42);
+
+    for (int i = 0; i < 1000; i++) {
+        values[i] = i;
+        switch (random() % 4) {
+            case 0: dequePushBack(deque, &values[i]); expected.push_back(&values[i]); break;
+            case 1: dequePushFront(deque, &values[i]); expected.push_front(&values[i]); break;
+            case 2:
+                EXPECT_EQ(dequePopBack(deque), expected.empty() ? nullptr : expected.back());
+                if (expected.empty() == false)
+                    expected.pop_back();
+                break;
+            default:
+                EXPECT_EQ(dequePopFront(deque), expected.empty() ? nullptr : expected.front());
+                if (expected.empty() == false)
+                    expected.pop_front();
+        }
+
+        ASSERT_EQ(deque -> size, expected.size());
+        for (size_t j = 0; j < expected.size(); j++)
+            ASSERT_EQ(dequeGet(deque, j), expected[j]);
+    }
+}
+
+TEST_F(DequeTest, dequeMixedOperationsTest) {
+    checkMixedOperations(deque);
+}
+
+// Emptied blocks are kept for reuse, up to the spare limit
+TEST_F(DequeTest, dequeSpareBlocksTest) {
+    int values[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    // A queue going back and forth across a block boundary reuses the same block
+    for (int i = 0; i < 4; i++)
+        dequePushBack(deque, &values[i]);
+    void * block = deque -> buffer -> contents[0];
+    for (int i = 0; i < 4; i++)
+        dequePopFront(deque);
+    EXPECT_EQ(deque -> spare_count, 1);
+
+    dequePushBack(deque, &values[4]);
+    EXPECT_EQ(deque -> buffer -> contents[0], block);
+    EXPECT_EQ(deque -> spare_count, 0);
+    dequePopFront(deque);
+
+    // Blocks past the limit are freed
+    deque -> spare_limit = 2;
+    for (int i = 0; i < 9; i++)
+        dequePushBack(deque, &values[i]);
+    EXPECT_EQ(deque -> buffer -> size, 3);
+    for (int i = 0; i < 9; i++)
+        EXPECT_EQ(*((int *)(dequePopFront(deque))), i + 1);
+    EXPECT_EQ(deque -> spare_count, 2);
+}
+
+// The block map grows at both ends and stays centered
+TEST_F(DequeTest, dequeBlockMapTest) {
+    std::vector<int> values(400);
+    for (int i = 0; i < 200; i++) {
+        values[i] = i;
+        dequePushFront(deque, &values[i]);
+        dequePushBack(deque, &values[i + 200]);
+    }
+
+    struct Buffer * buffer = deque -> buffer;
+    EXPECT_EQ(buffer -> size, 100);
+    EXPECT_GE(buffer -> contents, buffer -> storage);
+    EXPECT_LE(buffer -> contents + buffer -> size, buffer -> storage + buffer -> capacity);
+
+    // A queue drifting to the back recenters the map rather than growing it forever
+    for (int i = 0; i < 100000; i++)
+        dequePushBack(deque, dequePopFront(deque));
+
+    EXPECT_LE(buffer -> capacity, 4 * buffer -> size);
+    EXPECT_EQ(deque -> size, 400);
+    EXPECT_EQ(*((int *)(dequeGet(deque, 0))), 199);
+}
+
+// newPowerOfTwoDeque
+TEST_F(DequeTest, newPowerOfTwoDequeTest) {
+    struct Deque * other = newPowerOfTwoDeque(5);
+
+    // The capacity is rounded up to the next power of two
+    EXPECT_EQ(other -> capacity, 8);
+    EXPECT_EQ(other -> power_of_two, true);
+    EXPECT_EQ(other -> block_shift, 3);
+    checkMixedOperations(other);
+    deleteDeque(&other, nullptr);
+
+    other = newPowerOfTwoDeque(1);
+    EXPECT_EQ(other -> capacity, 1);
+    checkMixedOperations(other);
+    deleteDeque(&other, nullptr);
+
+    EXPECT_DEATH(newPowerOfTwoDeque(0), ::testing::HasSubstr("Deque capacity cannot be zero."));
+}
+
+// dequeSegment, dequeSegmentNext
+TEST_F(DequeTest, dequeSegmentTest) {
+    int values[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+    // An empty deque has no segment
+    struct DequeSegment segment = dequeSegment(deque);
+    EXPECT_EQ(dequeSegmentNext(deque, &segment), false);
+
+    // Blocks are [_ _ _ 2] [3 4 5 6] [7 8 9 _], partially filled at both ends
+    for (int i = 2; i < 10; i++)
+        dequePushBack(deque, &values[i]);
+    dequePushFront(deque, &values[1]);
+    dequePushFront(deque, &values[0]);
+    dequePopFront(deque);
+    dequePopBack(deque);
+
+    unsigned lengths[] = {1, 4, 3};
+    int expected = 2;
+    segment = dequeSegment(deque);
+    for (unsigned block = 0; block < 3; block++) {
+        ASSERT_EQ(dequeSegmentNext(deque, &segment), true);
+        EXPECT_EQ(segment.length, lengths[block]);
+        for (unsigned i = 0; i < segment.length; i++)
+            EXPECT_EQ(* (int *) segment.elements[i], expected++);
+    }
+    EXPECT_EQ(dequeSegmentNext(deque, &segment), false);
+    EXPECT_EQ(expected, 10);
+}
+
+// deleteDeque hands every element to the deleter exactly once
+static std::vector<void *> deleted_elements;
+
+static void recordDeleted(void * element) {
+    deleted_elements.push_back(element);
+}
+
+TEST_F(DequeTest, deleteDequeDeleterTest) {
+    int values[10];
+    for (int i = 0; i < 10; i++)
+        dequePushFront(deque, &values[i]);
+
+    deleted_elements.clear();
+    deleteDeque(&deque, recordDeleted);
+
+    std::vector<void *> expected;
+    for (int i = 0; i < 10; i++)
+        expected.push_back(&values[i]);
+    EXPECT_THAT(deleted_elements, ::testing::UnorderedElementsAreArray(expected));
+}
+
+// dequePushBackN, dequePushFrontN, dequePopFrontN, dequePopBackN mixed with single pushes and pops
+static void checkBatchOperations(struct Deque * deque) {
+    std::vector<int> values(20);
+    std::vector<void *> batch(20), popped(20);
+    std::deque<void *> expected;
+    std::mt19937 random(7);
+
+    for (int i = 0; i < 2000; i++) {
+        unsigned count = random() % 20;
+        for (unsigned j = 0; j < count; j++)
+            batch[j] = &values[random() % 20];
+
+        switch (random() % 6) {
+            case 0:
+                dequePushBackN(deque, batch.data(), count);
+                expected.insert(expected.end(), batch.begin(), batch.begin() + count);
+                break;
+            case 1:
+                dequePushFrontN(deque, batch.data(), count);
+                expected.insert(expected.begin(), batch.begin(), batch.begin() + count);
+                break;
+            case 2: {
+                unsigned popped_count = dequePopFrontN(deque, popped.data(), count);
+                ASSERT_EQ(popped_count, std::min<size_t>(count, expected.size()));
+                for (unsigned j = 0; j < popped_count; j++) {
+                    EXPECT_EQ(popped[j], expected.front());
+                    expected.pop_front();
+                }
+                break;
+            }
+            case 3: {
+                unsigned popped_count = dequePopBackN(deque, popped.data(), count);
+                ASSERT_EQ(popped_count, std::min<size_t>(count, expected.size()));
+                for (unsigned j = 0; j < popped_count; j++)
+                    EXPECT_EQ(popped[j], expected[expected.size() - popped_count + j]);
+                expected.resize(expected.size() - popped_count);
+                break;
+            }
+            case 4: dequePushFront(deque, batch[0]); expected.push_front(batch[0]); break;
+            default:
+                EXPECT_EQ(dequePopBack(deque), expected.empty() ? nullptr : expected.back());
+                if (expected.empty() == false)
+                    expected.pop_back();
+        }
+
+        ASSERT_EQ(deque -> size, expected.size());
+        for (size_t j = 0; j < expected.size(); j++)
+            ASSERT_EQ(dequeGet(deque, j), expected[j]);
+        if (deque -> size > 0) {
+            EXPECT_EQ(dequeFront(deque), expected.front());
+            EXPECT_EQ(dequeBack(deque), expected.back());
+        }
+    }
+}
+
+TEST_F(DequeTest, dequeBatchOperationsTest) {
+    checkBatchOperations(deque);
+
+    struct Deque * other = newPowerOfTwoDeque(8);
+    checkBatchOperations(other);
+    deleteDeque(&other, nullptr);
+
+    // Popping from an empty deque pops nothing
+    void * popped[1];
+    while (isDequeEmpty(deque) == false)
+        dequePopFront(deque);
+    EXPECT_EQ(dequePopFrontN(deque, popped, 1), 0);
+    EXPECT_EQ(dequePopBackN(deque, popped, 1), 0);
+    EXPECT_EQ(deque -> buffer -> size, 0);
+
+    deleteDeque(&deque, nullptr);
+    EXPECT_DEATH(dequePushBackN(deque, popped, 1), ::testing::HasSubstr("The parameter <deque> cannot be NULL."));
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <random>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+
+extern "C" {
+    #include "heap.h"
+}
+
+// Elements are integers stored in the pointers themselves
+static int compareIntegers(void const * a, void const * b) {
+    intptr_t x = (intptr_t) a, y = (intptr_t) b;
+    return (x > y) - (x < y);
+}
+
+static int compareIntegersReversed(void const * a, void const * b) {
+    return compareIntegers(b, a);
+}
+
+// Checks that no element compares lower than its parent
+static bool isHeap(struct Heap const * const heap) {
+    for (unsigned i = 1; i < heap -> vector -> size; i++) {
+        unsigned parent = (i - 1) / heap -> arity;
+        if (heap -> compare(heap -> vector -> elements[i], heap -> vector -> elements[parent]) < 0)
+            return false;
+    }
+
+    return true;
+}
+
+class HeapTest: public ::testing::TestWithParam<unsigned> {
+    protected:
+        void SetUp() override {
+            heap = newHeap(1, GetParam(), compareIntegers);
+        }
+
+        void TearDown() override {
+            deleteHeap(&heap, nullptr);
+        }
+
+        struct Heap * heap;
+};
+
+// newHeap
+TEST_P(HeapTest, newHeapTest) {
+    EXPECT_NE(heap, nullptr);
+    EXPECT_EQ(heap -> arity, GetParam());
+    EXPECT_EQ(isHeapEmpty(heap), true);
+    EXPECT_EQ(heapSize(heap), 0);
+    EXPECT_EQ(heapPeek(heap), nullptr);
+    EXPECT_EQ(heapPop(heap), nullptr);
+
+    EXPECT_DEATH(newHeap(0, GetParam(), compareIntegers), ::testing::HasSubstr("Initial heap capacity cannot be zero."));
+    EXPECT_DEATH(newHeap(4, 3, compareIntegers), ::testing::HasSubstr("Heap arity must be a power of two no smaller than 2."));
+    EXPECT_DEATH(newHeap(4, 1, compareIntegers), ::testing::HasSubstr("Heap arity must be a power of two no smaller than 2."));
+    EXPECT_DEATH(newHeap(4, GetParam(), nullptr), ::testing::HasSubstr("The parameter <compare> cannot be NULL."));
+}
+
+// heapPush, heapPop, heapPeek
+TEST_P(HeapTest, pushPopTest) {
+    std::vector<intptr_t> values(1000);
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = (i * 7919) % 500;
+    std::shuffle(values.begin(), values.end(), std::mt19937(42));
+
+    for (intptr_t value : values) {
+        EXPECT_EQ(heapPush(heap, (void *) value), true);
+        ASSERT_TRUE(isHeap(heap));
+    }
+    EXPECT_EQ(heapSize(heap), values.size());
+
+    // Elements come out lowest first, duplicates included
+    std::sort(values.begin(), values.end());
+    for (intptr_t value : values) {
+        EXPECT_EQ((intptr_t) heapPeek(heap), value);
+        ASSERT_EQ((intptr_t) heapPop(heap), value);
+        ASSERT_TRUE(isHeap(heap));
+    }
+    EXPECT_EQ(isHeapEmpty(heap), true);
+
+    deleteHeap(&heap, nullptr);
+    EXPECT_DEATH(heapPush(heap, nullptr), ::testing::HasSubstr("The parameter <heap> cannot be NULL."));
+    EXPECT_DEATH(heapPop(heap), ::testing::HasSubstr("The parameter <heap> cannot be NULL."));
+}
+
+// heapReplace
+TEST_P(HeapTest, replaceTest) {
+    EXPECT_EQ(heapReplace(heap, (void *) 5), nullptr);
+    EXPECT_EQ(heapSize(heap), 1);
+
+    for (intptr_t value : {8, 3, 9, 1})
+        heapPush(heap, (void *) value);
+
+    EXPECT_EQ((intptr_t) heapReplace(heap, (void *) 7), 1);
+    EXPECT_TRUE(isHeap(heap));
+    EXPECT_EQ(heapSize(heap), 5);
+
+    for (intptr_t value : {3, 5, 7, 8, 9})
+        EXPECT_EQ((intptr_t) heapPop(heap), value);
+}
+
+// newHeapFromVector
+TEST_P(HeapTest, fromVectorTest) {
+    for (unsigned size : {0, 1, 2, 5, 17, 1000}) {
+        struct Vector * vector = newVector(1);
+        std::vector<intptr_t> values;
+        for (unsigned i = 0; i < size; i++) {
+            values.push_back((i * 7919) % 101);
+            vectorPushBack(vector, (void *) values.back());
+        }
+
+        struct Heap * from = newHeapFromVector(vector, GetParam(), compareIntegers);
+        EXPECT_EQ(from -> vector, vector);
+        EXPECT_TRUE(isHeap(from));
+        EXPECT_EQ(heapSize(from), size);
+
+        std::sort(values.begin(), values.end());
+        for (intptr_t value : values)
+            ASSERT_EQ((intptr_t) heapPop(from), value);
+
+        deleteHeap(&from, nullptr);
+    }
+
+    EXPECT_DEATH(newHeapFromVector(nullptr, GetParam(), compareIntegers), ::testing::HasSubstr("The parameter <vector> cannot be NULL."));
+}
+
+// initHeap, heapSiftUp, heapSiftDown: a copy kept through the moved callback must match the heap after every sift
+static std::vector<intptr_t> shadow;
+static intptr_t held;
+
+static void followMove(struct Heap * const heap, unsigned from, unsigned to) {
+    (void) heap;
+    shadow[to] = from == HEAP_HELD_ELEMENT ? held : shadow[from];
+}
+
+TEST_P(HeapTest, siftTest) {
+    struct Heap embedded;
+    initHeap(&embedded, newVector(1), GetParam(), compareIntegers, followMove);
+    EXPECT_EQ(embedded.arity, GetParam());
+
+    shadow.assign(200, -1);
+    for (intptr_t i = 0; i < 200; i++) {
+        held = (i * 7919) % 101;
+        vectorPushBack(embedded.vector, (void *) held);
+        heapSiftUp(&embedded, heapSize(&embedded) - 1, (void *) held);
+    }
+    EXPECT_TRUE(isHeap(&embedded));
+
+    while (heapSize(&embedded) > 1) {
+        for (unsigned i = 0; i < heapSize(&embedded); i++)
+            ASSERT_EQ(shadow[i], (intptr_t) embedded.vector -> elements[i]);
+
+        // We pop by hand, the last element going down from the root
+        unsigned last = --embedded.vector -> size;
+        held = (intptr_t) embedded.vector -> elements[last];
+        heapSiftDown(&embedded, 0, (void *) held);
+        ASSERT_TRUE(isHeap(&embedded));
+    }
+
+    deleteVector(&embedded.vector, nullptr);
+    EXPECT_DEATH(initHeap(nullptr, nullptr, GetParam(), compareIntegers, nullptr), ::testing::HasSubstr("The parameter <heap> cannot be NULL."));
+}
+
+// A reversed comparator makes a max-heap
+TEST_P(HeapTest, maxHeapTest) {
+    struct Heap * max = newHeap(8, GetParam(), compareIntegersReversed);
+    for (intptr_t value : {4, 9, 2, 7})
+        heapPush(max, (void *) value);
+
+    for (intptr_t value : {9, 7, 4, 2})
+        EXPECT_EQ((intptr_t) heapPop(max), value);
+
+    deleteHeap(&max, nullptr);
+}
+
+// deleteHeap passes each element left to the deleter, we keep one bit per value to check that
+static unsigned deleted_mask = 0;
+
+static void maskDeleted(void * element) {
+    deleted_mask |= 1u << (intptr_t) element;
+}
+
+TEST_P(HeapTest, deleteHeapTest) {
+    for (intptr_t value = 0; value < 10; value++)
+        heapPush(heap, (void *) value);
+    heapPop(heap);
+
+    deleted_mask = 0;
+    deleteHeap(&heap, maskDeleted);
+    EXPECT_EQ(heap, nullptr);
+    EXPECT_EQ(deleted_mask, 0x3feu);
+}
+
+INSTANTIATE_TEST_SUITE_P(Arities, HeapTest, ::testing::Values(2, 4, 8));
+
+// An arity of 0 picks the default
+TEST(HeapDefaultTest, defaultArityTest) {
+    struct Heap * heap = newHeap(4, 0, compareIntegers);
+    EXPECT_EQ(heap -> arity, heap_default_arity);
+    deleteHeap(&heap, nullptr);
+}
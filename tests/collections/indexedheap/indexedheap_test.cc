@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+
+extern "C" {
+    #include "indexedheap.h"
+}
+
+// Elements are integers stored in the pointers themselves
+static int compareIntegers(void const * a, void const * b) {
+    intptr_t x = (intptr_t) a, y = (intptr_t) b;
+    return (x > y) - (x < y);
+}
+
+// Checks that no element compares lower than its parent and that positions and handles agree
+static bool isIndexedHeap(struct IndexedHeap const * const heap) {
+    void ** elements = heap -> heap.vector -> elements;
+
+    for (unsigned i = 0; i < indexedHeapSize(heap); i++) {
+        if (heap -> positions[heap -> handles[i]] != i)
+            return false;
+
+        if (i > 0 && heap -> heap.compare(elements[i], elements[(i - 1) / heap -> heap.arity]) < 0)
+            return false;
+    }
+
+    return true;
+}
+
+class IndexedHeapTest: public ::testing::TestWithParam<unsigned> {
+    protected:
+        void SetUp() override {
+            heap = newIndexedHeap(1, GetParam(), compareIntegers);
+        }
+
+        void TearDown() override {
+            deleteIndexedHeap(&heap, nullptr);
+        }
+
+        struct IndexedHeap * heap;
+};
+
+// newIndexedHeap
+TEST_P(IndexedHeapTest, newIndexedHeapTest) {
+    EXPECT_NE(heap, nullptr);
+    EXPECT_EQ(heap -> heap.arity, GetParam());
+    EXPECT_EQ(isIndexedHeapEmpty(heap), true);
+    EXPECT_EQ(indexedHeapPeek(heap), nullptr);
+    EXPECT_EQ(indexedHeapPop(heap), nullptr);
+    EXPECT_EQ(indexedHeapContains(heap, 0), false);
+
+    EXPECT_DEATH(newIndexedHeap(0, GetParam(), compareIntegers), ::testing::HasSubstr("Initial heap capacity cannot be zero."));
+    EXPECT_DEATH(newIndexedHeap(4, 6, compareIntegers), ::testing::HasSubstr("Heap arity must be a power of two no smaller than 2."));
+}
+
+// indexedHeapPush, indexedHeapPop, indexedHeapGet, indexedHeapContains
+TEST_P(IndexedHeapTest, pushPopTest) {
+    std::vector<unsigned> handles;
+    for (intptr_t value : {50, 20, 80, 10, 60})
+        handles.push_back(indexedHeapPush(heap, (void *) value));
+
+    // Handles are distinct and lead to their element wherever it went
+    EXPECT_THAT(handles, ::testing::UnorderedElementsAre(0, 1, 2, 3, 4));
+    EXPECT_EQ((intptr_t) indexedHeapGet(heap, handles[2]), 80);
+    EXPECT_EQ((intptr_t) indexedHeapPeek(heap), 10);
+
+    EXPECT_EQ((intptr_t) indexedHeapPop(heap), 10);
+    EXPECT_EQ(indexedHeapContains(heap, handles[3]), false);
+    EXPECT_DEATH(indexedHeapGet(heap, handles[3]), ::testing::HasSubstr("The handle does not belong to an element in the heap."));
+    EXPECT_DEATH(indexedHeapGet(heap, 100), ::testing::HasSubstr("The handle does not belong to an element in the heap."));
+
+    // The handle of the popped element is given out again
+    EXPECT_EQ(indexedHeapPush(heap, (void *) 30), handles[3]);
+
+    for (intptr_t value : {20, 30, 50, 60, 80})
+        EXPECT_EQ((intptr_t) indexedHeapPop(heap), value);
+    EXPECT_EQ(isIndexedHeapEmpty(heap), true);
+
+    deleteIndexedHeap(&heap, nullptr);
+    EXPECT_DEATH(indexedHeapPush(heap, nullptr), ::testing::HasSubstr("The parameter <heap> cannot be NULL."));
+}
+
+// indexedHeapDecreaseKey, indexedHeapIncreaseKey, indexedHeapUpdate, indexedHeapRemove
+TEST_P(IndexedHeapTest, changeKeyTest) {
+    std::vector<unsigned> handles;
+    for (intptr_t value = 10; value <= 100; value += 10)
+        handles.push_back(indexedHeapPush(heap, (void *) value));
+
+    indexedHeapDecreaseKey(heap, handles[9], (void *) 5);
+    EXPECT_TRUE(isIndexedHeap(heap));
+    EXPECT_EQ(indexedHeapPeek(heap), (void *) 5);
+
+    indexedHeapIncreaseKey(heap, handles[9], (void *) 200);
+    EXPECT_TRUE(isIndexedHeap(heap));
+    EXPECT_EQ(indexedHeapPeek(heap), (void *) 10);
+
+    indexedHeapUpdate(heap, handles[4], (void *) 1);
+    indexedHeapUpdate(heap, handles[0], (void *) 150);
+    EXPECT_TRUE(isIndexedHeap(heap));
+
+    EXPECT_EQ((intptr_t) indexedHeapRemove(heap, handles[2]), 30);
+    EXPECT_EQ((intptr_t) indexedHeapRemove(heap, handles[9]), 200);
+    EXPECT_TRUE(isIndexedHeap(heap));
+    EXPECT_EQ(indexedHeapContains(heap, handles[2]), false);
+
+    for (intptr_t value : {1, 20, 40, 60, 70, 80, 90, 150})
+        EXPECT_EQ((intptr_t) indexedHeapPop(heap), value);
+
+    EXPECT_DEATH(indexedHeapRemove(heap, handles[0]), ::testing::HasSubstr("The handle does not belong to an element in the heap."));
+    EXPECT_DEATH(indexedHeapDecreaseKey(heap, handles[0], nullptr), ::testing::HasSubstr("The handle does not belong to an element in the heap."));
+}
+
+// Random operations checked against a map from handles to values
+TEST_P(IndexedHeapTest, randomOperationsTest) {
+    std::mt19937 random(GetParam());
+    std::map<unsigned, intptr_t> model;
+
+    for (int step = 0; step < 20000; step++) {
+        unsigned operation = random() % 6;
+        intptr_t value = random() % 1000;
+
+        if (operation < 2 || model.empty()) {
+            unsigned handle = indexedHeapPush(heap, (void *) value);
+            ASSERT_EQ(model.count(handle), 0);
+            model[handle] = value;
+        }
+        else if (operation == 2) {
+            intptr_t lowest = (intptr_t) indexedHeapPop(heap);
+            auto found = std::min_element(model.begin(), model.end(),
+                [](auto const & a, auto const & b) { return a.second < b.second; });
+            ASSERT_EQ(lowest, found -> second);
+            // Several handles may hold the lowest value, we drop whichever one the heap gave up
+            for (auto it = model.begin(); it != model.end(); ++it) {
+                if (it -> second == lowest && indexedHeapContains(heap, it -> first) == false) {
+                    model.erase(it);
+                    break;
+                }
+            }
+        }
+        else {
+            auto it = model.begin();
+            std::advance(it, random() % model.size());
+            if (operation == 3) {
+                ASSERT_EQ((intptr_t) indexedHeapRemove(heap, it -> first), it -> second);
+                model.erase(it);
+            }
+            else {
+                indexedHeapUpdate(heap, it -> first, (void *) value);
+                it -> second = value;
+            }
+        }
+
+        ASSERT_EQ(indexedHeapSize(heap), model.size());
+        if (step % 100 == 0) {
+            ASSERT_TRUE(isIndexedHeap(heap));
+        }
+    }
+
+    for (auto const & entry : model)
+        ASSERT_EQ((intptr_t) indexedHeapGet(heap, entry.first), entry.second);
+}
+
+// Elements removed by handle are the caller's again, the deleter only gets the ones still in the heap
+static std::map<intptr_t, int> deleted_counts;
+
+static void countDeletions(void * element) {
+    deleted_counts[(intptr_t) element]++;
+}
+
+TEST_P(IndexedHeapTest, deleteIndexedHeapTest) {
+    for (intptr_t value = 0; value < 10; value++)
+        indexedHeapPush(heap, (void *) value);
+    intptr_t popped = (intptr_t) indexedHeapPop(heap);
+    intptr_t removed = (intptr_t) indexedHeapRemove(heap, 5);
+
+    deleted_counts.clear();
+    deleteIndexedHeap(&heap, countDeletions);
+    EXPECT_EQ(heap, nullptr);
+
+    std::map<intptr_t, int> expected;
+    for (intptr_t value = 0; value < 10; value++)
+        if (value != popped && value != removed)
+            expected[value] = 1;
+    EXPECT_EQ(deleted_counts, expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(Arities, IndexedHeapTest, ::testing::Values(2, 4, 8));
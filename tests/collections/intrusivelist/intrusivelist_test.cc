@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <list>
+#include <random>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+
+extern "C" {
+    #include "intrusivelist.h"
+}
+
+struct Entry {
+    int value;
+    struct ListLink link;
+};
+
+static int valueOf(struct ListLink * link) {
+    return intrusiveListEntry(link, struct Entry, link) -> value;
+}
+
+// Walks the list both ways, checking that the links agree with each other and with the size
+static std::vector<int> contents(struct IntrusiveList const * const list) {
+    std::vector<int> values;
+    struct ListLink * prev = NULL;
+    for (struct ListLink * link = list -> head; link != NULL; link = link -> next) {
+        EXPECT_EQ(link -> prev, prev);
+        values.push_back(valueOf(link));
+        prev = link;
+    }
+
+    EXPECT_EQ(list -> tail, prev);
+    EXPECT_EQ(list -> size, values.size());
+
+    return values;
+}
+
+class IntrusiveListTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            initIntrusiveList(&list);
+            for (int i = 0; i < 8; i++)
+                entries[i].value = i;
+        }
+
+        struct IntrusiveList list;
+        struct Entry entries[8];
+};
+
+// initIntrusiveList
+TEST_F(IntrusiveListTest, initIntrusiveListTest) {
+    EXPECT_EQ(list.head, nullptr);
+    EXPECT_EQ(list.tail, nullptr);
+    EXPECT_EQ(list.size, 0);
+
+    EXPECT_DEATH(initIntrusiveList(nullptr), ::testing::HasSubstr("The parameter <list> cannot be NULL."));
+}
+
+// isIntrusiveListEmpty
+TEST_F(IntrusiveListTest, isIntrusiveListEmptyTest) {
+    EXPECT_EQ(isIntrusiveListEmpty(&list), true);
+
+    intrusiveListPushBack(&list, &entries[0].link);
+    EXPECT_EQ(isIntrusiveListEmpty(&list), false);
+
+    EXPECT_DEATH(isIntrusiveListEmpty(nullptr), ::testing::HasSubstr("The parameter <list> cannot be NULL."));
+}
+
+// intrusiveListPushBack, intrusiveListPushFront
+TEST_F(IntrusiveListTest, intrusiveListPushTest) {
+    intrusiveListPushBack(&list, &entries[1].link);
+    intrusiveListPushBack(&list, &entries[2].link);
+    intrusiveListPushFront(&list, &entries[0].link);
+    intrusiveListPushBack(&list, &entries[3].link);
+
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(0, 1, 2, 3));
+    EXPECT_EQ(valueOf(intrusiveListFront(&list)), 0);
+    EXPECT_EQ(valueOf(intrusiveListBack(&list)), 3);
+
+    EXPECT_DEATH(intrusiveListPushBack(&list, nullptr), ::testing::HasSubstr("The parameter <link> cannot be NULL."));
+}
+
+// intrusiveListPopBack, intrusiveListPopFront
+TEST_F(IntrusiveListTest, intrusiveListPopTest) {
+    EXPECT_EQ(intrusiveListPopFront(&list), nullptr);
+    EXPECT_EQ(intrusiveListPopBack(&list), nullptr);
+
+    for (int i = 0; i < 4; i++)
+        intrusiveListPushBack(&list, &entries[i].link);
+
+    EXPECT_EQ(intrusiveListPopFront(&list), &entries[0].link);
+    EXPECT_EQ(intrusiveListPopBack(&list), &entries[3].link);
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(1, 2));
+
+    // Popped links are cleared
+    EXPECT_EQ(entries[0].link.next, nullptr);
+    EXPECT_EQ(entries[3].link.prev, nullptr);
+
+    EXPECT_EQ(intrusiveListPopBack(&list), &entries[2].link);
+    EXPECT_EQ(intrusiveListPopBack(&list), &entries[1].link);
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre());
+    EXPECT_EQ(intrusiveListFront(&list), nullptr);
+    EXPECT_EQ(intrusiveListBack(&list), nullptr);
+}
+
+// intrusiveListInsertBefore
+TEST_F(IntrusiveListTest, intrusiveListInsertBeforeTest) {
+    intrusiveListInsertBefore(&list, nullptr, &entries[2].link);
+    intrusiveListInsertBefore(&list, &entries[2].link, &entries[0].link);
+    intrusiveListInsertBefore(&list, &entries[2].link, &entries[1].link);
+    intrusiveListInsertBefore(&list, nullptr, &entries[3].link);
+
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(0, 1, 2, 3));
+}
+
+// intrusiveListRemove
+TEST_F(IntrusiveListTest, intrusiveListRemoveTest) {
+    for (int i = 0; i < 5; i++)
+        intrusiveListPushBack(&list, &entries[i].link);
+
+    intrusiveListRemove(&list, &entries[2].link);
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(0, 1, 3, 4));
+
+    intrusiveListRemove(&list, &entries[0].link);
+    intrusiveListRemove(&list, &entries[4].link);
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(1, 3));
+
+    // A removed element can go back in
+    intrusiveListPushFront(&list, &entries[2].link);
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(2, 1, 3));
+
+    // But it cannot be removed twice, nor moved once it is out
+    intrusiveListRemove(&list, &entries[3].link);
+    EXPECT_DEATH(intrusiveListRemove(&list, &entries[3].link), ::testing::HasSubstr("The link is not in the list."));
+    EXPECT_DEATH(intrusiveListMoveToFront(&list, &entries[3].link), ::testing::HasSubstr("The link is not in the list."));
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(2, 1));
+}
+
+// intrusiveListMoveToFront
+TEST_F(IntrusiveListTest, intrusiveListMoveToFrontTest) {
+    for (int i = 0; i < 4; i++)
+        intrusiveListPushBack(&list, &entries[i].link);
+
+    intrusiveListMoveToFront(&list, &entries[2].link);
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(2, 0, 1, 3));
+
+    intrusiveListMoveToFront(&list, &entries[3].link);
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(3, 2, 0, 1));
+
+    intrusiveListMoveToFront(&list, &entries[3].link);
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(3, 2, 0, 1));
+}
+
+// intrusiveListSplice
+TEST_F(IntrusiveListTest, intrusiveListSpliceTest) {
+    struct IntrusiveList other;
+    initIntrusiveList(&other);
+
+    // Splicing an empty list changes nothing
+    intrusiveListPushBack(&list, &entries[0].link);
+    intrusiveListPushBack(&list, &entries[4].link);
+    intrusiveListSplice(&list, nullptr, &other);
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(0, 4));
+
+    // In the middle
+    for (int i = 1; i < 4; i++)
+        intrusiveListPushBack(&other, &entries[i].link);
+    intrusiveListSplice(&list, &entries[4].link, &other);
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(0, 1, 2, 3, 4));
+    EXPECT_THAT(contents(&other), ::testing::ElementsAre());
+
+    // At the back
+    intrusiveListPushBack(&other, &entries[5].link);
+    intrusiveListSplice(&list, nullptr, &other);
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(0, 1, 2, 3, 4, 5));
+
+    // At the front
+    intrusiveListPushBack(&other, &entries[6].link);
+    intrusiveListPushBack(&other, &entries[7].link);
+    intrusiveListSplice(&list, list.head, &other);
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre(6, 7, 0, 1, 2, 3, 4, 5));
+
+    // Into an empty list
+    intrusiveListSplice(&other, nullptr, &list);
+    EXPECT_THAT(contents(&other), ::testing::ElementsAre(6, 7, 0, 1, 2, 3, 4, 5));
+    EXPECT_THAT(contents(&list), ::testing::ElementsAre());
+
+    EXPECT_DEATH(intrusiveListSplice(&list, nullptr, nullptr), ::testing::HasSubstr("The parameter <other> cannot be NULL."));
+}
+
+// A random mix of operations checked against std::list
+TEST_F(IntrusiveListTest, randomOperationsTest) {
+    std::vector<struct Entry> pool(64);
+    std::vector<bool> linked(pool.size(), false);
+    std::list<int> model;
+    std::mt19937 random(42);
+
+    for (size_t i = 0; i < pool.size(); i++)
+        pool[i].value = i;
+
+    for (int step = 0; step < 20000; step++) {
+        int index = random() % pool.size();
+        struct ListLink * link = &pool[index].link;
+
+        if (linked[index] == false) {
+            if (random() % 2) {
+                intrusiveListPushFront(&list, link);
+                model.push_front(index);
+            }
+            else {
+                intrusiveListPushBack(&list, link);
+                model.push_back(index);
+            }
+            linked[index] = true;
+        }
+        else if (random() % 2) {
+            intrusiveListRemove(&list, link);
+            model.remove(index);
+            linked[index] = false;
+        }
+        else {
+            intrusiveListMoveToFront(&list, link);
+            model.remove(index);
+            model.push_front(index);
+        }
+
+        if (step % 100 == 0) {
+            ASSERT_EQ(contents(&list), std::vector<int>(model.begin(), model.end()));
+        }
+    }
+}
@@ -1,8 +1,14 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <algorithm>
+#include <iterator>
+#include <list>
 #include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <random>
+#include <stdint.h>
+#include <vector>
 
 extern "C" {
     #include "list.h"
@@ -277,3 +283,687 @@ TEST_F(ListTest, listInsertTest) {
     deleteList(&list, nullptr);
     EXPECT_DEATH(listInsert(list, 0, &values[0]), ::testing::HasSubstr("The parameter <list> cannot be NULL."));
 }
+
+// listRemove
+TEST_F(ListTest, listRemoveTest) {
+    int values[] = {1, 2, 3, 4, 5};
+
+    for (int i = 0; i < 5; i++)
+        listPushBack(list, &values[i]);
+
+    EXPECT_EQ(*((int *)listRemove(list, 2)), 3);
+    EXPECT_EQ(*((int *)listGet(list, 2)), 4);
+    EXPECT_EQ(*((int *)listRemove(list, 3)), 5);
+    EXPECT_EQ(*((int *)list -> tail -> element), 4);
+    EXPECT_EQ(*((int *)listRemove(list, 0)), 1);
+    EXPECT_EQ(*((int *)list -> head -> element), 2);
+    EXPECT_EQ(list -> size, 2);
+    EXPECT_EQ(*((int *)listGet(list, 1)), 4);
+
+    EXPECT_EQ(*((int *)listRemove(list, 1)), 4);
+    EXPECT_EQ(*((int *)listRemove(list, 0)), 2);
+    EXPECT_EQ(isListEmpty(list), true);
+    EXPECT_EQ(list -> head, nullptr);
+    EXPECT_EQ(list -> tail, nullptr);
+
+    // Index is out of bounds
+    EXPECT_DEATH(listRemove(list, 0), ::testing::HasSubstr("Index is out of bounds."));
+}
+
+// ->begin, ->next, ->deref
+TEST_F(ListTest, list_iterator_Test) {
+    int values[] = {1, 2, 3, 4, 5};
+    struct Collection const * collection = &list -> collection;
+    struct CIterator iterator;
+
+    // An empty list has nothing to iterate over
+    EXPECT_EQ(collection -> begin(collection, &iterator), false);
+
+    for (int i = 0; i < 5; i++)
+        listPushBack(list, &values[i]);
+
+    int expected = 1;
+    for (bool more = collection -> begin(collection, &iterator); more; more = collection -> next(&iterator))
+        EXPECT_EQ(* (int *) collection -> deref(&iterator), expected++);
+    EXPECT_EQ(expected, 6);
+
+    // Lists are not contiguous
+    EXPECT_EQ(collection -> span, nullptr);
+}
+
+// listPopFront, listPopBack down to an empty list
+TEST_F(ListTest, listPopUntilEmptyTest) {
+    int values[] = {1, 2, 3};
+
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 3; i++)
+            listPushBack(list, &values[i]);
+
+        EXPECT_EQ(*((int *)listPopFront(list)), 1);
+        EXPECT_EQ(*((int *)listGet(list, 0)), 2);
+        EXPECT_EQ(*((int *)listPopBack(list)), 3);
+        EXPECT_EQ(*((int *)listPopFront(list)), 2);
+
+        EXPECT_EQ(isListEmpty(list), true);
+        EXPECT_EQ(list -> head, nullptr);
+        EXPECT_EQ(list -> tail, nullptr);
+        EXPECT_EQ(listPopFront(list), nullptr);
+    }
+}
+
+// Walks the list both ways, checking the links against each other and against the size
+static std::vector<int> listValues(struct List const * const list) {
+    std::vector<int> values;
+    struct ListNode * prev = NULL;
+    for (struct ListNode * node = list -> head; node != NULL; node = node -> next) {
+        EXPECT_EQ(node -> prev, prev);
+        values.push_back(* (int *) node -> element);
+        prev = node;
+    }
+
+    EXPECT_EQ(list -> tail, prev);
+    EXPECT_EQ(list -> size, values.size());
+
+    return values;
+}
+
+static int compareInts(void const * a, void const * b) {
+    return * (int const *) a - * (int const *) b;
+}
+
+// Orders by tens only, so that elements with the same tens tell whether a sort is stable
+static int compareTens(void const * a, void const * b) {
+    return * (int const *) a / 10 - * (int const *) b / 10;
+}
+
+// listSplice
+TEST_F(ListTest, listSpliceTest) {
+    int values[] = {0, 1, 2, 3, 4, 5, 6, 7};
+    struct List * other = newList();
+
+    listPushBack(list, &values[0]);
+    listPushBack(list, &values[5]);
+    for (int i = 1; i < 5; i++)
+        listPushBack(other, &values[i]);
+    listPushBack(other, &values[6]);
+
+    // Move the cursors, which must not point at moved nodes or stale indices afterwards
+    listGet(list, 1);
+    listGet(other, 2);
+
+    // A range from the middle of the other list
+    listSplice(list, list -> tail, other, other -> head -> next, other -> tail -> prev, 3);
+    EXPECT_THAT(listValues(list), ::testing::ElementsAre(0, 2, 3, 4, 5));
+    EXPECT_THAT(listValues(other), ::testing::ElementsAre(1, 6));
+    EXPECT_EQ(* (int *) listGet(list, 3), 4);
+    EXPECT_EQ(* (int *) listGet(other, 1), 6);
+
+    // The first node of the other list, at the front
+    listSplice(list, list -> head, other, other -> head, other -> head, 1);
+    EXPECT_THAT(listValues(list), ::testing::ElementsAre(1, 0, 2, 3, 4, 5));
+
+    // The rest of it, at the back
+    listSplice(list, NULL, other, other -> head, other -> tail, 1);
+    EXPECT_THAT(listValues(list), ::testing::ElementsAre(1, 0, 2, 3, 4, 5, 6));
+    EXPECT_THAT(listValues(other), ::testing::ElementsAre());
+    EXPECT_EQ(* (int *) listGet(list, 6), 6);
+
+    // Into an empty list
+    listSplice(other, NULL, list, list -> head, list -> tail, 7);
+    EXPECT_THAT(listValues(other), ::testing::ElementsAre(1, 0, 2, 3, 4, 5, 6));
+    EXPECT_THAT(listValues(list), ::testing::ElementsAre());
+
+    // Lists drawing from different pools can't exchange nodes
+    struct List * pooled = newPooledList(nullptr);
+    listPushBack(pooled, &values[7]);
+    EXPECT_DEATH(listSplice(list, NULL, pooled, pooled -> head, pooled -> head, 1), ::testing::HasSubstr("The lists must allocate their nodes in the same way."));
+    EXPECT_DEATH(listSplice(list, NULL, list, other -> head, other -> head, 1), ::testing::HasSubstr("The nodes must be moved to a different list."));
+    EXPECT_DEATH(listSplice(list, NULL, other, other -> head, other -> head, 8), ::testing::HasSubstr("The number of nodes is out of bounds."));
+    EXPECT_DEATH(listSplice(list, NULL, nullptr, nullptr, nullptr, 1), ::testing::HasSubstr("The parameter <other> cannot be NULL."));
+
+    deleteList(&pooled, nullptr);
+    deleteList(&other, nullptr);
+}
+
+// listMerge
+TEST_F(ListTest, listMergeTest) {
+    int values[] = {10, 11, 20, 30, 31, 40, 50, 51};
+    struct List * other = newList();
+
+    // Equal elements from this list come first
+    listPushBack(list, &values[0]);
+    listPushBack(list, &values[3]);
+    listPushBack(list, &values[6]);
+    listPushBack(other, &values[1]);
+    listPushBack(other, &values[2]);
+    listPushBack(other, &values[4]);
+    listPushBack(other, &values[5]);
+    listPushBack(other, &values[7]);
+
+    listGet(list, 2);
+    listMerge(list, other, compareTens);
+    EXPECT_THAT(listValues(list), ::testing::ElementsAre(10, 11, 20, 30, 31, 40, 50, 51));
+    EXPECT_THAT(listValues(other), ::testing::ElementsAre());
+    EXPECT_EQ(* (int *) listGet(list, 5), 40);
+
+    // Merging an empty list, or into an empty list
+    listMerge(list, other, compareTens);
+    EXPECT_EQ(list -> size, 8);
+    listMerge(other, list, compareTens);
+    EXPECT_THAT(listValues(other), ::testing::ElementsAre(10, 11, 20, 30, 31, 40, 50, 51));
+    EXPECT_THAT(listValues(list), ::testing::ElementsAre());
+
+    EXPECT_DEATH(listMerge(list, other, nullptr), ::testing::HasSubstr("The parameter <compare> cannot be NULL."));
+
+    deleteList(&other, nullptr);
+}
+
+// listSort
+TEST_F(ListTest, listSortTest) {
+    // Sorting an empty list or a single element changes nothing
+    listSort(list, compareInts);
+    EXPECT_THAT(listValues(list), ::testing::ElementsAre());
+
+    std::vector<int> values(1000);
+    std::mt19937 random(42);
+    for (size_t i = 0; i < values.size(); i++) {
+        // Each value tells its rank among the values with the same tens, in the order they are pushed
+        values[i] = (random() % 100) * 10;
+        for (size_t j = 0; j < i; j++) {
+            if (values[j] / 10 == values[i] / 10)
+                values[i]++;
+        }
+    }
+
+    for (size_t count : {1, 2, 3, 5, 64, 1000}) {
+        while (isListEmpty(list) == false)
+            listPopBack(list);
+        for (size_t i = 0; i < count; i++)
+            listPushBack(list, &values[i]);
+
+        std::vector<int> expected(values.begin(), values.begin() + count);
+        std::stable_sort(expected.begin(), expected.end(), [](int a, int b) { return a / 10 < b / 10; });
+
+        listGet(list, count - 1);
+        listSort(list, compareTens);
+        EXPECT_EQ(listValues(list), expected);
+        EXPECT_EQ(* (int *) listGet(list, count / 2), expected[count / 2]);
+    }
+
+    struct List * unrolled = newUnrolledList();
+    EXPECT_DEATH(listSort(unrolled, compareInts), ::testing::HasSubstr("Only linked lists can be sorted."));
+    deleteList(&unrolled, nullptr);
+}
+
+// listIterator, listIteratorNext, listIteratorPrev, listIteratorGet, listIteratorSet
+TEST_F(ListTest, listIteratorWalkTest) {
+    int values[] = {0, 1, 2, 3, 4};
+    int replacement = 10;
+
+    // On an empty list, the iterator stays off the list
+    struct ListIterator iterator = listIterator(list);
+    EXPECT_EQ(listIteratorNext(&iterator), false);
+    EXPECT_EQ(listIteratorPrev(&iterator), false);
+    EXPECT_DEATH(listIteratorGet(&iterator), ::testing::HasSubstr("The iterator is off the list."));
+
+    for (int i = 0; i < 5; i++)
+        listPushBack(list, &values[i]);
+
+    std::vector<int> forward;
+    while (listIteratorNext(&iterator))
+        forward.push_back(* (int *) listIteratorGet(&iterator));
+    EXPECT_THAT(forward, ::testing::ElementsAre(0, 1, 2, 3, 4));
+
+    // Off the list, going backward starts from the last element
+    std::vector<int> backward;
+    while (listIteratorPrev(&iterator))
+        backward.push_back(* (int *) listIteratorGet(&iterator));
+    EXPECT_THAT(backward, ::testing::ElementsAre(4, 3, 2, 1, 0));
+
+    listIteratorNext(&iterator);
+    listIteratorNext(&iterator);
+    listIteratorSet(&iterator, &replacement);
+    EXPECT_EQ(* (int *) listGet(list, 1), 10);
+
+    struct List * unrolled = newUnrolledList();
+    EXPECT_DEATH(listIterator(unrolled), ::testing::HasSubstr("Only linked lists have iterators."));
+    EXPECT_DEATH(listIteratorNext(nullptr), ::testing::HasSubstr("The parameter <iterator> cannot be NULL."));
+    deleteList(&unrolled, nullptr);
+}
+
+// listIteratorInsertBefore, listIteratorInsertAfter
+TEST_F(ListTest, listIteratorInsertTest) {
+    int values[] = {0, 1, 2, 3, 4, 5};
+    struct ListIterator iterator = listIterator(list);
+
+    // Off the list, inserting before adds at the back and inserting after adds at the front
+    listIteratorInsertBefore(&iterator, &values[3]);
+    listIteratorInsertAfter(&iterator, &values[1]);
+    listIteratorInsertBefore(&iterator, &values[5]);
+    EXPECT_THAT(listValues(list), ::testing::ElementsAre(1, 3, 5));
+
+    listIteratorNext(&iterator);
+    listIteratorNext(&iterator);
+    listIteratorInsertBefore(&iterator, &values[2]);
+    listIteratorInsertAfter(&iterator, &values[4]);
+    EXPECT_EQ(* (int *) listIteratorGet(&iterator), 3);
+    EXPECT_THAT(listValues(list), ::testing::ElementsAre(1, 2, 3, 4, 5));
+
+    // At the ends of the list
+    listIteratorPrev(&iterator);
+    listIteratorPrev(&iterator);
+    listIteratorInsertBefore(&iterator, &values[0]);
+    EXPECT_THAT(listValues(list), ::testing::ElementsAre(0, 1, 2, 3, 4, 5));
+
+    // Positional operations still see the right elements
+    for (int i = 0; i < 6; i++)
+        EXPECT_EQ(* (int *) listGet(list, i), i);
+}
+
+// listIteratorErase
+TEST_F(ListTest, listIteratorEraseTest) {
+    int values[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    for (int i = 0; i < 10; i++)
+        listPushBack(list, &values[i]);
+
+    // Filtering out the odd values, including the last one, after moving the current node of the list to the back
+    listGet(list, 9);
+    struct ListIterator iterator = listIterator(list);
+    while (listIteratorNext(&iterator)) {
+        if (* (int *) listIteratorGet(&iterator) % 2 == 1)
+            listIteratorErase(&iterator);
+    }
+    EXPECT_THAT(listValues(list), ::testing::ElementsAre(0, 2, 4, 6, 8));
+    EXPECT_EQ(* (int *) listGet(list, 4), 8);
+
+    // Erasing the first element leaves the iterator off the list, from where it goes to the new first element
+    listIteratorNext(&iterator);
+    EXPECT_EQ(* (int *) listIteratorErase(&iterator), 0);
+    EXPECT_EQ(iterator.node, nullptr);
+    EXPECT_EQ(listIteratorNext(&iterator), true);
+    EXPECT_EQ(* (int *) listIteratorGet(&iterator), 2);
+
+    while (isListEmpty(list) == false) {
+        iterator = listIterator(list);
+        listIteratorPrev(&iterator);
+        listIteratorErase(&iterator);
+    }
+    EXPECT_THAT(listValues(list), ::testing::ElementsAre());
+    EXPECT_DEATH(listIteratorErase(&iterator), ::testing::HasSubstr("The iterator is off the list."));
+}
+
+// Several iterators walking and modifying the same list, checked against std::list
+TEST_F(ListTest, listIteratorsRandomTest) {
+    std::vector<int> values(20000);
+    std::list<int> model;
+    std::mt19937 random(42);
+
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = i;
+
+    // Off the list is the end iterator of std::list, which is where both kinds of iterators start
+    struct ListIterator iterators[3] = {listIterator(list), listIterator(list), listIterator(list)};
+    std::list<int>::iterator positions[3] = {model.end(), model.end(), model.end()};
+
+    for (size_t step = 0; step < values.size(); step++) {
+        unsigned which = random() % 3;
+        struct ListIterator * iterator = &iterators[which];
+        std::list<int>::iterator & position = positions[which];
+
+        switch (random() % 6) {
+            case 0:
+                listIteratorNext(iterator);
+                position = position == model.end() ? model.begin() : std::next(position);
+                break;
+            case 1:
+                listIteratorPrev(iterator);
+                position = position == model.begin() ? model.end() : std::prev(position);
+                break;
+            case 2:
+                listIteratorInsertBefore(iterator, &values[step]);
+                model.insert(position, step);
+                break;
+            case 3:
+                listIteratorInsertAfter(iterator, &values[step]);
+                model.insert(position == model.end() ? model.begin() : std::next(position), step);
+                break;
+            case 4:
+                // Erasing also invalidates the other iterators on that element, so we send them off the list
+                if (position != model.end()) {
+                    std::list<int>::iterator erased = position;
+                    for (unsigned i = 0; i < 3; i++) {
+                        if (i != which && positions[i] == erased) {
+                            positions[i] = model.end();
+                            iterators[i].node = NULL;
+                        }
+                    }
+
+                    ASSERT_EQ(* (int *) listIteratorErase(iterator), * erased);
+                    position = erased == model.begin() ? model.end() : std::prev(erased);
+                    model.erase(erased);
+                }
+                break;
+            default:
+                if (model.empty() == false) {
+                    unsigned index = random() % model.size();
+                    ASSERT_EQ(* (int *) listGet(list, index), * std::next(model.begin(), index));
+                }
+                break;
+        }
+
+        if (position == model.end()) {
+            ASSERT_EQ(iterator -> node, nullptr);
+        }
+        else {
+            ASSERT_EQ(* (int *) listIteratorGet(iterator), * position);
+        }
+
+        if (step % 1000 == 0) {
+            ASSERT_EQ(listValues(list), std::vector<int>(model.begin(), model.end()));
+        }
+    }
+}
+
+// Pooled lists recycle their nodes, the deleter still has to run once per element on deleteList
+static int deleted_elements = 0;
+
+static void countDeleted(void * element) {
+    (void) element;
+    deleted_elements++;
+}
+
+class PooledListTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            pool = newListNodePool(4);
+            list = newPooledList(pool);
+        }
+
+        void TearDown() override {
+            deleteList(&list, nullptr);
+            deleteListNodePool(&pool);
+        }
+
+        struct ListNodePool * pool;
+        struct List * list;
+};
+
+// newListNodePool, newPooledList
+TEST_F(PooledListTest, newPooledListTest) {
+    EXPECT_NE(pool, nullptr);
+    EXPECT_NE(list, nullptr);
+    EXPECT_EQ(list -> pool, pool);
+    EXPECT_EQ(pool -> users, 1);
+
+    // A pool that is still used by a list cannot be deleted
+    EXPECT_DEATH(deleteListNodePool(&pool), ::testing::HasSubstr("The pool is still used by a list."));
+}
+
+// Nodes are carved out of slabs and released nodes are reused
+TEST_F(PooledListTest, nodeReuseTest) {
+    int values[] = {1, 2, 3, 4, 5, 6};
+
+    for (int i = 0; i < 4; i++)
+        listPushBack(list, &values[i]);
+
+    // Successive nodes from the same slab are adjacent
+    EXPECT_EQ(list -> head -> next, list -> head + 1);
+    EXPECT_EQ(list -> tail, list -> head + 3);
+
+    struct ListNode * old_tail = list -> tail;
+    EXPECT_EQ(*((int *)listPopBack(list)), 4);
+    listPushFront(list, &values[4]);
+    EXPECT_EQ(list -> head, old_tail);
+
+    // A fifth node needs a new slab
+    listPushBack(list, &values[5]);
+    EXPECT_NE(pool -> slabs -> next, nullptr);
+
+    int expected[] = {5, 1, 2, 3, 6};
+    for (int i = 0; i < 5; i++)
+        EXPECT_EQ(*((int *)listGet(list, i)), expected[i]);
+}
+
+// Lists sharing a pool
+TEST_F(PooledListTest, sharedPoolTest) {
+    int values[] = {1, 2, 3, 4, 5, 6};
+    struct List * other = newPooledList(pool);
+    EXPECT_EQ(pool -> users, 2);
+
+    for (int i = 0; i < 6; i++) {
+        listPushBack(list, &values[i]);
+        listPushFront(other, &values[i]);
+    }
+
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(*((int *)listGet(list, i)), values[i]);
+        EXPECT_EQ(*((int *)listGet(other, i)), values[5 - i]);
+    }
+
+    // Nodes of a deleted list go back to the pool for the other lists to use
+    deleteList(&other, countDeleted);
+    EXPECT_EQ(pool -> users, 1);
+    EXPECT_NE(pool -> free_nodes, nullptr);
+}
+
+// A list with a pool of its own
+TEST_F(PooledListTest, privatePoolTest) {
+    int values[] = {1, 2, 3};
+    struct List * own = newPooledList(nullptr);
+    EXPECT_NE(own -> pool, nullptr);
+    EXPECT_EQ(own -> owns_pool, true);
+
+    for (int i = 0; i < 1000; i++)
+        listPushBack(own, &values[i % 3]);
+    for (int i = 0; i < 500; i++)
+        listPopFront(own);
+    EXPECT_EQ(own -> size, 500);
+
+    // The deleter still sees every element before the slabs are released
+    deleted_elements = 0;
+    deleteList(&own, countDeleted);
+    EXPECT_EQ(own, nullptr);
+    EXPECT_EQ(deleted_elements, 500);
+}
+
+
+// Checks that blocks are linked both ways, none is empty, counts add up to the size, and the current block starts at the current index
+static bool isUnrolledList(struct List const * const list) {
+    unsigned size = 0;
+    bool current_found = list -> current_block == NULL;
+    struct ListBlock const * prev = NULL;
+
+    for (struct ListBlock const * block = list -> head_block; block != NULL; block = block -> next) {
+        if (block -> prev != prev || block -> count == 0 || block -> count > LIST_BLOCK_CAPACITY)
+            return false;
+
+        if (block == list -> current_block) {
+            if (list -> current_index != size)
+                return false;
+            current_found = true;
+        }
+
+        size += block -> count;
+        prev = block;
+    }
+
+    return list -> tail_block == prev && size == list -> size && current_found;
+}
+
+class UnrolledListTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            list = newUnrolledList();
+        }
+
+        void TearDown() override {
+            deleteList(&list, nullptr);
+        }
+
+        struct List * list;
+};
+
+// newUnrolledList
+TEST_F(UnrolledListTest, newUnrolledListTest) {
+    EXPECT_NE(list, nullptr);
+    EXPECT_EQ(list -> layout, LIST_UNROLLED);
+    EXPECT_EQ(isListEmpty(list), true);
+    EXPECT_EQ(listFront(list), nullptr);
+    EXPECT_EQ(listPopBack(list), nullptr);
+
+    // A block fills two cache lines
+    EXPECT_EQ(sizeof(struct ListBlock), 128);
+}
+
+// listPushBack, listPushFront, listBack, listFront
+TEST_F(UnrolledListTest, pushTest) {
+    intptr_t count = 3 * LIST_BLOCK_CAPACITY;
+    for (intptr_t i = 0; i < count; i++)
+        listPushBack(list, (void *) i);
+
+    // Elements pushed at the back fill blocks completely
+    EXPECT_EQ(list -> head_block -> count, LIST_BLOCK_CAPACITY);
+    EXPECT_EQ(list -> head_block -> next -> next, list -> tail_block);
+    EXPECT_TRUE(isUnrolledList(list));
+
+    for (intptr_t i = 1; i <= count; i++)
+        listPushFront(list, (void *) -i);
+    EXPECT_TRUE(isUnrolledList(list));
+
+    EXPECT_EQ((intptr_t) listFront(list), -count);
+    EXPECT_EQ((intptr_t) listBack(list), count - 1);
+    for (intptr_t i = 0; i < 2 * count; i++)
+        ASSERT_EQ((intptr_t) listGet(list, i), i < count ? i - count : i - count);
+}
+
+// listInsert, which splits full blocks
+TEST_F(UnrolledListTest, insertTest) {
+    std::vector<intptr_t> model;
+    for (intptr_t i = 0; i < LIST_BLOCK_CAPACITY; i++) {
+        listPushBack(list, (void *) i);
+        model.push_back(i);
+    }
+
+    listInsert(list, 3, (void *) 100);
+    model.insert(model.begin() + 3, 100);
+    EXPECT_NE(list -> head_block, list -> tail_block);
+    EXPECT_TRUE(isUnrolledList(list));
+
+    listInsert(list, LIST_BLOCK_CAPACITY - 1, (void *) 200);
+    model.insert(model.begin() + LIST_BLOCK_CAPACITY - 1, 200);
+    EXPECT_TRUE(isUnrolledList(list));
+
+    for (unsigned i = 0; i < model.size(); i++)
+        EXPECT_EQ((intptr_t) listGet(list, i), model[i]);
+}
+
+// listRemove, which merges blocks that get too empty
+TEST_F(UnrolledListTest, removeTest) {
+    for (intptr_t i = 0; i < 4 * LIST_BLOCK_CAPACITY; i++)
+        listPushBack(list, (void *) i);
+
+    // Emptying the middle of the list leaves few blocks behind
+    for (int i = 0; i < 2 * LIST_BLOCK_CAPACITY; i++)
+        listRemove(list, LIST_BLOCK_CAPACITY);
+    EXPECT_TRUE(isUnrolledList(list));
+
+    unsigned blocks = 0;
+    for (struct ListBlock * block = list -> head_block; block != NULL; block = block -> next)
+        blocks++;
+    EXPECT_LE(blocks, 3);
+
+    for (intptr_t i = 0; i < 2 * LIST_BLOCK_CAPACITY; i++)
+        EXPECT_EQ((intptr_t) listGet(list, i), i < LIST_BLOCK_CAPACITY ? i : i + 2 * LIST_BLOCK_CAPACITY);
+
+    while (isListEmpty(list) == false)
+        listRemove(list, list -> size / 2);
+    EXPECT_EQ(list -> head_block, nullptr);
+    EXPECT_EQ(list -> tail_block, nullptr);
+    EXPECT_EQ(list -> current_block, nullptr);
+}
+
+// ->begin, ->next, ->deref
+TEST_F(UnrolledListTest, iteratorTest) {
+    struct Collection const * collection = &list -> collection;
+    struct CIterator iterator;
+
+    EXPECT_EQ(collection -> begin(collection, &iterator), false);
+
+    for (intptr_t i = 0; i < 100; i++)
+        listPushBack(list, (void *) i);
+
+    intptr_t expected = 0;
+    for (bool more = collection -> begin(collection, &iterator); more; more = collection -> next(&iterator))
+        EXPECT_EQ((intptr_t) collection -> deref(&iterator), expected++);
+    EXPECT_EQ(expected, 100);
+}
+
+// deleteList
+TEST_F(UnrolledListTest, deleteTest) {
+    for (int i = 0; i < 100; i++)
+        listPushBack(list, nullptr);
+
+    deleted_elements = 0;
+    deleteList(&list, countDeleted);
+    EXPECT_EQ(list, nullptr);
+    EXPECT_EQ(deleted_elements, 100);
+}
+
+// A random mix of positional operations checked against std::vector, for both layouts
+TEST(ListLayoutsTest, randomOperationsTest) {
+    for (struct List * list : {newList(), newUnrolledList()}) {
+        std::vector<intptr_t> model;
+        std::mt19937 random(42);
+
+        for (int step = 0; step < 30000; step++) {
+            unsigned operation = random() % 8;
+            intptr_t value = random();
+
+            if (model.empty() || operation == 0) {
+                listPushBack(list, (void *) value);
+                model.push_back(value);
+            }
+            else if (operation == 1) {
+                listPushFront(list, (void *) value);
+                model.insert(model.begin(), value);
+            }
+            else if (operation == 2) {
+                unsigned index = random() % model.size();
+                listInsert(list, index, (void *) value);
+                model.insert(model.begin() + index, value);
+            }
+            else if (operation == 3) {
+                unsigned index = random() % model.size();
+                ASSERT_EQ((intptr_t) listRemove(list, index), model[index]);
+                model.erase(model.begin() + index);
+            }
+            else if (operation == 4) {
+                ASSERT_EQ((intptr_t) listPopFront(list), model.front());
+                model.erase(model.begin());
+            }
+            else if (operation == 5) {
+                ASSERT_EQ((intptr_t) listPopBack(list), model.back());
+                model.pop_back();
+            }
+            else if (operation == 6) {
+                unsigned index = random() % model.size();
+                listSet(list, index, (void *) value);
+                model[index] = value;
+            }
+            else {
+                unsigned index = random() % model.size();
+                ASSERT_EQ((intptr_t) listGet(list, index), model[index]);
+            }
+
+            ASSERT_EQ(list -> size, model.size());
+            if (list -> layout == LIST_UNROLLED) {
+                ASSERT_TRUE(isUnrolledList(list));
+            }
+        }
+
+        for (unsigned i = 0; i < model.size(); i++)
+            ASSERT_EQ((intptr_t) listGet(list, i), model[i]);
+
+        deleteList(&list, nullptr);
+    }
+}
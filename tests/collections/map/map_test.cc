@@ -4,12 +4,23 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <chrono>
+#include <set>
 #include <vector>
 
 extern "C" {
+    #include "hash.h"
     #include "map.h"
 }
 
+// Sends every key to the same bucket so that only the equality callback can tell them apart
+static uint64_t collidingHash(void const * data, unsigned length, char const key[16]) {
+    (void) data;
+    (void) length;
+    (void) key;
+    return 42;
+}
+
 class HashMapTest: public ::testing::Test {
     protected:
         void SetUp() override {
@@ -103,6 +114,32 @@ TEST_F(HashMapTest, resizeHashMapTest) {
     EXPECT_DEATH(resizeHashMap(hash_map, 20), ::testing::HasSubstr("The parameter <map> cannot be NULL."));
 }
 
+// resizeHashMap, as triggered by hashMapInsert
+TEST_F(HashMapTest, resizeHashMapGrowthTest) {
+    std::vector<uint64_t> keys(10000);
+    for (uint64_t i = 0; i < keys.size(); i++) {
+        keys[i] = i;
+        hashMapInsert(hash_map, sizeof keys[i], &keys[i], &keys[i]);
+    }
+
+    // The load factor is tracked accurately across resizes so the map keeps growing with its content
+    unsigned buckets_count = 0;
+    for (unsigned i = 0; i < hash_map -> capacity; i++) {
+        if (hash_map -> items[i] != NULL) {
+            EXPECT_EQ(hash_map -> items[i] -> prev, nullptr);
+            buckets_count++;
+        }
+    }
+    EXPECT_EQ(hash_map -> buckets_count, buckets_count);
+    EXPECT_GE(hash_map -> capacity, hash_map -> size);
+
+    // Deleting after a resize relinks chains correctly
+    for (uint64_t i = 0; i < keys.size(); i += 2)
+        EXPECT_EQ(hashMapDelete(hash_map, sizeof i, &i, nullptr), true);
+    for (uint64_t i = 0; i < keys.size(); i++)
+        EXPECT_EQ(hashMapGet(hash_map, sizeof i, &i), i % 2 == 0 ? nullptr : &keys[i]);
+}
+
 // isHashMapEmpty
 TEST_F(HashMapTest, isHashMapEmptyTest) {
     // No elements have been added to the hash map, it should be empty
@@ -297,3 +334,405 @@ TEST_F(HashMapTest, hashMap_get_Test) {
         ::testing::HasSubstr("The index is out of bounds.")
     );
 }
+
+
+// hashMapUseHasher
+TEST_F(HashMapTest, hashMapUseHasherTest) {
+    const char * pair1[] = {"key1", "value1"};
+    const char * pair2[] = {"key2", "value2"};
+
+    hashMapUseHasher(hash_map, collidingHash, bytesEqual);
+
+    hashMapInsert(hash_map, strlen(pair1[0]), pair1[0], const_cast<char *>(pair1[1]));
+    hashMapInsert(hash_map, strlen(pair2[0]), pair2[0], const_cast<char *>(pair2[1]));
+
+    // Both keys share a hash but the equality callback keeps them apart
+    EXPECT_EQ(hash_map -> size, 2);
+    EXPECT_EQ(hashMapGet(hash_map, strlen(pair1[0]), pair1[0]), pair1[1]);
+    EXPECT_EQ(hashMapGet(hash_map, strlen(pair2[0]), pair2[0]), pair2[1]);
+    EXPECT_EQ(hashMapGet(hash_map, 4, "key3"), nullptr);
+
+    hashMapDelete(hash_map, strlen(pair1[0]), pair1[0], nullptr);
+    EXPECT_EQ(hashMapGet(hash_map, strlen(pair1[0]), pair1[0]), nullptr);
+    EXPECT_EQ(hashMapGet(hash_map, strlen(pair2[0]), pair2[0]), pair2[1]);
+
+    // The hash function cannot change once keys were hashed with the previous one
+    EXPECT_DEATH(
+        hashMapUseHasher(hash_map, wyHash, nullptr),
+        ::testing::HasSubstr("The hash function of a non-empty hash map cannot be changed.")
+    );
+}
+
+// hashMapCursor, hashMapCursorNext
+TEST_F(HashMapTest, hashMapCursorTest) {
+    std::vector<uint64_t> keys(1000);
+    std::set<uint64_t> visited;
+
+    // An empty map has nothing to visit
+    struct HashMapCursor cursor = hashMapCursor(hash_map);
+    EXPECT_EQ(hashMapCursorNext(hash_map, &cursor), false);
+
+    for (uint64_t i = 0; i < keys.size(); i++) {
+        keys[i] = i;
+        hashMapInsert(hash_map, sizeof keys[i], &keys[i], &keys[i]);
+    }
+
+    // Every entry is visited exactly once
+    cursor = hashMapCursor(hash_map);
+    while (hashMapCursorNext(hash_map, &cursor)) {
+        EXPECT_EQ(cursor.key_len, sizeof(uint64_t));
+        EXPECT_EQ(cursor.key, cursor.value);
+        EXPECT_EQ(visited.insert(* (uint64_t const *) cursor.key).second, true);
+    }
+    EXPECT_EQ(visited.size(), keys.size());
+
+    // Once done, the cursor stays at the end
+    EXPECT_EQ(hashMapCursorNext(hash_map, &cursor), false);
+}
+
+// ->get, visiting entries in order
+TEST_F(HashMapTest, hashMap_get_SequentialTest) {
+    std::vector<uint64_t> keys(100000);
+    std::set<uint64_t> visited;
+
+    for (uint64_t i = 0; i < keys.size(); i++) {
+        keys[i] = i;
+        hashMapInsert(hash_map, sizeof keys[i], &keys[i], &keys[i]);
+    }
+
+    // This would take seconds if every call started over from the first bucket
+    for (unsigned i = 0; hash_map -> collection.atEnd(&hash_map -> collection, i) == false; i++) {
+        struct HashMapItem * item = (struct HashMapItem *) hash_map -> collection.get(&hash_map -> collection, i);
+        visited.insert(* (uint64_t const *) item -> key);
+    }
+    EXPECT_EQ(visited.size(), keys.size());
+
+    // Going back or modifying the map starts over without returning stale entries
+    struct HashMapItem * first = (struct HashMapItem *) hash_map -> collection.get(&hash_map -> collection, 0);
+    EXPECT_EQ(hash_map -> collection.get(&hash_map -> collection, 10), hash_map -> collection.get(&hash_map -> collection, 10));
+
+    hashMapDelete(hash_map, first -> key_len, first -> key, nullptr);
+    for (unsigned i = 0; hash_map -> collection.atEnd(&hash_map -> collection, i) == false; i++) {
+        struct HashMapItem * item = (struct HashMapItem *) hash_map -> collection.get(&hash_map -> collection, i);
+        EXPECT_NE(item, first);
+    }
+}
+
+class FlatHashMapTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            hash_map = newFlatHashMap(10);
+        }
+
+        void TearDown() override {
+            deleteHashMap(&hash_map, nullptr);
+        }
+    
+        struct HashMap * hash_map;
+};
+
+// newFlatHashMap
+TEST_F(FlatHashMapTest, newFlatHashMapTest) {
+    // Expect that a new hashMap was created
+    EXPECT_NE(hash_map, nullptr);
+    EXPECT_EQ(hash_map -> layout, HASH_MAP_FLAT);
+
+    // Expect that the capacity was rounded up to a full group
+    EXPECT_EQ(hash_map -> capacity, 16);
+
+    // Check that a different hashMap with size 0 fails to be created
+    EXPECT_DEATH(newFlatHashMap(0), ::testing::HasSubstr("Initial hash map capacity cannot be zero."));
+}
+
+// resizeHashMap
+TEST_F(FlatHashMapTest, resizeHashMapTest) {
+    const char * pair1[] = {"key1", "value1"};
+    const char * pair2[] = {"key2", "value2"};
+
+    hashMapInsert(hash_map, strlen(pair1[0]), pair1[0], const_cast<char *>(pair1[1]));
+    hashMapInsert(hash_map, strlen(pair2[0]), pair2[0], const_cast<char *>(pair2[1]));
+
+    hash_map = resizeHashMap(hash_map, 20);
+
+    // The capacity is always a power of two
+    EXPECT_EQ(hash_map -> capacity, 32);
+    EXPECT_EQ(hash_map -> size, 2);
+    EXPECT_STREQ(
+        (const char *) hashMapGet(hash_map, strlen(pair1[0]), pair1[0]),
+        "value1"
+    );
+    EXPECT_STREQ(
+        (const char *) hashMapGet(hash_map, strlen(pair2[0]), pair2[0]),
+        "value2"
+    );
+
+    EXPECT_DEATH(resizeHashMap(hash_map, 20), ::testing::HasSubstr("The new capacity cannot be less or equal to the existing capacity."));
+}
+
+// hashMapInsert, hashMapGet
+TEST_F(FlatHashMapTest, hashMapInsertTest) {
+    // Insert enough keys to force a few resizes
+    std::vector<uint64_t> keys(1000);
+    for (uint64_t i = 0; i < keys.size(); i++) {
+        keys[i] = i;
+        EXPECT_EQ(hashMapInsert(hash_map, sizeof keys[i], &keys[i], &keys[i]), true);
+    }
+    EXPECT_EQ(hash_map -> size, 1000);
+
+    for (uint64_t i = 0; i < keys.size(); i++)
+        EXPECT_EQ(hashMapGet(hash_map, sizeof i, &i), &keys[i]);
+
+    uint64_t missing = 1000;
+    EXPECT_EQ(hashMapGet(hash_map, sizeof missing, &missing), nullptr);
+
+    // Inserting the same key twice is not allowed
+    EXPECT_DEATH(
+        hashMapInsert(hash_map, sizeof keys[0], &keys[0], &keys[0]),
+        ::testing::HasSubstr("An element with the given key already exists in the hash map.")
+    );
+}
+
+// hashMapSet
+TEST_F(FlatHashMapTest, hashMapSetTest) {
+    const char * pair1[] = {"key1", "value1"};
+    const char * pair2[] = {"key2", "value2"};
+
+    hashMapInsert(hash_map, strlen(pair1[0]), pair1[0], const_cast<char *>(pair1[1]));
+
+    // Replacing an existing key returns the previous value
+    const char * new_value = "new_value";
+    EXPECT_STREQ(
+        (const char *) hashMapSet(hash_map, strlen(pair1[0]), pair1[0], const_cast<char *>(new_value)),
+        "value1"
+    );
+    EXPECT_STREQ(
+        (const char *) hashMapGet(hash_map, strlen(pair1[0]), pair1[0]),
+        "new_value"
+    );
+
+    // Setting a non-existing key inserts it
+    EXPECT_EQ(hashMapSet(hash_map, strlen(pair2[0]), pair2[0], const_cast<char *>(pair2[1])), nullptr);
+    EXPECT_EQ(hash_map -> size, 2);
+}
+
+// hashMapDelete
+TEST_F(FlatHashMapTest, hashMapDeleteTest) {
+    std::vector<uint64_t> keys(1000);
+    for (uint64_t i = 0; i < keys.size(); i++) {
+        keys[i] = i;
+        hashMapInsert(hash_map, sizeof keys[i], &keys[i], &keys[i]);
+    }
+
+    // Delete every other key then make sure the remaining ones can still be found past the tombstones
+    for (uint64_t i = 0; i < keys.size(); i += 2)
+        EXPECT_EQ(hashMapDelete(hash_map, sizeof i, &i, nullptr), true);
+    EXPECT_EQ(hash_map -> size, 500);
+
+    for (uint64_t i = 0; i < keys.size(); i++)
+        EXPECT_EQ(hashMapGet(hash_map, sizeof i, &i), i % 2 == 0 ? nullptr : &keys[i]);
+
+    uint64_t missing = 0;
+    EXPECT_EQ(hashMapDelete(hash_map, sizeof missing, &missing, nullptr), false);
+
+    // Churn through many more keys than the capacity to make sure tombstones get reclaimed
+    unsigned capacity = hash_map -> capacity;
+    for (uint64_t i = 0; i < 100000; i++) {
+        uint64_t key = 2000 + i;
+        hashMapInsert(hash_map, sizeof key, &key, &keys[0]);
+        hashMapDelete(hash_map, sizeof key, &key, nullptr);
+    }
+    EXPECT_EQ(hash_map -> size, 500);
+    EXPECT_EQ(hash_map -> capacity, capacity);
+}
+
+// ->get, ->atEnd
+TEST_F(FlatHashMapTest, hashMap_get_Test) {
+    const char * pair1[] = {"key1", "value1"};
+    const char * pair2[] = {"key2", "value2"};
+    const char * pair3[] = {"key3", "value3"};
+
+    std::vector<const char *> keys = {"key1", "key2", "key3"};
+    std::vector<const char *> values = {"value1", "value2", "value3"};
+
+    hashMapInsert(hash_map, strlen(pair1[0]), pair1[0], const_cast<char *>(pair1[1]));
+    hashMapInsert(hash_map, strlen(pair2[0]), pair2[0], const_cast<char *>(pair2[1]));
+    hashMapInsert(hash_map, strlen(pair3[0]), pair3[0], const_cast<char *>(pair3[1]));
+
+    for (unsigned i = 0; hash_map -> collection.atEnd(&hash_map -> collection, i) == false; i++) {
+        struct HashMapSlot * slot = (struct HashMapSlot *) hash_map -> collection.get(&hash_map -> collection, i);
+        ASSERT_THAT(keys, ::testing::Contains(slot -> key));
+        ASSERT_THAT(values, ::testing::Contains(slot -> value));
+    }
+
+    EXPECT_DEATH(
+        hash_map -> collection.get(&hash_map -> collection, 3),
+        ::testing::HasSubstr("The index is out of bounds.")
+    );
+}
+
+
+// hashMapUseHasher
+TEST_F(FlatHashMapTest, hashMapUseHasherTest) {
+    std::vector<uint64_t> keys(100);
+
+    hashMapUseHasher(hash_map, collidingHash, bytesEqual);
+
+    // Colliding keys spill over several groups and must all be found again
+    for (uint64_t i = 0; i < keys.size(); i++) {
+        keys[i] = i;
+        hashMapInsert(hash_map, sizeof keys[i], &keys[i], &keys[i]);
+    }
+
+    EXPECT_EQ(hash_map -> size, keys.size());
+    for (uint64_t i = 0; i < keys.size(); i++)
+        EXPECT_EQ(hashMapGet(hash_map, sizeof i, &i), &keys[i]);
+}
+
+// hashMapCursor, hashMapCursorNext
+TEST_F(FlatHashMapTest, hashMapCursorTest) {
+    std::vector<uint64_t> keys(1000);
+    std::set<uint64_t> visited;
+
+    for (uint64_t i = 0; i < keys.size(); i++) {
+        keys[i] = i;
+        hashMapInsert(hash_map, sizeof keys[i], &keys[i], &keys[i]);
+    }
+
+    // Tombstones are skipped
+    for (uint64_t i = 0; i < keys.size(); i += 2)
+        hashMapDelete(hash_map, sizeof i, &i, nullptr);
+
+    struct HashMapCursor cursor = hashMapCursor(hash_map);
+    while (hashMapCursorNext(hash_map, &cursor)) {
+        EXPECT_EQ(* (uint64_t const *) cursor.key % 2, 1);
+        EXPECT_EQ(visited.insert(* (uint64_t const *) cursor.key).second, true);
+    }
+    EXPECT_EQ(visited.size(), keys.size() / 2);
+}
+
+class IncrementalHashMapTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            hash_map = newIncrementalHashMap(10);
+        }
+
+        void TearDown() override {
+            deleteHashMap(&hash_map, nullptr);
+        }
+    
+        struct HashMap * hash_map;
+};
+
+// hashMapInsert, hashMapGet, hashMapSet, hashMapDelete
+TEST_F(IncrementalHashMapTest, hashMapMigrationTest) {
+    std::vector<uint64_t> keys(10000);
+    keys.reserve(100000);
+    bool migrated = false;
+    for (uint64_t i = 0; i < keys.size(); i++) {
+        keys[i] = i;
+        hashMapInsert(hash_map, sizeof keys[i], &keys[i], &keys[i]);
+        migrated = migrated || hash_map -> old_items != NULL;
+
+        // Every key inserted so far must be reachable whether it moved or not
+        if (i % 97 == 0) {
+            for (uint64_t j = 0; j <= i; j++)
+                ASSERT_EQ(hashMapGet(hash_map, sizeof j, &j), &keys[j]);
+        }
+    }
+    EXPECT_EQ(migrated, true);
+    EXPECT_EQ(hash_map -> size, 10000);
+
+    // Replace and delete keys while items are spread over both bucket arrays
+    uint64_t key = 10000;
+    while (hash_map -> old_items == NULL) {
+        keys.push_back(key);
+        hashMapInsert(hash_map, sizeof key, &keys.back(), nullptr);
+        key++;
+    }
+
+    for (uint64_t i = 0; i < 1000; i++)
+        EXPECT_EQ(hashMapSet(hash_map, sizeof keys[i], &keys[i], nullptr), &keys[i]);
+    for (uint64_t i = 0; i < 1000; i++)
+        EXPECT_EQ(hashMapDelete(hash_map, sizeof i, &i, nullptr), true);
+    for (uint64_t i = 0; i < 1000; i++)
+        EXPECT_EQ(hashMapDelete(hash_map, sizeof i, &i, nullptr), false);
+    EXPECT_EQ(hash_map -> size, key - 1000);
+}
+
+// ->get
+TEST_F(IncrementalHashMapTest, hashMap_get_Test) {
+    std::vector<uint64_t> keys;
+    keys.reserve(100000);
+    for (uint64_t i = 0; hash_map -> old_items == NULL || hash_map -> migrated == 0; i++) {
+        keys.push_back(i);
+        hashMapInsert(hash_map, sizeof keys[i], &keys[i], &keys[i]);
+    }
+
+    // Walking the collection in the middle of a migration must visit every item exactly once
+    std::set<void const *> seen;
+    for (unsigned i = 0; hash_map -> collection.atEnd(&hash_map -> collection, i) == false; i++) {
+        struct HashMapItem * item = (struct HashMapItem *) hash_map -> collection.get(&hash_map -> collection, i);
+        seen.insert(item -> key);
+    }
+    EXPECT_EQ(seen.size(), keys.size());
+}
+
+// Worst-case single insert latency
+TEST_F(IncrementalHashMapTest, hashMapInsertLatencyTest) {
+    std::vector<uint64_t> keys(200000);
+    struct HashMap * chained_map = newHashMap(10);
+
+    auto worst_insert = [&keys](struct HashMap * map) {
+        std::chrono::nanoseconds worst(0);
+        for (uint64_t i = 0; i < keys.size(); i++) {
+            keys[i] = i;
+
+            struct HashMapItem ** old_items = map -> old_items;
+            unsigned old_capacity = map -> old_capacity;
+            unsigned migrated = map -> migrated;
+
+            auto start = std::chrono::steady_clock::now();
+            hashMapInsert(map, sizeof keys[i], &keys[i], &keys[i]);
+            worst = std::max(worst, std::chrono::steady_clock::now() - start);
+
+            // No insert ever moves more than a bounded number of buckets
+            if (old_items != NULL && map -> old_items == old_items) {
+                EXPECT_LE(map -> migrated - migrated, hash_map_migration_steps);
+            }
+            else if (old_items != NULL) {
+                EXPECT_LE(old_capacity - migrated, hash_map_migration_steps);
+            }
+        }
+
+        return worst;
+    };
+
+    auto chained_worst = worst_insert(chained_map);
+    auto incremental_worst = worst_insert(hash_map);
+
+    RecordProperty("chained_worst_insert_ns", std::to_string(chained_worst.count()));
+    RecordProperty("incremental_worst_insert_ns", std::to_string(incremental_worst.count()));
+
+    EXPECT_EQ(hash_map -> size, keys.size());
+    deleteHashMap(&chained_map, nullptr);
+}
+
+// hashMapCursor, hashMapCursorNext
+TEST_F(IncrementalHashMapTest, hashMapCursorTest) {
+    std::vector<uint64_t> keys(1000);
+    std::set<uint64_t> visited;
+
+    // We stop while the map is still growing so that entries live in both bucket arrays
+    uint64_t count = 0;
+    do {
+        keys[count] = count;
+        hashMapInsert(hash_map, sizeof keys[count], &keys[count], &keys[count]);
+        count++;
+    } while (hash_map -> old_items == NULL || hash_map -> migrated == 0);
+    ASSERT_NE(hash_map -> old_items, nullptr);
+
+    struct HashMapCursor cursor = hashMapCursor(hash_map);
+    while (hashMapCursorNext(hash_map, &cursor))
+        EXPECT_EQ(visited.insert(* (uint64_t const *) cursor.key).second, true);
+    EXPECT_EQ(visited.size(), count);
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+
+extern "C" {
+    #include "minmaxheap.h"
+}
+
+// Elements are integers stored in the pointers themselves
+static int compareIntegers(void const * a, void const * b) {
+    intptr_t x = (intptr_t) a, y = (intptr_t) b;
+    return (x > y) - (x < y);
+}
+
+// Checks that every element is on the right side of all its descendants, according to its level
+static bool isMinMaxHeap(struct MinMaxHeap const * const heap) {
+    void ** elements = heap -> vector -> elements;
+    unsigned size = heap -> vector -> size;
+
+    for (unsigned i = 1; i < size; i++) {
+        unsigned level = 0;
+        for (unsigned j = i + 1; j > 1; j /= 2)
+            level++;
+
+        // Every ancestor must be lower or higher than the element, depending on its own level
+        unsigned ancestor_level = level;
+        for (unsigned ancestor = (i - 1) / 2; ; ancestor = (ancestor - 1) / 2) {
+            ancestor_level--;
+            int order = heap -> compare(elements[ancestor], elements[i]);
+            if ((ancestor_level % 2 == 0 && order > 0) || (ancestor_level % 2 == 1 && order < 0))
+                return false;
+            if (ancestor == 0)
+                break;
+        }
+    }
+
+    return true;
+}
+
+class MinMaxHeapTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            heap = newMinMaxHeap(1, compareIntegers);
+        }
+
+        void TearDown() override {
+            deleteMinMaxHeap(&heap, nullptr);
+        }
+
+        struct MinMaxHeap * heap;
+};
+
+// newMinMaxHeap
+TEST_F(MinMaxHeapTest, newMinMaxHeapTest) {
+    EXPECT_NE(heap, nullptr);
+    EXPECT_EQ(isMinMaxHeapEmpty(heap), true);
+    EXPECT_EQ(minMaxHeapSize(heap), 0);
+    EXPECT_EQ(minMaxHeapPeekMin(heap), nullptr);
+    EXPECT_EQ(minMaxHeapPeekMax(heap), nullptr);
+    EXPECT_EQ(minMaxHeapPopMin(heap), nullptr);
+    EXPECT_EQ(minMaxHeapPopMax(heap), nullptr);
+
+    EXPECT_DEATH(newMinMaxHeap(0, compareIntegers), ::testing::HasSubstr("Initial heap capacity cannot be zero."));
+    EXPECT_DEATH(newMinMaxHeap(4, nullptr), ::testing::HasSubstr("The parameter <compare> cannot be NULL."));
+}
+
+// minMaxHeapPush, minMaxHeapPopMin, minMaxHeapPopMax, minMaxHeapPeekMin, minMaxHeapPeekMax
+TEST_F(MinMaxHeapTest, pushPopTest) {
+    for (intptr_t value : {5, 9, 1, 7, 3})
+        EXPECT_EQ(minMaxHeapPush(heap, (void *) value), true);
+
+    EXPECT_TRUE(isMinMaxHeap(heap));
+    EXPECT_EQ((intptr_t) minMaxHeapPeekMin(heap), 1);
+    EXPECT_EQ((intptr_t) minMaxHeapPeekMax(heap), 9);
+
+    EXPECT_EQ((intptr_t) minMaxHeapPopMax(heap), 9);
+    EXPECT_EQ((intptr_t) minMaxHeapPopMin(heap), 1);
+    EXPECT_EQ((intptr_t) minMaxHeapPopMax(heap), 7);
+    EXPECT_EQ((intptr_t) minMaxHeapPopMax(heap), 5);
+    EXPECT_EQ((intptr_t) minMaxHeapPeekMin(heap), 3);
+    EXPECT_EQ((intptr_t) minMaxHeapPeekMax(heap), 3);
+    EXPECT_EQ((intptr_t) minMaxHeapPopMax(heap), 3);
+    EXPECT_EQ(isMinMaxHeapEmpty(heap), true);
+
+    deleteMinMaxHeap(&heap, nullptr);
+    EXPECT_DEATH(minMaxHeapPush(heap, nullptr), ::testing::HasSubstr("The parameter <heap> cannot be NULL."));
+    EXPECT_DEATH(minMaxHeapPopMin(heap), ::testing::HasSubstr("The parameter <heap> cannot be NULL."));
+    EXPECT_DEATH(minMaxHeapPopMax(heap), ::testing::HasSubstr("The parameter <heap> cannot be NULL."));
+}
+
+// Random pushes and pops at both ends checked against a multiset
+TEST_F(MinMaxHeapTest, randomOperationsTest) {
+    std::mt19937 random(42);
+    std::multiset<intptr_t> model;
+
+    for (int step = 0; step < 50000; step++) {
+        unsigned operation = random() % 6;
+        if (operation < 2 || model.empty()) {
+            intptr_t value = random() % 500;
+            minMaxHeapPush(heap, (void *) value);
+            model.insert(value);
+        }
+        else if (operation == 2) {
+            ASSERT_EQ((intptr_t) minMaxHeapPopMin(heap), * model.begin());
+            model.erase(model.begin());
+        }
+        else if (operation == 3) {
+            ASSERT_EQ((intptr_t) minMaxHeapPopMax(heap), * model.rbegin());
+            model.erase(std::prev(model.end()));
+        }
+        else if (operation == 4) {
+            intptr_t value = random() % 500;
+            ASSERT_EQ((intptr_t) minMaxHeapReplaceMin(heap, (void *) value), * model.begin());
+            model.erase(model.begin());
+            model.insert(value);
+        }
+        else {
+            intptr_t value = random() % 500;
+            ASSERT_EQ((intptr_t) minMaxHeapReplaceMax(heap, (void *) value), * model.rbegin());
+            model.erase(std::prev(model.end()));
+            model.insert(value);
+        }
+
+        ASSERT_EQ(minMaxHeapSize(heap), model.size());
+        if (model.empty() == false) {
+            ASSERT_EQ((intptr_t) minMaxHeapPeekMin(heap), * model.begin());
+            ASSERT_EQ((intptr_t) minMaxHeapPeekMax(heap), * model.rbegin());
+        }
+        if (step % 50 == 0) {
+            ASSERT_TRUE(isMinMaxHeap(heap));
+        }
+    }
+}
+
+// newMinMaxHeapFromVector
+TEST_F(MinMaxHeapTest, fromVectorTest) {
+    for (unsigned size : {0, 1, 2, 3, 6, 31, 1000}) {
+        struct Vector * vector = newVector(1);
+        std::vector<intptr_t> values;
+        for (unsigned i = 0; i < size; i++) {
+            values.push_back((i * 7919) % 101);
+            vectorPushBack(vector, (void *) values.back());
+        }
+
+        struct MinMaxHeap * from = newMinMaxHeapFromVector(vector, compareIntegers);
+        EXPECT_EQ(from -> vector, vector);
+        EXPECT_TRUE(isMinMaxHeap(from));
+
+        // We take elements from both ends alternately
+        std::sort(values.begin(), values.end());
+        size_t low = 0, high = values.size();
+        while (low < high) {
+            ASSERT_EQ((intptr_t) minMaxHeapPopMin(from), values[low++]);
+            if (low < high) {
+                ASSERT_EQ((intptr_t) minMaxHeapPopMax(from), values[--high]);
+            }
+        }
+        EXPECT_EQ(isMinMaxHeapEmpty(from), true);
+
+        deleteMinMaxHeap(&from, nullptr);
+    }
+
+    EXPECT_DEATH(newMinMaxHeapFromVector(nullptr, compareIntegers), ::testing::HasSubstr("The parameter <vector> cannot be NULL."));
+}
+
+// After popping both ends only the values in between are handed to the deleter
+static std::set<intptr_t> deleted_values;
+
+static void collectDeleted(void * element) {
+    deleted_values.insert((intptr_t) element);
+}
+
+TEST_F(MinMaxHeapTest, deleteMinMaxHeapTest) {
+    for (intptr_t value = 0; value < 10; value++)
+        minMaxHeapPush(heap, (void *) value);
+    minMaxHeapPopMin(heap);
+    minMaxHeapPopMax(heap);
+
+    deleted_values.clear();
+    deleteMinMaxHeap(&heap, collectDeleted);
+    EXPECT_EQ(heap, nullptr);
+    EXPECT_EQ(deleted_values, std::set<intptr_t>({1, 2, 3, 4, 5, 6, 7, 8}));
+}
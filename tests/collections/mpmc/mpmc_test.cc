@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+    #include "mpmc.h"
+}
+
+class MpmcQueueTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            queue = newMpmcQueue(6);
+        }
+
+        void TearDown() override {
+            deleteMpmcQueue(&queue, nullptr);
+        }
+
+        struct MpmcQueue * queue;
+};
+
+// newMpmcQueue
+TEST_F(MpmcQueueTest, newMpmcQueueTest) {
+    EXPECT_NE(queue, nullptr);
+
+    // The capacity is rounded up to a power of two
+    EXPECT_EQ(queue -> capacity, 8);
+
+    // Slots and indices each live on their own cache line
+    EXPECT_EQ(sizeof(struct MpmcSlot), CACHE_LINE_SIZE);
+    EXPECT_EQ((uintptr_t) queue -> slots % CACHE_LINE_SIZE, 0);
+    EXPECT_EQ((uintptr_t) &queue -> tail % CACHE_LINE_SIZE, 0);
+    EXPECT_EQ((uintptr_t) &queue -> head % CACHE_LINE_SIZE, 0);
+    EXPECT_NE((uintptr_t) &queue -> tail / CACHE_LINE_SIZE, (uintptr_t) &queue -> head / CACHE_LINE_SIZE);
+
+    // A single slot is not enough for the sequence numbers to tell producers and consumers apart
+    struct MpmcQueue * small = newMpmcQueue(1);
+    EXPECT_EQ(small -> capacity, 2);
+    deleteMpmcQueue(&small, nullptr);
+
+    EXPECT_DEATH(newMpmcQueue(0), ::testing::HasSubstr("Queue capacity cannot be zero."));
+}
+
+// mpmcQueueTryPushBack, mpmcQueueTryPopFront, isMpmcQueueEmpty
+TEST_F(MpmcQueueTest, tryPushPopTest) {
+    int values[20];
+    EXPECT_EQ(isMpmcQueueEmpty(queue), true);
+    EXPECT_EQ(mpmcQueueTryPopFront(queue), nullptr);
+
+    // We go around the slots a couple of times
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 8; i++)
+            EXPECT_EQ(mpmcQueueTryPushBack(queue, &values[i]), true);
+
+        EXPECT_EQ(mpmcQueueTryPushBack(queue, &values[8]), false);
+        EXPECT_EQ(isMpmcQueueEmpty(queue), false);
+
+        EXPECT_EQ(mpmcQueueTryPopFront(queue), &values[0]);
+        EXPECT_EQ(mpmcQueueTryPushBack(queue, &values[8]), true);
+
+        for (int i = 1; i < 9; i++)
+            EXPECT_EQ(mpmcQueueTryPopFront(queue), &values[i]);
+        EXPECT_EQ(isMpmcQueueEmpty(queue), true);
+        EXPECT_EQ(mpmcQueueTryPopFront(queue), nullptr);
+    }
+
+    // NULL is what popping an empty queue returns, so it cannot be pushed
+    EXPECT_DEATH(mpmcQueueTryPushBack(queue, nullptr), ::testing::HasSubstr("The parameter <element> cannot be NULL."));
+    EXPECT_DEATH(mpmcQueuePushBack(queue, nullptr), ::testing::HasSubstr("The parameter <element> cannot be NULL."));
+
+    deleteMpmcQueue(&queue, nullptr);
+    EXPECT_DEATH(mpmcQueueTryPushBack(queue, &values[0]), ::testing::HasSubstr("The parameter <queue> cannot be NULL."));
+    EXPECT_DEATH(mpmcQueueTryPopFront(queue), ::testing::HasSubstr("The parameter <queue> cannot be NULL."));
+}
+
+// mpmcQueuePushBack, mpmcQueuePopFront
+TEST_F(MpmcQueueTest, blockingPushPopTest) {
+    int values[8];
+    for (int i = 0; i < 8; i++)
+        mpmcQueuePushBack(queue, &values[i]);
+
+    // The push waits until another thread makes room
+    int last;
+    std::thread producer([this, &last]() {
+        mpmcQueuePushBack(queue, &last);
+    });
+
+    for (int i = 0; i < 8; i++)
+        EXPECT_EQ(mpmcQueuePopFront(queue), &values[i]);
+    EXPECT_EQ(mpmcQueuePopFront(queue), &last);
+    producer.join();
+
+    // The pop waits until another thread pushes something
+    std::thread late_producer([this, &last]() {
+        std::this_thread::yield();
+        mpmcQueuePushBack(queue, &last);
+    });
+    EXPECT_EQ(mpmcQueuePopFront(queue), &last);
+    late_producer.join();
+}
+
+// deleteMpmcQueue walks the slots from head to tail, even once they wrapped around the ring
+static uintptr_t deleted_sum = 0;
+
+static void sumDeleted(void * element) {
+    deleted_sum += (uintptr_t) element;
+}
+
+TEST_F(MpmcQueueTest, deleteMpmcQueueTest) {
+    // We fill the ring, free some slots at the front then push into them again
+    uintptr_t pushed = 1;
+    while (mpmcQueueTryPushBack(queue, (void *) pushed))
+        pushed++;
+    for (int i = 0; i < 3; i++)
+        mpmcQueueTryPopFront(queue);
+    for (int i = 0; i < 2; i++)
+        mpmcQueueTryPushBack(queue, (void *) pushed++);
+
+    // The values 4 to pushed - 1 are left
+    deleted_sum = 0;
+    deleteMpmcQueue(&queue, sumDeleted);
+    EXPECT_EQ(queue, nullptr);
+    EXPECT_EQ(deleted_sum, (pushed - 1) * pushed / 2 - 6);
+}
+
+// Several producers and consumers at the same time: every element is popped exactly once,
+// and the elements of any one producer come out in the order it pushed them
+TEST_F(MpmcQueueTest, manyThreadsTest) {
+    const unsigned producers_count = 3, consumers_count = 3;
+    const uintptr_t per_producer = 50000;
+
+    std::vector<std::thread> producers;
+    for (uintptr_t p = 0; p < producers_count; p++) {
+        producers.emplace_back([this, p, per_producer]() {
+            for (uintptr_t i = 1; i <= per_producer; ) {
+                // Elements encode their producer in the high bits and their rank in the low bits
+                if (mpmcQueueTryPushBack(queue, (void *) ((p << 32) | i)))
+                    i++;
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<std::vector<uintptr_t>> received(consumers_count);
+    std::vector<std::thread> consumers;
+    // Consumers stop once they have popped the total number of elements between them
+    uintptr_t popped_total = 0;
+    for (unsigned c = 0; c < consumers_count; c++) {
+        consumers.emplace_back([this, c, &received, &popped_total, producers_count, per_producer]() {
+            while (__atomic_load_n(&popped_total, __ATOMIC_RELAXED) < producers_count * per_producer) {
+                void * element = mpmcQueueTryPopFront(queue);
+                if (element == nullptr) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                received[c].push_back((uintptr_t) element);
+                __atomic_fetch_add(&popped_total, 1, __ATOMIC_RELAXED);
+            }
+        });
+    }
+
+    for (std::thread & producer : producers)
+        producer.join();
+    for (std::thread & consumer : consumers)
+        consumer.join();
+
+    std::vector<unsigned> seen(producers_count * (per_producer + 1), 0);
+    for (std::vector<uintptr_t> & elements : received) {
+        std::vector<uintptr_t> last(producers_count, 0);
+        for (uintptr_t element : elements) {
+            uintptr_t producer = element >> 32, rank = element & 0xffffffff;
+            ASSERT_LT(producer, producers_count);
+            ASSERT_GT(rank, last[producer]);
+            last[producer] = rank;
+            seen[producer * (per_producer + 1) + rank]++;
+        }
+    }
+
+    for (uintptr_t p = 0; p < producers_count; p++) {
+        for (uintptr_t i = 1; i <= per_producer; i++)
+            ASSERT_EQ(seen[p * (per_producer + 1) + i], 1);
+    }
+
+    EXPECT_EQ(isMpmcQueueEmpty(queue), true);
+}
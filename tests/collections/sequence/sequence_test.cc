@@ -0,0 +1,343 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <random>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+
+extern "C" {
+    #include "sequence.h"
+    #include "lsearch.h"
+}
+
+static void * box(intptr_t value) {
+    return (void *) value;
+}
+
+static intptr_t unbox(void * element) {
+    return (intptr_t) element;
+}
+
+// Checks the sizes recorded in the branches and the occupancy of the nodes, returning the number of elements under the node
+static unsigned checkNode(void * node, unsigned height, bool is_root, std::vector<struct SequenceLeaf *> & leaves) {
+    if (height == 0) {
+        struct SequenceLeaf * leaf = (struct SequenceLeaf *) node;
+        EXPECT_GT(leaf -> count, 0);
+        if (is_root == false) {
+            EXPECT_GE(leaf -> count, SEQUENCE_LEAF_CAPACITY / 2);
+        }
+        leaves.push_back(leaf);
+        return leaf -> count;
+    }
+
+    struct SequenceBranch * branch = (struct SequenceBranch *) node;
+    EXPECT_GE(branch -> count, is_root ? 2 : SEQUENCE_BRANCH_CAPACITY / 2);
+
+    unsigned size = 0;
+    for (unsigned i = 0; i < branch -> count; i++) {
+        unsigned child_size = checkNode(branch -> children[i], height - 1, false, leaves);
+        EXPECT_EQ(branch -> sizes[i], child_size);
+        size += child_size;
+    }
+
+    return size;
+}
+
+// Checks the structure of the sequence and returns its elements in order, as seen by walking the leaves
+static std::vector<intptr_t> contents(struct Sequence const * const sequence) {
+    std::vector<struct SequenceLeaf *> leaves;
+    leaves.push_back(sequence -> head);
+    if (sequence -> root != NULL)
+        EXPECT_EQ(checkNode(sequence -> root, sequence -> height, true, leaves), sequence -> tree_size);
+    else
+        EXPECT_EQ(sequence -> tree_size, 0);
+    leaves.push_back(sequence -> tail);
+
+    // The leaves of the tree are linked in order between the head and the tail
+    std::vector<intptr_t> values;
+    struct SequenceLeaf * prev = NULL;
+    struct SequenceLeaf * leaf = sequence -> head;
+    for (struct SequenceLeaf * expected : leaves) {
+        EXPECT_EQ(leaf, expected);
+        if (leaf == NULL)
+            break;
+        EXPECT_EQ(leaf -> prev, prev);
+        for (unsigned i = 0; i < leaf -> count; i++)
+            values.push_back(unbox(leaf -> elements[i]));
+        prev = leaf;
+        leaf = leaf -> next;
+    }
+
+    EXPECT_EQ(leaf, nullptr);
+    EXPECT_EQ(sequence -> size, values.size());
+
+    return values;
+}
+
+static std::vector<intptr_t> range(intptr_t first, intptr_t last) {
+    std::vector<intptr_t> values;
+    for (intptr_t value = first; value < last; value++)
+        values.push_back(value);
+
+    return values;
+}
+
+static unsigned deleted_count = 0;
+
+static void countingDeleter(void * element) {
+    (void) element;
+    deleted_count++;
+}
+
+static int compareIntegers(void const * const a, void const * const b) {
+    return (int) (unbox((void *) a) - unbox((void *) b));
+}
+
+class SequenceTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            sequence = newSequence();
+        }
+
+        void TearDown() override {
+            deleteSequence(&sequence, nullptr);
+        }
+
+        struct Sequence * sequence = NULL;
+};
+
+// newSequence
+TEST_F(SequenceTest, newSequenceTest) {
+    ASSERT_NE(sequence, nullptr);
+    EXPECT_EQ(sequence -> root, nullptr);
+    EXPECT_EQ(sequence -> size, 0);
+    EXPECT_THAT(contents(sequence), ::testing::ElementsAre());
+}
+
+// deleteSequence
+TEST_F(SequenceTest, deleteSequenceTest) {
+    for (intptr_t i = 0; i < 1000; i++)
+        sequencePushBack(sequence, box(i));
+
+    deleted_count = 0;
+    deleteSequence(&sequence, countingDeleter);
+    EXPECT_EQ(sequence, nullptr);
+    EXPECT_EQ(deleted_count, 1000);
+
+    // Deleting again is harmless
+    deleteSequence(&sequence, countingDeleter);
+    deleteSequence(nullptr, countingDeleter);
+}
+
+// isSequenceEmpty, sequenceSize
+TEST_F(SequenceTest, isSequenceEmptyTest) {
+    EXPECT_EQ(isSequenceEmpty(sequence), true);
+    EXPECT_EQ(sequenceSize(sequence), 0);
+
+    sequencePushFront(sequence, box(1));
+    EXPECT_EQ(isSequenceEmpty(sequence), false);
+    EXPECT_EQ(sequenceSize(sequence), 1);
+
+    EXPECT_DEATH(isSequenceEmpty(nullptr), ::testing::HasSubstr("The parameter <sequence> cannot be NULL."));
+    EXPECT_DEATH(sequenceSize(nullptr), ::testing::HasSubstr("The parameter <sequence> cannot be NULL."));
+}
+
+// sequencePushBack, sequencePushFront
+TEST_F(SequenceTest, sequencePushTest) {
+    // Enough elements for the tree to grow a few levels from both ends
+    for (intptr_t i = 0; i < 20000; i++) {
+        EXPECT_EQ(sequencePushBack(sequence, box(20000 + i)), true);
+        EXPECT_EQ(sequencePushFront(sequence, box(19999 - i)), true);
+    }
+
+    EXPECT_GE(sequence -> height, 2);
+    EXPECT_EQ(contents(sequence), range(0, 40000));
+
+    EXPECT_DEATH(sequencePushBack(nullptr, box(0)), ::testing::HasSubstr("The parameter <sequence> cannot be NULL."));
+    EXPECT_DEATH(sequencePushFront(nullptr, box(0)), ::testing::HasSubstr("The parameter <sequence> cannot be NULL."));
+}
+
+// sequencePopBack, sequencePopFront
+TEST_F(SequenceTest, sequencePopTest) {
+    EXPECT_EQ(sequencePopBack(sequence), nullptr);
+    EXPECT_EQ(sequencePopFront(sequence), nullptr);
+
+    for (intptr_t i = 0; i < 10000; i++)
+        sequencePushBack(sequence, box(i));
+
+    // The pops go through the head and the tail, then through the leaves of the tree they take over
+    for (intptr_t i = 0; i < 2500; i++) {
+        EXPECT_EQ(unbox(sequencePopFront(sequence)), i);
+        EXPECT_EQ(unbox(sequencePopBack(sequence)), 9999 - i);
+    }
+    EXPECT_EQ(contents(sequence), range(2500, 7500));
+
+    // Popping from one end only eventually reaches the elements at the other end
+    for (intptr_t i = 2500; i < 7500; i++)
+        EXPECT_EQ(unbox(sequencePopFront(sequence)), i);
+    EXPECT_EQ(sequencePopFront(sequence), nullptr);
+    EXPECT_THAT(contents(sequence), ::testing::ElementsAre());
+
+    for (intptr_t i = 0; i < 100; i++)
+        sequencePushFront(sequence, box(i));
+    for (intptr_t i = 0; i < 100; i++)
+        EXPECT_EQ(unbox(sequencePopBack(sequence)), i);
+    EXPECT_EQ(sequencePopBack(sequence), nullptr);
+
+    EXPECT_DEATH(sequencePopBack(nullptr), ::testing::HasSubstr("The parameter <sequence> cannot be NULL."));
+    EXPECT_DEATH(sequencePopFront(nullptr), ::testing::HasSubstr("The parameter <sequence> cannot be NULL."));
+}
+
+// sequenceGet, sequenceSet
+TEST_F(SequenceTest, sequenceGetSetTest) {
+    for (intptr_t i = 0; i < 5000; i++)
+        sequencePushBack(sequence, box(i));
+
+    for (unsigned i = 0; i < 5000; i++)
+        EXPECT_EQ(unbox(sequenceGet(sequence, i)), i);
+
+    for (unsigned i = 0; i < 5000; i++)
+        sequenceSet(sequence, i, box(2 * i));
+    for (unsigned i = 0; i < 5000; i++)
+        EXPECT_EQ(unbox(sequenceGet(sequence, i)), 2 * i);
+
+    EXPECT_DEATH(sequenceGet(sequence, 5000), ::testing::HasSubstr("Index is out of bounds."));
+    EXPECT_DEATH(sequenceSet(sequence, 5000, box(0)), ::testing::HasSubstr("Index is out of bounds."));
+    EXPECT_DEATH(sequenceGet(nullptr, 0), ::testing::HasSubstr("The parameter <sequence> cannot be NULL."));
+}
+
+// sequenceInsert
+TEST_F(SequenceTest, sequenceInsertTest) {
+    EXPECT_EQ(sequenceInsert(sequence, 0, box(1)), true);
+    EXPECT_EQ(sequenceInsert(sequence, 1, box(3)), true);
+    EXPECT_EQ(sequenceInsert(sequence, 1, box(2)), true);
+    EXPECT_EQ(sequenceInsert(sequence, 0, box(0)), true);
+    EXPECT_THAT(contents(sequence), ::testing::ElementsAre(0, 1, 2, 3));
+
+    // Inserting in the middle over and over splits the same leaves
+    std::vector<intptr_t> expected = {0, 1, 2, 3};
+    for (intptr_t i = 4; i < 10000; i++) {
+        unsigned index = expected.size() / 2;
+        sequenceInsert(sequence, index, box(i));
+        expected.insert(expected.begin() + index, i);
+    }
+    EXPECT_EQ(contents(sequence), expected);
+
+    EXPECT_DEATH(sequenceInsert(sequence, 10001, box(0)), ::testing::HasSubstr("Index is out of bounds."));
+    EXPECT_DEATH(sequenceInsert(nullptr, 0, box(0)), ::testing::HasSubstr("The parameter <sequence> cannot be NULL."));
+}
+
+// sequenceRemove
+TEST_F(SequenceTest, sequenceRemoveTest) {
+    for (intptr_t i = 0; i < 10000; i++)
+        sequencePushBack(sequence, box(i));
+
+    // Removing every other element leaves the leaves half full, so they merge as we go
+    std::vector<intptr_t> expected = range(0, 10000);
+    for (unsigned i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(unbox(sequenceRemove(sequence, i)), expected[i]);
+        expected.erase(expected.begin() + i);
+    }
+    EXPECT_EQ(contents(sequence), expected);
+
+    while (expected.empty() == false) {
+        unsigned index = expected.size() / 3;
+        EXPECT_EQ(unbox(sequenceRemove(sequence, index)), expected[index]);
+        expected.erase(expected.begin() + index);
+    }
+    EXPECT_THAT(contents(sequence), ::testing::ElementsAre());
+    EXPECT_EQ(sequence -> root, nullptr);
+    EXPECT_EQ(sequence -> height, 0);
+
+    EXPECT_DEATH(sequenceRemove(sequence, 0), ::testing::HasSubstr("Index is out of bounds."));
+    EXPECT_DEATH(sequenceRemove(nullptr, 0), ::testing::HasSubstr("The parameter <sequence> cannot be NULL."));
+}
+
+// Collection interface
+TEST_F(SequenceTest, sequenceCollectionTest) {
+    struct Collection * collection = &sequence -> collection;
+    EXPECT_EQ(lsearchInteger(collection, 0), -1);
+
+    for (intptr_t i = 0; i < 1000; i++)
+        sequencePushBack(sequence, box(i));
+    // Some elements in the head, so that iterators start there
+    for (intptr_t i = 1; i <= 10; i++)
+        sequencePushFront(sequence, box(-i));
+
+    std::vector<intptr_t> iterated;
+    struct CIterator iterator;
+    for (bool more = collection -> begin(collection, &iterator); more; more = collection -> next(&iterator))
+        iterated.push_back(unbox(collection -> deref(&iterator)));
+    EXPECT_EQ(iterated, contents(sequence));
+
+    EXPECT_EQ(collection -> atEnd(collection, 1008), false);
+    EXPECT_EQ(collection -> atEnd(collection, 1009), true);
+    EXPECT_EQ(unbox(collection -> get(collection, 10)), 0);
+
+    intptr_t needle = 500;
+    EXPECT_EQ(lsearch(collection, box(needle), compareIntegers), 510);
+    EXPECT_EQ(lsearchInteger(collection, -10), 0);
+    EXPECT_EQ(lsearchInteger(collection, 999), 1009);
+    EXPECT_EQ(lsearchInteger(collection, 1000), -1);
+}
+
+// A random mix of operations checked against std::vector
+TEST_F(SequenceTest, randomOperationsTest) {
+    std::vector<intptr_t> model;
+    std::mt19937 random(42);
+
+    for (int step = 0; step < 200000; step++) {
+        // Growing for the first half and shrinking for the second, so that the tree goes up and down
+        unsigned operation = random() % 10;
+        bool grow = step < 100000 ? operation < 6 : operation < 4;
+
+        if (grow) {
+            intptr_t value = step;
+            switch (random() % 3) {
+                case 0:
+                    sequencePushBack(sequence, box(value));
+                    model.push_back(value);
+                    break;
+                case 1:
+                    sequencePushFront(sequence, box(value));
+                    model.insert(model.begin(), value);
+                    break;
+                default:
+                    unsigned index = random() % (model.size() + 1);
+                    sequenceInsert(sequence, index, box(value));
+                    model.insert(model.begin() + index, value);
+                    break;
+            }
+        }
+        else if (model.empty() == false) {
+            switch (random() % 3) {
+                case 0:
+                    ASSERT_EQ(unbox(sequencePopBack(sequence)), model.back());
+                    model.pop_back();
+                    break;
+                case 1:
+                    ASSERT_EQ(unbox(sequencePopFront(sequence)), model.front());
+                    model.erase(model.begin());
+                    break;
+                default:
+                    unsigned index = random() % model.size();
+                    ASSERT_EQ(unbox(sequenceRemove(sequence, index)), model[index]);
+                    model.erase(model.begin() + index);
+                    break;
+            }
+        }
+
+        if (model.empty() == false) {
+            unsigned index = random() % model.size();
+            ASSERT_EQ(unbox(sequenceGet(sequence, index)), model[index]);
+        }
+
+        if (step % 5000 == 0) {
+            ASSERT_EQ(contents(sequence), model);
+        }
+    }
+
+    ASSERT_EQ(contents(sequence), model);
+}
@@ -4,12 +4,22 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <set>
 #include <vector>
 
 extern "C" {
+    #include "hash.h"
     #include "set.h"
 }
 
+// Sends every value to the same bucket so that only the equality callback can tell them apart
+static uint64_t collidingHash(void const * data, unsigned length, char const key[16]) {
+    (void) data;
+    (void) length;
+    (void) key;
+    return 42;
+}
+
 class HashSetTest: public ::testing::Test {
     protected:
         void SetUp() override {
@@ -103,6 +113,32 @@ TEST_F(HashSetTest, resizeHashSetTest) {
     EXPECT_DEATH(resizeHashSet(hash_set, 20), ::testing::HasSubstr("The parameter <set> cannot be NULL."));
 }
 
+// resizeHashSet, as triggered by hashSetInsert
+TEST_F(HashSetTest, resizeHashSetGrowthTest) {
+    std::vector<uint64_t> values(10000);
+    for (uint64_t i = 0; i < values.size(); i++) {
+        values[i] = i;
+        hashSetInsert(hash_set, sizeof values[i], &values[i]);
+    }
+
+    // The load factor is tracked accurately across resizes so the set keeps growing with its content
+    unsigned buckets_count = 0;
+    for (unsigned i = 0; i < hash_set -> capacity; i++) {
+        if (hash_set -> items[i] != NULL) {
+            EXPECT_EQ(hash_set -> items[i] -> prev, nullptr);
+            buckets_count++;
+        }
+    }
+    EXPECT_EQ(hash_set -> buckets_count, buckets_count);
+    EXPECT_GE(hash_set -> capacity, hash_set -> size);
+
+    // Deleting after a resize relinks chains correctly
+    for (uint64_t i = 0; i < values.size(); i += 2)
+        EXPECT_EQ(hashSetDelete(hash_set, sizeof i, &i, nullptr), true);
+    for (uint64_t i = 0; i < values.size(); i++)
+        EXPECT_EQ(hashSetContains(hash_set, sizeof i, &i), i % 2 == 1);
+}
+
 // isHashSetEmpty
 TEST_F(HashSetTest, isHashSetEmptyTest) {
     // No elements have been added to the hash set, it should be empty
@@ -215,6 +251,65 @@ TEST_F(HashSetTest, hashSetDeleteTest) {
     );
 }
 
+// hashSetUseHasher
+TEST_F(HashSetTest, hashSetUseHasherTest) {
+    const char * value1 = "value1";
+    const char * value2 = "value2";
+
+    hashSetUseHasher(hash_set, collidingHash, bytesEqual);
+
+    hashSetInsert(hash_set, strlen(value1), const_cast<char *>(value1));
+    hashSetInsert(hash_set, strlen(value2), const_cast<char *>(value2));
+    hashSetInsert(hash_set, strlen(value1), const_cast<char *>(value1));
+
+    // Both values share a hash but the equality callback keeps them apart, and duplicates are still rejected
+    EXPECT_EQ(hash_set -> size, 2);
+    EXPECT_EQ(hashSetContains(hash_set, strlen(value1), const_cast<char *>(value1)), true);
+    EXPECT_EQ(hashSetContains(hash_set, strlen(value2), const_cast<char *>(value2)), true);
+    EXPECT_EQ(hashSetContains(hash_set, 6, const_cast<char *>("value3")), false);
+
+    hashSetDelete(hash_set, strlen(value1), const_cast<char *>(value1), nullptr);
+    EXPECT_EQ(hashSetContains(hash_set, strlen(value1), const_cast<char *>(value1)), false);
+    EXPECT_EQ(hashSetContains(hash_set, strlen(value2), const_cast<char *>(value2)), true);
+
+    // The hash function cannot change once values were hashed with the previous one
+    EXPECT_DEATH(
+        hashSetUseHasher(hash_set, wyHash, nullptr),
+        ::testing::HasSubstr("The hash function of a non-empty hash set cannot be changed.")
+    );
+}
+
+// hashSetCursor, hashSetCursorNext
+TEST_F(HashSetTest, hashSetCursorTest) {
+    std::vector<uint64_t> values(1000);
+    std::set<uint64_t> visited;
+
+    // An empty set has nothing to visit
+    struct HashSetCursor cursor = hashSetCursor(hash_set);
+    EXPECT_EQ(hashSetCursorNext(hash_set, &cursor), false);
+
+    for (uint64_t i = 0; i < values.size(); i++) {
+        values[i] = i;
+        hashSetInsert(hash_set, sizeof values[i], &values[i]);
+    }
+
+    // Every value is visited exactly once
+    cursor = hashSetCursor(hash_set);
+    while (hashSetCursorNext(hash_set, &cursor)) {
+        EXPECT_EQ(cursor.value_len, sizeof(uint64_t));
+        EXPECT_EQ(visited.insert(* (uint64_t *) cursor.value).second, true);
+    }
+    EXPECT_EQ(visited.size(), values.size());
+
+    // The collection interface visits them all too, resuming where the previous call stopped
+    visited.clear();
+    for (unsigned i = 0; hash_set -> collection.atEnd(&hash_set -> collection, i) == false; i++) {
+        struct HashSetItem * item = (struct HashSetItem *) hash_set -> collection.get(&hash_set -> collection, i);
+        visited.insert(* (uint64_t *) item -> value);
+    }
+    EXPECT_EQ(visited.size(), values.size());
+}
+
 // ->atEnd
 TEST_F(HashSetTest, hashSet_atEnd_Test) {
     // Insert a few values
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+    #include "spsc.h"
+}
+
+class SpscQueueTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            queue = newSpscQueue(6);
+        }
+
+        void TearDown() override {
+            deleteSpscQueue(&queue, nullptr);
+        }
+
+        struct SpscQueue * queue;
+};
+
+// newSpscQueue
+TEST_F(SpscQueueTest, newSpscQueueTest) {
+    EXPECT_NE(queue, nullptr);
+
+    // The capacity is rounded up to a power of two
+    EXPECT_EQ(queue -> capacity, 8);
+
+    // The indices written by each thread live on their own cache line
+    EXPECT_EQ((uintptr_t) &queue -> tail % CACHE_LINE_SIZE, 0);
+    EXPECT_EQ((uintptr_t) &queue -> head % CACHE_LINE_SIZE, 0);
+    EXPECT_NE((uintptr_t) &queue -> tail / CACHE_LINE_SIZE, (uintptr_t) &queue -> head / CACHE_LINE_SIZE);
+
+    EXPECT_DEATH(newSpscQueue(0), ::testing::HasSubstr("Queue capacity cannot be zero."));
+}
+
+// spscQueuePushBack, spscQueuePopFront, isSpscQueueEmpty
+TEST_F(SpscQueueTest, pushPopTest) {
+    int values[20];
+    EXPECT_EQ(isSpscQueueEmpty(queue), true);
+    EXPECT_EQ(spscQueuePopFront(queue), nullptr);
+
+    // We go around the slots a couple of times
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 8; i++)
+            EXPECT_EQ(spscQueuePushBack(queue, &values[i]), true);
+
+        EXPECT_EQ(spscQueuePushBack(queue, &values[8]), false);
+        EXPECT_EQ(isSpscQueueEmpty(queue), false);
+
+        EXPECT_EQ(spscQueuePopFront(queue), &values[0]);
+        EXPECT_EQ(spscQueuePushBack(queue, &values[8]), true);
+
+        for (int i = 1; i < 9; i++)
+            EXPECT_EQ(spscQueuePopFront(queue), &values[i]);
+        EXPECT_EQ(isSpscQueueEmpty(queue), true);
+    }
+
+    // NULL is what popping an empty queue returns, so it cannot be pushed
+    EXPECT_DEATH(spscQueuePushBack(queue, nullptr), ::testing::HasSubstr("The parameter <element> cannot be NULL."));
+
+    deleteSpscQueue(&queue, nullptr);
+    EXPECT_DEATH(spscQueuePushBack(queue, &values[0]), ::testing::HasSubstr("The parameter <queue> cannot be NULL."));
+    EXPECT_DEATH(spscQueuePopFront(queue), ::testing::HasSubstr("The parameter <queue> cannot be NULL."));
+}
+
+// spscQueuePushBackN, spscQueuePopFrontN
+TEST_F(SpscQueueTest, batchTest) {
+    int values[10];
+    void * elements[10], * popped[10];
+    for (int i = 0; i < 10; i++)
+        elements[i] = &values[i];
+
+    // Only as many elements as fit are pushed
+    EXPECT_EQ(spscQueuePushBackN(queue, elements, 5), 5);
+    EXPECT_EQ(spscQueuePushBackN(queue, elements + 5, 5), 3);
+
+    EXPECT_EQ(spscQueuePopFrontN(queue, popped, 6), 6);
+    for (int i = 0; i < 6; i++)
+        EXPECT_EQ(popped[i], elements[i]);
+
+    // This batch wraps around the end of the slots
+    EXPECT_EQ(spscQueuePushBackN(queue, elements, 6), 6);
+    EXPECT_EQ(spscQueuePopFrontN(queue, popped, 10), 8);
+    EXPECT_EQ(popped[0], elements[6]);
+    EXPECT_EQ(popped[1], elements[7]);
+    for (int i = 0; i < 6; i++)
+        EXPECT_EQ(popped[i + 2], elements[i]);
+
+    EXPECT_EQ(spscQueuePopFrontN(queue, popped, 10), 0);
+
+    elements[3] = nullptr;
+    EXPECT_DEATH(spscQueuePushBackN(queue, elements, 5), ::testing::HasSubstr("The parameter <elements> cannot contain NULL."));
+}
+
+// deleteSpscQueue gives the deleter the elements left and only those
+static void markDeleted(void * element) {
+    (* (int *) element)++;
+}
+
+TEST_F(SpscQueueTest, deleteSpscQueueTest) {
+    int marks[8] = {0};
+    for (int i = 0; i < 8; i++)
+        spscQueuePushBack(queue, &marks[i]);
+    for (int i = 0; i < 3; i++)
+        spscQueuePopFront(queue);
+
+    deleteSpscQueue(&queue, markDeleted);
+    EXPECT_EQ(queue, nullptr);
+    EXPECT_THAT(marks, ::testing::ElementsAre(0, 0, 0, 1, 1, 1, 1, 1));
+}
+
+// One producer and one consumer running at the same time, the consumer must see every element in order
+TEST_F(SpscQueueTest, twoThreadsTest) {
+    const uintptr_t count = 200000;
+
+    std::thread producer([this, count]() {
+        for (uintptr_t i = 1; i <= count; ) {
+            if (i % 3 == 0) {
+                void * batch[7];
+                unsigned length = 0;
+                for (; length < 7 && i + length <= count; length++)
+                    batch[length] = (void *) (i + length);
+                unsigned pushed = spscQueuePushBackN(queue, batch, length);
+                i += pushed;
+                if (pushed == 0)
+                    std::this_thread::yield();
+            }
+            else if (spscQueuePushBack(queue, (void *) i)) {
+                i++;
+            }
+            else {
+                // The queue is full, we let the consumer run in case both threads share a core
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uintptr_t expected = 1;
+    void * popped[5];
+    while (expected <= count) {
+        unsigned length = spscQueuePopFrontN(queue, popped, 5);
+        for (unsigned j = 0; j < length; j++)
+            ASSERT_EQ((uintptr_t) popped[j], expected++);
+
+        void * element = spscQueuePopFront(queue);
+        if (element != nullptr)
+            ASSERT_EQ((uintptr_t) element, expected++);
+        else if (length == 0)
+            std::this_thread::yield();
+    }
+
+    producer.join();
+    EXPECT_EQ(isSpscQueueEmpty(queue), true);
+}
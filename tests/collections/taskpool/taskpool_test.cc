@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+    #include "taskpool.h"
+}
+
+// Recursive Fibonacci, spawning one half and computing the other half on the same thread
+struct FibonacciArgument {
+    unsigned n;
+    uint64_t result;
+};
+
+static void fibonacci(struct TaskPool * const pool, void * argument) {
+    struct FibonacciArgument * fib = (struct FibonacciArgument *) argument;
+    if (fib -> n < 2) {
+        fib -> result = fib -> n;
+        return;
+    }
+
+    struct FibonacciArgument left = {fib -> n - 1, 0}, right = {fib -> n - 2, 0};
+    struct Task task;
+    taskPoolSpawn(pool, &task, fibonacci, &left);
+    fibonacci(pool, &right);
+    taskPoolWait(pool, &task);
+
+    fib -> result = left.result + right.result;
+}
+
+// newTaskPool, deleteTaskPool
+TEST(TaskPoolTest, newTaskPoolTest) {
+    struct TaskPool * pool = newTaskPool(3);
+    EXPECT_NE(pool, nullptr);
+    EXPECT_EQ(pool -> workers_count, 3);
+
+    deleteTaskPool(&pool);
+    EXPECT_EQ(pool, nullptr);
+
+    // Zero means one worker per processor
+    pool = newTaskPool(0);
+    EXPECT_GE(pool -> workers_count, 1);
+    deleteTaskPool(&pool);
+}
+
+// taskPoolSpawn, taskPoolWait
+TEST(TaskPoolTest, forkJoinTest) {
+    for (unsigned workers_count : {1, 2, 4}) {
+        struct TaskPool * pool = newTaskPool(workers_count);
+
+        struct FibonacciArgument fib = {20, 0};
+        struct Task task;
+        taskPoolSpawn(pool, &task, fibonacci, &fib);
+        taskPoolWait(pool, &task);
+        EXPECT_EQ(fib.result, 6765);
+
+        deleteTaskPool(&pool);
+    }
+
+    struct Task task;
+    struct FibonacciArgument fib = {1, 0};
+    EXPECT_DEATH(taskPoolSpawn(nullptr, &task, fibonacci, &fib), ::testing::HasSubstr("The parameter <pool> cannot be NULL."));
+    EXPECT_DEATH(taskPoolWait(nullptr, &task), ::testing::HasSubstr("The parameter <pool> cannot be NULL."));
+}
+
+// Several threads outside the pool spawning tasks at the same time, more than the shared queue holds
+static void increment(struct TaskPool * const pool, void * argument) {
+    (void) pool;
+    __atomic_fetch_add((unsigned *) argument, 1, __ATOMIC_RELAXED);
+}
+
+TEST(TaskPoolTest, outsideSpawnTest) {
+    struct TaskPool * pool = newTaskPool(2);
+    unsigned counter = 0;
+
+    std::vector<std::thread> submitters;
+    for (int s = 0; s < 3; s++) {
+        submitters.emplace_back([pool, &counter]() {
+            std::vector<struct Task> tasks(2000);
+            for (struct Task & task : tasks)
+                taskPoolSpawn(pool, &task, increment, &counter);
+            for (struct Task & task : tasks)
+                taskPoolWait(pool, &task);
+        });
+    }
+
+    for (std::thread & submitter : submitters)
+        submitter.join();
+
+    EXPECT_EQ(counter, 6000);
+    deleteTaskPool(&pool);
+}
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+extern "C" {
+    #include "typed.h"
+}
+
+struct Point {
+    int x;
+    int y;
+};
+
+static uint64_t hashString(char const * key) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (; * key != '\0'; key++)
+        hash = (hash ^ (unsigned char) * key) * 1099511628211ULL;
+
+    return ccHashInteger(hash);
+}
+
+#define STRINGS_EQUAL(a, b) (strcmp((a), (b)) == 0)
+
+// Every key lands in the same place, so probing is all there is
+static uint64_t collidingHash(uint64_t key) {
+    (void) key;
+    return 42;
+}
+
+CC_VECTOR_DEFINE(IntVector, int)
+CC_VECTOR_DEFINE(PointVector, struct Point)
+// The void pointer vector is just another instantiation
+CC_VECTOR_DEFINE(PointerVector, void *)
+CC_HASHMAP_DEFINE(IdMap, uint64_t, double, ccHashInteger, CC_EQUALS)
+CC_HASHMAP_DEFINE(NameMap, char const *, int, hashString, STRINGS_EQUAL)
+CC_HASHMAP_DEFINE(CollidingMap, uint64_t, uint64_t, collidingHash, CC_EQUALS)
+
+
+class TypedVectorTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            IntVectorInit(&vector, 1);
+        }
+
+        void TearDown() override {
+            IntVectorDestroy(&vector);
+        }
+
+        struct IntVector vector;
+};
+
+// IntVectorInit, IntVectorDestroy
+TEST_F(TypedVectorTest, initTest) {
+    EXPECT_NE(vector.elements, nullptr);
+    EXPECT_EQ(vector.capacity, 1);
+    EXPECT_EQ(vector.size, 0);
+
+    struct IntVector other;
+    EXPECT_DEATH(IntVectorInit(&other, 0), ::testing::HasSubstr("Initial vector capacity cannot be zero."));
+
+    IntVectorDestroy(&vector);
+    EXPECT_EQ(vector.elements, nullptr);
+    EXPECT_EQ(vector.size, 0);
+}
+
+// IntVectorPushBack, IntVectorGet, IntVectorPopBack
+TEST_F(TypedVectorTest, pushBackTest) {
+    for (int i = 0; i < 1000; i++)
+        EXPECT_EQ(IntVectorPushBack(&vector, i), true);
+
+    EXPECT_EQ(vector.size, 1000);
+    EXPECT_GE(vector.capacity, 1000);
+    for (int i = 0; i < 1000; i++)
+        EXPECT_EQ(IntVectorGet(&vector, i), i);
+
+    EXPECT_EQ(IntVectorPopBack(&vector), 999);
+    EXPECT_EQ(vector.size, 999);
+
+    EXPECT_DEATH(IntVectorGet(&vector, 999), ::testing::HasSubstr("The index is out of bounds."));
+}
+
+// IntVectorSet, IntVectorAt, IntVectorReserve
+TEST_F(TypedVectorTest, setTest) {
+    EXPECT_EQ(IntVectorReserve(&vector, 100), true);
+    EXPECT_EQ(vector.capacity, 100);
+
+    IntVectorPushBack(&vector, 1);
+    IntVectorPushBack(&vector, 2);
+    IntVectorSet(&vector, 0, 10);
+    * IntVectorAt(&vector, 1) += 10;
+
+    EXPECT_EQ(IntVectorGet(&vector, 0), 10);
+    EXPECT_EQ(IntVectorGet(&vector, 1), 12);
+
+    EXPECT_DEATH(IntVectorSet(&vector, 2, 0), ::testing::HasSubstr("The index is out of bounds."));
+}
+
+// Elements of any type, stored by value
+TEST_F(TypedVectorTest, structTest) {
+    struct PointVector points;
+    PointVectorInit(&points, 4);
+    for (int i = 0; i < 10; i++)
+        PointVectorPushBack(&points, {i, -i});
+
+    EXPECT_EQ(PointVectorGet(&points, 7).x, 7);
+    EXPECT_EQ(PointVectorAt(&points, 7) -> y, -7);
+    PointVectorDestroy(&points);
+
+    struct PointerVector pointers;
+    PointerVectorInit(&pointers, 4);
+    PointerVectorPushBack(&pointers, &points);
+    EXPECT_EQ(PointerVectorGet(&pointers, 0), &points);
+    PointerVectorDestroy(&pointers);
+}
+
+
+class TypedHashMapTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            IdMapInit(&map, 10);
+        }
+
+        void TearDown() override {
+            IdMapDestroy(&map);
+        }
+
+        struct IdMap map;
+};
+
+// IdMapInit, IdMapDestroy
+TEST_F(TypedHashMapTest, initTest) {
+    // The capacity is rounded up to a power of two
+    EXPECT_EQ(map.capacity, 16);
+    EXPECT_EQ(map.size, 0);
+
+    struct IdMap other;
+    EXPECT_DEATH(IdMapInit(&other, 0), ::testing::HasSubstr("Initial hash map capacity cannot be zero."));
+}
+
+// IdMapInsert, IdMapGet
+TEST_F(TypedHashMapTest, insertTest) {
+    for (uint64_t key = 0; key < 10000; key++)
+        EXPECT_EQ(IdMapInsert(&map, key, key * 0.5), true);
+
+    EXPECT_EQ(map.size, 10000);
+    for (uint64_t key = 0; key < 10000; key++) {
+        double * value = IdMapGet(&map, key);
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(* value, key * 0.5);
+    }
+    EXPECT_EQ(IdMapGet(&map, 10000), nullptr);
+
+    EXPECT_DEATH(IdMapInsert(&map, 1, 0), ::testing::HasSubstr("An element with the given key already exists in the hash map."));
+}
+
+// IdMapSet
+TEST_F(TypedHashMapTest, setTest) {
+    IdMapSet(&map, 1, 1.0);
+    IdMapSet(&map, 1, 2.0);
+
+    EXPECT_EQ(map.size, 1);
+    EXPECT_EQ(* IdMapGet(&map, 1), 2.0);
+}
+
+// IdMapDelete
+TEST_F(TypedHashMapTest, deleteTest) {
+    for (uint64_t key = 0; key < 100; key++)
+        IdMapInsert(&map, key, key);
+
+    for (uint64_t key = 0; key < 100; key += 2)
+        EXPECT_EQ(IdMapDelete(&map, key), true);
+    EXPECT_EQ(IdMapDelete(&map, 0), false);
+
+    EXPECT_EQ(map.size, 50);
+    for (uint64_t key = 0; key < 100; key++)
+        EXPECT_EQ(IdMapGet(&map, key) != nullptr, key % 2 == 1);
+
+    // Inserting and deleting over and over reuses tombstones rather than growing forever
+    unsigned capacity = map.capacity;
+    for (uint64_t round = 0; round < 10000; round++) {
+        IdMapInsert(&map, 1000 + round, 0);
+        IdMapDelete(&map, 1000 + round);
+    }
+    EXPECT_EQ(map.capacity, capacity);
+    EXPECT_EQ(map.size, 50);
+}
+
+// Custom hash and equality
+TEST_F(TypedHashMapTest, customKeysTest) {
+    struct NameMap names;
+    NameMapInit(&names, 4);
+
+    char first[] = "first";
+    NameMapInsert(&names, "first", 1);
+    NameMapInsert(&names, "second", 2);
+
+    // Keys are compared with the given equality, not by address
+    EXPECT_EQ(* NameMapGet(&names, first), 1);
+    EXPECT_EQ(* NameMapGet(&names, "second"), 2);
+    EXPECT_EQ(NameMapGet(&names, "third"), nullptr);
+    NameMapDestroy(&names);
+
+    struct CollidingMap colliding;
+    CollidingMapInit(&colliding, 4);
+    for (uint64_t key = 0; key < 100; key++)
+        CollidingMapInsert(&colliding, key, key * 2);
+    CollidingMapDelete(&colliding, 50);
+
+    for (uint64_t key = 0; key < 100; key++) {
+        if (key == 50)
+            EXPECT_EQ(CollidingMapGet(&colliding, key), nullptr);
+        else
+            EXPECT_EQ(* CollidingMapGet(&colliding, key), key * 2);
+    }
+    CollidingMapDestroy(&colliding);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <inttypes.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -124,3 +125,175 @@ TEST_F(VectorTest, vectorSetTest) {
     deleteVector(&vector, nullptr);
     EXPECT_DEATH(vectorSet(vector, 0, &value2), ::testing::HasSubstr("The parameter <vector> cannot be NULL."));
 }
+
+// ->begin, ->next, ->deref, ->span
+TEST_F(VectorTest, vector_iterator_Test) {
+    int values[] = {1, 2, 3, 4, 5};
+    struct Collection const * collection = &vector -> collection;
+    struct CIterator iterator;
+
+    // An empty vector has nothing to iterate over
+    EXPECT_EQ(collection -> begin(collection, &iterator), false);
+
+    for (int i = 0; i < 5; i++)
+        vectorPushBack(vector, &values[i]);
+
+    int expected = 1;
+    for (bool more = collection -> begin(collection, &iterator); more; more = collection -> next(&iterator))
+        EXPECT_EQ(* (int *) collection -> deref(&iterator), expected++);
+    EXPECT_EQ(expected, 6);
+
+    // The span is the array of elements itself
+    unsigned length = 0;
+    void * const * elements = collection -> span(collection, &length);
+    EXPECT_EQ(length, 5);
+    EXPECT_EQ(elements, vector -> elements);
+}
+
+
+// A 16-byte record, as stored by value
+struct Record {
+    uint64_t timestamp;
+    uint32_t id;
+    float value;
+};
+
+class ValueVectorTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            vector = newValueVector(sizeof(struct Record), 2);
+
+            for (uint32_t i = 0; i < 10; i++)
+                records[i] = {1000 + i, i, i * 0.5f};
+        }
+
+        void TearDown() override {
+            deleteValueVector(&vector, nullptr);
+        }
+
+        struct ValueVector * vector;
+        struct Record records[10];
+};
+
+static unsigned deleted_records = 0;
+static void countRecord(void * record) {
+    (void) record;
+    deleted_records++;
+}
+
+// newValueVector
+TEST_F(ValueVectorTest, newValueVectorTest) {
+    EXPECT_NE(vector, nullptr);
+    EXPECT_EQ(vector -> element_size, sizeof(struct Record));
+    EXPECT_EQ(vector -> capacity, 2);
+    EXPECT_EQ(isValueVectorEmpty(vector), true);
+
+    EXPECT_DEATH(newValueVector(0, 10), ::testing::HasSubstr("The size of the elements cannot be zero."));
+    EXPECT_DEATH(newValueVector(4, 0), ::testing::HasSubstr("Initial vector capacity cannot be zero."));
+}
+
+// valueVectorPushBack, valueVectorGet
+TEST_F(ValueVectorTest, valueVectorPushBackTest) {
+    for (int i = 0; i < 10; i++)
+        EXPECT_EQ(valueVectorPushBack(vector, &records[i]), true);
+
+    EXPECT_EQ(vector -> size, 10);
+    EXPECT_GE(vector -> capacity, 10);
+
+    // Elements are copies stored one after the other
+    for (unsigned i = 0; i < 10; i++) {
+        struct Record * record = (struct Record *) valueVectorGet(vector, i);
+        EXPECT_NE(record, &records[i]);
+        EXPECT_EQ(record -> id, i);
+        EXPECT_EQ((char *) record, vector -> elements + i * sizeof(struct Record));
+    }
+
+    EXPECT_DEATH(valueVectorGet(vector, 10), ::testing::HasSubstr("The index is out of bounds."));
+}
+
+// valueVectorPushBackMany, valueVectorGetMany
+TEST_F(ValueVectorTest, valueVectorPushBackManyTest) {
+    EXPECT_EQ(valueVectorPushBackMany(vector, records, 4), true);
+    EXPECT_EQ(valueVectorPushBackMany(vector, records + 4, 6), true);
+    EXPECT_EQ(vector -> size, 10);
+
+    struct Record copies[3];
+    valueVectorGetMany(vector, 7, 3, copies);
+    for (unsigned i = 0; i < 3; i++)
+        EXPECT_EQ(copies[i].id, 7 + i);
+
+    EXPECT_DEATH(valueVectorGetMany(vector, 8, 3, copies), ::testing::HasSubstr("The index is out of bounds."));
+}
+
+// valueVectorSet
+TEST_F(ValueVectorTest, valueVectorSetTest) {
+    valueVectorPushBackMany(vector, records, 10);
+
+    valueVectorSet(vector, 3, &records[9]);
+    EXPECT_EQ(((struct Record *) valueVectorGet(vector, 3)) -> id, 9);
+
+    // Through the collection interface, elements are copied the same way
+    vector -> collection.set(&vector -> collection, 4, &records[0]);
+    EXPECT_EQ(((struct Record *) vector -> collection.get(&vector -> collection, 4)) -> id, 0);
+
+    EXPECT_DEATH(valueVectorSet(vector, 10, &records[0]), ::testing::HasSubstr("The index is out of bounds."));
+}
+
+// valueVectorInsert, valueVectorInsertMany
+TEST_F(ValueVectorTest, valueVectorInsertTest) {
+    valueVectorPushBack(vector, &records[0]);
+    valueVectorPushBack(vector, &records[5]);
+
+    // In the middle, at the front and at the back
+    valueVectorInsertMany(vector, 1, records + 1, 4);
+    valueVectorInsert(vector, 0, &records[9]);
+    valueVectorInsert(vector, vector -> size, &records[8]);
+
+    uint32_t expected[] = {9, 0, 1, 2, 3, 4, 5, 8};
+    ASSERT_EQ(vector -> size, 8);
+    for (unsigned i = 0; i < 8; i++)
+        EXPECT_EQ(((struct Record *) valueVectorGet(vector, i)) -> id, expected[i]);
+
+    EXPECT_DEATH(valueVectorInsert(vector, 9, &records[0]), ::testing::HasSubstr("The index is out of bounds."));
+}
+
+// valueVectorErase, valueVectorEraseMany
+TEST_F(ValueVectorTest, valueVectorEraseTest) {
+    valueVectorPushBackMany(vector, records, 10);
+    deleted_records = 0;
+
+    valueVectorErase(vector, 0, countRecord);
+    valueVectorEraseMany(vector, 2, 3, countRecord);
+    valueVectorErase(vector, vector -> size - 1, nullptr);
+
+    uint32_t expected[] = {1, 2, 6, 7, 8};
+    ASSERT_EQ(vector -> size, 5);
+    EXPECT_EQ(deleted_records, 4);
+    for (unsigned i = 0; i < 5; i++)
+        EXPECT_EQ(((struct Record *) valueVectorGet(vector, i)) -> id, expected[i]);
+
+    EXPECT_DEATH(valueVectorEraseMany(vector, 3, 3, nullptr), ::testing::HasSubstr("The index is out of bounds."));
+
+    // The remaining elements are handed to the deleter when the vector goes away
+    deleteValueVector(&vector, countRecord);
+    EXPECT_EQ(deleted_records, 9);
+}
+
+// ->begin, ->next, ->deref, ->atEnd
+TEST_F(ValueVectorTest, valueVector_iterator_Test) {
+    struct Collection const * collection = &vector -> collection;
+    struct CIterator iterator;
+
+    EXPECT_EQ(collection -> begin(collection, &iterator), false);
+
+    valueVectorPushBackMany(vector, records, 10);
+
+    uint32_t expected = 0;
+    for (bool more = collection -> begin(collection, &iterator); more; more = collection -> next(&iterator))
+        EXPECT_EQ(((struct Record *) collection -> deref(&iterator)) -> id, expected++);
+    EXPECT_EQ(expected, 10);
+
+    EXPECT_EQ(collection -> atEnd(collection, 9), false);
+    EXPECT_EQ(collection -> atEnd(collection, 10), true);
+    EXPECT_EQ(collection -> span, nullptr);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+    #include "wsdeque.h"
+}
+
+class WorkStealingDequeTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            deque = newWorkStealingDeque(3);
+        }
+
+        void TearDown() override {
+            deleteWorkStealingDeque(&deque, nullptr);
+        }
+
+        struct WorkStealingDeque * deque;
+};
+
+// newWorkStealingDeque
+TEST_F(WorkStealingDequeTest, newWorkStealingDequeTest) {
+    EXPECT_NE(deque, nullptr);
+
+    // The capacity is rounded up to a power of two
+    EXPECT_EQ(deque -> array -> capacity, 4);
+    EXPECT_EQ(isWorkStealingDequeEmpty(deque), true);
+
+    // The indices written by the owner and by thieves live on their own cache line
+    EXPECT_NE((uintptr_t) &deque -> top / CACHE_LINE_SIZE, (uintptr_t) &deque -> bottom / CACHE_LINE_SIZE);
+
+    EXPECT_DEATH(newWorkStealingDeque(0), ::testing::HasSubstr("Deque capacity cannot be zero."));
+}
+
+// workStealingDequePushBack, workStealingDequePopBack, workStealingDequeSteal
+TEST_F(WorkStealingDequeTest, pushPopStealTest) {
+    int values[20];
+    EXPECT_EQ(workStealingDequePopBack(deque), nullptr);
+    EXPECT_EQ(workStealingDequeSteal(deque), nullptr);
+
+    for (int i = 0; i < 3; i++)
+        workStealingDequePushBack(deque, &values[i]);
+
+    // The owner works at the back and thieves at the front
+    EXPECT_EQ(workStealingDequePopBack(deque), &values[2]);
+    EXPECT_EQ(workStealingDequeSteal(deque), &values[0]);
+    EXPECT_EQ(workStealingDequePopBack(deque), &values[1]);
+    EXPECT_EQ(workStealingDequePopBack(deque), nullptr);
+    EXPECT_EQ(workStealingDequeSteal(deque), nullptr);
+    EXPECT_EQ(isWorkStealingDequeEmpty(deque), true);
+
+    // Pushing past the capacity grows the array, with the elements staying in order
+    workStealingDequePushBack(deque, &values[0]);
+    workStealingDequeSteal(deque);
+    for (int i = 0; i < 20; i++)
+        workStealingDequePushBack(deque, &values[i]);
+
+    EXPECT_EQ(deque -> array -> capacity, 32);
+    EXPECT_NE(deque -> array -> previous, nullptr);
+    for (int i = 0; i < 10; i++)
+        EXPECT_EQ(workStealingDequeSteal(deque), &values[i]);
+    for (int i = 19; i >= 10; i--)
+        EXPECT_EQ(workStealingDequePopBack(deque), &values[i]);
+    EXPECT_EQ(isWorkStealingDequeEmpty(deque), true);
+
+    // NULL is what popping or stealing returns when there is nothing to take, so it cannot be pushed
+    EXPECT_DEATH(workStealingDequePushBack(deque, nullptr), ::testing::HasSubstr("The parameter <element> cannot be NULL."));
+
+    deleteWorkStealingDeque(&deque, nullptr);
+    EXPECT_DEATH(workStealingDequePushBack(deque, &values[0]), ::testing::HasSubstr("The parameter <deque> cannot be NULL."));
+    EXPECT_DEATH(workStealingDequePopBack(deque), ::testing::HasSubstr("The parameter <deque> cannot be NULL."));
+    EXPECT_DEATH(workStealingDequeSteal(deque), ::testing::HasSubstr("The parameter <deque> cannot be NULL."));
+}
+
+// Stolen elements leave from the top and popped ones from the bottom, the deleter gets what lies in between
+static std::vector<intptr_t> deleted_values;
+
+static void collectDeleted(void * element) {
+    deleted_values.push_back((intptr_t) element);
+}
+
+TEST_F(WorkStealingDequeTest, deleteWorkStealingDequeTest) {
+    for (intptr_t i = 1; i <= 10; i++)
+        workStealingDequePushBack(deque, (void *) i);
+    for (int i = 0; i < 3; i++)
+        workStealingDequeSteal(deque);
+    workStealingDequePopBack(deque);
+
+    deleted_values.clear();
+    deleteWorkStealingDeque(&deque, collectDeleted);
+    EXPECT_EQ(deque, nullptr);
+    EXPECT_THAT(deleted_values, ::testing::UnorderedElementsAre(4, 5, 6, 7, 8, 9));
+}
+
+// The owner pushes and pops while thieves steal, every element must be taken exactly once
+TEST_F(WorkStealingDequeTest, concurrentStealTest) {
+    const unsigned thieves_count = 3;
+    const uintptr_t count = 100000;
+    bool owner_done = false;
+
+    std::vector<std::vector<uintptr_t>> stolen(thieves_count);
+    std::vector<std::thread> thieves;
+    for (unsigned t = 0; t < thieves_count; t++) {
+        thieves.emplace_back([this, t, &stolen, &owner_done]() {
+            while (__atomic_load_n(&owner_done, __ATOMIC_ACQUIRE) == false) {
+                void * element = workStealingDequeSteal(deque);
+                if (element != nullptr)
+                    stolen[t].push_back((uintptr_t) element);
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    // The owner pops one element for every two it pushes so that the deque keeps growing and shrinking
+    std::vector<uintptr_t> popped;
+    for (uintptr_t i = 1; i <= count; i++) {
+        workStealingDequePushBack(deque, (void *) i);
+        if (i % 2 == 0) {
+            void * element = workStealingDequePopBack(deque);
+            if (element != nullptr)
+                popped.push_back((uintptr_t) element);
+        }
+    }
+
+    void * element;
+    while (isWorkStealingDequeEmpty(deque) == false) {
+        if ((element = workStealingDequePopBack(deque)) != nullptr)
+            popped.push_back((uintptr_t) element);
+    }
+
+    __atomic_store_n(&owner_done, true, __ATOMIC_RELEASE);
+    for (std::thread & thief : thieves)
+        thief.join();
+
+    std::vector<unsigned> seen(count + 1, 0);
+    for (uintptr_t value : popped)
+        seen[value]++;
+    for (std::vector<uintptr_t> & values : stolen) {
+        // Each thief sees elements in the order they were pushed
+        for (size_t i = 1; i < values.size(); i++)
+            ASSERT_LT(values[i - 1], values[i]);
+        for (uintptr_t value : values)
+            seen[value]++;
+    }
+
+    for (uintptr_t i = 1; i <= count; i++)
+        ASSERT_EQ(seen[i], 1);
+}
+